@@ -0,0 +1,148 @@
+#include <benchmark/benchmark.h>
+
+#include <components/detournavigator/navigatorimpl.hpp>
+#include <components/detournavigator/navigatorutils.hpp>
+#include <components/detournavigator/navmeshdb.hpp>
+#include <components/esm/loadland.hpp>
+#include <components/loadinglistener/loadinglistener.hpp>
+#include <components/sceneutil/workqueue.hpp>
+
+#include <chrono>
+#include <cmath>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace
+{
+    using namespace DetourNavigator;
+
+    constexpr std::size_t requestsPerBatch = 256;
+
+    const osg::Vec3f agentHalfExtents(29, 29, 66);
+    const float stepSize = 28.333332061767578125f;
+
+    Settings makeSettings()
+    {
+        Settings result;
+        result.mEnableWriteRecastMeshToFile = false;
+        result.mEnableWriteNavMeshToFile = false;
+        result.mEnableRecastMeshFileNameRevision = false;
+        result.mEnableNavMeshFileNameRevision = false;
+        result.mRecast.mBorderSize = 16;
+        result.mRecast.mCellHeight = 0.2f;
+        result.mRecast.mCellSize = 0.2f;
+        result.mRecast.mDetailSampleDist = 6;
+        result.mRecast.mDetailSampleMaxError = 1;
+        result.mRecast.mMaxClimb = 34;
+        result.mRecast.mMaxSimplificationError = 1.3f;
+        result.mRecast.mMaxSlope = 49;
+        result.mRecast.mRecastScaleFactor = 0.017647058823529415f;
+        result.mRecast.mSwimHeightScale = 0.89999997615814208984375f;
+        result.mRecast.mMaxEdgeLen = 12;
+        result.mDetour.mMaxNavMeshQueryNodes = 2048;
+        result.mRecast.mMaxVertsPerPoly = 6;
+        result.mRecast.mRegionMergeArea = 400;
+        result.mRecast.mRegionMinArea = 64;
+        result.mRecast.mTileSize = 64;
+        result.mWaitUntilMinDistanceToPlayer = std::numeric_limits<int>::max();
+        result.mAsyncNavMeshUpdaterThreads = 4;
+        result.mMaxNavMeshTilesCacheSize = 64 * 1024 * 1024;
+        result.mDetour.mMaxPolygonPathSize = 1024;
+        result.mDetour.mMaxSmoothPathSize = 1024;
+        result.mDetour.mMaxPolys = 4096;
+        result.mMaxTilesNumber = 512;
+        result.mMinUpdateInterval = std::chrono::milliseconds(50);
+        result.mWriteToNavMeshDb = false;
+        return result;
+    }
+
+    /// Navmesh over a single exterior cell with hilly terrain, generated once for all benchmarks.
+    struct Scene
+    {
+        std::vector<float> mHeights;
+        std::unique_ptr<Navigator> mNavigator;
+
+        Scene()
+            : mHeights(ESM::Land::LAND_SIZE * ESM::Land::LAND_SIZE)
+        {
+            for (int y = 0; y < ESM::Land::LAND_SIZE; ++y)
+                for (int x = 0; x < ESM::Land::LAND_SIZE; ++x)
+                    mHeights[y * ESM::Land::LAND_SIZE + x] = 40 * std::sin(x * 0.3f) * std::cos(y * 0.2f);
+
+            HeightfieldSurface surface;
+            surface.mHeights = mHeights.data();
+            surface.mSize = ESM::Land::LAND_SIZE;
+            surface.mMinHeight = -40;
+            surface.mMaxHeight = 40;
+
+            mNavigator = std::make_unique<NavigatorImpl>(makeSettings(), std::make_unique<NavMeshDb>(":memory:"));
+            mNavigator->addAgent(agentHalfExtents);
+            mNavigator->addHeightfield(osg::Vec2i(0, 0), ESM::Land::REAL_SIZE, surface);
+            mNavigator->update(osg::Vec3f(ESM::Land::REAL_SIZE / 2, ESM::Land::REAL_SIZE / 2, 0));
+            Loading::Listener listener;
+            mNavigator->wait(listener, WaitConditionType::allJobsDone);
+        }
+    };
+
+    const Scene& getScene()
+    {
+        static const Scene scene;
+        return scene;
+    }
+
+    std::vector<PathRequest> generateRequests(std::size_t count)
+    {
+        std::minstd_rand random;
+        std::uniform_real_distribution<float> distribution(512, ESM::Land::REAL_SIZE - 512);
+        std::vector<PathRequest> result;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const osg::Vec3f start(distribution(random), distribution(random), 0);
+            const osg::Vec3f end(distribution(random), distribution(random), 0);
+            result.push_back(PathRequest {agentHalfExtents, stepSize, start, end, Flag_walk, AreaCosts {}, 0});
+        }
+        return result;
+    }
+
+    void findPathSequentially(benchmark::State& state)
+    {
+        const Navigator& navigator = *getScene().mNavigator;
+        const std::vector<PathRequest> requests = generateRequests(requestsPerBatch);
+        std::vector<osg::Vec3f> path;
+
+        for (auto _ : state)
+        {
+            for (const PathRequest& request : requests)
+            {
+                path.clear();
+                auto out = std::back_inserter(path);
+                benchmark::DoNotOptimize(findPath(navigator, request.mAgentHalfExtents, request.mStepSize,
+                    request.mStart, request.mEnd, request.mIncludeFlags, request.mAreaCosts, request.mEndTolerance, out));
+            }
+        }
+
+        state.SetItemsProcessed(state.iterations() * requests.size());
+    }
+
+    void findPathsInBatch(benchmark::State& state)
+    {
+        const Navigator& navigator = *getScene().mNavigator;
+        const std::vector<PathRequest> requests = generateRequests(requestsPerBatch);
+        // The calling thread takes requests too
+        const std::size_t workers = static_cast<std::size_t>(state.range(0)) - 1;
+        const osg::ref_ptr<SceneUtil::WorkQueue> workQueue(new SceneUtil::WorkQueue(workers));
+
+        for (auto _ : state)
+            benchmark::DoNotOptimize(findPaths(navigator, requests, workQueue.get(), workers));
+
+        state.SetItemsProcessed(state.iterations() * requests.size());
+    }
+}
+
+BENCHMARK(findPathSequentially)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(findPathsInBatch)->Unit(benchmark::kMillisecond)->UseRealTime()->Arg(1)->Arg(2)->Arg(4)->Arg(8);
+
+BENCHMARK_MAIN();
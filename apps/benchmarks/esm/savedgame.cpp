@@ -0,0 +1,199 @@
+#include <benchmark/benchmark.h>
+
+#include <components/esm/cellstate.hpp>
+#include <components/esm/compressedsavedgame.hpp>
+#include <components/esm/esmreader.hpp>
+#include <components/esm/esmwriter.hpp>
+#include <components/esm/fogstate.hpp>
+#include <components/esm/objectstate.hpp>
+#include <components/esm/savedgame.hpp>
+
+#include <algorithm>
+#include <random>
+#include <sstream>
+#include <string>
+
+namespace
+{
+    template <typename Random>
+    ESM::ObjectState generateObjectState(std::size_t index, Random& random)
+    {
+        std::uniform_real_distribution<float> distribution(-8192, 8192);
+        ESM::ObjectState result;
+        result.blank();
+        result.mRef.blank();
+        result.mRef.mRefID = "object_" + std::to_string(index % 500);
+        result.mRef.mRefNum.mIndex = static_cast<unsigned int>(index);
+        result.mRef.mRefNum.mContentFile = 0;
+        for (int i = 0; i < 3; ++i)
+        {
+            result.mPosition.pos[i] = distribution(random);
+            result.mPosition.rot[i] = distribution(random) / 8192;
+        }
+        result.mCount = 1;
+        result.mEnabled = 1;
+        result.mHasCustomState = false;
+        return result;
+    }
+
+    template <typename Random>
+    ESM::FogTexture generateFogTexture(int x, int y, Random& random)
+    {
+        // Fog textures are stored as PNG which doesn't compress much further
+        std::uniform_int_distribution<int> distribution(0, 255);
+        ESM::FogTexture result;
+        result.mX = x;
+        result.mY = y;
+        result.mImageData.resize(4096);
+        std::generate(result.mImageData.begin(), result.mImageData.end(),
+                      [&] { return static_cast<char>(distribution(random)); });
+        return result;
+    }
+
+    /// Writes a saved game that resembles one from late in a playthrough: many visited cells with changed
+    /// references, and fog of war for some of them.
+    std::string generateSavedGame(int cells, std::size_t objectsPerCell)
+    {
+        std::minstd_rand random;
+        std::ostringstream stream;
+        ESM::ESMWriter writer;
+        writer.setFormat(ESM::SavedGame::sCurrentFormat);
+        writer.setRecordCount(1 + 2 * cells);
+        writer.save(stream);
+
+        ESM::SavedGame profile;
+        profile.mPlayerName = "player";
+        profile.mPlayerLevel = 1;
+        profile.mPlayerCell = "cell";
+        profile.mInGameTime = ESM::EpochTimeStamp {};
+        profile.mTimePlayed = 0;
+        profile.mScreenshot.resize(16 * 1024);
+        writer.startRecord(ESM::REC_SAVE);
+        profile.save(writer);
+        writer.endRecord(ESM::REC_SAVE);
+
+        std::size_t index = 0;
+        for (int i = 0; i < cells; ++i)
+        {
+            ESM::CellState cellState;
+            cellState.mId.mWorldspace = ESM::CellId::sDefaultWorldspace;
+            cellState.mId.mIndex.mX = i % 64;
+            cellState.mId.mIndex.mY = i / 64;
+            cellState.mId.mPaged = true;
+            cellState.mWaterLevel = 0;
+            cellState.mHasFogOfWar = i % 4 == 0;
+            cellState.mLastRespawn = ESM::TimeStamp {};
+
+            writer.startRecord(ESM::REC_CSTA);
+            cellState.save(writer);
+            if (cellState.mHasFogOfWar)
+            {
+                ESM::FogState fog;
+                fog.mFogTextures.push_back(generateFogTexture(cellState.mId.mIndex.mX, cellState.mId.mIndex.mY, random));
+                fog.save(writer, false);
+            }
+            for (std::size_t j = 0; j < objectsPerCell; ++j)
+            {
+                writer.writeHNT("OBJE", static_cast<int>(ESM::REC_STAT));
+                generateObjectState(index++, random).save(writer);
+            }
+            writer.writeHNT("OBJE", static_cast<int>(0));
+            writer.endRecord(ESM::REC_CSTA);
+
+            writer.startRecord(ESM::REC_GMAP);
+            writer.writeHNT("DATA", static_cast<std::uint32_t>(i));
+            writer.endRecord(ESM::REC_GMAP);
+        }
+        writer.close();
+        return stream.str();
+    }
+
+    const std::string& getSavedGame()
+    {
+        static const std::string result = generateSavedGame(4096, 100);
+        return result;
+    }
+
+    std::size_t readAllRecords(ESM::ESMReader& reader)
+    {
+        std::size_t result = 0;
+        while (reader.hasMoreRecs())
+        {
+            reader.getRecName();
+            reader.getRecHeader();
+            while (reader.hasMoreSubs())
+            {
+                reader.getSubName();
+                reader.skipHSub();
+                ++result;
+            }
+        }
+        return result;
+    }
+
+    void writeUncompressed(benchmark::State& state)
+    {
+        const std::string& data = getSavedGame();
+        std::size_t size = 0;
+        for (auto _ : state)
+        {
+            std::istringstream source(data);
+            std::ostringstream dest;
+            dest << source.rdbuf();
+            size = static_cast<std::size_t>(dest.tellp());
+        }
+        state.counters["size"] = static_cast<double>(size);
+        state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * data.size()));
+    }
+
+    void writeCompressed(benchmark::State& state)
+    {
+        const std::string& data = getSavedGame();
+        std::size_t size = 0;
+        for (auto _ : state)
+        {
+            std::istringstream source(data);
+            std::ostringstream dest;
+            ESM::writeCompressedSavedGame(source, dest, static_cast<std::size_t>(state.range(0)));
+            size = static_cast<std::size_t>(dest.tellp());
+        }
+        state.counters["size"] = static_cast<double>(size);
+        state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * data.size()));
+    }
+
+    void readUncompressed(benchmark::State& state)
+    {
+        const std::string& data = getSavedGame();
+        for (auto _ : state)
+        {
+            ESM::ESMReader reader;
+            reader.open(ESM::openSavedGame(std::make_unique<std::istringstream>(data)), "save");
+            benchmark::DoNotOptimize(readAllRecords(reader));
+        }
+        state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * data.size()));
+    }
+
+    void readCompressed(benchmark::State& state)
+    {
+        const std::string& data = getSavedGame();
+        std::istringstream source(data);
+        std::ostringstream dest;
+        ESM::writeCompressedSavedGame(source, dest, static_cast<std::size_t>(state.range(0)));
+        const std::string compressed = dest.str();
+        for (auto _ : state)
+        {
+            ESM::ESMReader reader;
+            reader.open(ESM::openSavedGame(std::make_unique<std::istringstream>(compressed)), "save");
+            benchmark::DoNotOptimize(readAllRecords(reader));
+        }
+        state.counters["size"] = static_cast<double>(compressed.size());
+        state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * data.size()));
+    }
+}
+
+BENCHMARK(writeUncompressed);
+BENCHMARK(writeCompressed)->Arg(64 * 1024)->Arg(1024 * 1024)->Arg(4 * 1024 * 1024);
+BENCHMARK(readUncompressed);
+BENCHMARK(readCompressed)->Arg(64 * 1024)->Arg(1024 * 1024)->Arg(4 * 1024 * 1024);
+
+BENCHMARK_MAIN();
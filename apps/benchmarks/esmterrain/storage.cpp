@@ -0,0 +1,148 @@
+#include <benchmark/benchmark.h>
+
+#include <components/esm/loadland.hpp>
+#include <components/esmterrain/storage.hpp>
+
+#include <osg/Array>
+
+#include <random>
+#include <vector>
+
+namespace
+{
+    constexpr int gridSize = 16;
+    constexpr int loadFlags = ESM::Land::DATA_VHGT | ESM::Land::DATA_VNML | ESM::Land::DATA_VCLR | ESM::Land::DATA_VTEX;
+
+    /// Square grid of generated cells. Land objects are kept between the calls like MWRender::LandManager does.
+    class GridStorage final : public ESMTerrain::Storage
+    {
+    public:
+        GridStorage()
+            : ESMTerrain::Storage(nullptr)
+            , mLands(gridSize * gridSize)
+        {
+            std::minstd_rand random;
+            std::uniform_int_distribution<int> heightDistribution(-256, 256);
+            std::uniform_int_distribution<int> normalDistribution(-64, 64);
+            std::uniform_int_distribution<int> colourDistribution(0, 255);
+            for (std::size_t i = 0; i < mLands.size(); ++i)
+            {
+                ESM::Land& land = mLands[i];
+                land.blank();
+                land.mX = static_cast<int>(i) % gridSize;
+                land.mY = static_cast<int>(i) / gridSize;
+                ESM::Land::LandData& data = *land.getLandData();
+                for (int j = 0; j < ESM::Land::LAND_NUM_VERTS; ++j)
+                {
+                    data.mHeights[j] = heightDistribution(random) * 8.f;
+                    data.mNormals[j * 3] = static_cast<ESM::Land::VNML>(normalDistribution(random));
+                    data.mNormals[j * 3 + 1] = static_cast<ESM::Land::VNML>(normalDistribution(random));
+                    data.mNormals[j * 3 + 2] = 127;
+                    for (int k = 0; k < 3; ++k)
+                        data.mColours[j * 3 + k] = static_cast<unsigned char>(colourDistribution(random));
+                }
+            }
+            clearCache();
+        }
+
+        /// Drops the land objects together with the vertex data decoded for them.
+        void clearCache()
+        {
+            mLandObjects.clear();
+            for (const ESM::Land& land : mLands)
+                mLandObjects.emplace_back(new ESMTerrain::LandObject(&land, loadFlags));
+        }
+
+        osg::ref_ptr<const ESMTerrain::LandObject> getLand(int cellX, int cellY) override
+        {
+            if (cellX < 0 || cellY < 0 || cellX >= gridSize || cellY >= gridSize)
+                return nullptr;
+            return mLandObjects[cellY * gridSize + cellX];
+        }
+
+        const ESM::LandTexture* getLandTexture(int index, short plugin) override
+        {
+            return nullptr;
+        }
+
+        void getBounds(float& minX, float& maxX, float& minY, float& maxY) override
+        {
+            minX = minY = 0;
+            maxX = maxY = gridSize;
+        }
+
+    private:
+        std::vector<ESM::Land> mLands;
+        std::vector<osg::ref_ptr<const ESMTerrain::LandObject>> mLandObjects;
+    };
+
+    /// Builds all chunks of the grid with the same size and LOD level as the quad tree would use for them.
+    std::size_t fillAllChunks(GridStorage& storage, int chunkSize)
+    {
+        int lodLevel = 0;
+        while ((1 << lodLevel) < chunkSize)
+            ++lodLevel;
+        osg::ref_ptr<osg::Vec3Array> positions = new osg::Vec3Array;
+        osg::ref_ptr<osg::Vec3Array> normals = new osg::Vec3Array;
+        osg::ref_ptr<osg::Vec4ubArray> colours = new osg::Vec4ubArray;
+        std::size_t chunks = 0;
+        for (int x = 0; x < gridSize; x += chunkSize)
+        {
+            for (int y = 0; y < gridSize; y += chunkSize)
+            {
+                const osg::Vec2f center(x + chunkSize / 2.f, y + chunkSize / 2.f);
+                storage.fillVertexBuffers(lodLevel, static_cast<float>(chunkSize), center, positions, normals, colours);
+                benchmark::DoNotOptimize(positions->front());
+                ++chunks;
+            }
+        }
+        return chunks;
+    }
+
+    void fillVertexBuffers(benchmark::State& state)
+    {
+        GridStorage storage;
+        const int chunkSize = static_cast<int>(state.range(0));
+        std::size_t chunks = 0;
+        for (auto _ : state)
+            chunks += fillAllChunks(storage, chunkSize);
+        state.counters["chunks"] = benchmark::Counter(static_cast<double>(chunks), benchmark::Counter::kIsRate);
+    }
+
+    void fillVertexBuffersWithoutCache(benchmark::State& state)
+    {
+        GridStorage storage;
+        const int chunkSize = static_cast<int>(state.range(0));
+        std::size_t chunks = 0;
+        for (auto _ : state)
+        {
+            state.PauseTiming();
+            storage.clearCache();
+            state.ResumeTiming();
+            chunks += fillAllChunks(storage, chunkSize);
+        }
+        state.counters["chunks"] = benchmark::Counter(static_cast<double>(chunks), benchmark::Counter::kIsRate);
+    }
+
+    /// All LOD levels of the quad tree, one after another, sharing the decoded cells.
+    void fillVertexBuffersForAllLods(benchmark::State& state)
+    {
+        GridStorage storage;
+        std::size_t chunks = 0;
+        for (auto _ : state)
+        {
+            state.PauseTiming();
+            storage.clearCache();
+            state.ResumeTiming();
+            for (int chunkSize = 1; chunkSize <= gridSize; chunkSize *= 2)
+                chunks += fillAllChunks(storage, chunkSize);
+        }
+        state.counters["chunks"] = benchmark::Counter(static_cast<double>(chunks), benchmark::Counter::kIsRate);
+    }
+}
+
+BENCHMARK(fillVertexBuffers)->Arg(1)->Arg(4)->Arg(16);
+BENCHMARK(fillVertexBuffersWithoutCache)->Arg(1)->Arg(4)->Arg(16);
+BENCHMARK(fillVertexBuffersForAllLods);
+
+BENCHMARK_MAIN();
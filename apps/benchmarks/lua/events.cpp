@@ -0,0 +1,72 @@
+#include <benchmark/benchmark.h>
+
+#include <components/lua/serialization.hpp>
+
+#include <osg/Vec3f>
+
+#include <vector>
+
+namespace
+{
+    // Event data similar to what mods usually send: a number, a small table, or a table with nested tables.
+    sol::object makeEventData(sol::state& lua, int complexity)
+    {
+        if (complexity == 0)
+            return sol::make_object(lua, 42.0);
+        sol::table result(lua, sol::create);
+        result["name"] = "some_event_payload";
+        result["position"] = osg::Vec3f(1, 2, 3);
+        result["value"] = 0.5;
+        result["enabled"] = true;
+        for (int i = 1; i < complexity; ++i)
+        {
+            sol::table nested(lua, sol::create);
+            nested["index"] = i;
+            nested["id"] = "nested_item";
+            nested["offset"] = osg::Vec3f(i, i, i);
+            result[i] = nested;
+        }
+        return result;
+    }
+
+    // Sending an event stored serialized data in the queue, receiving deserialized it.
+    void serializeEvents(benchmark::State& state)
+    {
+        sol::state lua;
+        lua.open_libraries(sol::lib::base);
+        const sol::object data = makeEventData(lua, static_cast<int>(state.range(0)));
+        std::vector<LuaUtil::BinaryData> queue;
+        for (auto _ : state)
+        {
+            for (int i = 0; i < 100; ++i)
+                queue.push_back(LuaUtil::serialize(data));
+            for (const LuaUtil::BinaryData& event : queue)
+                benchmark::DoNotOptimize(LuaUtil::deserialize(lua, event));
+            queue.clear();
+        }
+        state.SetItemsProcessed(state.iterations() * 100);
+    }
+
+    // Sending an event stores a copy of the data in the queue, receiving passes it as it is.
+    void copyEvents(benchmark::State& state)
+    {
+        sol::state lua;
+        lua.open_libraries(sol::lib::base);
+        const sol::object data = makeEventData(lua, static_cast<int>(state.range(0)));
+        std::vector<sol::object> queue;
+        for (auto _ : state)
+        {
+            for (int i = 0; i < 100; ++i)
+                queue.push_back(LuaUtil::copy(lua, data));
+            for (const sol::object& event : queue)
+                benchmark::DoNotOptimize(event);
+            queue.clear();
+        }
+        state.SetItemsProcessed(state.iterations() * 100);
+    }
+}
+
+BENCHMARK(serializeEvents)->Arg(0)->Arg(1)->Arg(10);
+BENCHMARK(copyEvents)->Arg(0)->Arg(1)->Arg(10);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,117 @@
+#include <benchmark/benchmark.h>
+
+#include "apps/openmw/mwmechanics/magiceffects.hpp"
+
+#include <components/esm/activespells.hpp>
+#include <components/esm/loadmgef.hpp>
+
+#include <cstddef>
+#include <random>
+#include <vector>
+
+namespace
+{
+    using namespace MWMechanics;
+
+    constexpr std::size_t actorsCount = 100;
+
+    // Effects checked by the actors and character controllers every frame.
+    constexpr int readEffects[] = {
+        ESM::MagicEffect::Soultrap, ESM::MagicEffect::StuntedMagicka, ESM::MagicEffect::WaterBreathing,
+        ESM::MagicEffect::CalmHumanoid, ESM::MagicEffect::Vampirism, ESM::MagicEffect::Paralyze,
+        ESM::MagicEffect::Levitate, ESM::MagicEffect::Jump, ESM::MagicEffect::Light, ESM::MagicEffect::Invisibility,
+        ESM::MagicEffect::Chameleon, ESM::MagicEffect::Sanctuary, ESM::MagicEffect::FortifyMaximumMagicka,
+        ESM::MagicEffect::SwiftSwim, ESM::MagicEffect::SlowFall, ESM::MagicEffect::Burden,
+    };
+
+    // Effects with an argument are like fortify or drain attribute and skill.
+    constexpr int argEffects[] = {
+        ESM::MagicEffect::FortifyAttribute, ESM::MagicEffect::DrainAttribute, ESM::MagicEffect::FortifySkill,
+        ESM::MagicEffect::DrainSkill, ESM::MagicEffect::DamageAttribute, ESM::MagicEffect::RestoreAttribute,
+    };
+
+    struct Actor
+    {
+        std::vector<ESM::ActiveEffect> mEffects;
+        MagicEffects mMagnitudes;
+    };
+
+    std::vector<Actor> makeActors(std::size_t effectsCount)
+    {
+        std::minstd_rand random;
+        std::uniform_int_distribution<int> effectId(0, ESM::MagicEffect::Length - 1);
+        std::uniform_int_distribution<std::size_t> argEffect(0, std::size(argEffects) - 1);
+        std::uniform_int_distribution<int> arg(0, 26);
+        std::uniform_real_distribution<float> magnitude(1, 100);
+        std::bernoulli_distribution hasArg(0.2);
+        std::vector<Actor> result(actorsCount);
+        for (Actor& actor : result)
+        {
+            for (std::size_t i = 0; i < effectsCount; ++i)
+            {
+                ESM::ActiveEffect effect {};
+                if (hasArg(random))
+                {
+                    effect.mEffectId = argEffects[argEffect(random)];
+                    effect.mArg = arg(random);
+                }
+                else
+                {
+                    effect.mEffectId = effectId(random);
+                    effect.mArg = -1;
+                }
+                effect.mMinMagnitude = magnitude(random);
+                effect.mMaxMagnitude = effect.mMinMagnitude + magnitude(random);
+                actor.mEffects.push_back(effect);
+            }
+        }
+        return result;
+    }
+
+    // Reapplies all active effects with new magnitudes and reads the effects like the actors update does.
+    float updateActor(Actor& actor, std::minstd_rand& random)
+    {
+        for (ESM::ActiveEffect& effect : actor.mEffects)
+        {
+            std::uniform_real_distribution<float> distribution(effect.mMinMagnitude, effect.mMaxMagnitude);
+            const float magnitude = distribution(random);
+            actor.mMagnitudes.add(EffectKey(effect.mEffectId, effect.mArg), EffectParam(magnitude - effect.mMagnitude));
+            effect.mMagnitude = magnitude;
+        }
+        float result = 0;
+        for (int effectId : readEffects)
+            result += actor.mMagnitudes.get(EffectKey(effectId)).getMagnitude();
+        return result;
+    }
+
+    void recalculateMagicEffects(benchmark::State& state)
+    {
+        std::vector<Actor> actors = makeActors(static_cast<std::size_t>(state.range(0)));
+        std::minstd_rand random;
+        for (auto _ : state)
+            for (Actor& actor : actors)
+                benchmark::DoNotOptimize(updateActor(actor, random));
+        state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(actors.size()));
+    }
+
+    void setMagicEffectsModifiers(benchmark::State& state)
+    {
+        std::vector<Actor> actors = makeActors(static_cast<std::size_t>(state.range(0)));
+        std::minstd_rand random;
+        for (Actor& actor : actors)
+            updateActor(actor, random);
+        MagicEffects stats;
+        for (auto _ : state)
+        {
+            for (const Actor& actor : actors)
+                stats.setModifiers(actor.mMagnitudes);
+            benchmark::DoNotOptimize(stats);
+        }
+        state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(actors.size()));
+    }
+}
+
+BENCHMARK(recalculateMagicEffects)->Arg(4)->Arg(16)->Arg(64);
+BENCHMARK(setMagicEffectsModifiers)->Arg(4)->Arg(16)->Arg(64);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,97 @@
+#include <benchmark/benchmark.h>
+
+#include "apps/openmw/mwsound/voiceselector.hpp"
+
+#include <cmath>
+#include <cstddef>
+#include <random>
+#include <vector>
+
+namespace
+{
+    constexpr std::size_t maxRealVoices = 192;
+
+    struct Emitter
+    {
+        float mX;
+        float mY;
+        float mVelocityX;
+        float mVelocityY;
+        float mVolume;
+        float mMinDistance;
+        float mMaxDistance;
+    };
+
+    /// Emitters wander around the listener in a square of a few exterior cells like actors do.
+    struct Simulation
+    {
+        std::vector<Emitter> mEmitters;
+        std::vector<MWSound::VoiceState> mVoices;
+        MWSound::VoiceSelector mSelector;
+
+        explicit Simulation(std::size_t count)
+            : mVoices(count)
+        {
+            std::minstd_rand random;
+            std::uniform_real_distribution<float> position(-16384, 16384);
+            std::uniform_real_distribution<float> velocity(-300, 300);
+            std::uniform_real_distribution<float> volume(0.2f, 1);
+            std::uniform_real_distribution<float> minDistance(100, 1000);
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                const float min = minDistance(random);
+                mEmitters.push_back(Emitter {position(random), position(random), velocity(random), velocity(random),
+                                             volume(random), min, min * 20});
+            }
+        }
+
+        /// Returns the number of voices that have to be bound to or released from a source.
+        std::size_t update(float duration)
+        {
+            for (std::size_t i = 0; i < mEmitters.size(); ++i)
+            {
+                Emitter& emitter = mEmitters[i];
+                emitter.mX += emitter.mVelocityX * duration;
+                emitter.mY += emitter.mVelocityY * duration;
+                if (std::abs(emitter.mX) > 16384)
+                    emitter.mVelocityX = -emitter.mVelocityX;
+                if (std::abs(emitter.mY) > 16384)
+                    emitter.mVelocityY = -emitter.mVelocityY;
+
+                MWSound::VoiceState& voice = mVoices[i];
+                const float distance = std::sqrt(emitter.mX * emitter.mX + emitter.mY * emitter.mY);
+                voice.mAudibility = emitter.mVolume
+                    * MWSound::getDistanceGain(distance, emitter.mMinDistance, emitter.mMaxDistance);
+                voice.mPlayable = true;
+            }
+
+            mSelector.select(mVoices, maxRealVoices);
+
+            std::size_t changes = 0;
+            for (MWSound::VoiceState& voice : mVoices)
+            {
+                if (voice.mReal != voice.mSelected)
+                    ++changes;
+                voice.mReal = voice.mSelected;
+            }
+            return changes;
+        }
+    };
+
+    void updateVirtualVoices(benchmark::State& state)
+    {
+        Simulation simulation(static_cast<std::size_t>(state.range(0)));
+        std::size_t changes = 0;
+        std::size_t updates = 0;
+        for (auto _ : state)
+        {
+            changes += simulation.update(1 / 30.f);
+            ++updates;
+        }
+        state.counters["changes per update"] = static_cast<double>(changes) / static_cast<double>(updates);
+    }
+}
+
+BENCHMARK(updateVirtualVoices)->Arg(100)->Arg(1000)->Arg(10000);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,181 @@
+#include <benchmark/benchmark.h>
+
+#include "apps/openmw/mwworld/bestitems.hpp"
+
+#include <cmath>
+#include <cstddef>
+#include <list>
+#include <random>
+#include <vector>
+
+namespace
+{
+    constexpr std::size_t itemsCount = 2000;
+    constexpr int weaponSkills = 6;
+
+    // Stack of a merchant inventory, a weapon when mSkill is not negative.
+    struct Stack
+    {
+        int mSkill;
+        int mDamage;
+        float mWeight;
+        int mCount;
+    };
+
+    using Stacks = std::list<Stack>;
+
+    struct Inventory
+    {
+        Stacks mStacks;
+        // To pick a random stack in constant time
+        std::vector<Stacks::iterator> mIndex;
+        std::minstd_rand mRandom;
+
+        Inventory()
+        {
+            for (std::size_t i = 0; i < itemsCount; ++i)
+                addStack();
+        }
+
+        Stacks::iterator addStack()
+        {
+            mIndex.push_back(mStacks.insert(mStacks.end(), makeStack()));
+            return mIndex.back();
+        }
+
+        Stack makeStack()
+        {
+            std::uniform_int_distribution<int> skill(-weaponSkills, weaponSkills - 1);
+            std::uniform_int_distribution<int> damage(1, 60);
+            std::uniform_real_distribution<float> weight(0.1f, 30);
+            std::uniform_int_distribution<int> count(1, 20);
+            return Stack {skill(mRandom), damage(mRandom), weight(mRandom), count(mRandom)};
+        }
+
+        // Picks a stack to sell like a merchant does.
+        std::size_t pickStack()
+        {
+            std::uniform_int_distribution<std::size_t> index(0, mIndex.size() - 1);
+            return index(mRandom);
+        }
+
+        void removeStack(std::size_t index)
+        {
+            mStacks.erase(mIndex[index]);
+            mIndex[index] = mIndex.back();
+            mIndex.pop_back();
+        }
+    };
+
+    float getWeight(const Stacks& stacks)
+    {
+        float result = 0;
+        for (const Stack& stack : stacks)
+            result += std::abs(stack.mCount) * stack.mWeight;
+        return result;
+    }
+
+    // Scan per skill like autoEquipWeapon did.
+    int rankWeapons(const Stacks& stacks)
+    {
+        int result = 0;
+        for (int skill = 0; skill < weaponSkills; ++skill)
+        {
+            int max = 0;
+            const Stack* best = nullptr;
+            for (const Stack& stack : stacks)
+            {
+                if (stack.mCount == 0 || stack.mSkill != skill)
+                    continue;
+                if (stack.mDamage >= max)
+                {
+                    max = stack.mDamage;
+                    best = &stack;
+                }
+            }
+            if (best != nullptr)
+                result += best->mDamage;
+        }
+        return result;
+    }
+
+    void rescanInventory(benchmark::State& state)
+    {
+        Inventory inventory;
+        for (auto _ : state)
+        {
+            inventory.removeStack(inventory.pickStack());
+            inventory.addStack();
+            benchmark::DoNotOptimize(getWeight(inventory.mStacks));
+            benchmark::DoNotOptimize(rankWeapons(inventory.mStacks));
+        }
+    }
+
+    struct Aggregates
+    {
+        float mWeight = 0;
+        MWWorld::BestItems<int, Stacks::const_iterator> mBestWeapons {0};
+        bool mBestWeaponsUpToDate = false;
+
+        void addStack(Stacks::const_iterator it)
+        {
+            mWeight += std::abs(it->mCount) * it->mWeight;
+            if (mBestWeaponsUpToDate && it->mSkill >= 0)
+                mBestWeapons.add(it->mSkill, it, static_cast<float>(it->mDamage));
+        }
+
+        void removeStack(Stacks::const_iterator it)
+        {
+            mWeight -= std::abs(it->mCount) * it->mWeight;
+            if (it->mSkill >= 0)
+                mBestWeaponsUpToDate = false;
+        }
+
+        int rankWeapons(const Stacks& stacks)
+        {
+            if (!mBestWeaponsUpToDate)
+            {
+                mBestWeapons.clear();
+                for (auto it = stacks.begin(); it != stacks.end(); ++it)
+                    if (it->mCount != 0 && it->mSkill >= 0)
+                        mBestWeapons.add(it->mSkill, it, static_cast<float>(it->mDamage));
+                mBestWeaponsUpToDate = true;
+            }
+            int result = 0;
+            for (int skill = 0; skill < weaponSkills; ++skill)
+                if (const Stacks::const_iterator* best = mBestWeapons.find(skill))
+                    result += (*best)->mDamage;
+            return result;
+        }
+    };
+
+    void updateInventoryIncrementally(benchmark::State& state)
+    {
+        Inventory inventory;
+        Aggregates aggregates;
+        for (auto it = inventory.mStacks.cbegin(); it != inventory.mStacks.cend(); ++it)
+            aggregates.addStack(it);
+        const bool sellWeapons = state.range(0) != 0;
+        for (auto _ : state)
+        {
+            std::size_t removed = inventory.pickStack();
+            // Merchants mostly trade the items they do not use
+            if (!sellWeapons)
+                while (inventory.mIndex[removed]->mSkill >= 0)
+                    removed = inventory.pickStack();
+            aggregates.removeStack(inventory.mIndex[removed]);
+            inventory.removeStack(removed);
+            const auto added = inventory.addStack();
+            if (!sellWeapons)
+                added->mSkill = -1;
+            aggregates.addStack(added);
+            benchmark::DoNotOptimize(aggregates.mWeight);
+            benchmark::DoNotOptimize(aggregates.rankWeapons(inventory.mStacks));
+        }
+    }
+}
+
+BENCHMARK(rescanInventory);
+BENCHMARK(updateInventoryIncrementally)->Arg(0)->Arg(1);
+
+BENCHMARK_MAIN();
@@ -26,6 +26,7 @@
 #include <boost/filesystem.hpp>
 #include <boost/program_options.hpp>
 
+#include <chrono>
 #include <cstddef>
 #include <stdexcept>
 #include <string>
@@ -84,6 +85,10 @@ namespace NavMeshTool
 
                 ("process-interior-cells", bpo::value<bool>()->implicit_value(true)
                     ->default_value(false), "build navmesh for interior cells")
+
+                ("incremental", bpo::value<bool>()->implicit_value(true)
+                    ->default_value(false), "process only cells changed since the previous run and generate only tiles "
+                    "touched by them, changes of the model files are not detected")
             ;
 
             return result;
@@ -158,6 +163,7 @@ namespace NavMeshTool
             }
 
             const bool processInteriorCells = variables["process-interior-cells"].as<bool>();
+            const bool incremental = variables["incremental"].as<bool>();
 
             Fallback::Map::init(variables["fallback"].as<Fallback::FallbackMap>().mMap);
 
@@ -191,8 +197,20 @@ namespace NavMeshTool
             DetourNavigator::Settings navigatorSettings = DetourNavigator::makeSettingsFromSettingsManager();
             navigatorSettings.mRecast.mSwimHeightScale = EsmLoader::getGameSetting(esmData.mGameSettings, "fSwimHeightScale").getFloat();
 
-            WorldspaceData cellsData = gatherWorldspaceData(navigatorSettings, readers, vfs, bulletShapeManager,
-                                                            esmData, processInteriorCells);
+            const auto readStart = std::chrono::steady_clock::now();
+
+            const std::vector<CellSource> cellsSources = getCellsSources(navigatorSettings, agentHalfExtents, readers,
+                                                                         vfs, esmData, processInteriorCells);
+            const std::vector<DetourNavigator::CellTiles> storedCellsTiles = db.getCellsTiles();
+
+            WorldspaceData cellsData = incremental
+                ? gatherChangedWorldspaceData(navigatorSettings, readers, vfs, bulletShapeManager, esmData,
+                                              cellsSources, storedCellsTiles)
+                : gatherWorldspaceData(navigatorSettings, readers, vfs, bulletShapeManager, esmData,
+                                       cellsSources, storedCellsTiles);
+
+            Log(Debug::Info) << "Read cells in "
+                << std::chrono::duration<double>(std::chrono::steady_clock::now() - readStart).count() << "s";
 
             generateAllNavMeshTiles(agentHalfExtents, navigatorSettings, threadsNumber, cellsData, std::move(db));
 
@@ -15,6 +15,7 @@
 #include <components/detournavigator/recastmeshprovider.hpp>
 #include <components/detournavigator/serialization.hpp>
 #include <components/detournavigator/tilecachedrecastmeshmanager.hpp>
+#include <components/detournavigator/tilegraph.hpp>
 #include <components/detournavigator/tileposition.hpp>
 #include <components/esm/loadcell.hpp>
 #include <components/misc/guarded.hpp>
@@ -40,6 +41,7 @@ namespace NavMeshTool
 {
     namespace
     {
+        using DetourNavigator::CellTiles;
         using DetourNavigator::GenerateNavMeshTile;
         using DetourNavigator::NavMeshDb;
         using DetourNavigator::NavMeshTileInfo;
@@ -49,6 +51,7 @@ namespace NavMeshTool
         using DetourNavigator::Settings;
         using DetourNavigator::ShapeId;
         using DetourNavigator::TileId;
+        using DetourNavigator::TilePortals;
         using DetourNavigator::TilePosition;
         using DetourNavigator::TileVersion;
         using Sqlite3::Transaction;
@@ -68,6 +71,35 @@ namespace NavMeshTool
             }
         };
 
+        using Duration = std::chrono::steady_clock::duration;
+
+        // Sum of the durations over all threads.
+        class PhaseTime
+        {
+        public:
+            void add(Duration value) { mValue += value.count(); }
+
+            double getSeconds() const
+            {
+                return std::chrono::duration_cast<std::chrono::duration<double>>(Duration(mValue.load())).count();
+            }
+
+        private:
+            std::atomic<Duration::rep> mValue {0};
+        };
+
+        class MeasureTime
+        {
+        public:
+            explicit MeasureTime(PhaseTime& phaseTime) : mPhaseTime(phaseTime) {}
+
+            ~MeasureTime() { mPhaseTime.add(std::chrono::steady_clock::now() - mStart); }
+
+        private:
+            PhaseTime& mPhaseTime;
+            const std::chrono::steady_clock::time_point mStart = std::chrono::steady_clock::now();
+        };
+
         class NavMeshTileConsumer final : public DetourNavigator::NavMeshTileConsumer
         {
         public:
@@ -86,6 +118,14 @@ namespace NavMeshTool
 
             std::size_t getUpdated() const { return mUpdated.load(); }
 
+            const PhaseTime& getSerializeTime() const { return mSerializeTime; }
+
+            const PhaseTime& getLookupTime() const { return mLookupTime; }
+
+            const PhaseTime& getGenerateTime() const { return mGenerateTime; }
+
+            const PhaseTime& getWriteTime() const { return mWriteTime; }
+
             std::int64_t resolveMeshSource(const MeshSource& source) override
             {
                 const std::lock_guard lock(mMutex);
@@ -95,6 +135,7 @@ namespace NavMeshTool
             std::optional<NavMeshTileInfo> find(const std::string& worldspace, const TilePosition &tilePosition,
                 const std::vector<std::byte> &input) override
             {
+                const MeasureTime measureTime(mLookupTime);
                 std::optional<NavMeshTileInfo> result;
                 std::lock_guard lock(mMutex);
                 if (const auto tile = mDb.findTile(worldspace, tilePosition, input))
@@ -110,29 +151,53 @@ namespace NavMeshTool
             void ignore() override { report(); }
 
             void insert(const std::string& worldspace, const TilePosition& tilePosition, std::int64_t version,
-                const std::vector<std::byte>& input, PreparedNavMeshData& data) override
+                const std::vector<std::byte>& input, PreparedNavMeshData& data, const TilePortals& portals) override
             {
-                data.mUserId = static_cast<unsigned>(mNextTileId);
+                const MeasureTime measureTime(mWriteTime);
+                const std::vector<std::byte> serializedPortals = serialize(portals);
                 {
                     std::lock_guard lock(mMutex);
+                    data.mUserId = static_cast<unsigned>(mNextTileId);
                     mDb.insertTile(mNextTileId, worldspace, tilePosition, TileVersion {version}, input, serialize(data));
+                    mDb.insertTilePortals(mNextTileId, serializedPortals);
                     ++mNextTileId.t;
                 }
                 ++mInserted;
                 report();
             }
 
-            void update(std::int64_t tileId, std::int64_t version, PreparedNavMeshData& data) override
+            void update(std::int64_t tileId, std::int64_t version, PreparedNavMeshData& data,
+                const TilePortals& portals) override
             {
+                const MeasureTime measureTime(mWriteTime);
                 data.mUserId = static_cast<unsigned>(tileId);
+                const std::vector<std::byte> serializedPortals = serialize(portals);
                 {
                     std::lock_guard lock(mMutex);
                     mDb.updateTile(TileId {tileId}, TileVersion {version}, serialize(data));
+                    mDb.insertTilePortals(TileId {tileId}, serializedPortals);
                 }
                 ++mUpdated;
                 report();
             }
 
+            void reportTimes(Duration serialize, Duration generate) override
+            {
+                mSerializeTime.add(serialize);
+                mGenerateTime.add(generate);
+            }
+
+            void writeCellsTiles(const std::vector<CellTiles>& cellsTiles,
+                const std::vector<std::pair<std::string, std::string>>& removedCells)
+            {
+                const MeasureTime measureTime(mWriteTime);
+                const std::lock_guard lock(mMutex);
+                for (const auto& [worldspace, cellId] : removedCells)
+                    mDb.deleteCellTiles(worldspace, cellId);
+                for (const CellTiles& cellTiles : cellsTiles)
+                    mDb.insertCellTiles(cellTiles);
+            }
+
             void wait()
             {
                 constexpr std::size_t tilesPerTransaction = 3000;
@@ -155,6 +220,10 @@ namespace NavMeshTool
             std::atomic_size_t mProvided {0};
             std::atomic_size_t mInserted {0};
             std::atomic_size_t mUpdated {0};
+            PhaseTime mSerializeTime;
+            PhaseTime mLookupTime;
+            PhaseTime mGenerateTime;
+            PhaseTime mWriteTime;
             std::mutex mMutex;
             NavMeshDb mDb;
             Transaction mTransaction;
@@ -183,30 +252,42 @@ namespace NavMeshTool
 
         for (const std::unique_ptr<WorldspaceNavMeshInput>& input : data.mNavMeshInputs)
         {
-            DetourNavigator::getTilesPositions(
-                Misc::Convert::toOsg(input->mAabb.m_min), Misc::Convert::toOsg(input->mAabb.m_max), settings.mRecast,
-                [&] (const TilePosition& tilePosition)
-                {
-                    workQueue.addWorkItem(new GenerateNavMeshTile(
-                        input->mWorldspace,
-                        tilePosition,
-                        RecastMeshProvider(input->mTileCachedRecastMeshManager),
-                        agentHalfExtents,
-                        settings,
-                        navMeshTileConsumer
-                    ));
-
-                    ++tiles;
-                });
+            const auto addTile = [&] (const TilePosition& tilePosition)
+            {
+                workQueue.addWorkItem(new GenerateNavMeshTile(
+                    input->mWorldspace,
+                    tilePosition,
+                    RecastMeshProvider(input->mTileCachedRecastMeshManager),
+                    agentHalfExtents,
+                    settings,
+                    navMeshTileConsumer
+                ));
+
+                ++tiles;
+            };
+
+            if (input->mTiles.has_value())
+                std::for_each(input->mTiles->begin(), input->mTiles->end(), addTile);
+            else
+                DetourNavigator::getTilesPositions(Misc::Convert::toOsg(input->mAabb.m_min),
+                    Misc::Convert::toOsg(input->mAabb.m_max), settings.mRecast, addTile);
 
             navMeshTileConsumer->mExpected = tiles;
         }
 
         navMeshTileConsumer->wait();
+        // Workers report times after providing the tile.
+        workQueue.stop();
+        navMeshTileConsumer->writeCellsTiles(data.mCellsTiles, data.mRemovedCells);
         navMeshTileConsumer->commit();
 
         Log(Debug::Info) << "Generated navmesh for " << navMeshTileConsumer->getProvided() << " tiles, "
             << navMeshTileConsumer->getInserted() << " are inserted and "
             << navMeshTileConsumer->getUpdated() << " updated";
+
+        Log(Debug::Info) << "Time spent by all workers: serialize: " << navMeshTileConsumer->getSerializeTime().getSeconds()
+            << "s, lookup: " << navMeshTileConsumer->getLookupTime().getSeconds()
+            << "s, generate: " << navMeshTileConsumer->getGenerateTime().getSeconds()
+            << "s, write: " << navMeshTileConsumer->getWriteTime().getSeconds() << "s";
     }
 }
@@ -23,17 +23,29 @@
 
 #include <LinearMath/btVector3.h>
 
+#include <extern/smhasher/MurmurHash3.h>
+
+#include <boost/filesystem/path.hpp>
+
 #include <osg/Vec2i>
 #include <osg/Vec3f>
 #include <osg/ref_ptr>
 
 #include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <map>
 #include <memory>
+#include <set>
 #include <stdexcept>
 #include <string>
 #include <string_view>
 #include <thread>
 #include <tuple>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -41,12 +53,14 @@ namespace NavMeshTool
 {
     namespace
     {
+        using DetourNavigator::CellTiles;
         using DetourNavigator::CollisionShape;
         using DetourNavigator::HeightfieldPlane;
         using DetourNavigator::HeightfieldShape;
         using DetourNavigator::HeightfieldSurface;
         using DetourNavigator::ObjectId;
         using DetourNavigator::ObjectTransform;
+        using DetourNavigator::TilePosition;
 
         struct CellRef
         {
@@ -101,6 +115,28 @@ namespace NavMeshTool
             return result;
         }
 
+        bool isNavMeshObject(ESM::RecNameInts type)
+        {
+            switch (type)
+            {
+                case ESM::REC_ACTI:
+                case ESM::REC_CONT:
+                case ESM::REC_DOOR:
+                case ESM::REC_STAT:
+                    return true;
+                default:
+                    return false;
+            }
+        }
+
+        std::string getObjectModel(const CellRef& cellRef, const EsmLoader::EsmData& esmData, const VFS::Manager& vfs)
+        {
+            std::string model(getModel(esmData, cellRef.mRefId, cellRef.mType));
+            if (!model.empty() && cellRef.mType != ESM::REC_STAT)
+                model = Misc::ResourceHelpers::correctActorModelPath(model, &vfs);
+            return model;
+        }
+
         template <class F>
         void forEachObject(const ESM::Cell& cell, const EsmLoader::EsmData& esmData, const VFS::Manager& vfs,
             Resource::BulletShapeManager& bulletShapeManager, std::vector<ESM::ESMReader>& readers,
@@ -112,12 +148,12 @@ namespace NavMeshTool
 
             for (CellRef& cellRef : cellRefs)
             {
-                std::string model(getModel(esmData, cellRef.mRefId, cellRef.mType));
-                if (model.empty())
+                if (!isNavMeshObject(cellRef.mType))
                     continue;
 
-                if (cellRef.mType != ESM::REC_STAT)
-                    model = Misc::ResourceHelpers::correctActorModelPath(model, &vfs);
+                const std::string model = getObjectModel(cellRef, esmData, vfs);
+                if (model.empty())
+                    continue;
 
                 osg::ref_ptr<const Resource::BulletShape> shape = [&]
                 {
@@ -137,17 +173,7 @@ namespace NavMeshTool
 
                 osg::ref_ptr<Resource::BulletShapeInstance> shapeInstance(new Resource::BulletShapeInstance(std::move(shape)));
 
-                switch (cellRef.mType)
-                {
-                    case ESM::REC_ACTI:
-                    case ESM::REC_CONT:
-                    case ESM::REC_DOOR:
-                    case ESM::REC_STAT:
-                        f(BulletObject(std::move(shapeInstance), cellRef.mPos, cellRef.mScale));
-                        break;
-                    default:
-                        break;
-                }
+                f(BulletObject(std::move(shapeInstance), cellRef.mPos, cellRef.mScale));
             }
         }
 
@@ -182,7 +208,7 @@ namespace NavMeshTool
                 static_cast<btScalar>(cellPosition.y() * ESM::Land::REAL_SIZE),
                 minHeight
             );
-            aabb.m_min = btVector3(
+            aabb.m_max = btVector3(
                 static_cast<btScalar>((cellPosition.x() + 1) * ESM::Land::REAL_SIZE),
                 static_cast<btScalar>((cellPosition.y() + 1) * ESM::Land::REAL_SIZE),
                 maxHeight
@@ -218,6 +244,214 @@ namespace NavMeshTool
             surface.mSize = static_cast<std::size_t>(ESM::Land::LAND_SIZE);
             return {surface, landData.mMinHeight, landData.mMaxHeight};
         }
+
+        class DigestBuilder
+        {
+        public:
+            template <class T>
+            void addValue(const T& value)
+            {
+                static_assert(std::is_trivially_copyable_v<T>);
+                addBytes(&value, sizeof(value));
+            }
+
+            void addString(std::string_view value)
+            {
+                addValue(value.size());
+                addBytes(value.data(), value.size());
+            }
+
+            void addBytes(const void* data, std::size_t size)
+            {
+                const std::byte* const begin = static_cast<const std::byte*>(data);
+                mData.insert(mData.end(), begin, begin + size);
+            }
+
+            std::vector<std::byte> finish() const
+            {
+                const std::array<std::uint64_t, 2> seed {0, 0};
+                std::array<std::uint64_t, 2> hash {0, 0};
+                MurmurHash3_x64_128(mData.data(), static_cast<int>(mData.size()), seed.data(), hash.data());
+                std::vector<std::byte> result(sizeof(hash));
+                std::memcpy(result.data(), hash.data(), sizeof(hash));
+                return result;
+            }
+
+        private:
+            std::vector<std::byte> mData;
+        };
+
+        struct TilesRange
+        {
+            TilePosition mMin;
+            TilePosition mMax;
+        };
+
+        bool isEmpty(const TilesRange& range)
+        {
+            return range.mMin.x() > range.mMax.x() || range.mMin.y() > range.mMax.y();
+        }
+
+        bool intersects(const TilesRange& lhs, const TilesRange& rhs)
+        {
+            return lhs.mMin.x() <= rhs.mMax.x() && rhs.mMin.x() <= lhs.mMax.x()
+                && lhs.mMin.y() <= rhs.mMax.y() && rhs.mMin.y() <= lhs.mMax.y();
+        }
+
+        TilesRange getTilesRange(const btAABB& aabb, const DetourNavigator::RecastSettings& settings)
+        {
+            TilesRange result {TilePosition(std::numeric_limits<int>::max(), std::numeric_limits<int>::max()),
+                               TilePosition(std::numeric_limits<int>::min(), std::numeric_limits<int>::min())};
+            DetourNavigator::getTilesPositions(Misc::Convert::toOsg(aabb.m_min), Misc::Convert::toOsg(aabb.m_max), settings,
+                [&] (const TilePosition& tilePosition)
+                {
+                    result.mMin.x() = std::min(result.mMin.x(), tilePosition.x());
+                    result.mMin.y() = std::min(result.mMin.y(), tilePosition.y());
+                    result.mMax.x() = std::max(result.mMax.x(), tilePosition.x());
+                    result.mMax.y() = std::max(result.mMax.y(), tilePosition.y());
+                });
+            return result;
+        }
+
+        std::string getCellId(const ESM::Cell& cell)
+        {
+            if (cell.isExterior())
+                return std::to_string(cell.mData.mX) + "," + std::to_string(cell.mData.mY);
+            return cell.mName;
+        }
+
+        std::string getContentFiles(const ESM::Cell& cell, const std::vector<ESM::ESMReader>& readers)
+        {
+            std::string result;
+            for (const ESM::ESM_Context& context : cell.mContextList)
+            {
+                if (!result.empty())
+                    result += '\n';
+                result += boost::filesystem::path(readers[static_cast<std::size_t>(context.index)].getName())
+                    .filename().string();
+            }
+            return result;
+        }
+
+        using CellKey = std::pair<std::string_view, std::string_view>;
+
+        std::map<CellKey, const CellTiles*> makeCellsTilesIndex(const std::vector<CellTiles>& cellsTiles)
+        {
+            std::map<CellKey, const CellTiles*> result;
+            for (const CellTiles& cellTiles : cellsTiles)
+                result.emplace(CellKey(cellTiles.mWorldspace, cellTiles.mCellId), &cellTiles);
+            return result;
+        }
+
+        std::vector<const CellTiles*> getRemovedCells(const std::vector<CellSource>& sources,
+            const std::vector<CellTiles>& storedCellsTiles)
+        {
+            std::set<CellKey> present;
+            for (const CellSource& source : sources)
+                present.emplace(source.mWorldspace, source.mCellId);
+            std::vector<const CellTiles*> result;
+            for (const CellTiles& cellTiles : storedCellsTiles)
+                if (present.find(CellKey(cellTiles.mWorldspace, cellTiles.mCellId)) == present.end())
+                    result.push_back(&cellTiles);
+            return result;
+        }
+
+        void addCells(const DetourNavigator::Settings& settings, std::vector<ESM::ESMReader>& readers,
+            const VFS::Manager& vfs, Resource::BulletShapeManager& bulletShapeManager, const EsmLoader::EsmData& esmData,
+            const std::vector<const CellSource*>& sources, WorldspaceData& data)
+        {
+            std::map<std::string_view, WorldspaceNavMeshInput*> navMeshInputs;
+            for (const std::unique_ptr<WorldspaceNavMeshInput>& input : data.mNavMeshInputs)
+                navMeshInputs.emplace(input->mWorldspace, input.get());
+
+            for (std::size_t i = 0; i < sources.size(); ++i)
+            {
+                const CellSource& source = *sources[i];
+                const ESM::Cell& cell = esmData.mCells[source.mCellIndex];
+                const bool exterior = cell.isExterior();
+
+                Log(Debug::Debug) << "Processing " << (exterior ? "exterior" : "interior")
+                    << " cell (" << (i + 1) << "/" << sources.size() << ") \"" << cell.getDescription() << "\"";
+
+                const osg::Vec2i cellPosition(cell.mData.mX, cell.mData.mY);
+                const std::size_t cellObjectsBegin = data.mObjects.size();
+                btAABB cellAabb;
+                bool cellAabbInitialized = false;
+
+                WorldspaceNavMeshInput& navMeshInput = [&] () -> WorldspaceNavMeshInput&
+                {
+                    auto it = navMeshInputs.find(source.mWorldspace);
+                    if (it == navMeshInputs.end())
+                    {
+                        auto& input = data.mNavMeshInputs.emplace_back(
+                            std::make_unique<WorldspaceNavMeshInput>(source.mWorldspace, settings.mRecast));
+                        input->mTileCachedRecastMeshManager.setWorldspace(source.mWorldspace);
+                        it = navMeshInputs.emplace(input->mWorldspace, input.get()).first;
+                    }
+                    return *it->second;
+                } ();
+
+                if (exterior)
+                {
+                    const auto it = std::lower_bound(esmData.mLands.begin(), esmData.mLands.end(), cellPosition, LessByXY {});
+                    const auto [heightfieldShape, minHeight, maxHeight] = makeHeightfieldShape(
+                        it == esmData.mLands.end() ? std::optional<ESM::Land>() : *it,
+                        cellPosition, data.mHeightfields, data.mLandData
+                    );
+
+                    const btAABB aabb = getAabb(cellPosition, minHeight, maxHeight);
+                    mergeOrAssign(aabb, navMeshInput.mAabb, navMeshInput.mAabbInitialized);
+                    mergeOrAssign(aabb, cellAabb, cellAabbInitialized);
+
+                    navMeshInput.mTileCachedRecastMeshManager.addHeightfield(cellPosition, ESM::Land::REAL_SIZE, heightfieldShape);
+
+                    navMeshInput.mTileCachedRecastMeshManager.addWater(cellPosition, ESM::Land::REAL_SIZE, -1);
+                }
+                else
+                {
+                    if ((cell.mData.mFlags & ESM::Cell::HasWater) != 0)
+                        navMeshInput.mTileCachedRecastMeshManager.addWater(cellPosition, std::numeric_limits<int>::max(), cell.mWater);
+                }
+
+                forEachObject(cell, esmData, vfs, bulletShapeManager, readers,
+                    [&] (BulletObject object)
+                    {
+                        const btTransform& transform = object.getCollisionObject().getWorldTransform();
+                        const btAABB aabb = BulletHelpers::getAabb(*object.getCollisionObject().getCollisionShape(), transform);
+                        mergeOrAssign(aabb, navMeshInput.mAabb, navMeshInput.mAabbInitialized);
+                        mergeOrAssign(aabb, cellAabb, cellAabbInitialized);
+                        if (const btCollisionShape* avoid = object.getShapeInstance()->mAvoidCollisionShape.get())
+                        {
+                            const btAABB avoidAabb = BulletHelpers::getAabb(*avoid, transform);
+                            navMeshInput.mAabb.merge(avoidAabb);
+                            cellAabb.merge(avoidAabb);
+                        }
+
+                        const ObjectId objectId(data.mObjects.size() + 1);
+                        const CollisionShape shape(object.getShapeInstance(), *object.getCollisionObject().getCollisionShape(), object.getObjectTransform());
+
+                        navMeshInput.mTileCachedRecastMeshManager.addObject(objectId, shape, transform, DetourNavigator::AreaType_ground);
+
+                        if (const btCollisionShape* avoid = object.getShapeInstance()->mAvoidCollisionShape.get())
+                        {
+                            const CollisionShape avoidShape(object.getShapeInstance(), *avoid, object.getObjectTransform());
+                            navMeshInput.mTileCachedRecastMeshManager.addObject(objectId, avoidShape, transform, DetourNavigator::AreaType_null);
+                        }
+
+                        data.mObjects.emplace_back(std::move(object));
+                    });
+
+                const TilesRange tilesRange = cellAabbInitialized
+                    ? getTilesRange(cellAabb, settings.mRecast)
+                    : TilesRange {TilePosition(0, 0), TilePosition(-1, -1)};
+                data.mCellsTiles.push_back(CellTiles {source.mWorldspace, source.mCellId, source.mContentFiles,
+                    source.mDigest, tilesRange.mMin, tilesRange.mMax});
+
+                Log(Debug::Info) << "Processed " << (exterior ? "exterior" : "interior")
+                    << " cell (" << (i + 1) << "/" << sources.size() << ") " << cell.getDescription()
+                    << " with " << (data.mObjects.size() - cellObjectsBegin) << " objects";
+            }
+        }
     }
 
     WorldspaceNavMeshInput::WorldspaceNavMeshInput(std::string worldspace, const DetourNavigator::RecastSettings& settings)
@@ -228,16 +462,13 @@ namespace NavMeshTool
         mAabb.m_max = btVector3(0, 0, 0);
     }
 
-    WorldspaceData gatherWorldspaceData(const DetourNavigator::Settings& settings, std::vector<ESM::ESMReader>& readers,
-        const VFS::Manager& vfs, Resource::BulletShapeManager& bulletShapeManager, const EsmLoader::EsmData& esmData,
+    std::vector<CellSource> getCellsSources(const DetourNavigator::Settings& settings, const osg::Vec3f& agentHalfExtents,
+        std::vector<ESM::ESMReader>& readers, const VFS::Manager& vfs, const EsmLoader::EsmData& esmData,
         bool processInteriorCells)
     {
-        Log(Debug::Info) << "Processing " << esmData.mCells.size() << " cells...";
+        Log(Debug::Info) << "Reading " << esmData.mCells.size() << " cells...";
 
-        std::map<std::string_view, std::unique_ptr<WorldspaceNavMeshInput>> navMeshInputs;
-        WorldspaceData data;
-
-        std::size_t objectsCounter = 0;
+        std::vector<CellSource> result;
 
         for (std::size_t i = 0; i < esmData.mCells.size(); ++i)
         {
@@ -251,78 +482,147 @@ namespace NavMeshTool
                 continue;
             }
 
-            Log(Debug::Debug) << "Processing " << (exterior ? "exterior" : "interior")
-                << " cell (" << (i + 1) << "/" << esmData.mCells.size() << ") \"" << cell.getDescription() << "\"";
-
-            const osg::Vec2i cellPosition(cell.mData.mX, cell.mData.mY);
-            const std::size_t cellObjectsBegin = data.mObjects.size();
+            DigestBuilder digest;
+            digest.addValue(settings.mRecast);
+            digest.addValue(settings.mNavMeshVersion);
+            digest.addValue(agentHalfExtents);
+            digest.addValue(cell.mData);
+            digest.addValue(cell.mWater);
 
-            WorldspaceNavMeshInput& navMeshInput = [&] () -> WorldspaceNavMeshInput&
+            if (exterior)
             {
-                auto it = navMeshInputs.find(cell.mCellId.mWorldspace);
-                if (it == navMeshInputs.end())
+                const osg::Vec2i cellPosition(cell.mData.mX, cell.mData.mY);
+                const auto it = std::lower_bound(esmData.mLands.begin(), esmData.mLands.end(), cellPosition, LessByXY {});
+                if (it != esmData.mLands.end() && GetXY {}(*it) == cellPosition
+                        && (it->mDataTypes & ESM::Land::DATA_VHGT) != 0)
                 {
-                    it = navMeshInputs.emplace(cell.mCellId.mWorldspace,
-                        std::make_unique<WorldspaceNavMeshInput>(cell.mCellId.mWorldspace, settings.mRecast)).first;
-                    it->second->mTileCachedRecastMeshManager.setWorldspace(cell.mCellId.mWorldspace);
+                    const auto landData = std::make_unique<ESM::Land::LandData>();
+                    it->loadData(ESM::Land::DATA_VHGT, landData.get());
+                    digest.addBytes(landData->mHeights, sizeof(landData->mHeights));
                 }
-                return *it->second;
-            } ();
+            }
 
-            if (exterior)
+            for (const CellRef& cellRef : loadCellRefs(cell, esmData, readers))
             {
-                const auto it = std::lower_bound(esmData.mLands.begin(), esmData.mLands.end(), cellPosition, LessByXY {});
-                const auto [heightfieldShape, minHeight, maxHeight] = makeHeightfieldShape(
-                    it == esmData.mLands.end() ? std::optional<ESM::Land>() : *it,
-                    cellPosition, data.mHeightfields, data.mLandData
-                );
+                if (!isNavMeshObject(cellRef.mType))
+                    continue;
+                const std::string model = getObjectModel(cellRef, esmData, vfs);
+                if (model.empty())
+                    continue;
+                digest.addString(model);
+                digest.addValue(cellRef.mScale);
+                digest.addValue(cellRef.mPos);
+            }
 
-                mergeOrAssign(getAabb(cellPosition, minHeight, maxHeight),
-                              navMeshInput.mAabb, navMeshInput.mAabbInitialized);
+            result.push_back(CellSource {i, cell.mCellId.mWorldspace, getCellId(cell),
+                getContentFiles(cell, readers), digest.finish()});
+        }
 
-                navMeshInput.mTileCachedRecastMeshManager.addHeightfield(cellPosition, ESM::Land::REAL_SIZE, heightfieldShape);
+        return result;
+    }
 
-                navMeshInput.mTileCachedRecastMeshManager.addWater(cellPosition, ESM::Land::REAL_SIZE, -1);
-            }
+    WorldspaceData gatherWorldspaceData(const DetourNavigator::Settings& settings, std::vector<ESM::ESMReader>& readers,
+        const VFS::Manager& vfs, Resource::BulletShapeManager& bulletShapeManager, const EsmLoader::EsmData& esmData,
+        const std::vector<CellSource>& sources, const std::vector<CellTiles>& storedCellsTiles)
+    {
+        Log(Debug::Info) << "Processing " << sources.size() << " cells...";
+
+        WorldspaceData data;
+
+        std::vector<const CellSource*> cells;
+        cells.reserve(sources.size());
+        for (const CellSource& source : sources)
+            cells.push_back(&source);
+
+        addCells(settings, readers, vfs, bulletShapeManager, esmData, cells, data);
+
+        for (const CellTiles* cellTiles : getRemovedCells(sources, storedCellsTiles))
+            data.mRemovedCells.emplace_back(cellTiles->mWorldspace, cellTiles->mCellId);
+
+        Log(Debug::Info) << "Processed " << sources.size() << " cells, added "
+            << data.mObjects.size() << " objects and " << data.mHeightfields.size() << " height fields";
+
+        return data;
+    }
+
+    WorldspaceData gatherChangedWorldspaceData(const DetourNavigator::Settings& settings,
+        std::vector<ESM::ESMReader>& readers, const VFS::Manager& vfs, Resource::BulletShapeManager& bulletShapeManager,
+        const EsmLoader::EsmData& esmData, const std::vector<CellSource>& sources,
+        const std::vector<CellTiles>& storedCellsTiles)
+    {
+        const std::map<CellKey, const CellTiles*> stored = makeCellsTilesIndex(storedCellsTiles);
+        const std::vector<const CellTiles*> removed = getRemovedCells(sources, storedCellsTiles);
+
+        std::vector<const CellSource*> changed;
+        std::vector<std::pair<const CellSource*, const CellTiles*>> unchanged;
+        for (const CellSource& source : sources)
+        {
+            const auto it = stored.find(CellKey(source.mWorldspace, source.mCellId));
+            if (it == stored.end() || it->second->mDigest != source.mDigest)
+                changed.push_back(&source);
             else
-            {
-                if ((cell.mData.mFlags & ESM::Cell::HasWater) != 0)
-                    navMeshInput.mTileCachedRecastMeshManager.addWater(cellPosition, std::numeric_limits<int>::max(), cell.mWater);
-            }
+                unchanged.emplace_back(&source, it->second);
+        }
 
-            forEachObject(cell, esmData, vfs, bulletShapeManager, readers,
-                [&] (BulletObject object)
-                {
-                    const btTransform& transform = object.getCollisionObject().getWorldTransform();
-                    const btAABB aabb = BulletHelpers::getAabb(*object.getCollisionObject().getCollisionShape(), transform);
-                    mergeOrAssign(aabb, navMeshInput.mAabb, navMeshInput.mAabbInitialized);
-                    if (const btCollisionShape* avoid = object.getShapeInstance()->mAvoidCollisionShape.get())
-                        navMeshInput.mAabb.merge(BulletHelpers::getAabb(*avoid, transform));
+        Log(Debug::Info) << changed.size() << "/" << sources.size() << " cells are new or changed and "
+            << removed.size() << " are removed";
 
-                    const ObjectId objectId(++objectsCounter);
-                    const CollisionShape shape(object.getShapeInstance(), *object.getCollisionObject().getCollisionShape(), object.getObjectTransform());
+        WorldspaceData data;
 
-                    navMeshInput.mTileCachedRecastMeshManager.addObject(objectId, shape, transform, DetourNavigator::AreaType_ground);
+        for (const CellTiles* cellTiles : removed)
+            data.mRemovedCells.emplace_back(cellTiles->mWorldspace, cellTiles->mCellId);
 
-                    if (const btCollisionShape* avoid = object.getShapeInstance()->mAvoidCollisionShape.get())
-                    {
-                        const CollisionShape avoidShape(object.getShapeInstance(), *avoid, object.getObjectTransform());
-                        navMeshInput.mTileCachedRecastMeshManager.addObject(objectId, avoidShape, transform, DetourNavigator::AreaType_null);
-                    }
+        if (changed.empty() && removed.empty())
+            return data;
 
-                    data.mObjects.emplace_back(std::move(object));
-                });
+        addCells(settings, readers, vfs, bulletShapeManager, esmData, changed, data);
 
-            Log(Debug::Info) << "Processed " << (exterior ? "exterior" : "interior")
-                << " cell (" << (i + 1) << "/" << esmData.mCells.size() << ") " << cell.getDescription()
-                << " with " << (data.mObjects.size() - cellObjectsBegin) << " objects";
+        // Tiles touched by the changed cells before and after the change and by the removed cells.
+        std::map<std::string, std::vector<TilesRange>, std::less<>> changedTiles;
+        const auto addChangedTiles = [&] (const CellTiles& cellTiles)
+        {
+            const TilesRange range {cellTiles.mMinTile, cellTiles.mMaxTile};
+            if (!isEmpty(range))
+                changedTiles[cellTiles.mWorldspace].push_back(range);
+        };
+        for (const CellTiles& cellTiles : data.mCellsTiles)
+            addChangedTiles(cellTiles);
+        for (const CellSource* source : changed)
+            if (const auto it = stored.find(CellKey(source->mWorldspace, source->mCellId)); it != stored.end())
+                addChangedTiles(*it->second);
+        for (const CellTiles* cellTiles : removed)
+            addChangedTiles(*cellTiles);
+
+        // Changed tiles have to be generated with all objects touching them including ones from unchanged cells.
+        std::vector<const CellSource*> affected;
+        for (const auto& [source, cellTiles] : unchanged)
+        {
+            const auto it = changedTiles.find(source->mWorldspace);
+            if (it == changedTiles.end())
+                continue;
+            const TilesRange range {cellTiles->mMinTile, cellTiles->mMaxTile};
+            if (std::any_of(it->second.begin(), it->second.end(), [&] (const TilesRange& v) { return intersects(v, range); }))
+                affected.push_back(source);
         }
 
-        data.mNavMeshInputs.reserve(navMeshInputs.size());
-        std::transform(navMeshInputs.begin(), navMeshInputs.end(), std::back_inserter(data.mNavMeshInputs),
-                       [] (auto& v) { return std::move(v.second); });
+        Log(Debug::Info) << affected.size() << " unchanged cells touch the same tiles";
+
+        addCells(settings, readers, vfs, bulletShapeManager, esmData, affected, data);
+
+        for (const std::unique_ptr<WorldspaceNavMeshInput>& input : data.mNavMeshInputs)
+        {
+            std::vector<TilePosition> tiles;
+            if (const auto it = changedTiles.find(input->mWorldspace); it != changedTiles.end())
+                for (const TilesRange& range : it->second)
+                    for (int x = range.mMin.x(); x <= range.mMax.x(); ++x)
+                        for (int y = range.mMin.y(); y <= range.mMax.y(); ++y)
+                            tiles.emplace_back(x, y);
+            std::sort(tiles.begin(), tiles.end());
+            tiles.erase(std::unique(tiles.begin(), tiles.end()), tiles.end());
+            input->mTiles = std::move(tiles);
+        }
 
-        Log(Debug::Info) << "Processed " << esmData.mCells.size() << " cells, added "
+        Log(Debug::Info) << "Processed " << (changed.size() + affected.size()) << " cells, added "
             << data.mObjects.size() << " objects and " << data.mHeightfields.size() << " height fields";
 
         return data;
@@ -2,7 +2,9 @@
 #define OPENMW_NAVMESHTOOL_WORLDSPACEDATA_H
 
 #include <components/bullethelpers/collisionobject.hpp>
+#include <components/detournavigator/navmeshdb.hpp>
 #include <components/detournavigator/tilecachedrecastmeshmanager.hpp>
+#include <components/detournavigator/tileposition.hpp>
 #include <components/esm/loadland.hpp>
 #include <components/misc/convert.hpp>
 #include <components/resource/bulletshape.hpp>
@@ -11,8 +13,13 @@
 #include <BulletCollision/Gimpact/btBoxCollision.h>
 #include <LinearMath/btVector3.h>
 
+#include <osg/Vec3f>
+
+#include <cstddef>
 #include <memory>
+#include <optional>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace ESM
@@ -51,6 +58,8 @@ namespace NavMeshTool
         TileCachedRecastMeshManager mTileCachedRecastMeshManager;
         btAABB mAabb;
         bool mAabbInitialized = false;
+        // When set only these tiles are generated instead of all tiles covered by mAabb.
+        std::optional<std::vector<DetourNavigator::TilePosition>> mTiles;
 
         explicit WorldspaceNavMeshInput(std::string worldspace, const DetourNavigator::RecastSettings& settings);
     };
@@ -87,11 +96,38 @@ namespace NavMeshTool
         std::vector<BulletObject> mObjects;
         std::vector<std::unique_ptr<ESM::Land::LandData>> mLandData;
         std::vector<std::vector<float>> mHeightfields;
+        // Tiles touched by the processed cells to store in the db.
+        std::vector<DetourNavigator::CellTiles> mCellsTiles;
+        // Worldspace and id of the cells stored in the db but absent in the content files.
+        std::vector<std::pair<std::string, std::string>> mRemovedCells;
+    };
+
+    struct CellSource
+    {
+        // Index in EsmData::mCells.
+        std::size_t mCellIndex;
+        std::string mWorldspace;
+        std::string mCellId;
+        std::string mContentFiles;
+        std::vector<std::byte> mDigest;
     };
 
+    // Reads cell references and land heights without loading the models to find changed cells. The digest does not
+    // cover content of the model files, a changed model requires a full run.
+    std::vector<CellSource> getCellsSources(const DetourNavigator::Settings& settings, const osg::Vec3f& agentHalfExtents,
+        std::vector<ESM::ESMReader>& readers, const VFS::Manager& vfs, const EsmLoader::EsmData& esmData,
+        bool processInteriorCells);
+
     WorldspaceData gatherWorldspaceData(const DetourNavigator::Settings& settings, std::vector<ESM::ESMReader>& readers,
         const VFS::Manager& vfs, Resource::BulletShapeManager& bulletShapeManager, const EsmLoader::EsmData& esmData,
-        bool processInteriorCells);
+        const std::vector<CellSource>& sources, const std::vector<DetourNavigator::CellTiles>& storedCellsTiles);
+
+    // Processes only new and changed cells and the cells touching the same tiles as the new, changed and removed
+    // cells. Only these tiles are generated.
+    WorldspaceData gatherChangedWorldspaceData(const DetourNavigator::Settings& settings,
+        std::vector<ESM::ESMReader>& readers, const VFS::Manager& vfs, Resource::BulletShapeManager& bulletShapeManager,
+        const EsmLoader::EsmData& esmData, const std::vector<CellSource>& sources,
+        const std::vector<DetourNavigator::CellTiles>& storedCellsTiles);
 }
 
 #endif
@@ -0,0 +1,101 @@
+#include "benchmark.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <numeric>
+#include <sstream>
+#include <stdexcept>
+
+#include <osg/Math>
+
+namespace OMW
+{
+    CameraPath CameraPath::read(std::istream& stream)
+    {
+        CameraPath result;
+        std::string line;
+        for (std::size_t lineNumber = 1; std::getline(stream, line); ++lineNumber)
+        {
+            const auto begin = line.find_first_not_of(" \t\r");
+            if (begin == std::string::npos || line[begin] == '#')
+                continue;
+            std::istringstream lineStream(line);
+            CameraPathPoint point;
+            osg::Vec3f rotation;
+            if (!(lineStream >> point.mTime >> point.mPosition.x() >> point.mPosition.y() >> point.mPosition.z()
+                    >> rotation.x() >> rotation.y() >> rotation.z()))
+                throw std::runtime_error("Invalid camera path point at line " + std::to_string(lineNumber));
+            for (int i = 0; i < 3; ++i)
+                point.mRotation[i] = osg::DegreesToRadians(rotation[i]);
+            result.mPoints.push_back(point);
+        }
+        std::stable_sort(result.mPoints.begin(), result.mPoints.end(),
+                         [] (const CameraPathPoint& l, const CameraPathPoint& r) { return l.mTime < r.mTime; });
+        return result;
+    }
+
+    CameraPathPoint CameraPath::get(double time) const
+    {
+        const auto next = std::upper_bound(mPoints.begin(), mPoints.end(), time,
+                                           [] (double value, const CameraPathPoint& point) { return value < point.mTime; });
+        if (next == mPoints.begin())
+            return mPoints.front();
+        if (next == mPoints.end())
+            return mPoints.back();
+        const CameraPathPoint& prev = *std::prev(next);
+        const float factor = static_cast<float>((time - prev.mTime) / (next->mTime - prev.mTime));
+        return CameraPathPoint {
+            time,
+            prev.mPosition + (next->mPosition - prev.mPosition) * factor,
+            prev.mRotation + (next->mRotation - prev.mRotation) * factor,
+        };
+    }
+
+    Percentiles getPercentiles(std::vector<double> values)
+    {
+        Percentiles result;
+        if (values.empty())
+            return result;
+        std::sort(values.begin(), values.end());
+        const auto getPercentile = [&] (double percent)
+        {
+            const auto rank = static_cast<std::size_t>(std::ceil(percent / 100 * values.size()));
+            return values[std::max<std::size_t>(rank, 1) - 1];
+        };
+        result.mCount = values.size();
+        result.mMean = std::accumulate(values.begin(), values.end(), 0.0) / values.size();
+        result.mP50 = getPercentile(50);
+        result.mP90 = getPercentile(90);
+        result.mP99 = getPercentile(99);
+        result.mMax = values.back();
+        return result;
+    }
+
+    void BenchmarkReport::add(std::string_view name, double milliseconds)
+    {
+        auto it = std::find_if(mTimes.begin(), mTimes.end(), [&] (const auto& v) { return v.first == name; });
+        if (it == mTimes.end())
+            it = mTimes.emplace(mTimes.end(), std::string(name), std::vector<double>());
+        it->second.push_back(milliseconds);
+    }
+
+    void BenchmarkReport::write(std::ostream& stream, std::size_t frames, float timeStep) const
+    {
+        stream << std::fixed << std::setprecision(3)
+               << "{\n  \"frames\": " << frames << ",\n  \"timestep\": " << timeStep << ",\n  \"subsystems\": {";
+        bool first = true;
+        for (const auto& [name, times] : mTimes)
+        {
+            const Percentiles percentiles = getPercentiles(times);
+            stream << (first ? "" : ",") << "\n    \"" << name << "\": {\"samples\": " << percentiles.mCount
+                   << ", \"mean\": " << percentiles.mMean
+                   << ", \"p50\": " << percentiles.mP50
+                   << ", \"p90\": " << percentiles.mP90
+                   << ", \"p99\": " << percentiles.mP99
+                   << ", \"max\": " << percentiles.mMax << "}";
+            first = false;
+        }
+        stream << "\n  }\n}\n";
+    }
+}
@@ -0,0 +1,80 @@
+#ifndef OPENMW_BENCHMARK_H
+#define OPENMW_BENCHMARK_H
+
+#include <osg/Vec3f>
+
+#include <cstddef>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace OMW
+{
+    /// Options of the benchmark mode. The engine runs exactly mFrames frames with a fixed time step, moves the player
+    /// along the camera path (if given) and quits writing a summary of the frame times.
+    struct BenchmarkSettings
+    {
+        std::size_t mFrames = 0;
+        float mTimeStep = 1.0f / 60.0f;
+        std::string mCameraPath;
+        std::string mReport;
+        bool mHiddenWindow = false;
+    };
+
+    struct CameraPathPoint
+    {
+        double mTime;
+        osg::Vec3f mPosition;
+        osg::Vec3f mRotation;  // in radians
+    };
+
+    /// @brief Player positions and rotations at given time since the benchmark start.
+    class CameraPath
+    {
+    public:
+        /// Reads a text file, every line holds a point: time in seconds, position (x, y, z) and rotation (x, y, z)
+        /// in degrees. Empty lines and lines starting with # are ignored. Points are sorted by time, keeping the
+        /// order of points with the same time.
+        /// Throws std::runtime_error on a malformed line.
+        static CameraPath read(std::istream& stream);
+
+        bool empty() const { return mPoints.empty(); }
+
+        /// Linearly interpolates between the neighbour points. Before the first and after the last point returns it.
+        CameraPathPoint get(double time) const;
+
+    private:
+        std::vector<CameraPathPoint> mPoints;
+    };
+
+    struct Percentiles
+    {
+        std::size_t mCount = 0;
+        double mMean = 0;
+        double mP50 = 0;
+        double mP90 = 0;
+        double mP99 = 0;
+        double mMax = 0;
+    };
+
+    /// Uses the nearest rank method.
+    Percentiles getPercentiles(std::vector<double> values);
+
+    /// @brief Collects frame times of engine subsystems and writes them as JSON.
+    class BenchmarkReport
+    {
+    public:
+        void add(std::string_view name, double milliseconds);
+
+        void write(std::ostream& stream, std::size_t frames, float timeStep) const;
+
+    private:
+        // Subsystems are written in the order they are first added.
+        std::vector<std::pair<std::string, std::vector<double>>> mTimes;
+    };
+}
+
+#endif
@@ -16,7 +16,9 @@
 
 #include <SDL.h>
 
+#include <components/debug/debugging.hpp>
 #include <components/debug/debuglog.hpp>
+#include <components/debug/frameprofiler.hpp>
 #include <components/debug/gldebug.hpp>
 
 #include <components/misc/rng.hpp>
@@ -83,12 +85,14 @@ namespace
     struct UserStats
     {
         const std::string mLabel;
+        const std::string mName;
         const std::string mBegin;
         const std::string mEnd;
         const std::string mTaken;
 
         UserStats(const std::string& label, const std::string& prefix)
             : mLabel(label),
+              mName(prefix),
               mBegin(prefix + "_time_begin"),
               mEnd(prefix + "_time_end"),
               mTaken(prefix + "_time_taken")
@@ -177,7 +181,8 @@ namespace
     {
         public:
             ScopedProfile(osg::Timer_t frameStart, unsigned int frameNumber, const osg::Timer& timer, osg::Stats& stats)
-                : mScopeStart(timer.tick()),
+                : mZone(UserStatsValue<sType>::sValue.mLabel.c_str()),
+                  mScopeStart(timer.tick()),
                   mFrameStart(frameStart),
                   mFrameNumber(frameNumber),
                   mTimer(timer),
@@ -201,6 +206,7 @@ namespace
             }
 
         private:
+            const Debug::ProfileZone mZone;
             const osg::Timer_t mScopeStart;
             const osg::Timer_t mFrameStart;
             const unsigned int mFrameNumber;
@@ -228,6 +234,31 @@ namespace
             profiler.removeUserStatsLine(" -Async");
     }
 
+    void addBenchmarkFrame(const osg::Stats& stats, unsigned int frameNumber, OMW::BenchmarkReport& report)
+    {
+        forEachUserStatsValue([&] (const UserStats& v)
+        {
+            double taken = 0;
+            if (stats.getAttribute(frameNumber, v.mTaken, taken))
+                report.add(v.mName, taken * 1000);
+        });
+    }
+
+    void writeBenchmarkReport(const OMW::BenchmarkSettings& settings, const OMW::BenchmarkReport& report)
+    {
+        if (settings.mReport.empty())
+        {
+            report.write(getRawStdout(), settings.mFrames, settings.mTimeStep);
+            return;
+        }
+        std::ofstream stream(settings.mReport);
+        report.write(stream, settings.mFrames, settings.mTimeStep);
+        if (stream.good())
+            Log(Debug::Info) << "Benchmark report is written to " << settings.mReport;
+        else
+            Log(Debug::Error) << "Failed to write benchmark report to " << settings.mReport;
+    }
+
     struct ScheduleNonDialogMessageBox
     {
         void operator()(std::string message) const
@@ -272,6 +303,7 @@ void OMW::Engine::executeLocalScripts()
 
 bool OMW::Engine::frame(float frametime)
 {
+    const Debug::ProfileZone zone("Frame");
     try
     {
         const osg::Timer_t frameStart = mViewer->getStartTick();
@@ -456,6 +488,8 @@ OMW::Engine::~Engine()
     delete mScriptContext;
     mScriptContext = nullptr;
 
+    if (mResourceSystem)
+        mResourceSystem->getSceneManager()->setWorkQueue(nullptr);
     mWorkQueue = nullptr;
 
     mViewer = nullptr;
@@ -550,7 +584,8 @@ void OMW::Engine::createWindow(Settings::Manager& settings)
     int height = settings.getInt("resolution y", "Video");
     bool fullscreen = settings.getBool("fullscreen", "Video");
     bool windowBorder = settings.getBool("window border", "Video");
-    bool vsync = settings.getBool("vsync", "Video");
+    // Frame times of a benchmark shouldn't depend on the display refresh rate.
+    bool vsync = settings.getBool("vsync", "Video") && mBenchmark.mFrames == 0;
     unsigned int antialiasing = std::max(0, settings.getInt("antialiasing", "Video"));
 
     int pos_x = SDL_WINDOWPOS_CENTERED_DISPLAY(screen),
@@ -562,7 +597,8 @@ void OMW::Engine::createWindow(Settings::Manager& settings)
         pos_y = SDL_WINDOWPOS_UNDEFINED_DISPLAY(screen);
     }
 
-    Uint32 flags = SDL_WINDOW_OPENGL|SDL_WINDOW_SHOWN|SDL_WINDOW_RESIZABLE;
+    Uint32 flags = SDL_WINDOW_OPENGL|SDL_WINDOW_RESIZABLE;
+    flags |= mBenchmark.mHiddenWindow ? SDL_WINDOW_HIDDEN : SDL_WINDOW_SHOWN;
     if(fullscreen)
         flags |= SDL_WINDOW_FULLSCREEN;
 
@@ -721,6 +757,7 @@ void OMW::Engine::prepareEngine (Settings::Manager & settings)
     if (numThreads <= 0)
         throw std::runtime_error("Invalid setting: 'preload num threads' must be >0");
     mWorkQueue = new SceneUtil::WorkQueue(numThreads);
+    mResourceSystem->getSceneManager()->setWorkQueue(mWorkQueue);
 
     mScreenCaptureOperation = new SceneUtil::AsyncScreenCaptureOperation(
         mWorkQueue,
@@ -737,7 +774,7 @@ void OMW::Engine::prepareEngine (Settings::Manager & settings)
 
     mViewer->addEventHandler(mScreenCaptureHandler);
 
-    mLuaManager = new MWLua::LuaManager(mVFS.get());
+    mLuaManager = new MWLua::LuaManager(mVFS.get(), (mCfgMgr.getUserDataPath() / "luaprofile.json").string());
     mEnvironment.setLuaManager(mLuaManager);
 
     // Create input and UI first to set up a bootstrapping environment for
@@ -940,6 +977,7 @@ private:
 
     void threadBody()
     {
+        Debug::FrameProfiler::setThreadName("Lua");
         while (true)
         {
             std::unique_lock<std::mutex> lk(mMutex);
@@ -998,6 +1036,11 @@ void OMW::Engine::go()
 
     prepareEngine (settings);
 
+    Debug::FrameProfiler::setThreadName("Main");
+    Debug::FrameProfiler::setTraceFile((mCfgMgr.getUserDataPath() / "frameprofile.json").string());
+    if (Settings::Manager::getBool("frame profiler", "General"))
+        Debug::FrameProfiler::start();
+
     std::ofstream stats;
     if (const auto path = std::getenv("OPENMW_OSG_STATS_FILE"))
     {
@@ -1047,17 +1090,44 @@ void OMW::Engine::go()
 
     LuaWorker luaWorker(this);  // starts a separate lua thread if "lua num threads" > 0
 
+    const bool benchmark = mBenchmark.mFrames > 0;
+    CameraPath cameraPath;
+    BenchmarkReport benchmarkReport;
+    std::size_t benchmarkFrame = 0;
+    if (benchmark)
+    {
+        if (mSaveGameFile.empty() && !mSkipMenu)
+            Log(Debug::Warning) << "Benchmark is started without a savegame or --skip-menu, it will measure the main menu";
+        if (!mBenchmark.mCameraPath.empty())
+        {
+            boost::filesystem::ifstream stream(mBenchmark.mCameraPath);
+            if (!stream.is_open())
+                throw std::runtime_error("Failed to open camera path file " + mBenchmark.mCameraPath);
+            cameraPath = CameraPath::read(stream);
+        }
+        mViewer->getViewerStats()->collectStats("engine", true);
+        Log(Debug::Info) << "Running benchmark for " << mBenchmark.mFrames << " frames";
+    }
+
     // Start the main rendering loop
     double simulationTime = 0.0;
-    Misc::FrameRateLimiter frameRateLimiter = Misc::makeFrameRateLimiter(mEnvironment.getFrameRateLimit());
+    Misc::FrameRateLimiter frameRateLimiter = Misc::makeFrameRateLimiter(benchmark ? 0 : mEnvironment.getFrameRateLimit());
     const std::chrono::steady_clock::duration maxSimulationInterval(std::chrono::milliseconds(200));
     while (!mViewer->done() && !mEnvironment.getStateManager()->hasQuitRequest())
     {
-        const double dt = std::chrono::duration_cast<std::chrono::duration<double>>(std::min(
+        const double dt = benchmark ? mBenchmark.mTimeStep : std::chrono::duration_cast<std::chrono::duration<double>>(std::min(
             frameRateLimiter.getLastFrameDuration(),
             maxSimulationInterval
         )).count();
 
+        if (!cameraPath.empty() && mEnvironment.getStateManager()->getState() == MWState::StateManager::State_Running)
+        {
+            const CameraPathPoint point = cameraPath.get(benchmarkFrame * static_cast<double>(mBenchmark.mTimeStep));
+            MWBase::World* const world = mEnvironment.getWorld();
+            const MWWorld::Ptr player = world->moveObject(world->getPlayerPtr(), point.mPosition);
+            world->rotateObject(player, point.mRotation);
+        }
+
         mViewer->advance(simulationTime);
 
         if (!frame(dt))
@@ -1097,10 +1167,27 @@ void OMW::Engine::go()
         }
 
         frameRateLimiter.limit();
+
+        if (benchmark)
+        {
+            // Stats of the physics worker for a frame are set during the next one.
+            const auto frameNumber = mViewer->getFrameStamp()->getFrameNumber();
+            if (benchmarkFrame > 0)
+                addBenchmarkFrame(*mViewer->getViewerStats(), frameNumber - 1, benchmarkReport);
+            benchmarkReport.add("frame", std::chrono::duration<double, std::milli>(frameRateLimiter.getLastFrameDuration()).count());
+            if (++benchmarkFrame >= mBenchmark.mFrames)
+                break;
+        }
     }
 
+    if (benchmark)
+        writeBenchmarkReport(mBenchmark, benchmarkReport);
+
     luaWorker.join();
 
+    if (Debug::FrameProfiler::isRunning())
+        Log(Debug::Info) << Debug::FrameProfiler::toggle();
+
     // Save user settings
     settings.saveUser(settingspath);
 
@@ -1171,3 +1258,8 @@ void OMW::Engine::setRandomSeed(unsigned int seed)
 {
     mRandomSeed = seed;
 }
+
+void OMW::Engine::setBenchmark(const BenchmarkSettings& benchmark)
+{
+    mBenchmark = benchmark;
+}
@@ -13,6 +13,8 @@
 
 #include "mwworld/ptr.hpp"
 
+#include "benchmark.hpp"
+
 namespace Resource
 {
     class ResourceSystem;
@@ -99,6 +101,7 @@ namespace OMW
             std::vector<std::string> mScriptBlacklist;
             bool mScriptBlacklistUse;
             bool mNewGame;
+            BenchmarkSettings mBenchmark;
 
             // not implemented
             Engine (const Engine&);
@@ -191,6 +194,9 @@ namespace OMW
 
             void setRandomSeed(unsigned int seed);
 
+            /// Run a benchmark instead of an interactive game if the number of frames is not 0.
+            void setBenchmark(const BenchmarkSettings& benchmark);
+
         private:
             Files::ConfigurationManager& mCfgMgr;
             class LuaWorker;
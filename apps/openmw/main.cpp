@@ -152,6 +152,20 @@ bool parseOptions (int argc, char** argv, OMW::Engine& engine, Files::Configurat
     engine.enableFontExport(variables["export-fonts"].as<bool>());
     engine.setRandomSeed(variables["random-seed"].as<unsigned int>());
 
+    OMW::BenchmarkSettings benchmark;
+    benchmark.mFrames = variables["benchmark-frames"].as<unsigned int>();
+    const float benchmarkFps = variables["benchmark-fps"].as<float>();
+    if (benchmarkFps <= 0)
+    {
+        Log(Debug::Error) << "Benchmark fps should be positive, got " << benchmarkFps << ". Aborting...";
+        return false;
+    }
+    benchmark.mTimeStep = 1.0f / benchmarkFps;
+    benchmark.mCameraPath = variables["benchmark-path"].as<Files::MaybeQuotedPath>().string();
+    benchmark.mReport = variables["benchmark-report"].as<Files::MaybeQuotedPath>().string();
+    benchmark.mHiddenWindow = variables["benchmark-hidden-window"].as<bool>();
+    engine.setBenchmark(benchmark);
+
     return true;
 }
 
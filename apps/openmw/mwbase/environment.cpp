@@ -215,4 +215,5 @@ void MWBase::Environment::reportStats(unsigned int frameNumber, osg::Stats& stat
 {
     mMechanicsManager->reportStats(frameNumber, stats);
     mWorld->reportStats(frameNumber, stats);
+    mLuaManager->reportStats(frameNumber, stats);
 }
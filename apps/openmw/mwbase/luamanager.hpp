@@ -1,6 +1,7 @@
 #ifndef GAME_MWBASE_LUAMANAGER_H
 #define GAME_MWBASE_LUAMANAGER_H
 
+#include <string>
 #include <variant>
 #include <SDL_events.h>
 
@@ -14,6 +15,11 @@ namespace Loading
     class Listener;
 }
 
+namespace osg
+{
+    class Stats;
+}
+
 namespace ESM
 {
     class ESMReader;
@@ -78,6 +84,17 @@ namespace MWBase
 
         // Drops script cache and reloads all scripts. Calls `onSave` and `onLoad` for every script.
         virtual void reloadAllScripts() = 0;
+
+        virtual void reportStats(unsigned int frameNumber, osg::Stats& stats) const = 0;
+
+        // Human readable memory usage of Lua scripts; shown by the console command "luamemory".
+        virtual std::string getMemoryUsageDescription() const = 0;
+
+        // Starts the profiler if it is stopped. Otherwise stops it and saves the collected trace.
+        // Returns a message for the console.
+        virtual std::string toggleProfiler() = 0;
+
+        virtual std::string getProfilerReport() const = 0;
     };
 
 }
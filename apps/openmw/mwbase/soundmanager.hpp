@@ -4,6 +4,7 @@
 #include <memory>
 #include <string>
 #include <set>
+#include <vector>
 
 #include "../mwworld/ptr.hpp"
 #include "../mwsound/type.hpp"
@@ -148,6 +149,9 @@ namespace MWBase
             virtual void stopSound(Sound *sound) = 0;
             ///< Stop the given sound from playing
 
+            virtual void prefetchSounds(const std::vector<std::string>& soundIds) = 0;
+            ///< Start decoding the given sounds in the background, so they don't stall the first playback
+
             virtual void stopSound3D(const MWWorld::ConstPtr &reference, const std::string& soundId) = 0;
             ///< Stop the given object from playing the given sound,
 
@@ -35,6 +35,7 @@ namespace ESM
 {
     class ESMReader;
     class ESMWriter;
+    struct BaseSaveState;
     struct Position;
     struct Cell;
     struct Class;
@@ -118,12 +119,28 @@ namespace MWBase
 
             virtual int countSavedGameRecords() const = 0;
             virtual int countSavedGameCells() const = 0;
+            virtual int countBaseSaveCells() const = 0;
+
+            virtual int countChangedCells() const = 0;
+            ///< Number of cells whose state might have changed since the base saved game was written or read.
+
+            virtual void setBaseSave (const ESM::BaseSaveState& baseSave) = 0;
+            ///< If the name is not empty, write() only includes the state of changed cells and references the base
+            /// saved game for the others.
 
             virtual void write (ESM::ESMWriter& writer, Loading::Listener& listener) const = 0;
 
+            virtual void writeBaseSave (ESM::ESMWriter& writer, Loading::Listener& listener) = 0;
+            ///< Write the state of all cells to a base saved game.
+
             virtual void readRecord (ESM::ESMReader& reader, uint32_t type,
                 const std::map<int, int>& contentFileMap) = 0;
 
+            virtual void readBaseSave (ESM::ESMReader& reader, const ESM::BaseSaveState& baseSave,
+                const std::map<int, int>& contentFileMap) = 0;
+            ///< Read the state of cells that have not changed since the base saved game was written.
+            /// \param baseSave REC_BASE record of the saved game referencing the base saved game.
+
             virtual MWWorld::CellStore *getExterior (int x, int y) = 0;
 
             virtual MWWorld::CellStore *getInterior (const std::string& name) = 0;
@@ -477,6 +494,10 @@ namespace MWBase
             virtual bool getLOS(const MWWorld::ConstPtr& actor,const MWWorld::ConstPtr& targetActor) = 0;
             ///< get Line of Sight (morrowind stupid implementation)
 
+            virtual void getLOS(const MWWorld::ConstPtr& actor, const std::vector<MWWorld::Ptr>& targetActors,
+                std::vector<bool>& result) = 0;
+            ///< get Line of Sight for every target actor at once
+
             virtual float getDistToNearestRayHit(const osg::Vec3f& from, const osg::Vec3f& dir, float maxDist, bool includeWater = false) = 0;
 
             virtual void enableActorCollision(const MWWorld::Ptr& actor, bool enable) = 0;
@@ -655,7 +676,7 @@ namespace MWBase
             virtual bool isAreaOccupiedByOtherActor(const osg::Vec3f& position, const float radius,
                 const MWWorld::ConstPtr& ignore, std::vector<MWWorld::Ptr>* occupyingActors = nullptr) const = 0;
 
-            virtual void reportStats(unsigned int frameNumber, osg::Stats& stats) const = 0;
+            virtual void reportStats(unsigned int frameNumber, osg::Stats& stats) = 0;
 
             virtual std::vector<MWWorld::Ptr> getAll(const std::string& id) = 0;
     };
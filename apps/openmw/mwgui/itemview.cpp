@@ -1,6 +1,7 @@
 #include "itemview.hpp"
 
 #include <cmath>
+#include <stdexcept>
 
 #include <MyGUI_FactoryManager.h>
 #include <MyGUI_Gui.h>
@@ -15,9 +16,22 @@
 namespace MWGui
 {
 
+namespace
+{
+    // Hidden widgets kept for items added later. Widgets beyond that are destroyed, so the pool doesn't keep the size
+    // of the largest model ever shown.
+    constexpr std::size_t maxSpareItemWidgets = 64;
+
+    bool isShown(const ItemStack& shown, const ItemStack& item)
+    {
+        return shown.mBase == item.mBase && shown.mType == item.mType && shown.mCount == item.mCount;
+    }
+}
+
 ItemView::ItemView()
     : mModel(nullptr)
     , mScrollView(nullptr)
+    , mDragArea(nullptr)
 {
 }
 
@@ -46,33 +60,37 @@ void ItemView::initialiseOverride()
         throw std::runtime_error("Item view needs a scroll view");
 
     mScrollView->setCanvasAlign(MyGUI::Align::Left | MyGUI::Align::Top);
+
+    mDragArea = mScrollView->createWidget<MyGUI::Widget>("",0,0,mScrollView->getWidth(),mScrollView->getHeight(),
+                                                         MyGUI::Align::Stretch);
+    mDragArea->setNeedMouseFocus(true);
+    mDragArea->eventMouseButtonClick += MyGUI::newDelegate(this, &ItemView::onSelectedBackground);
+    mDragArea->eventMouseWheel += MyGUI::newDelegate(this, &ItemView::onMouseWheelMoved);
 }
 
 void ItemView::layoutWidgets()
 {
-    if (!mScrollView->getChildCount())
+    if (!mDragArea)
         return;
 
     int x = 0;
     int y = 0;
-    MyGUI::Widget* dragArea = mScrollView->getChildAt(0);
     int maxHeight = mScrollView->getHeight();
+    const std::size_t count = mItems.size();
 
     int rows = maxHeight/42;
     rows = std::max(rows, 1);
-    bool showScrollbar = int(std::ceil(dragArea->getChildCount()/float(rows))) > mScrollView->getWidth()/42;
+    bool showScrollbar = int(std::ceil(count/float(rows))) > mScrollView->getWidth()/42;
     if (showScrollbar)
         maxHeight -= 18;
 
-    for (unsigned int i=0; i<dragArea->getChildCount(); ++i)
+    for (std::size_t i=0; i<count; ++i)
     {
-        MyGUI::Widget* w = dragArea->getChildAt(i);
-
-        w->setPosition(x, y);
+        mItemWidgets[i]->setPosition(x, y);
 
         y += 42;
 
-        if (y > maxHeight-42 && i < dragArea->getChildCount()-1)
+        if (y > maxHeight-42 && i < count-1)
         {
             x += 42;
             y = 0;
@@ -88,48 +106,71 @@ void ItemView::layoutWidgets()
     mScrollView->setCanvasSize(size);
     mScrollView->setVisibleVScroll(true);
     mScrollView->setVisibleHScroll(true);
-    dragArea->setSize(size);
+    mDragArea->setSize(size);
 }
 
 void ItemView::update()
 {
-    while (mScrollView->getChildCount())
-        MyGUI::Gui::getInstance().destroyWidget(mScrollView->getChildAt(0));
-
-    if (!mModel)
-        return;
-
-    mModel->update();
-
-    MyGUI::Widget* dragArea = mScrollView->createWidget<MyGUI::Widget>("",0,0,mScrollView->getWidth(),mScrollView->getHeight(),
-                                                                       MyGUI::Align::Stretch);
-    dragArea->setNeedMouseFocus(true);
-    dragArea->eventMouseButtonClick += MyGUI::newDelegate(this, &ItemView::onSelectedBackground);
-    dragArea->eventMouseWheel += MyGUI::newDelegate(this, &ItemView::onMouseWheelMoved);
-
-    for (ItemModel::ModelIndex i=0; i<static_cast<int>(mModel->getItemCount()); ++i)
+    std::size_t count = 0;
+    if (mModel)
     {
-        const ItemStack& item = mModel->getItem(i);
+        mModel->update();
+        count = mModel->getItemCount();
+    }
 
-        ItemWidget* itemWidget = dragArea->createWidget<ItemWidget>("MW_ItemIcon",
+    while (mItemWidgets.size() < count)
+    {
+        ItemWidget* itemWidget = mDragArea->createWidget<ItemWidget>("MW_ItemIcon",
             MyGUI::IntCoord(0, 0, 42, 42), MyGUI::Align::Default);
         itemWidget->setUserString("ToolTipType", "ItemModelIndex");
-        itemWidget->setUserData(std::make_pair(i, mModel));
-        ItemWidget::ItemState state = ItemWidget::None;
-        if (item.mType == ItemStack::Type_Barter)
-            state = ItemWidget::Barter;
-        if (item.mType == ItemStack::Type_Equipped)
-            state = ItemWidget::Equip;
-        itemWidget->setItem(item.mBase, state);
-        itemWidget->setCount(item.mCount);
-
         itemWidget->eventMouseButtonClick += MyGUI::newDelegate(this, &ItemView::onSelectedItem);
         itemWidget->eventMouseWheel += MyGUI::newDelegate(this, &ItemView::onMouseWheelMoved);
+        mItemWidgets.push_back(itemWidget);
+    }
+
+    for (std::size_t i = count; i < mItems.size(); ++i)
+    {
+        mItemWidgets[i]->setVisible(false);
+        mItemWidgets[i]->setItem(MWWorld::Ptr());
+    }
+
+    while (mItemWidgets.size() > count + maxSpareItemWidgets)
+    {
+        MyGUI::Gui::getInstance().destroyWidget(mItemWidgets.back());
+        mItemWidgets.pop_back();
+    }
+
+    mItems.resize(count);
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const ItemModel::ModelIndex index = static_cast<ItemModel::ModelIndex>(i);
+        // Indices and the model may change even if the widget shows the same item
+        mItemWidgets[i]->setUserData(std::make_pair(index, mModel));
+        setItem(i, mModel->getItem(index));
     }
 
     layoutWidgets();
 }
 
+void ItemView::setItem(std::size_t index, const ItemStack& item)
+{
+    ItemWidget* itemWidget = mItemWidgets[index];
+    ItemStack& shown = mItems[index];
+    if (itemWidget->getVisible() && isShown(shown, item))
+        return;
+
+    ItemWidget::ItemState state = ItemWidget::None;
+    if (item.mType == ItemStack::Type_Barter)
+        state = ItemWidget::Barter;
+    if (item.mType == ItemStack::Type_Equipped)
+        state = ItemWidget::Equip;
+    itemWidget->setItem(item.mBase, state);
+    itemWidget->setCount(item.mCount);
+    itemWidget->setVisible(true);
+    shown = item;
+}
+
 void ItemView::resetScrollBars()
 {
     mScrollView->setViewOffset(MyGUI::IntPoint(0, 0));
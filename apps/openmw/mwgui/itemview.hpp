@@ -1,12 +1,15 @@
 #ifndef MWGUI_ITEMVIEW_H
 #define MWGUI_ITEMVIEW_H
 
+#include <vector>
+
 #include <MyGUI_Widget.h>
 
 #include "itemmodel.hpp"
 
 namespace MWGui
 {
+    class ItemWidget;
 
     class ItemView final : public MyGUI::Widget
     {
@@ -28,6 +31,7 @@ namespace MWGui
         /// Fired when the background was clicked (useful for drag and drop)
         EventHandle_Void eventBackgroundClicked;
 
+        /// Updates the model. Item widgets are reused, only those showing a different item stack are changed.
         void update();
 
         void resetScrollBars();
@@ -44,8 +48,17 @@ namespace MWGui
         void onSelectedBackground (MyGUI::Widget* sender);
         void onMouseWheelMoved(MyGUI::Widget* _sender, int _rel);
 
+        void setItem(std::size_t index, const ItemStack& item);
+
         ItemModel* mModel;
         MyGUI::ScrollView* mScrollView;
+        MyGUI::Widget* mDragArea;
+
+        // Widgets are kept when the model shrinks or changes and hidden if not used, up to a limited number of
+        // unused ones.
+        std::vector<ItemWidget*> mItemWidgets;
+        // Item stacks shown by the visible widgets.
+        std::vector<ItemStack> mItems;
 
     };
 
@@ -1,5 +1,9 @@
 #include "sortfilteritemmodel.hpp"
 
+#include <algorithm>
+#include <array>
+#include <cassert>
+
 #include <components/misc/stringops.hpp>
 #include <components/misc/utf8stream.hpp>
 #include <components/debug/debuglog.hpp>
@@ -28,121 +32,117 @@
 
 namespace
 {
-    bool compareType(unsigned int type1, unsigned int type2)
+    unsigned getTypeOrder(unsigned int type)
     {
-        // this defines the sorting order of types. types that are first in the vector appear before other types.
-        std::vector<unsigned int> mapping;
-        mapping.emplace_back(ESM::Weapon::sRecordId );
-        mapping.emplace_back(ESM::Armor::sRecordId );
-        mapping.emplace_back(ESM::Clothing::sRecordId );
-        mapping.emplace_back(ESM::Potion::sRecordId );
-        mapping.emplace_back(ESM::Ingredient::sRecordId );
-        mapping.emplace_back(ESM::Apparatus::sRecordId );
-        mapping.emplace_back(ESM::Book::sRecordId );
-        mapping.emplace_back(ESM::Light::sRecordId );
-        mapping.emplace_back(ESM::Miscellaneous::sRecordId );
-        mapping.emplace_back(ESM::Lockpick::sRecordId );
-        mapping.emplace_back(ESM::Repair::sRecordId );
-        mapping.emplace_back(ESM::Probe::sRecordId );
-
-        assert( std::find(mapping.begin(), mapping.end(), type1) != mapping.end() );
-        assert( std::find(mapping.begin(), mapping.end(), type2) != mapping.end() );
-
-        return std::find(mapping.begin(), mapping.end(), type1) < std::find(mapping.begin(), mapping.end(), type2);
+        // this defines the sorting order of types. types that are first in the array appear before other types.
+        static const std::array<unsigned int, 12> mapping {
+            ESM::Weapon::sRecordId,
+            ESM::Armor::sRecordId,
+            ESM::Clothing::sRecordId,
+            ESM::Potion::sRecordId,
+            ESM::Ingredient::sRecordId,
+            ESM::Apparatus::sRecordId,
+            ESM::Book::sRecordId,
+            ESM::Light::sRecordId,
+            ESM::Miscellaneous::sRecordId,
+            ESM::Lockpick::sRecordId,
+            ESM::Repair::sRecordId,
+            ESM::Probe::sRecordId,
+        };
+
+        const auto it = std::find(mapping.begin(), mapping.end(), type);
+        assert(it != mapping.end());
+        return static_cast<unsigned>(it - mapping.begin());
+    }
+
+    /// Everything the items are sorted by. Computed once per item instead of on each comparison.
+    struct SortKey
+    {
+        MWGui::ItemStack::Type mType;
+        unsigned mTypeOrder;
+        std::string mName;
+        int mChargePercent;
+        bool mHasItemHealth;
+        int mItemHealth;
+        float mRemainingUsageTime;
+        int mValue;
+        float mWeight;
+        std::string mRefId;
+    };
+
+    int getChargePercent(const MWWorld::Ptr& item)
+    {
+        // 1. enchanted items showed before non-enchanted
+        // 2. item with lesser charge percent comes after items with more charge percent
+        // 3. item with constant effect comes before items with non-constant effects
+        const std::string& enchantmentId = item.getClass().getEnchantment(item);
+        if (enchantmentId.empty())
+            return -1;
+        const ESM::Enchantment* ench = MWBase::Environment::get().getWorld()->getStore().get<ESM::Enchantment>().search(enchantmentId);
+        if (!ench)
+            return -1;
+        if (ench->mData.mType == ESM::Enchantment::ConstantEffect)
+            return 101;
+        return static_cast<int>(item.getCellRef().getNormalizedEnchantmentCharge(ench->mData.mCharge) * 100);
+    }
+
+    SortKey makeSortKey(const MWGui::ItemStack& item, std::string&& name)
+    {
+        const MWWorld::Ptr& base = item.mBase;
+        const MWWorld::Class& cls = base.getClass();
+        SortKey result;
+        result.mType = item.mType;
+        result.mTypeOrder = getTypeOrder(base.getType());
+        result.mName = std::move(name);
+        result.mChargePercent = getChargePercent(base);
+        result.mHasItemHealth = cls.hasItemHealth(base);
+        result.mItemHealth = result.mHasItemHealth ? cls.getItemHealth(base) : 0;
+        result.mRemainingUsageTime = cls.getRemainingUsageTime(base);
+        result.mValue = cls.getValue(base);
+        result.mWeight = cls.getWeight(base);
+        result.mRefId = base.getCellRef().getRefId();
+        return result;
     }
 
     struct Compare
     {
         bool mSortByType;
         Compare() : mSortByType(true) {}
-        bool operator() (const MWGui::ItemStack& left, const MWGui::ItemStack& right)
+        bool operator() (const SortKey& left, const SortKey& right) const
         {
             if (mSortByType && left.mType != right.mType)
                 return left.mType < right.mType;
 
-            float result = 0;
-
             // compare items by type
-            auto leftType = left.mBase.getType();
-            auto rightType = right.mBase.getType();
-
-            if (leftType != rightType)
-                return compareType(leftType, rightType);
+            if (left.mTypeOrder != right.mTypeOrder)
+                return left.mTypeOrder < right.mTypeOrder;
 
             // compare items by name
-            std::string leftName = Utf8Stream::lowerCaseUtf8(left.mBase.getClass().getName(left.mBase));
-            std::string rightName = Utf8Stream::lowerCaseUtf8(right.mBase.getClass().getName(right.mBase));
-
-            result = leftName.compare(rightName);
-            if (result != 0)
-                return result < 0;
-
-            // compare items by enchantment:
-            // 1. enchanted items showed before non-enchanted
-            // 2. item with lesser charge percent comes after items with more charge percent
-            // 3. item with constant effect comes before items with non-constant effects
-            int leftChargePercent = -1;
-            int rightChargePercent = -1;
-            leftName = left.mBase.getClass().getEnchantment(left.mBase);
-            rightName = right.mBase.getClass().getEnchantment(right.mBase);
-
-            if (!leftName.empty())
-            {
-                const ESM::Enchantment* ench = MWBase::Environment::get().getWorld()->getStore().get<ESM::Enchantment>().search(leftName);
-                if (ench)
-                {
-                    if (ench->mData.mType == ESM::Enchantment::ConstantEffect)
-                        leftChargePercent = 101;
-                    else
-                        leftChargePercent = static_cast<int>(left.mBase.getCellRef().getNormalizedEnchantmentCharge(ench->mData.mCharge) * 100);
-                }
-            }
-
-            if (!rightName.empty())
-            {
-                const ESM::Enchantment* ench = MWBase::Environment::get().getWorld()->getStore().get<ESM::Enchantment>().search(rightName);
-                if (ench)
-                {
-                    if (ench->mData.mType == ESM::Enchantment::ConstantEffect)
-                        rightChargePercent = 101;
-                    else
-                        rightChargePercent = static_cast<int>(right.mBase.getCellRef().getNormalizedEnchantmentCharge(ench->mData.mCharge) * 100);
-                }
-            }
+            if (left.mName != right.mName)
+                return left.mName < right.mName;
 
-            result = leftChargePercent - rightChargePercent;
-            if (result != 0)
-                return result > 0;
+            // compare items by enchantment
+            if (left.mChargePercent != right.mChargePercent)
+                return left.mChargePercent > right.mChargePercent;
 
             // compare items by condition
-            if (left.mBase.getClass().hasItemHealth(left.mBase) && right.mBase.getClass().hasItemHealth(right.mBase))
-            {
-                result = left.mBase.getClass().getItemHealth(left.mBase) - right.mBase.getClass().getItemHealth(right.mBase);
-                if (result != 0)
-                    return result > 0;
-            }
+            if (left.mHasItemHealth && right.mHasItemHealth && left.mItemHealth != right.mItemHealth)
+                return left.mItemHealth > right.mItemHealth;
 
             // compare items by remaining usage time
-            result = left.mBase.getClass().getRemainingUsageTime(left.mBase) - right.mBase.getClass().getRemainingUsageTime(right.mBase);
-            if (result != 0)
-                return result > 0;
+            if (left.mRemainingUsageTime != right.mRemainingUsageTime)
+                return left.mRemainingUsageTime > right.mRemainingUsageTime;
 
             // compare items by value
-            result = left.mBase.getClass().getValue(left.mBase) - right.mBase.getClass().getValue(right.mBase);
-            if (result != 0)
-                return result > 0;
+            if (left.mValue != right.mValue)
+                return left.mValue > right.mValue;
 
             // compare items by weight
-            result = left.mBase.getClass().getWeight(left.mBase) - right.mBase.getClass().getWeight(right.mBase);
-            if (result != 0)
-                return result > 0;
+            if (left.mWeight != right.mWeight)
+                return left.mWeight > right.mWeight;
 
             // compare items by Id
-            leftName = left.mBase.getCellRef().getRefId();
-            rightName = right.mBase.getCellRef().getRefId();
-
-            result = leftName.compare(rightName);
-            return result < 0;
+            return left.mRefId < right.mRefId;
         }
     };
 }
@@ -176,6 +176,11 @@ namespace MWGui
     }
 
     bool SortFilterItemModel::filterAccepts (const ItemStack& item)
+    {
+        return filterAccepts(item, Utf8Stream::lowerCaseUtf8(item.mBase.getClass().getName(item.mBase)));
+    }
+
+    bool SortFilterItemModel::filterAccepts (const ItemStack& item, const std::string& lowerCaseName)
     {
         MWWorld::Ptr base = item.mBase;
 
@@ -213,10 +218,7 @@ namespace MWGui
                 throw std::logic_error("name and magic effect filter are mutually exclusive");
 
             if (!mNameFilter.empty())
-            {
-                const auto itemName = Utf8Stream::lowerCaseUtf8(base.getClass().getName(base));
-                return itemName.find(mNameFilter) != std::string::npos;
-            }
+                return lowerCaseName.find(mNameFilter) != std::string::npos;
 
             if (!mEffectFilter.empty())
             {
@@ -286,8 +288,7 @@ namespace MWGui
                 return false;
         }
 
-        std::string compare = Utf8Stream::lowerCaseUtf8(item.mBase.getClass().getName(item.mBase));
-        if(compare.find(mNameFilter) == std::string::npos)
+        if (lowerCaseName.find(mNameFilter) == std::string::npos)
             return false;
 
         return true;
@@ -333,7 +334,8 @@ namespace MWGui
 
         size_t count = mSourceModel->getItemCount();
 
-        mItems.clear();
+        std::vector<std::pair<SortKey, ItemStack>> items;
+        items.reserve(count);
         for (size_t i=0; i<count; ++i)
         {
             ItemStack item = mSourceModel->getItem(i);
@@ -348,13 +350,25 @@ namespace MWGui
                 }
             }
 
-            if (item.mCount > 0 && filterAccepts(item))
-                mItems.push_back(item);
+            if (item.mCount == 0)
+                continue;
+
+            std::string name = Utf8Stream::lowerCaseUtf8(item.mBase.getClass().getName(item.mBase));
+            if (!filterAccepts(item, name))
+                continue;
+
+            items.emplace_back(makeSortKey(item, std::move(name)), item);
         }
 
         Compare cmp;
         cmp.mSortByType = mSortByType;
-        std::sort(mItems.begin(), mItems.end(), cmp);
+        std::sort(items.begin(), items.end(),
+                  [&] (const auto& left, const auto& right) { return cmp(left.first, right.first); });
+
+        mItems.clear();
+        mItems.reserve(items.size());
+        for (auto& item : items)
+            mItems.push_back(std::move(item.second));
     }
 
     void SortFilterItemModel::onClose()
@@ -52,6 +52,8 @@ namespace MWGui
 
 
     private:
+        bool filterAccepts (const ItemStack& item, const std::string& lowerCaseName);
+
         std::vector<ItemStack> mItems;
 
         std::vector<std::pair<MWWorld::Ptr, size_t> > mDragItems;
@@ -20,6 +20,7 @@ namespace MWLua
         LuaManager* mLuaManager;
         LuaUtil::LuaState* mLua;
         LuaUtil::UserdataSerializer* mSerializer;
+        LuaUtil::UserdataSerializer* mLocalSerializer;  // Creates userdata in the form local scripts expect
         WorldView* mWorldView;
         LocalEventQueue* mLocalEventQueue;
         GlobalEventQueue* mGlobalEventQueue;
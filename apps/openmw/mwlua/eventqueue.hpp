@@ -1,6 +1,8 @@
 #ifndef MWLUA_EVENTQUEUE_H
 #define MWLUA_EVENTQUEUE_H
 
+#include <sol/sol.hpp>
+
 #include "object.hpp"
 
 namespace ESM
@@ -14,30 +16,28 @@ namespace LuaUtil
     class UserdataSerializer;
 }
 
-namespace sol
-{
-    class state;
-}
-
 namespace MWLua
 {
+    // Event data is kept as a Lua value (see LuaUtil::copy) and only serialized when the queue is saved.
     struct GlobalEvent
     {
         std::string mEventName;
-        std::string mEventData;
+        sol::object mEventData;
     };
     struct LocalEvent
     {
         ObjectId mDest;
         std::string mEventName;
-        std::string mEventData;
+        sol::object mEventData;
     };
     using GlobalEventQueue = std::vector<GlobalEvent>;
     using LocalEventQueue = std::vector<LocalEvent>;
 
     void loadEvents(sol::state& lua, ESM::ESMReader& esm, GlobalEventQueue&, LocalEventQueue&,
-                    const std::map<int, int>& contentFileMapping, const LuaUtil::UserdataSerializer* serializer);
-    void saveEvents(ESM::ESMWriter& esm, const GlobalEventQueue&, const LocalEventQueue&);
+                    const std::map<int, int>& contentFileMapping, const LuaUtil::UserdataSerializer* globalSerializer,
+                    const LuaUtil::UserdataSerializer* localSerializer);
+    void saveEvents(ESM::ESMWriter& esm, const GlobalEventQueue&, const LocalEventQueue&,
+                    const LuaUtil::UserdataSerializer* serializer);
 }
 
 #endif // MWLUA_EVENTQUEUE_H
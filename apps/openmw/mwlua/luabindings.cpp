@@ -33,7 +33,8 @@ namespace MWLua
         };
         api["sendGlobalEvent"] = [context](std::string eventName, const sol::object& eventData)
         {
-            context.mGlobalEventQueue->push_back({std::move(eventName), LuaUtil::serialize(eventData, context.mSerializer)});
+            context.mGlobalEventQueue->push_back(
+                {std::move(eventName), LuaUtil::copy(context.mLua->sol(), eventData, context.mSerializer)});
         };
         api["getGameTimeInSeconds"] = [world=context.mWorldView]() { return world->getGameTimeInSeconds(); };
         api["getGameTimeInHours"] = [world=context.mWorldView]() { return world->getGameTimeInHours(); };
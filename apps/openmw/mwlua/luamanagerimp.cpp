@@ -1,5 +1,13 @@
 #include "luamanagerimp.hpp"
 
+#include <algorithm>
+#include <chrono>
+#include <sstream>
+
+#include <boost/filesystem/fstream.hpp>
+
+#include <osg/Stats>
+
 #include <components/debug/debuglog.hpp>
 
 #include <components/esm/esmreader.hpp>
@@ -8,6 +16,8 @@
 
 #include <components/lua/utilpackage.hpp>
 
+#include <components/settings/settings.hpp>
+
 #include "../mwbase/windowmanager.hpp"
 
 #include "../mwworld/class.hpp"
@@ -19,11 +29,26 @@
 
 namespace MWLua
 {
+    namespace
+    {
+        constexpr std::size_t profilerReportEntries = 20;
+    }
 
-    LuaManager::LuaManager(const VFS::Manager* vfs) : mLua(vfs, &mConfiguration)
+    LuaManager::LuaManager(const VFS::Manager* vfs, const std::string& profilerTracePath)
+        : mProfilerTracePath(profilerTracePath)
+        , mLua(vfs, &mConfiguration)
     {
         Log(Debug::Info) << "Lua version: " << LuaUtil::getLuaVersion();
 
+        const int memoryLimit = Settings::Manager::getInt("lua script memory limit", "Lua");
+        mLua.getAllocator().setScriptMemoryLimit(static_cast<std::size_t>(std::max(memoryLimit, 0)) * 1024 * 1024);
+
+        const float frameBudget = Settings::Manager::getFloat("lua frame budget", "Lua");
+        mLua.getProfiler().setFrameBudget(std::chrono::duration_cast<LuaUtil::LuaProfiler::Clock::duration>(
+            std::chrono::duration<float, std::milli>(std::max(frameBudget, 0.f))));
+        if (Settings::Manager::getBool("lua profiler", "Lua"))
+            mLua.getProfiler().start();
+
         mGlobalSerializer = createUserdataSerializer(false, mWorldView.getObjectRegistry());
         mLocalSerializer = createUserdataSerializer(true, mWorldView.getObjectRegistry());
         mGlobalLoader = createUserdataSerializer(false, mWorldView.getObjectRegistry(), &mContentFileMapping);
@@ -50,6 +75,7 @@ namespace MWLua
         context.mLocalEventQueue = &mLocalEvents;
         context.mGlobalEventQueue = &mGlobalEvents;
         context.mSerializer = mGlobalSerializer.get();
+        context.mLocalSerializer = mLocalSerializer.get();
 
         Context localContext = context;
         localContext.mIsGlobal = false;
@@ -171,6 +197,8 @@ namespace MWLua
 
         if (!mWorldView.isPaused())
             mGlobalScripts.update(frameDuration);
+
+        mLua.getProfiler().finishFrame();
     }
 
     void LuaManager::synchronizedUpdate()
@@ -360,7 +388,7 @@ namespace MWLua
         ESM::LuaScripts globalScripts;
         mGlobalScripts.save(globalScripts);
         globalScripts.save(writer);
-        saveEvents(writer, mGlobalEvents, mLocalEvents);
+        saveEvents(writer, mGlobalEvents, mLocalEvents, mGlobalSerializer.get());
 
         writer.endRecord(ESM::REC_LUAM);
     }
@@ -373,7 +401,8 @@ namespace MWLua
         mWorldView.load(reader);
         ESM::LuaScripts globalScripts;
         globalScripts.load(reader);
-        loadEvents(mLua.sol(), reader, mGlobalEvents, mLocalEvents, mContentFileMapping, mGlobalLoader.get());
+        loadEvents(mLua.sol(), reader, mGlobalEvents, mLocalEvents, mContentFileMapping, mGlobalLoader.get(),
+                   mLocalLoader.get());
 
         mGlobalScripts.setSerializer(mGlobalLoader.get());
         mGlobalScripts.load(globalScripts);
@@ -435,4 +464,73 @@ namespace MWLua
             scripts->receiveEngineEvent(LocalScripts::OnActive());
     }
 
+    void LuaManager::reportStats(unsigned int frameNumber, osg::Stats& stats) const
+    {
+        if (!mLua.isMemoryTracked())
+            return;
+        const LuaUtil::LuaAllocator::Stats& allocatorStats = mLua.getAllocator().getStats();
+        stats.setAttribute(frameNumber, "Lua UsedMemory", allocatorStats.mUsed);
+        stats.setAttribute(frameNumber, "Lua PoolMemory", allocatorStats.mPoolReserved);
+        if (allocatorStats.mPoolReserved > 0)
+            stats.setAttribute(frameNumber, "Lua PoolUsage",
+                               static_cast<double>(allocatorStats.mPoolUsed) / allocatorStats.mPoolReserved * 100.0);
+        if (allocatorStats.mAllocations > 0)
+            stats.setAttribute(frameNumber, "Lua PoolAllocRate",
+                               static_cast<double>(allocatorStats.mPoolAllocations) / allocatorStats.mAllocations * 100.0);
+        stats.setAttribute(frameNumber, "Lua FailedAllocs", allocatorStats.mFailedAllocations);
+    }
+
+    std::string LuaManager::getMemoryUsageDescription() const
+    {
+        if (!mLua.isMemoryTracked())
+            return "Memory usage of Lua scripts is not tracked with " + LuaUtil::getLuaVersion();
+
+        const LuaUtil::LuaAllocator& allocator = mLua.getAllocator();
+        const LuaUtil::LuaAllocator::Stats& stats = allocator.getStats();
+        std::ostringstream out;
+        out << "Lua memory: " << stats.mUsed / 1024 << " KiB used, "
+            << (stats.mPoolReserved + stats.mLargeUsed) / 1024 << " KiB reserved\n";
+        out << "Pools: " << stats.mPoolUsed / 1024 << " of " << stats.mPoolReserved / 1024 << " KiB in use, "
+            << stats.mPoolAllocations << " of " << stats.mAllocations << " allocations\n";
+        if (allocator.getScriptMemoryLimit() > 0)
+            out << "Limit per script: " << allocator.getScriptMemoryLimit() / 1024 << " KiB, "
+                << stats.mFailedAllocations << " allocations failed\n";
+
+        std::vector<std::pair<std::size_t, int>> usage;
+        for (std::size_t i = 0; i < allocator.getScriptsCount() && i < mConfiguration.size(); ++i)
+        {
+            const std::size_t scriptUsage = allocator.getScriptMemoryUsage(static_cast<int>(i));
+            if (scriptUsage > 0)
+                usage.emplace_back(scriptUsage, static_cast<int>(i));
+        }
+        std::sort(usage.begin(), usage.end(), std::greater<>());
+        for (const auto& [scriptUsage, scriptId] : usage)
+            out << scriptUsage / 1024 << " KiB " << mConfiguration[scriptId].mScriptPath << "\n";
+        return out.str();
+    }
+
+    std::string LuaManager::toggleProfiler()
+    {
+        LuaUtil::LuaProfiler& profiler = mLua.getProfiler();
+        if (!profiler.isRunning())
+        {
+            profiler.start();
+            return "Lua profiler is started";
+        }
+        profiler.stop();
+        std::string result = profiler.getReport(profilerReportEntries);
+        boost::filesystem::ofstream stream(mProfilerTracePath);
+        profiler.writeChromeTrace(stream);
+        if (stream.good())
+            result += "Trace is saved to " + mProfilerTracePath;
+        else
+            result += "Can't save trace to " + mProfilerTracePath;
+        return result;
+    }
+
+    std::string LuaManager::getProfilerReport() const
+    {
+        return mLua.getProfiler().getReport(profilerReportEntries);
+    }
+
 }
@@ -22,7 +22,8 @@ namespace MWLua
     class LuaManager : public MWBase::LuaManager
     {
     public:
-        LuaManager(const VFS::Manager* vfs);
+        // `profilerTracePath` is a file to save the trace of the Lua profiler.
+        LuaManager(const VFS::Manager* vfs, const std::string& profilerTracePath);
 
         // Called by engine.cpp when the environment is fully initialized.
         void init();
@@ -68,6 +69,11 @@ namespace MWLua
         // Drops script cache and reloads all scripts. Calls `onSave` and `onLoad` for every script.
         void reloadAllScripts() override;
 
+        void reportStats(unsigned int frameNumber, osg::Stats& stats) const override;
+        std::string getMemoryUsageDescription() const override;
+        std::string toggleProfiler() override;
+        std::string getProfilerReport() const override;
+
         // Used to call Lua callbacks from C++
         void queueCallback(LuaUtil::Callback callback, sol::object arg)
         {
@@ -87,6 +93,7 @@ namespace MWLua
         void initConfiguration();
         LocalScripts* createLocalScripts(const MWWorld::Ptr& ptr, ESM::LuaScriptCfg::Flags);
 
+        const std::string mProfilerTracePath;
         bool mInitialized = false;
         bool mGlobalScriptsStarted = false;
         LuaUtil::ScriptsConfiguration mConfiguration;
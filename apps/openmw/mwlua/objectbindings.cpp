@@ -119,7 +119,8 @@ namespace MWLua
         objectT[sol::meta_function::to_string] = &ObjectT::toString;
         objectT["sendEvent"] = [context](const ObjectT& dest, std::string eventName, const sol::object& eventData)
         {
-            context.mLocalEventQueue->push_back({dest.id(), std::move(eventName), LuaUtil::serialize(eventData, context.mSerializer)});
+            context.mLocalEventQueue->push_back(
+                {dest.id(), std::move(eventName), LuaUtil::copy(context.mLua->sol(), eventData, context.mLocalSerializer)});
         };
 
         objectT["canMove"] = [](const ObjectT& o)
@@ -374,16 +374,21 @@ namespace MWMechanics
         }
     }
 
-    bool ActiveSpells::applyPurges(const MWWorld::Ptr& ptr, std::list<ActiveSpellParams>::iterator* currentSpell, std::vector<ActiveEffect>::iterator* currentEffect)
+    bool ActiveSpells::applyPurges(const MWWorld::Ptr& ptr, std::vector<ActiveSpellParams>::iterator* currentSpell, std::vector<ActiveEffect>::iterator* currentEffect)
     {
+        // Erasing from the vector invalidates iterators, so track positions of the current spell and effect
+        std::size_t currentSpellIndex = currentSpell ? static_cast<std::size_t>(*currentSpell - mSpells.begin()) : 0;
+        std::size_t currentEffectIndex = currentSpell && currentEffect
+            ? static_cast<std::size_t>(*currentEffect - (*currentSpell)->mEffects.begin()) : 0;
         bool removedCurrentSpell = false;
         while(!mPurges.empty())
         {
             auto predicate = mPurges.front();
             mPurges.pop();
-            for(auto spellIt = mSpells.begin(); spellIt != mSpells.end();)
+            for(std::size_t spellIndex = 0; spellIndex < mSpells.size();)
             {
-                bool isCurrentSpell = currentSpell && *currentSpell == spellIt;
+                auto spellIt = mSpells.begin() + spellIndex;
+                bool isCurrentSpell = currentSpell && !removedCurrentSpell && currentSpellIndex == spellIndex;
                 std::visit([&] (auto&& variant)
                 {
                     using T = std::decay_t<decltype(variant)>;
@@ -392,17 +397,16 @@ namespace MWMechanics
                         if(variant(*spellIt))
                         {
                             auto params = *spellIt;
-                            spellIt = mSpells.erase(spellIt);
+                            mSpells.erase(spellIt);
                             if(isCurrentSpell)
-                            {
-                                *currentSpell = spellIt;
                                 removedCurrentSpell = true;
-                            }
+                            else if(currentSpell && spellIndex < currentSpellIndex)
+                                --currentSpellIndex;
                             for(const auto& effect : params.mEffects)
                                 onMagicEffectRemoved(ptr, params, effect);
                         }
                         else
-                            ++spellIt;
+                            ++spellIndex;
                     }
                     else
                     {
@@ -412,26 +416,26 @@ namespace MWMechanics
                             if(variant(*spellIt, *effectIt))
                             {
                                 auto effect = *effectIt;
-                                if(isCurrentSpell && currentEffect)
-                                {
-                                    auto distance = std::distance(spellIt->mEffects.begin(), *currentEffect);
-                                    if(effectIt <= *currentEffect)
-                                        distance--;
-                                    effectIt = spellIt->mEffects.erase(effectIt);
-                                    *currentEffect = spellIt->mEffects.begin() + distance;
-                                }
-                                else
-                                    effectIt = spellIt->mEffects.erase(effectIt);
+                                if(isCurrentSpell && currentEffect
+                                    && static_cast<std::size_t>(effectIt - spellIt->mEffects.begin()) < currentEffectIndex)
+                                    --currentEffectIndex;
+                                effectIt = spellIt->mEffects.erase(effectIt);
                                 onMagicEffectRemoved(ptr, *spellIt, effect);
                             }
                             else
                                 ++effectIt;
                         }
-                        ++spellIt;
+                        ++spellIndex;
                     }
                 }, predicate);
             }
         }
+        if(currentSpell)
+        {
+            *currentSpell = mSpells.begin() + currentSpellIndex;
+            if(currentEffect && !removedCurrentSpell)
+                *currentEffect = (*currentSpell)->mEffects.begin() + currentEffectIndex;
+        }
         return removedCurrentSpell;
     }
 
@@ -2,7 +2,6 @@
 #define GAME_MWMECHANICS_ACTIVESPELLS_H
 
 #include <functional>
-#include <list>
 #include <queue>
 #include <string>
 #include <variant>
@@ -79,7 +78,7 @@ namespace MWMechanics
                     void resetWorsenings();
             };
 
-            typedef std::list<ActiveSpellParams>::const_iterator TIterator;
+            typedef std::vector<ActiveSpellParams>::const_iterator TIterator;
 
             void readState (const ESM::ActiveSpells& state);
             void writeState (ESM::ActiveSpells& state) const;
@@ -103,14 +102,15 @@ namespace MWMechanics
                 ~IterationGuard();
             };
 
-            std::list<ActiveSpellParams> mSpells;
+            // Iterators are invalidated by update and purges.
+            std::vector<ActiveSpellParams> mSpells;
             std::vector<ActiveSpellParams> mQueue;
             std::queue<Predicate> mPurges;
             bool mIterating;
 
             void addToSpells(const MWWorld::Ptr& ptr, const ActiveSpellParams& spell);
 
-            bool applyPurges(const MWWorld::Ptr& ptr, std::list<ActiveSpellParams>::iterator* currentSpell = nullptr, std::vector<ActiveEffect>::iterator* currentEffect = nullptr);
+            bool applyPurges(const MWWorld::Ptr& ptr, std::vector<ActiveSpellParams>::iterator* currentSpell = nullptr, std::vector<ActiveEffect>::iterator* currentEffect = nullptr);
 
         public:
 
@@ -7,6 +7,7 @@
 
 #include <components/sceneutil/positionattitudetransform.hpp>
 #include <components/debug/debuglog.hpp>
+#include <components/debug/frameprofiler.hpp>
 #include <components/misc/rng.hpp>
 #include <components/misc/mathutil.hpp>
 #include <components/settings/settings.hpp>
@@ -1211,6 +1212,7 @@ namespace MWMechanics
 
     void Actors::predictAndAvoidCollisions(float duration)
     {
+        const Debug::ProfileZone zone("Actors::predictAndAvoidCollisions");
         if (!MWBase::Environment::get().getMechanicsManager()->isAIActive())
             return;
 
@@ -1355,6 +1357,7 @@ namespace MWMechanics
 
     void Actors::update (float duration, bool paused)
     {
+        const Debug::ProfileZone zone("Actors::update");
         if(!paused)
         {
             static float timerUpdateHeadTrack = 0;
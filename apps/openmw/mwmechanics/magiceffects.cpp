@@ -1,5 +1,6 @@
 #include "magiceffects.hpp"
 
+#include <algorithm>
 #include <cmath>
 #include <stdexcept>
 
@@ -78,8 +79,6 @@ namespace MWMechanics
         return mModifier;
     }
 
-    EffectParam::EffectParam() : mModifier (0), mBase(0) {}
-
     EffectParam& EffectParam::operator+= (const EffectParam& param)
     {
         mModifier += param.mModifier;
@@ -96,41 +95,105 @@ namespace MWMechanics
         return *this;
     }
 
-    void MagicEffects::remove(const EffectKey &key)
+    namespace
     {
-        mCollection.erase(key);
-    }
+        bool isDense(const EffectKey& key)
+        {
+            return key.mArg == -1 && key.mId >= 0 && key.mId < ESM::MagicEffect::Length;
+        }
 
-    void MagicEffects::add (const EffectKey& key, const EffectParam& param)
-    {
-        Collection::iterator iter = mCollection.find (key);
+        bool isEmpty(const EffectParam& param)
+        {
+            return param.getBase() == 0 && param.getModifier() == 0.f;
+        }
 
-        if (iter==mCollection.end())
+        // Only sums and differences are truncated, an effect that is not present yet gets the modifier as is.
+        // Effects with zero base and modifier count as not present.
+        void addTo(EffectParam& effect, const EffectParam& param)
         {
-            mCollection.insert (std::make_pair (key, param));
+            if (isEmpty(effect))
+                effect = param;
+            else
+                effect += param;
         }
-        else
+
+        EffectParam difference(const EffectParam& now, const EffectParam& prev)
         {
-            iter->second += param;
+            if (isEmpty(prev))
+                return now;
+            return now - prev;
+        }
+
+        template <class T>
+        auto findWithArg(T& effects, const EffectKey& key)
+        {
+            return std::lower_bound(effects.begin(), effects.end(), key,
+                                    [] (const auto& v, const EffectKey& k) { return v.first < k; });
         }
     }
 
-    void MagicEffects::modifyBase(const EffectKey &key, int diff)
+    EffectParam* MagicEffects::find(const EffectKey& key)
     {
-        mCollection[key].modifyBase(diff);
+        if (isDense(key))
+            return &mEffects[key.mId];
+        const auto it = findWithArg(mEffectsWithArg, key);
+        if (it == mEffectsWithArg.end() || key < it->first)
+            return nullptr;
+        return &it->second;
     }
 
-    void MagicEffects::setModifiers(const MagicEffects &effects)
+    const EffectParam* MagicEffects::find(const EffectKey& key) const
     {
-        for (Collection::iterator it = mCollection.begin(); it != mCollection.end(); ++it)
-        {
-            it->second.setModifier(effects.get(it->first).getModifier());
-        }
+        if (isDense(key))
+            return &mEffects[key.mId];
+        const auto it = findWithArg(mEffectsWithArg, key);
+        if (it == mEffectsWithArg.end() || key < it->first)
+            return nullptr;
+        return &it->second;
+    }
 
-        for (Collection::const_iterator it = effects.begin(); it != effects.end(); ++it)
+    EffectParam& MagicEffects::getOrAdd(const EffectKey& key)
+    {
+        if (isDense(key))
+            return mEffects[key.mId];
+        auto it = findWithArg(mEffectsWithArg, key);
+        if (it == mEffectsWithArg.end() || key < it->first)
+            it = mEffectsWithArg.emplace(it, key, EffectParam());
+        return it->second;
+    }
+
+    void MagicEffects::remove(const EffectKey &key)
+    {
+        if (isDense(key))
         {
-            mCollection[it->first].setModifier(it->second.getModifier());
+            mEffects[key.mId] = EffectParam();
+            return;
         }
+        const auto it = findWithArg(mEffectsWithArg, key);
+        if (it != mEffectsWithArg.end() && !(key < it->first))
+            mEffectsWithArg.erase(it);
+    }
+
+    void MagicEffects::add (const EffectKey& key, const EffectParam& param)
+    {
+        addTo(getOrAdd(key), param);
+    }
+
+    void MagicEffects::modifyBase(const EffectKey &key, int diff)
+    {
+        getOrAdd(key).modifyBase(diff);
+    }
+
+    void MagicEffects::setModifiers(const MagicEffects &effects)
+    {
+        for (std::size_t i = 0; i < mEffects.size(); ++i)
+            mEffects[i].setModifier(effects.mEffects[i].getModifier());
+
+        for (auto& [key, param] : mEffectsWithArg)
+            param.setModifier(effects.get(key).getModifier());
+
+        for (const auto& [key, param] : effects.mEffectsWithArg)
+            getOrAdd(key).setModifier(param.getModifier());
     }
 
     MagicEffects& MagicEffects::operator+= (const MagicEffects& effects)
@@ -142,72 +205,52 @@ namespace MWMechanics
             return *this;
         }
 
-        for (Collection::const_iterator iter (effects.begin()); iter!=effects.end(); ++iter)
-        {
-            Collection::iterator result = mCollection.find (iter->first);
+        // Skip absent effects to not truncate the modifiers of the present ones
+        for (std::size_t i = 0; i < mEffects.size(); ++i)
+            if (!isEmpty(effects.mEffects[i]))
+                addTo(mEffects[i], effects.mEffects[i]);
 
-            if (result!=mCollection.end())
-                result->second += iter->second;
-            else
-                mCollection.insert (*iter);
-        }
+        for (const auto& [key, param] : effects.mEffectsWithArg)
+            addTo(getOrAdd(key), param);
 
         return *this;
     }
 
     EffectParam MagicEffects::get (const EffectKey& key) const
     {
-        Collection::const_iterator iter = mCollection.find (key);
-
-        if (iter==mCollection.end())
-        {
-            return EffectParam();
-        }
-        else
-        {
-            return iter->second;
-        }
+        if (const EffectParam* const param = find(key))
+            return *param;
+        return EffectParam();
     }
 
     MagicEffects MagicEffects::diff (const MagicEffects& prev, const MagicEffects& now)
     {
         MagicEffects result;
 
-        // adding/changing
-        for (Collection::const_iterator iter (now.begin()); iter!=now.end(); ++iter)
-        {
-            Collection::const_iterator other = prev.mCollection.find (iter->first);
+        for (std::size_t i = 0; i < result.mEffects.size(); ++i)
+            result.mEffects[i] = difference(now.mEffects[i], prev.mEffects[i]);
 
-            if (other==prev.end())
-            {
-                // adding
-                result.add (iter->first, iter->second);
-            }
-            else
-            {
-                // changing
-                result.add (iter->first, iter->second - other->second);
-            }
-        }
+        // adding/changing
+        for (const auto& [key, param] : now.mEffectsWithArg)
+            result.add(key, difference(param, prev.get(key)));
 
         // removing
-        for (Collection::const_iterator iter (prev.begin()); iter!=prev.end(); ++iter)
-        {
-            Collection::const_iterator other = now.mCollection.find (iter->first);
-            if (other==now.end())
-            {
-                result.add (iter->first, EffectParam() - iter->second);
-            }
-        }
+        for (const auto& [key, param] : prev.mEffectsWithArg)
+            if (now.find(key) == nullptr)
+                result.add(key, EffectParam() - param);
 
         return result;
     }
 
     void MagicEffects::writeState(ESM::MagicEffects &state) const
     {
-        for (const auto& [key, params] : mCollection)
+        for (std::size_t i = 0; i < mEffects.size(); ++i)
+            if (!isEmpty(mEffects[i]))
+                state.mEffects[static_cast<int>(i)] = {mEffects[i].getBase(), mEffects[i].getModifier()};
+
+        for (const auto& [key, params] : mEffectsWithArg)
         {
-            if (params.getBase() != 0 || params.getModifier() != 0.f)
+            if (!isEmpty(params))
             {
                 // Don't worry about mArg, never used by magic effect script instructions
                 state.mEffects[key.mId] = {params.getBase(), params.getModifier()};
@@ -219,8 +262,9 @@ namespace MWMechanics
     {
         for (const auto& [key, params] : state.mEffects)
         {
-            mCollection[EffectKey(key)].setBase(params.first);
-            mCollection[EffectKey(key)].setModifier(params.second);
+            EffectParam& param = getOrAdd(EffectKey(key));
+            param.setBase(params.first);
+            param.setModifier(params.second);
         }
     }
 }
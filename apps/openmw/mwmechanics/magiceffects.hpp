@@ -1,8 +1,11 @@
 #ifndef GAME_MWMECHANICS_MAGICEFFECTS_H
 #define GAME_MWMECHANICS_MAGICEFFECTS_H
 
-#include <map>
-#include <string>
+#include <array>
+#include <utility>
+#include <vector>
+
+#include <components/esm/loadmgef.hpp>
 
 namespace ESM
 {
@@ -32,9 +35,9 @@ namespace MWMechanics
     {
     private:
         // Note usually this would be int, but applying partial resistance might introduce a decimal point.
-        float mModifier;
+        float mModifier = 0;
 
-        int mBase;
+        int mBase = 0;
 
     public:
         /// Get the total magnitude including base and modifier.
@@ -48,7 +51,7 @@ namespace MWMechanics
         void setBase(int base);
         int getBase() const;
 
-        EffectParam();
+        EffectParam() = default;
 
         EffectParam(float magnitude) : mModifier(magnitude), mBase(0) {}
 
@@ -70,21 +73,24 @@ namespace MWMechanics
     }
 
     /// \brief Effects currently affecting a NPC or creature
+    ///
+    /// Effects without an argument are stored in an array indexed by the effect id. Effects with a skill or an
+    /// attribute argument are rare, they are kept in a small vector sorted by the key.
     class MagicEffects
     {
-        public:
+        private:
 
-            typedef std::map<EffectKey, EffectParam> Collection;
+            std::array<EffectParam, ESM::MagicEffect::Length> mEffects;
 
-        private:
+            std::vector<std::pair<EffectKey, EffectParam>> mEffectsWithArg;
 
-            Collection mCollection;
+            EffectParam* find(const EffectKey& key);
 
-        public:
+            const EffectParam* find(const EffectKey& key) const;
 
-            Collection::const_iterator begin() const { return mCollection.begin(); }
+            EffectParam& getOrAdd(const EffectKey& key);
 
-            Collection::const_iterator end() const { return mCollection.end(); }
+        public:
 
             void readState (const ESM::MagicEffects& state);
             void writeState (ESM::MagicEffects& state) const;
@@ -1,5 +1,7 @@
 #include "mechanicsmanagerimp.hpp"
 
+#include <algorithm>
+
 #include <osg/Stats>
 
 #include <components/misc/rng.hpp>
@@ -314,6 +316,8 @@ namespace MWMechanics
 
     void MechanicsManager::update(float duration, bool paused)
     {
+        mDetections.clear();
+
         // Note: we should do it here since game mechanics and world updates use these values
         MWWorld::Ptr ptr = getPlayer();
         MWBase::WindowManager *winMgr = MWBase::Environment::get().getWindowManager();
@@ -1151,8 +1155,12 @@ namespace MWMechanics
         std::set<MWWorld::Ptr> playerFollowers;
         getActorsSidingWith(player, playerFollowers);
 
+        // NPC will complain about theft even if he will do nothing about it
+        const bool complain = type == OT_Theft || type == OT_Pickpocket;
+
         // Did anyone see it?
         bool crimeSeen = false;
+        std::vector<MWWorld::Ptr> observers;
         for (const MWWorld::Ptr &neighbor : neighbors)
         {
             if (!canReportCrime(neighbor, victim, playerFollowers))
@@ -1161,15 +1169,28 @@ namespace MWMechanics
             if ((neighbor == victim && victimAware)
                     // Murder crime can be reported even if no one saw it (hearing is enough, I guess).
                     // TODO: Add mod support for stealth executions!
-                    || (type == OT_Murder && neighbor != victim)
-                    || (MWBase::Environment::get().getWorld()->getLOS(player, neighbor) && awarenessCheck(player, neighbor)))
+                    || (type == OT_Murder && neighbor != victim))
             {
-                // NPC will complain about theft even if he will do nothing about it
-                if (type == OT_Theft || type == OT_Pickpocket)
+                if (complain)
                     MWBase::Environment::get().getDialogueManager()->say(neighbor, "thief");
 
                 crimeSeen = true;
             }
+            else
+                observers.push_back(neighbor);
+        }
+
+        // Seeing is the most expensive check, skip it when nobody else needs to complain
+        if (!observers.empty() && (complain || !crimeSeen))
+        {
+            findWitnesses(player, observers, [&] (const MWWorld::Ptr& witness)
+            {
+                if (complain)
+                    MWBase::Environment::get().getDialogueManager()->say(witness, "thief");
+
+                crimeSeen = true;
+                return !complain;
+            });
         }
 
         if (crimeSeen)
@@ -1503,6 +1524,40 @@ namespace MWMechanics
         commitCrime(player, victim, MWBase::MechanicsManager::OT_Murder);
     }
 
+    template <class Function>
+    void MechanicsManager::findWitnesses(const MWWorld::Ptr& ptr, std::vector<MWWorld::Ptr>& observers, Function&& onWitness)
+    {
+        std::set<MWWorld::Ptr> unique;
+        observers.erase(std::remove_if(observers.begin(), observers.end(),
+            [&] (const MWWorld::Ptr& observer) { return !unique.insert(observer).second; }), observers.end());
+
+        // Closer observers are more likely to notice, so they are checked first.
+        const osg::Vec3f position = ptr.getRefData().getPosition().asVec3();
+        std::sort(observers.begin(), observers.end(), [&] (const MWWorld::Ptr& lhs, const MWWorld::Ptr& rhs)
+        {
+            return (lhs.getRefData().getPosition().asVec3() - position).length2()
+                < (rhs.getRefData().getPosition().asVec3() - position).length2();
+        });
+
+        std::vector<MWWorld::Ptr> unknown;
+        for (const MWWorld::Ptr& observer : observers)
+            if (mDetections.find(std::make_pair(ptr, observer)) == mDetections.end())
+                unknown.push_back(observer);
+
+        std::vector<bool> lineOfSight;
+        MWBase::Environment::get().getWorld()->getLOS(ptr, unknown, lineOfSight);
+
+        std::size_t unknownIndex = 0;
+        for (const MWWorld::Ptr& observer : observers)
+        {
+            const auto [it, inserted] = mDetections.emplace(std::make_pair(ptr, observer), false);
+            if (inserted)
+                it->second = lineOfSight[unknownIndex++] && awarenessCheck(ptr, observer);
+            if (it->second && onWitness(observer))
+                return;
+        }
+    }
+
     bool MechanicsManager::awarenessCheck(const MWWorld::Ptr &ptr, const MWWorld::Ptr &observer)
     {
         if (observer.getClass().getCreatureStats(observer).isDead() || !observer.getRefData().isEnabled())
@@ -1708,6 +1763,7 @@ namespace MWMechanics
     {
         mActors.clear();
         mStolenItems.clear();
+        mDetections.clear();
         mClassSelected = false;
         mRaceSelected = false;
     }
@@ -1830,22 +1886,17 @@ namespace MWMechanics
             const MWWorld::Store<ESM::GameSetting>& gmst = MWBase::Environment::get().getWorld()->getStore().get<ESM::GameSetting>();
             getActorsInRange(actor.getRefData().getPosition().asVec3(), gmst.find("fAlarmRadius")->mValue.getFloat(), neighbors);
 
+            neighbors.erase(std::remove_if(neighbors.begin(), neighbors.end(),
+                [&] (const MWWorld::Ptr& neighbor) { return neighbor == actor || !neighbor.getClass().isNpc(); }),
+                neighbors.end());
+
             bool detected = false, reported = false;
-            for (const MWWorld::Ptr& neighbor : neighbors)
+            findWitnesses(actor, neighbors, [&] (const MWWorld::Ptr& witness)
             {
-                if (neighbor == actor || !neighbor.getClass().isNpc())
-                    continue;
-
-                if (MWBase::Environment::get().getWorld()->getLOS(neighbor, actor) && awarenessCheck(actor, neighbor))
-                {
-                    detected = true;
-                    if (neighbor.getClass().getCreatureStats(neighbor).getAiSetting(MWMechanics::CreatureStats::AI_Alarm).getModified() > 0)
-                    {
-                        reported = true;
-                        break;
-                    }
-                }
-            }
+                detected = true;
+                reported = witness.getClass().getCreatureStats(witness).getAiSetting(MWMechanics::CreatureStats::AI_Alarm).getModified() > 0;
+                return reported;
+            });
 
             if (detected)
             {
@@ -34,6 +34,9 @@ namespace MWMechanics
             typedef std::map<std::string, OwnerMap> StolenItemsMap;
             StolenItemsMap mStolenItems;
 
+            // Whether observer (second) has detected actor (first) during the current frame.
+            std::map<std::pair<MWWorld::Ptr, MWWorld::Ptr>, bool> mDetections;
+
         public:
 
             void buildPlayer();
@@ -238,6 +241,11 @@ namespace MWMechanics
 
             bool reportCrime (const MWWorld::Ptr& ptr, const MWWorld::Ptr& victim,
                                       OffenseType type, const std::string& factionId, int arg=0);
+
+            /// Calls onWitness for the observers who see ptr starting from the closest one until it returns true.
+            /// Line of sight is requested for all observers at once, awareness is checked only when needed.
+            template <class Function>
+            void findWitnesses(const MWWorld::Ptr& ptr, std::vector<MWWorld::Ptr>& observers, Function&& onWitness);
     };
 }
 
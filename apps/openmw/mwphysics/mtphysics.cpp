@@ -4,6 +4,7 @@
 #include <osg/Stats>
 
 #include "components/debug/debuglog.hpp"
+#include "components/debug/frameprofiler.hpp"
 #include <components/misc/barrier.hpp>
 #include "components/misc/convert.hpp"
 #include "components/settings/settings.hpp"
@@ -519,7 +520,22 @@ namespace MWPhysics
     bool PhysicsTaskScheduler::getLineOfSight(const std::shared_ptr<Actor>& actor1, const std::shared_ptr<Actor>& actor2)
     {
         MaybeExclusiveLock lock(mLOSCacheMutex, mNumThreads);
+        return getCachedLineOfSight(actor1, actor2);
+    }
+
+    void PhysicsTaskScheduler::getLinesOfSight(const std::shared_ptr<Actor>& actor,
+        const std::vector<std::shared_ptr<Actor>>& targets, std::vector<bool>& result)
+    {
+        result.clear();
+        result.reserve(targets.size());
 
+        MaybeExclusiveLock lock(mLOSCacheMutex, mNumThreads);
+        for (const auto& target : targets)
+            result.push_back(target == actor || getCachedLineOfSight(actor, target));
+    }
+
+    bool PhysicsTaskScheduler::getCachedLineOfSight(const std::shared_ptr<Actor>& actor1, const std::shared_ptr<Actor>& actor2)
+    {
         auto req = LOSRequest(actor1, actor2);
         auto result = std::find(mLOSCache.begin(), mLOSCache.end(), req);
         if (result == mLOSCache.end())
@@ -581,6 +597,7 @@ namespace MWPhysics
 
     void PhysicsTaskScheduler::worker()
     {
+        Debug::FrameProfiler::setThreadName("Physics");
         std::size_t lastFrame = 0;
         std::shared_lock lock(mSimulationMutex);
         while (!mQuit)
@@ -622,6 +639,7 @@ namespace MWPhysics
 
     void PhysicsTaskScheduler::doSimulation()
     {
+        const Debug::ProfileZone zone("PhysicsTaskScheduler::doSimulation");
         while (mRemainingSteps)
         {
             mPreStepBarrier->wait([this] { afterPreStep(); });
@@ -733,6 +751,7 @@ namespace MWPhysics
     {
         if (mNumThreads == 0)
             return;
+        const Debug::ProfileZone zone("PhysicsTaskScheduler::waitForWorkers");
         std::unique_lock lock(mWorkersDoneMutex);
         if (mFrameCounter != mWorkersFrameCounter)
             mWorkersDone.wait(lock);
@@ -56,6 +56,9 @@ namespace MWPhysics
             void removeCollisionObject(btCollisionObject* collisionObject);
             void updateSingleAabb(std::shared_ptr<PtrHolder> ptr, bool immediate=false);
             bool getLineOfSight(const std::shared_ptr<Actor>& actor1, const std::shared_ptr<Actor>& actor2);
+            /// Same as getLineOfSight for every target but takes the cache lock once.
+            void getLinesOfSight(const std::shared_ptr<Actor>& actor, const std::vector<std::shared_ptr<Actor>>& targets,
+                std::vector<bool>& result);
             void debugDraw();
             void* getUserPointer(const btCollisionObject* object) const;
             void releaseSharedStates(); // destroy all objects whose destructor can't be safely called from ~PhysicsTaskScheduler()
@@ -65,6 +68,8 @@ namespace MWPhysics
             void worker();
             void updateActorsPositions();
             bool hasLineOfSight(const Actor* actor1, const Actor* actor2);
+            // Requires mLOSCacheMutex to be locked exclusively.
+            bool getCachedLineOfSight(const std::shared_ptr<Actor>& actor1, const std::shared_ptr<Actor>& actor2);
             void refreshLOSCache();
             void updateAabbs();
             void updatePtrAabb(const std::shared_ptr<PtrHolder>& ptr);
@@ -367,6 +367,34 @@ namespace MWPhysics
         return mTaskScheduler->getLineOfSight(it1->second, it2->second);
     }
 
+    void PhysicsSystem::getLinesOfSight(const MWWorld::ConstPtr& actor, const std::vector<MWWorld::ConstPtr>& targets,
+        std::vector<bool>& result) const
+    {
+        result.assign(targets.size(), false);
+
+        const auto it = mActors.find(actor.mRef);
+        if (it == mActors.end())
+            return;
+
+        std::vector<std::shared_ptr<Actor>> found;
+        std::vector<std::size_t> indices;
+        found.reserve(targets.size());
+        indices.reserve(targets.size());
+        for (std::size_t i = 0; i < targets.size(); ++i)
+        {
+            const auto target = mActors.find(targets[i].mRef);
+            if (target == mActors.end())
+                continue;
+            found.push_back(target->second);
+            indices.push_back(i);
+        }
+
+        std::vector<bool> lineOfSight;
+        mTaskScheduler->getLinesOfSight(it->second, found, lineOfSight);
+        for (std::size_t i = 0; i < indices.size(); ++i)
+            result[indices[i]] = lineOfSight[i];
+    }
+
     bool PhysicsSystem::isOnGround(const MWWorld::Ptr &actor)
     {
         Actor* physactor = getActor(actor);
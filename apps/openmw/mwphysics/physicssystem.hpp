@@ -198,6 +198,10 @@ namespace MWPhysics
             /// Return true if actor1 can see actor2.
             bool getLineOfSight(const MWWorld::ConstPtr& actor1, const MWWorld::ConstPtr& actor2) const override;
 
+            /// Return for every target whether actor can see it. Uses a single lock of the line of sight cache.
+            void getLinesOfSight(const MWWorld::ConstPtr& actor, const std::vector<MWWorld::ConstPtr>& targets,
+                std::vector<bool>& result) const;
+
             bool isOnGround (const MWWorld::Ptr& actor);
 
             bool canMoveToWaterSurface (const MWWorld::ConstPtr &actor, const float waterlevel);
@@ -106,6 +106,8 @@ namespace MWRender
         {
         }
 
+        const char* getProfileName() const override { return "CreateMapWorkItem"; }
+
         void doWork() override
         {
             osg::ref_ptr<osg::Image> image = new osg::Image;
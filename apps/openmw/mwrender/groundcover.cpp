@@ -1,5 +1,7 @@
 #include "groundcover.hpp"
 
+#include <chrono>
+
 #include <osg/ComputeBoundsVisitor>
 #include <osg/AlphaFunc>
 #include <osg/BlendFunc>
@@ -7,6 +9,7 @@
 #include <osg/VertexAttribDivisor>
 #include <osg/Program>
 
+#include <components/debug/debuglog.hpp>
 #include <components/esm/esmreader.hpp>
 #include <components/sceneutil/lightmanager.hpp>
 #include <components/sceneutil/nodecallback.hpp>
@@ -90,7 +93,6 @@ namespace MWRender
 
             return true;
         }
-        void reset() { mCurrentGroundcover = 0.f; }
 
     private:
         float mCurrentGroundcover = 0.f;
@@ -111,12 +113,11 @@ namespace MWRender
         osg::BoundingBox mBox;
     };
 
-    inline bool isInChunkBorders(ESM::CellRef& ref, osg::Vec2f& minBound, osg::Vec2f& maxBound)
+    inline bool isInChunkBorders(const osg::Vec3f& pos, osg::Vec2f& minBound, osg::Vec2f& maxBound)
     {
         osg::Vec2f size = maxBound - minBound;
         if (size.x() >=1 && size.y() >=1) return true;
 
-        osg::Vec3f pos = ref.mPos.asVec3();
         osg::Vec3f cellPos = pos / ESM::Land::REAL_SIZE;
         if ((minBound.x() > std::floor(minBound.x()) && cellPos.x() < minBound.x()) || (minBound.y() > std::floor(minBound.y()) && cellPos.y() < minBound.y())
             || (maxBound.x() < std::ceil(maxBound.x()) && cellPos.x() >= maxBound.x()) || (maxBound.y() < std::ceil(maxBound.y()) && cellPos.y() >= maxBound.y()))
@@ -125,12 +126,65 @@ namespace MWRender
         return true;
     }
 
+    namespace
+    {
+        void fillRefIndex(PagedRefIndex& refIndex, const MWWorld::GroundcoverStore& store, float density)
+        {
+            const auto start = std::chrono::steady_clock::now();
+            std::vector<std::pair<int, int>> cells;
+            store.listCells(cells);
+            std::vector<ESM::ESMReader> esm;
+            for (const auto& [cellX, cellY] : cells)
+            {
+                ESM::Cell cell;
+                store.initCell(cell, cellX, cellY);
+                if (cell.mContextList.empty()) continue;
+
+                // The density filter only depends on the order of references in a cell, so it is applied once here
+                // rather than for each chunk.
+                DensityCalculator calculator(density);
+                std::map<ESM::RefNum, ESM::CellRef> refs;
+                for (size_t i=0; i<cell.mContextList.size(); ++i)
+                {
+                    unsigned int index = cell.mContextList[i].index;
+                    if (esm.size() <= index)
+                        esm.resize(index+1);
+                    cell.restore(esm[index], i);
+                    ESM::CellRef ref;
+                    ref.mRefNum.unset();
+                    bool deleted = false;
+                    while(cell.getNextRef(esm[index], ref, deleted))
+                    {
+                        if (!deleted && refs.find(ref.mRefNum) == refs.end() && !calculator.isInstanceEnabled()) deleted = true;
+
+                        if (deleted) { refs.erase(ref.mRefNum); continue; }
+                        refs[ref.mRefNum] = std::move(ref);
+                    }
+                }
+
+                refIndex.addCell(cellX, cellY);
+                for (const auto& [refNum, ref] : refs)
+                {
+                    const std::string model = store.getGroundcoverModel(ref.mRefID);
+                    if (!model.empty())
+                        refIndex.addRef(refNum, model, ref.mPos, ref.mScale, ESM::REC_STAT);
+                }
+            }
+            refIndex.finish();
+
+            Log(Debug::Info) << "Groundcover reference index with " << refIndex.size() << " references in "
+                << refIndex.getCellsCount() << " cells filled in "
+                << std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() << " ms";
+        }
+    }
+
     osg::ref_ptr<osg::Node> Groundcover::getChunk(float size, const osg::Vec2f& center, unsigned char lod, unsigned int lodFlags, bool activeGrid, const osg::Vec3f& viewPoint, bool compile)
     {
         if (lod > getMaxLodLevel())
             return nullptr;
         GroundcoverChunkId id = std::make_tuple(center, size);
         osg::ref_ptr<osg::Object> obj = mCache->getRefFromObjectCache(id);
+        countRequest(compile, obj != nullptr);
         if (obj)
             return static_cast<osg::Node*>(obj.get());
         else
@@ -148,7 +202,7 @@ namespace MWRender
          , mSceneManager(sceneManager)
          , mDensity(density)
          , mStateset(new osg::StateSet)
-         , mGroundcoverStore(store)
+         , mStore(store)
     {
          setViewDistance(viewDistance);
          // MGE uses default alpha settings for groundcover, so we can not rely on alpha properties
@@ -173,49 +227,19 @@ namespace MWRender
     {
         if (mDensity <=0.f) return;
 
+        // Filled by the first chunk built, usually by the terrain preloading on a worker thread, so it doesn't delay
+        // the startup
+        std::call_once(mRefIndexFilled, [&] { fillRefIndex(mRefIndex, mStore, mDensity); });
+
         osg::Vec2f minBound = (center - osg::Vec2f(size/2.f, size/2.f));
         osg::Vec2f maxBound = (center + osg::Vec2f(size/2.f, size/2.f));
-        DensityCalculator calculator(mDensity);
-        std::vector<ESM::ESMReader> esm;
         osg::Vec2i startCell = osg::Vec2i(std::floor(center.x() - size/2.f), std::floor(center.y() - size/2.f));
-        for (int cellX = startCell.x(); cellX < startCell.x() + size; ++cellX)
+        osg::Vec2i endCell = startCell + osg::Vec2i(std::ceil(size), std::ceil(size));
+        mRefIndex.forEachInCells(startCell, endCell, [&] (std::size_t ref)
         {
-            for (int cellY = startCell.y(); cellY < startCell.y() + size; ++cellY)
-            {
-                ESM::Cell cell;
-                mGroundcoverStore.initCell(cell, cellX, cellY);
-                if (cell.mContextList.empty()) continue;
-
-                calculator.reset();
-                std::map<ESM::RefNum, ESM::CellRef> refs;
-                for (size_t i=0; i<cell.mContextList.size(); ++i)
-                {
-                    unsigned int index = cell.mContextList[i].index;
-                    if (esm.size() <= index)
-                        esm.resize(index+1);
-                    cell.restore(esm[index], i);
-                    ESM::CellRef ref;
-                    ref.mRefNum.unset();
-                    bool deleted = false;
-                    while(cell.getNextRef(esm[index], ref, deleted))
-                    {
-                        if (!deleted && refs.find(ref.mRefNum) == refs.end() && !calculator.isInstanceEnabled()) deleted = true;
-                        if (!deleted && !isInChunkBorders(ref, minBound, maxBound)) deleted = true;
-
-                        if (deleted) { refs.erase(ref.mRefNum); continue; }
-                        refs[ref.mRefNum] = std::move(ref);
-                    }
-                }
-
-                for (auto& pair : refs)
-                {
-                    ESM::CellRef& ref = pair.second;
-                    const std::string& model = mGroundcoverStore.getGroundcoverModel(ref.mRefID);
-                    if (!model.empty())
-                        instances[model].emplace_back(std::move(ref));
-                }
-            }
-        }
+            if (isInChunkBorders(mRefIndex.getPosition(ref), minBound, maxBound))
+                instances[mRefIndex.getModel(ref)].emplace_back(mRefIndex.getPos(ref), mRefIndex.getScale(ref));
+        });
     }
 
     osg::ref_ptr<osg::Node> Groundcover::createChunk(InstanceMap& instances, const osg::Vec2f& center)
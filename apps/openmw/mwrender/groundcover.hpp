@@ -5,6 +5,10 @@
 #include <components/resource/scenemanager.hpp>
 #include <components/esm/loadcell.hpp>
 
+#include <mutex>
+
+#include "pagedrefindex.hpp"
+
 namespace MWWorld
 {
     class ESMStore;
@@ -35,7 +39,7 @@ namespace MWRender
             ESM::Position mPos;
             float mScale;
 
-            GroundcoverEntry(const ESM::CellRef& ref) : mPos(ref.mPos), mScale(ref.mScale)
+            GroundcoverEntry(const ESM::Position& pos, float scale) : mPos(pos), mScale(scale)
             {}
         };
 
@@ -44,7 +48,9 @@ namespace MWRender
         float mDensity;
         osg::ref_ptr<osg::StateSet> mStateset;
         osg::ref_ptr<osg::Program> mProgramTemplate;
-        const MWWorld::GroundcoverStore& mGroundcoverStore;
+        const MWWorld::GroundcoverStore& mStore;
+        std::once_flag mRefIndexFilled;
+        PagedRefIndex mRefIndex;
 
         typedef std::map<std::string, std::vector<GroundcoverEntry>> InstanceMap;
         osg::ref_ptr<osg::Node> createChunk(InstanceMap& instances, const osg::Vec2f& center);
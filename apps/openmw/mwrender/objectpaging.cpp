@@ -1,5 +1,7 @@
 #include "objectpaging.hpp"
 
+#include <array>
+#include <chrono>
 #include <unordered_map>
 
 #include <osg/Version>
@@ -7,8 +9,11 @@
 #include <osg/Switch>
 #include <osg/MatrixTransform>
 #include <osg/Material>
+#include <osg/Program>
+#include <osg/VertexAttribDivisor>
 #include <osgUtil/IncrementalCompileOperation>
 
+#include <components/debug/debuglog.hpp>
 #include <components/esm/esmreader.hpp>
 #include <components/misc/resourcehelpers.hpp>
 #include <components/resource/scenemanager.hpp>
@@ -25,11 +30,10 @@
 #include <components/sceneutil/morphgeometry.hpp>
 #include <components/sceneutil/riggeometry.hpp>
 #include <components/settings/settings.hpp>
+#include <components/shader/shadermanager.hpp>
 #include <components/misc/rng.hpp>
 
 #include "apps/openmw/mwworld/esmstore.hpp"
-#include "apps/openmw/mwbase/environment.hpp"
-#include "apps/openmw/mwbase/world.hpp"
 
 #include "vismask.hpp"
 
@@ -77,6 +81,7 @@ namespace MWRender
         ChunkId id = std::make_tuple(center, size, activeGrid);
 
         osg::ref_ptr<osg::Object> obj = mCache->getRefFromObjectCache(id);
+        countRequest(compile, obj != nullptr);
         if (obj)
             return static_cast<osg::Node*>(obj.get());
         else
@@ -266,6 +271,17 @@ namespace MWRender
         std::set<ESM::RefNum> mRefnums;
     };
 
+    // Instancing statistics of a chunk, summed over the cached chunks when reporting statistics
+    class InstancingStats : public osg::Object
+    {
+    public:
+        InstancingStats(){}
+        InstancingStats(const InstancingStats& copy, const osg::CopyOp&) : mInstancedObjects(copy.mInstancedObjects), mSavedMemory(copy.mSavedMemory) {}
+        META_Object(MWRender, InstancingStats)
+        std::size_t mInstancedObjects = 0;
+        std::int64_t mSavedMemory = 0;  // bytes of vertex data that merging would have copied
+    };
+
     class AnalyzeVisitor : public osg::NodeVisitor
     {
     public:
@@ -379,36 +395,143 @@ namespace MWRender
         }
     };
 
-    ObjectPaging::ObjectPaging(Resource::SceneManager* sceneManager)
-            : GenericResourceManager<ChunkId>(nullptr)
-         , mSceneManager(sceneManager)
-         , mRefTrackerLocked(false)
+    // Objects that can't be instanced keep their per-instance state in callbacks or in special drawables.
+    class CanInstanceVisitor : public osg::NodeVisitor
     {
-        mActiveGrid = Settings::Manager::getBool("object paging active grid", "Terrain");
-        mDebugBatches = Settings::Manager::getBool("debug chunks", "Terrain");
-        mMergeFactor = Settings::Manager::getFloat("object paging merge factor", "Terrain");
-        mMinSize = Settings::Manager::getFloat("object paging min size", "Terrain");
-        mMinSizeMergeFactor = Settings::Manager::getFloat("object paging min size merge factor", "Terrain");
-        mMinSizeCostMultiplier = Settings::Manager::getFloat("object paging min size cost multiplier", "Terrain");
-    }
+    public:
+        CanInstanceVisitor() : osg::NodeVisitor(TRAVERSE_ALL_CHILDREN) {}
 
-    osg::ref_ptr<osg::Node> ObjectPaging::createChunk(float size, const osg::Vec2f& center, bool activeGrid, const osg::Vec3f& viewPoint, bool compile)
+        void apply(osg::Node& node) override
+        {
+            if (node.getCullCallback() || node.getUpdateCallback())
+                mCanInstance = false;
+            else
+                traverse(node);
+        }
+        void apply(osg::Drawable& drawable) override
+        {
+            if (drawable.getCullCallback() || drawable.getUpdateCallback() || drawable.getDrawCallback())
+                mCanInstance = false;
+        }
+        void apply(osg::Geometry& geom) override
+        {
+            if (geom.getCullCallback() || geom.getUpdateCallback() || geom.getDrawCallback() || !geom.getVertexArray())
+                mCanInstance = false;
+            else
+            {
+                // The per-instance transform may alias the texture coordinates of these units
+                const unsigned int firstAliasedUnit = Shader::ShaderManager::sInstanceTransformAttribLocation - 8;
+                for (unsigned int unit = firstAliasedUnit; unit < firstAliasedUnit + 3; ++unit)
+                    if (geom.getTexCoordArray(unit))
+                        mCanInstance = false;
+                ++mNumGeometries;
+            }
+        }
+
+        bool mCanInstance = true;
+        unsigned int mNumGeometries = 0;
+    };
+
+    // Per-instance transforms are passed to the vertex shader as columns of a 3x4 matrix in three consecutive vertex attributes
+    // starting at Shader::ShaderManager::sInstanceTransformAttribLocation.
+    // The transforms are relative to the coordinate system of each geometry, so transforms inside the mesh don't need to be flattened.
+    class ObjectInstancingVisitor : public osg::NodeVisitor
     {
-        osg::Vec2i startCell = osg::Vec2i(std::floor(center.x() - size/2.f), std::floor(center.y() - size/2.f));
+    public:
+        ObjectInstancingVisitor(const std::vector<osg::Matrixf>& instances)
+            : osg::NodeVisitor(TRAVERSE_ALL_CHILDREN)
+            , mInstances(instances)
+        {
+        }
 
-        osg::Vec3f worldCenter = osg::Vec3f(center.x(), center.y(), 0)*ESM::Land::REAL_SIZE;
-        osg::Vec3f relativeViewPoint = viewPoint - worldCenter;
+        void apply(osg::Geometry& geom) override
+        {
+            const osg::Matrixf local = osg::computeLocalToWorld(getNodePath());
+            const osg::Matrixf localInverse = osg::Matrixf::inverse(local);
+            const osg::BoundingBox geomBox = geom.getBoundingBox();
+
+            std::array<osg::ref_ptr<osg::Vec4Array>, 3> columns;
+            for (auto& column : columns)
+                column = new osg::Vec4Array(mInstances.size());
+            osg::BoundingBox box;
+            for (std::size_t i = 0; i < mInstances.size(); ++i)
+            {
+                const osg::Matrixf transform = local * mInstances[i] * localInverse;
+                for (int j = 0; j < 3; ++j)
+                    (*columns[j])[i] = osg::Vec4f(transform(0, j), transform(1, j), transform(2, j), transform(3, j));
+                for (unsigned int corner = 0; corner < 8; ++corner)
+                    box.expandBy(geomBox.corner(corner) * transform);
+            }
+            geom.setInitialBound(box);
+
+            for (unsigned int i = 0; i < geom.getNumPrimitiveSets(); ++i)
+                geom.getPrimitiveSet(i)->setNumInstances(mInstances.size());
+
+            // Display lists do not support instancing in OSG 3.4
+            geom.setUseDisplayList(false);
+            geom.setUseVertexBufferObjects(true);
+
+            for (int j = 0; j < 3; ++j)
+            {
+                geom.setVertexAttribArray(Shader::ShaderManager::sInstanceTransformAttribLocation + j, columns[j].get(), osg::Array::BIND_PER_VERTEX);
+                mInstanceDataSize += columns[j]->getTotalDataSize();
+            }
+
+            for (const osg::Array* array : {geom.getVertexArray(), geom.getNormalArray(), geom.getColorArray(), geom.getSecondaryColorArray()})
+                if (array)
+                    mVertexDataSize += array->getTotalDataSize();
+            for (unsigned int unit = 0; unit < geom.getNumTexCoordArrays(); ++unit)
+                if (const osg::Array* array = geom.getTexCoordArray(unit))
+                    mVertexDataSize += array->getTotalDataSize();
+        }
+
+        std::size_t mVertexDataSize = 0;
+        std::size_t mInstanceDataSize = 0;
+
+    private:
+        const std::vector<osg::Matrixf>& mInstances;
+    };
+
+    namespace
+    {
+        // The record that is the last to pass the type filter wins, so near and far chunks may draw different
+        // records for the same reference. Records are numbered to tell whether both merges ended on the same one.
+        using MergedRefs = std::map<ESM::RefNum, std::pair<std::size_t, ESM::CellRef>>;
+
+        void mergeRef(MergedRefs& refs, bool far, int type, bool deleted, std::size_t record, const ESM::CellRef& ref)
+        {
+            if (!typeFilter(type, far))
+                return;
+            if (deleted)
+                refs.erase(ref.mRefNum);
+            else
+                refs[ref.mRefNum] = std::make_pair(record, ref);
+        }
 
-        std::map<ESM::RefNum, ESM::CellRef> refs;
-        std::vector<ESM::ESMReader> esm;
-        const MWWorld::ESMStore& store = MWBase::Environment::get().getWorld()->getStore();
+        void addRefs(PagedRefIndex& refIndex, const MergedRefs& refs, std::uint8_t flags, const MWWorld::ESMStore& store)
+        {
+            for (const auto& [refNum, record] : refs)
+            {
+                const ESM::CellRef& ref = record.second;
+                if (Misc::ResourceHelpers::isHiddenMarker(ref.mRefID))
+                    continue;
+                int type = store.findStatic(ref.mRefID);
+                std::string model = getModel(type, ref.mRefID, store);
+                if (model.empty()) continue;
+                refIndex.addRef(refNum, "meshes/" + model, ref.mPos, ref.mScale, type, flags);
+            }
+        }
 
-        for (int cellX = startCell.x(); cellX < startCell.x() + size; ++cellX)
+        void fillRefIndex(PagedRefIndex& refIndex, const MWWorld::ESMStore& store)
         {
-            for (int cellY = startCell.y(); cellY < startCell.y() + size; ++cellY)
+            const auto start = std::chrono::steady_clock::now();
+            std::vector<ESM::ESMReader> esm;
+            std::size_t record = 0;
+            const MWWorld::Store<ESM::Cell>& cells = store.get<ESM::Cell>();
+            for (auto cell = cells.extBegin(); cell != cells.extEnd(); ++cell)
             {
-                const ESM::Cell* cell = store.get<ESM::Cell>().searchStatic(cellX, cellY);
-                if (!cell) continue;
+                MergedRefs nearRefs;
+                MergedRefs farRefs;
                 for (size_t i=0; i<cell->mContextList.size(); ++i)
                 {
                     try
@@ -430,9 +553,9 @@ namespace MWRender
 
                             if (std::find(cell->mMovedRefs.begin(), cell->mMovedRefs.end(), ref.mRefNum) != cell->mMovedRefs.end()) continue;
                             int type = store.findStatic(ref.mRefID);
-                            if (!typeFilter(type,size>=2)) continue;
-                            if (deleted) { refs.erase(ref.mRefNum); continue; }
-                            refs[ref.mRefNum] = std::move(ref);
+                            mergeRef(nearRefs, false, type, deleted, record, ref);
+                            mergeRef(farRefs, true, type, deleted, record, ref);
+                            ++record;
                         }
                     }
                     catch (std::exception&)
@@ -442,26 +565,145 @@ namespace MWRender
                 }
                 for (auto [ref, deleted] : cell->mLeasedRefs)
                 {
-                    if (deleted) { refs.erase(ref.mRefNum); continue; }
+                    if (deleted)
+                    {
+                        nearRefs.erase(ref.mRefNum);
+                        farRefs.erase(ref.mRefNum);
+                        continue;
+                    }
                     int type = store.findStatic(ref.mRefID);
-                    if (!typeFilter(type,size>=2)) continue;
-                    refs[ref.mRefNum] = std::move(ref);
+                    mergeRef(nearRefs, false, type, false, record, ref);
+                    mergeRef(farRefs, true, type, false, record, ref);
+                    ++record;
                 }
+
+                // Far chunks draw the same record as near chunks unless a later content file overrides the
+                // reference with a record only drawn in near chunks.
+                MergedRefs sharedRefs;
+                for (auto it = nearRefs.begin(); it != nearRefs.end();)
+                {
+                    const auto far = farRefs.find(it->first);
+                    if (far != farRefs.end() && far->second.first == it->second.first)
+                    {
+                        farRefs.erase(far);
+                        sharedRefs.insert(sharedRefs.end(), std::move(*it));
+                        it = nearRefs.erase(it);
+                    }
+                    else
+                        ++it;
+                }
+
+                refIndex.addCell(cell->getGridX(), cell->getGridY());
+                addRefs(refIndex, sharedRefs, PagedRefIndex::Flag_Near | PagedRefIndex::Flag_Far, store);
+                addRefs(refIndex, nearRefs, PagedRefIndex::Flag_Near, store);
+                addRefs(refIndex, farRefs, PagedRefIndex::Flag_Far, store);
             }
+            refIndex.finish();
+
+            Log(Debug::Info) << "Object paging reference index with " << refIndex.size() << " references in "
+                << refIndex.getCellsCount() << " cells filled in "
+                << std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() << " ms";
         }
+    }
 
-        if (activeGrid)
+    ObjectPaging::ObjectPaging(Resource::SceneManager* sceneManager, const MWWorld::ESMStore& store)
+            : GenericResourceManager<ChunkId>(nullptr)
+         , mSceneManager(sceneManager)
+         , mStore(store)
+         , mRefTrackerLocked(false)
+    {
+        mActiveGrid = Settings::Manager::getBool("object paging active grid", "Terrain");
+        mDebugBatches = Settings::Manager::getBool("debug chunks", "Terrain");
+        mMergeFactor = Settings::Manager::getFloat("object paging merge factor", "Terrain");
+        mMinSize = Settings::Manager::getFloat("object paging min size", "Terrain");
+        mMinSizeMergeFactor = Settings::Manager::getFloat("object paging min size merge factor", "Terrain");
+        mMinSizeCostMultiplier = Settings::Manager::getFloat("object paging min size cost multiplier", "Terrain");
+        mInstancing = Settings::Manager::getBool("object paging instancing", "Terrain");
+        mInstancingThreshold = static_cast<std::size_t>(std::max(2, Settings::Manager::getInt("object paging instancing threshold", "Terrain")));
+
+        if (mInstancing)
         {
-            std::lock_guard<std::mutex> lock(mRefTrackerMutex);
-            for (auto ref : getRefTracker().mBlacklist)
-                refs.erase(ref);
+            const osg::Program* programTemplate = mSceneManager->getShaderManager().getProgramTemplate();
+            mInstancingProgramTemplate = programTemplate ? Shader::ShaderManager::cloneProgram(programTemplate) : osg::ref_ptr<osg::Program>(new osg::Program);
+            mInstancingStateSet = new osg::StateSet;
+            for (unsigned int j = 0; j < 3; ++j)
+            {
+                const unsigned int location = Shader::ShaderManager::sInstanceTransformAttribLocation + j;
+                mInstancingProgramTemplate->addBindAttribLocation("aInstanceTransform" + std::to_string(j), location);
+                mInstancingStateSet->setAttribute(new osg::VertexAttribDivisor(location, 1));
+            }
+            // Used by the shadow casting shader, which is shared by all objects
+            mInstancingStateSet->addUniform(new osg::Uniform("useInstancing", true));
+        }
+    }
+
+    ObjectPaging::~ObjectPaging()
+    {
+    }
+
+    osg::ref_ptr<osg::Node> ObjectPaging::createInstancedNode(const osg::Node* node, const std::vector<std::size_t>& instances,
+        const osg::Vec3f& worldCenter, float sqrDistance, osg::Node::NodeMask copyMask, bool merge, InstancingStats& stats)
+    {
+        CopyOp copyop;
+        copyop.mCopyMask = copyMask;
+        copyop.setCopyFlags(osg::CopyOp::DEEP_COPY_NODES|osg::CopyOp::DEEP_COPY_DRAWABLES);
+        // Billboards depend on the position of each instance
+        copyop.mOptimizeBillboards = false;
+        copyop.mSqrDistance = sqrDistance;
+        osg::ref_ptr<osg::Group> root = new osg::Group;
+        copyop.copy(node, root);
+
+        CanInstanceVisitor canInstanceVisitor;
+        root->accept(canInstanceVisitor);
+        if (!canInstanceVisitor.mCanInstance || canInstanceVisitor.mNumGeometries == 0)
+            return nullptr;
+
+        std::vector<osg::Matrixf> transforms;
+        transforms.reserve(instances.size());
+        for (std::size_t ref : instances)
+        {
+            const osg::Vec3f& rot = mRefIndex.getRotation(ref);
+            const float scale = mRefIndex.getScale(ref);
+            osg::Matrixf matrix;
+            matrix.preMultTranslate(mRefIndex.getPosition(ref) - worldCenter);
+            matrix.preMultRotate(osg::Quat(rot[2], osg::Vec3f(0,0,-1)) * osg::Quat(rot[1], osg::Vec3f(0,-1,0)) * osg::Quat(rot[0], osg::Vec3f(-1,0,0)));
+            matrix.preMultScale(osg::Vec3f(scale, scale, scale));
+            transforms.push_back(matrix);
         }
 
+        ObjectInstancingVisitor instancingVisitor(transforms);
+        root->accept(instancingVisitor);
+
+        root->setStateSet(mInstancingStateSet);
+        root->setDataVariance(osg::Object::STATIC);
+        mSceneManager->recreateShaders(root, "objects", true, mInstancingProgramTemplate, true);
+        mSceneManager->shareState(root);
+
+        stats.mInstancedObjects += instances.size();
+        // Unlike merging, drawing copies of a node without merging them shares the vertex data with the template.
+        const std::size_t copiedVertexData = merge ? instances.size() * instancingVisitor.mVertexDataSize : 0;
+        stats.mSavedMemory += static_cast<std::int64_t>(copiedVertexData) - static_cast<std::int64_t>(instancingVisitor.mInstanceDataSize);
+
+        return root;
+    }
+
+    osg::ref_ptr<osg::Node> ObjectPaging::createChunk(float size, const osg::Vec2f& center, bool activeGrid, const osg::Vec3f& viewPoint, bool compile)
+    {
+        // Filled by the first chunk built, usually by the terrain preloading on a worker thread, so it doesn't delay
+        // the startup
+        std::call_once(mRefIndexFilled, [&] { fillRefIndex(mRefIndex, mStore); });
+
+        const auto buildStart = std::chrono::steady_clock::now();
+        osg::Vec2i startCell = osg::Vec2i(std::floor(center.x() - size/2.f), std::floor(center.y() - size/2.f));
+
+        osg::Vec3f worldCenter = osg::Vec3f(center.x(), center.y(), 0)*ESM::Land::REAL_SIZE;
+        osg::Vec3f relativeViewPoint = viewPoint - worldCenter;
+
         osg::Vec2f minBound = (center - osg::Vec2f(size/2.f, size/2.f));
         osg::Vec2f maxBound = (center + osg::Vec2f(size/2.f, size/2.f));
         struct InstanceList
         {
-            std::vector<const ESM::CellRef*> mInstances;
+            std::vector<std::size_t> mInstances;
             AnalyzeVisitor::Result mAnalyzeResult;
             bool mNeedCompile = false;
         };
@@ -480,35 +722,39 @@ namespace MWRender
         float minSize = mMinSize;
         if (mMinSizeMergeFactor)
             minSize *= mMinSizeMergeFactor;
-        for (const auto& pair : refs)
+        const osg::Vec2i endCell = startCell + osg::Vec2i(std::ceil(size), std::ceil(size));
+        mRefIndex.forEachInCells(startCell, endCell, [&] (std::size_t ref)
         {
-            const ESM::CellRef& ref = pair.second;
+            const ESM::RefNum& refNum = mRefIndex.getRefNum(ref);
+            const int type = mRefIndex.getType(ref);
+            if (!(mRefIndex.getFlags(ref) & (size>=2 ? PagedRefIndex::Flag_Far : PagedRefIndex::Flag_Near)))
+                return;
+            if (activeGrid)
+            {
+                std::lock_guard<std::mutex> lock(mRefTrackerMutex);
+                if (getRefTracker().mBlacklist.count(refNum))
+                    return;
+            }
 
-            osg::Vec3f pos = ref.mPos.asVec3();
+            const osg::Vec3f& pos = mRefIndex.getPosition(ref);
             if (size < 1.f)
             {
                 osg::Vec3f cellPos = pos / ESM::Land::REAL_SIZE;
                 if ((minBound.x() > std::floor(minBound.x()) && cellPos.x() < minBound.x()) || (minBound.y() > std::floor(minBound.y()) && cellPos.y() < minBound.y())
                  || (maxBound.x() < std::ceil(maxBound.x()) && cellPos.x() >= maxBound.x()) || (maxBound.y() < std::ceil(maxBound.y()) && cellPos.y() >= maxBound.y()))
-                    continue;
+                    return;
             }
 
             float dSqr = (viewPoint - pos).length2();
             if (!activeGrid)
             {
                 std::lock_guard<std::mutex> lock(mSizeCacheMutex);
-                SizeCache::iterator found = mSizeCache.find(pair.first);
+                SizeCache::iterator found = mSizeCache.find(refNum);
                 if (found != mSizeCache.end() && found->second < dSqr*minSize*minSize)
-                    continue;
+                    return;
             }
 
-            if (Misc::ResourceHelpers::isHiddenMarker(ref.mRefID))
-                continue;
-
-            int type = store.findStatic(ref.mRefID);
-            std::string model = getModel(type, ref.mRefID, store);
-            if (model.empty()) continue;
-            model = "meshes/" + model;
+            std::string model = mRefIndex.getModel(ref);
 
             if (activeGrid && type != ESM::REC_STAT)
             {
@@ -518,7 +764,7 @@ namespace MWRender
                 {
                     kfname.replace(kfname.size()-4, 4, ".kf");
                     if (mSceneManager->getVFS()->exists(kfname))
-                        continue;
+                        return;
                 }
             }
 
@@ -527,23 +773,24 @@ namespace MWRender
             if (activeGrid)
             {
                 if (cnode->getNumChildrenRequiringUpdateTraversal() > 0 || SceneUtil::hasUserDescription(cnode, Constants::NightDayLabel) || SceneUtil::hasUserDescription(cnode, Constants::HerbalismLabel))
-                    continue;
+                    return;
                 else
-                    refnumSet->mRefnums.insert(pair.first);
+                    refnumSet->mRefnums.insert(refNum);
             }
 
             {
                 std::lock_guard<std::mutex> lock(mRefTrackerMutex);
-                if (getRefTracker().mDisabled.count(pair.first))
-                    continue;
+                if (getRefTracker().mDisabled.count(refNum))
+                    return;
             }
 
-            float radius2 = cnode->getBound().radius2() * ref.mScale*ref.mScale;
+            const float scale = mRefIndex.getScale(ref);
+            float radius2 = cnode->getBound().radius2() * scale*scale;
             if (radius2 < dSqr*minSize*minSize && !activeGrid)
             {
                 std::lock_guard<std::mutex> lock(mSizeCacheMutex);
-                mSizeCache[pair.first] = radius2;
-                continue;
+                mSizeCache[refNum] = radius2;
+                return;
             }
 
             auto emplaced = nodes.emplace(cnode, InstanceList());
@@ -555,12 +802,13 @@ namespace MWRender
             }
             else
                 analyzeVisitor.addInstance(emplaced.first->second.mAnalyzeResult);
-            emplaced.first->second.mInstances.push_back(&ref);
-        }
+            emplaced.first->second.mInstances.push_back(ref);
+        });
 
         osg::ref_ptr<osg::Group> group = new osg::Group;
         osg::ref_ptr<osg::Group> mergeGroup = new osg::Group;
         osg::ref_ptr<Resource::TemplateMultiRef> templateRefs = new Resource::TemplateMultiRef;
+        osg::ref_ptr<InstancingStats> instancingStats = new InstancingStats;
         osgUtil::StateToCompile stateToCompile(0, nullptr);
         CopyOp copyop;
         copyop.mCopyMask = copyMask;
@@ -580,20 +828,57 @@ namespace MWRender
             if (minSizeMergeFactor2 > 0)
                 minSizeMerged *= minSizeMergeFactor2;
 
+            auto isTooSmall = [&] (std::size_t ref)
+            {
+                const float scale = mRefIndex.getScale(ref);
+                return !activeGrid && minSizeMerged != minSize
+                    && cnode->getBound().radius2() * scale*scale < (viewPoint-mRefIndex.getPosition(ref)).length2()*minSizeMerged*minSizeMerged;
+            };
+
+            // Instanced nodes can't be marked with ref nums, so the active grid is never instanced
+            if (mInstancing && !activeGrid && pair.second.mInstances.size() >= mInstancingThreshold)
+            {
+                std::vector<std::size_t> instances;
+                instances.reserve(pair.second.mInstances.size());
+                for (std::size_t ref : pair.second.mInstances)
+                    if (!isTooSmall(ref))
+                        instances.push_back(ref);
+                osg::ref_ptr<osg::Node> instanced;
+                if (instances.size() >= mInstancingThreshold)
+                    instanced = createInstancedNode(cnode, instances, worldCenter, analyzeVisitor.mCurrentDistance, copyMask, merge, *instancingStats);
+                if (instanced)
+                {
+                    if (mDebugBatches)
+                    {
+                        DebugVisitor dv;
+                        instanced->accept(dv);
+                    }
+                    group->addChild(instanced);
+                    templateRefs->addRef(cnode);
+                    if (compile)
+                    {
+                        stateToCompile._mode = osgUtil::GLObjectsVisitor::COMPILE_STATE_ATTRIBUTES|osgUtil::GLObjectsVisitor::COMPILE_DISPLAY_LISTS;
+                        instanced->accept(stateToCompile);
+                    }
+                    continue;
+                }
+            }
+
             unsigned int numinstances = 0;
-            for (auto cref : pair.second.mInstances)
+            for (std::size_t ref : pair.second.mInstances)
             {
-                const ESM::CellRef& ref = *cref;
-                osg::Vec3f pos = ref.mPos.asVec3();
+                const osg::Vec3f& pos = mRefIndex.getPosition(ref);
+                const osg::Vec3f& rot = mRefIndex.getRotation(ref);
+                const float scale = mRefIndex.getScale(ref);
 
-                if (!activeGrid && minSizeMerged != minSize && cnode->getBound().radius2() * cref->mScale*cref->mScale < (viewPoint-pos).length2()*minSizeMerged*minSizeMerged)
+                if (isTooSmall(ref))
                     continue;
 
                 osg::Vec3f nodePos = pos - worldCenter;
-                osg::Quat nodeAttitude = osg::Quat(ref.mPos.rot[2], osg::Vec3f(0,0,-1)) *
-                                        osg::Quat(ref.mPos.rot[1], osg::Vec3f(0,-1,0)) *
-                                        osg::Quat(ref.mPos.rot[0], osg::Vec3f(-1,0,0));
-                osg::Vec3f nodeScale = osg::Vec3f(ref.mScale, ref.mScale, ref.mScale);
+                osg::Quat nodeAttitude = osg::Quat(rot[2], osg::Vec3f(0,0,-1)) *
+                                        osg::Quat(rot[1], osg::Vec3f(0,-1,0)) *
+                                        osg::Quat(rot[0], osg::Vec3f(-1,0,0));
+                osg::Vec3f nodeScale = osg::Vec3f(scale, scale, scale);
 
                 osg::ref_ptr<osg::Group> trans;
                 if (merge)
@@ -631,12 +916,12 @@ namespace MWRender
                 {
                     if (merge)
                     {
-                        AddRefnumMarkerVisitor visitor(ref.mRefNum);
+                        AddRefnumMarkerVisitor visitor(mRefIndex.getRefNum(ref));
                         trans->accept(visitor);
                     }
                     else
                     {
-                        osg::ref_ptr<RefnumMarker> marker = new RefnumMarker; marker->mRefnum = ref.mRefNum;
+                        osg::ref_ptr<RefnumMarker> marker = new RefnumMarker; marker->mRefnum = mRefIndex.getRefNum(ref);
                         trans->getOrCreateUserDataContainer()->addUserObject(marker);
                     }
                 }
@@ -670,6 +955,7 @@ namespace MWRender
                 optimizer.setViewPoint(relativeViewPoint);
                 optimizer.setMergeAlphaBlending(true);
             }
+            optimizer.setWorkQueue(mSceneManager->getWorkQueue());
             optimizer.setIsOperationPermissibleForObjectCallback(new CanOptimizeCallback);
             unsigned int options = SceneUtil::Optimizer::FLATTEN_STATIC_TRANSFORMS|SceneUtil::Optimizer::REMOVE_REDUNDANT_NODES|SceneUtil::Optimizer::MERGE_GEOMETRY;
 
@@ -706,6 +992,10 @@ namespace MWRender
             group->addCullCallback(new SceneUtil::LightListCallback);
         }
         udc->addUserObject(templateRefs);
+        if (instancingStats->mInstancedObjects > 0)
+            udc->addUserObject(instancingStats);
+
+        mBuildTime += std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - buildStart).count();
 
         return group;
     }
@@ -839,9 +1129,35 @@ namespace MWRender
         mCache->call(grf);
     }
 
+    struct InstancingStatsFunctor
+    {
+        void operator()(MWRender::ChunkId id, osg::Object* obj)
+        {
+            const osg::UserDataContainer* udc = obj->getUserDataContainer();
+            if (!udc)
+                return;
+            for (unsigned int i = 0; i < udc->getNumUserObjects(); ++i)
+                if (const InstancingStats* stats = dynamic_cast<const InstancingStats*>(udc->getUserObject(i)))
+                {
+                    mInstancedObjects += stats->mInstancedObjects;
+                    mSavedMemory += stats->mSavedMemory;
+                }
+        }
+        std::size_t mInstancedObjects = 0;
+        std::int64_t mSavedMemory = 0;
+    };
+
     void ObjectPaging::reportStats(unsigned int frameNumber, osg::Stats *stats) const
     {
         stats->setAttribute(frameNumber, "Object Chunk", mCache->getCacheSize());
+        stats->setAttribute(frameNumber, "Object Chunk BuildTime", mBuildTime.exchange(0) / 1000.0);
+        if (mInstancing)
+        {
+            InstancingStatsFunctor isf;
+            mCache->call(isf);
+            stats->setAttribute(frameNumber, "Object Chunk Instances", isf.mInstancedObjects);
+            stats->setAttribute(frameNumber, "Object Chunk SavedMemory", isf.mSavedMemory / 1024.0);
+        }
     }
 
 }
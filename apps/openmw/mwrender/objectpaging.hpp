@@ -5,8 +5,16 @@
 #include <components/resource/resourcemanager.hpp>
 #include <components/esm/loadcell.hpp>
 
+#include <atomic>
+#include <cstdint>
 #include <mutex>
 
+#include "pagedrefindex.hpp"
+
+namespace osg
+{
+    class Program;
+}
 namespace Resource
 {
     class SceneManager;
@@ -21,11 +29,13 @@ namespace MWRender
 
     typedef std::tuple<osg::Vec2f, float, bool> ChunkId; // Center, Size, ActiveGrid
 
+    class InstancingStats;
+
     class ObjectPaging : public Resource::GenericResourceManager<ChunkId>, public Terrain::QuadTreeWorld::ChunkManager
     {
     public:
-        ObjectPaging(Resource::SceneManager* sceneManager);
-        ~ObjectPaging() = default;
+        ObjectPaging(Resource::SceneManager* sceneManager, const MWWorld::ESMStore& store);
+        ~ObjectPaging();
 
         osg::ref_ptr<osg::Node> getChunk(float size, const osg::Vec2f& center, unsigned char lod, unsigned int lodFlags, bool activeGrid, const osg::Vec3f& viewPoint, bool compile) override;
 
@@ -45,18 +55,34 @@ namespace MWRender
         /// @return true if view needs rebuild
         bool unlockCache();
 
+        /// Reports the time spent building chunks since the previous call and resets it, so it's meant to be called
+        /// once per frame. Instancing statistics are summed over the chunks currently in the cache.
         void reportStats(unsigned int frameNumber, osg::Stats* stats) const override;
 
         void getPagedRefnums(const osg::Vec4i &activeGrid, std::set<ESM::RefNum> &out);
 
     private:
+        /// @return nullptr if the node can't be drawn with instancing
+        osg::ref_ptr<osg::Node> createInstancedNode(const osg::Node* node, const std::vector<std::size_t>& instances,
+            const osg::Vec3f& worldCenter, float sqrDistance, osg::Node::NodeMask copyMask, bool merge, InstancingStats& stats);
+
         Resource::SceneManager* mSceneManager;
+        const MWWorld::ESMStore& mStore;
+        std::once_flag mRefIndexFilled;
+        PagedRefIndex mRefIndex;
         bool mActiveGrid;
         bool mDebugBatches;
         float mMergeFactor;
         float mMinSize;
         float mMinSizeMergeFactor;
         float mMinSizeCostMultiplier;
+        bool mInstancing;
+        std::size_t mInstancingThreshold;
+        osg::ref_ptr<osg::Program> mInstancingProgramTemplate;
+        osg::ref_ptr<osg::StateSet> mInstancingStateSet;
+
+        // Chunks are built by worker threads, the build time is reported and reset by the main thread in reportStats.
+        mutable std::atomic<std::uint64_t> mBuildTime {0};  // microseconds
 
         std::mutex mRefTrackerMutex;
         struct RefTracker
@@ -0,0 +1,75 @@
+#include "pagedrefindex.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <tuple>
+#include <utility>
+
+namespace MWRender
+{
+
+    void PagedRefIndex::addCell(int x, int y)
+    {
+        const auto size = static_cast<std::uint32_t>(mRefNums.size());
+        if (!mCells.empty())
+            mCells.back().mEnd = size;
+        mCells.push_back(Cell {x, y, size, size});
+    }
+
+    void PagedRefIndex::addRef(const ESM::RefNum& refNum, const std::string& model, const ESM::Position& pos, float scale, int type,
+                               std::uint8_t flags)
+    {
+        assert(!mCells.empty());
+        const auto modelId = mModelIds.emplace(model, static_cast<std::uint32_t>(mModels.size()));
+        if (modelId.second)
+            mModels.push_back(model);
+        mRefNums.push_back(refNum);
+        mModelIndices.push_back(modelId.first->second);
+        mPositions.push_back(pos.asVec3());
+        mRotations.emplace_back(pos.rot[0], pos.rot[1], pos.rot[2]);
+        mScales.push_back(scale);
+        mTypes.push_back(type);
+        mFlags.push_back(flags);
+    }
+
+    void PagedRefIndex::finish()
+    {
+        if (!mCells.empty())
+            mCells.back().mEnd = static_cast<std::uint32_t>(mRefNums.size());
+        mCells.erase(std::remove_if(mCells.begin(), mCells.end(), [] (const Cell& cell) { return cell.mBegin == cell.mEnd; }),
+                     mCells.end());
+        std::sort(mCells.begin(), mCells.end(),
+                  [] (const Cell& l, const Cell& r) { return std::tie(l.mX, l.mY) < std::tie(r.mX, r.mY); });
+        assert(std::adjacent_find(mCells.begin(), mCells.end(),
+                   [] (const Cell& l, const Cell& r) { return l.mX == r.mX && l.mY == r.mY; }) == mCells.end());
+
+        mCells.shrink_to_fit();
+        mRefNums.shrink_to_fit();
+        mModelIndices.shrink_to_fit();
+        mPositions.shrink_to_fit();
+        mRotations.shrink_to_fit();
+        mScales.shrink_to_fit();
+        mTypes.shrink_to_fit();
+        mFlags.shrink_to_fit();
+        mModels.shrink_to_fit();
+        mModelIds.clear();
+    }
+
+    ESM::Position PagedRefIndex::getPos(std::size_t ref) const
+    {
+        ESM::Position pos;
+        for (int i = 0; i < 3; ++i)
+        {
+            pos.pos[i] = mPositions[ref][i];
+            pos.rot[i] = mRotations[ref][i];
+        }
+        return pos;
+    }
+
+    std::vector<PagedRefIndex::Cell>::const_iterator PagedRefIndex::findCell(int x, int y) const
+    {
+        return std::lower_bound(mCells.begin(), mCells.end(), std::make_pair(x, y),
+                                [] (const Cell& cell, const std::pair<int, int>& key) { return std::make_pair(cell.mX, cell.mY) < key; });
+    }
+
+}
@@ -0,0 +1,95 @@
+#ifndef OPENMW_MWRENDER_PAGEDREFINDEX_H
+#define OPENMW_MWRENDER_PAGEDREFINDEX_H
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <osg/Vec2i>
+#include <osg/Vec3f>
+
+#include <components/esm/cellref.hpp>
+
+namespace MWRender
+{
+
+    /// @brief Compact index of the references that content files place in exterior cells.
+    /// References are stored as a structure of arrays and grouped by cell, so building a chunk only touches the
+    /// references of the cells it covers and doesn't need to parse the content files again.
+    /// A reference number may be added twice with different flags, when content files override a reference with a
+    /// record that is only drawn in near chunks.
+    /// @note The index is filled once before it's first used; afterwards it is immutable and can be read from any
+    /// thread.
+    class PagedRefIndex
+    {
+    public:
+        /// Chunks drawing a reference
+        enum Flags : std::uint8_t
+        {
+            Flag_Near = 1,
+            Flag_Far = 2,
+        };
+
+        /// References of a cell should be added right after the cell; cells can be added in any order.
+        void addCell(int x, int y);
+        void addRef(const ESM::RefNum& refNum, const std::string& model, const ESM::Position& pos, float scale, int type,
+                    std::uint8_t flags = Flag_Near | Flag_Far);
+
+        /// Must be called after all references are added.
+        void finish();
+
+        std::size_t size() const { return mRefNums.size(); }
+        std::size_t getCellsCount() const { return mCells.size(); }
+
+        const ESM::RefNum& getRefNum(std::size_t ref) const { return mRefNums[ref]; }
+        std::uint32_t getModelIndex(std::size_t ref) const { return mModelIndices[ref]; }
+        const std::string& getModel(std::size_t ref) const { return mModels[mModelIndices[ref]]; }
+        const osg::Vec3f& getPosition(std::size_t ref) const { return mPositions[ref]; }
+        const osg::Vec3f& getRotation(std::size_t ref) const { return mRotations[ref]; }
+        float getScale(std::size_t ref) const { return mScales[ref]; }
+        int getType(std::size_t ref) const { return mTypes[ref]; }
+        std::uint8_t getFlags(std::size_t ref) const { return mFlags[ref]; }
+        ESM::Position getPos(std::size_t ref) const;
+
+        /// Calls `function(ref)` for every reference placed in the cells in range [begin, end).
+        template <class Function>
+        void forEachInCells(const osg::Vec2i& begin, const osg::Vec2i& end, Function&& function) const
+        {
+            for (int x = begin.x(); x < end.x(); ++x)
+            {
+                // Cells are sorted by (x, y), so a column of cells is a contiguous range.
+                for (auto cell = findCell(x, begin.y()); cell != mCells.end() && cell->mX == x && cell->mY < end.y(); ++cell)
+                {
+                    for (std::uint32_t ref = cell->mBegin; ref < cell->mEnd; ++ref)
+                        function(static_cast<std::size_t>(ref));
+                }
+            }
+        }
+
+    private:
+        struct Cell
+        {
+            int mX;
+            int mY;
+            std::uint32_t mBegin;
+            std::uint32_t mEnd;
+        };
+
+        std::vector<Cell>::const_iterator findCell(int x, int y) const;
+
+        std::vector<Cell> mCells;
+        std::vector<ESM::RefNum> mRefNums;
+        std::vector<std::uint32_t> mModelIndices;
+        std::vector<osg::Vec3f> mPositions;
+        std::vector<osg::Vec3f> mRotations;
+        std::vector<float> mScales;
+        std::vector<int> mTypes;
+        std::vector<std::uint8_t> mFlags;
+        std::vector<std::string> mModels;
+        std::map<std::string, std::uint32_t> mModelIds;  // used only while filling
+    };
+
+}
+
+#endif
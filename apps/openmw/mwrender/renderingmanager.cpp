@@ -267,6 +267,8 @@ namespace MWRender
         {
         }
 
+        const char* getProfileName() const override { return "PreloadCommonAssetsWorkItem"; }
+
         void doWork() override
         {
             try
@@ -294,7 +296,8 @@ namespace MWRender
 
     RenderingManager::RenderingManager(osgViewer::Viewer* viewer, osg::ref_ptr<osg::Group> rootNode,
                                        Resource::ResourceSystem* resourceSystem, SceneUtil::WorkQueue* workQueue,
-                                       const std::string& resourcePath, DetourNavigator::Navigator& navigator, const MWWorld::GroundcoverStore& groundcoverStore)
+                                       const std::string& resourcePath, DetourNavigator::Navigator& navigator, const MWWorld::ESMStore& store,
+                                       const MWWorld::GroundcoverStore& groundcoverStore)
         : mViewer(viewer)
         , mRootNode(rootNode)
         , mResourceSystem(resourceSystem)
@@ -429,7 +432,7 @@ namespace MWRender
                 compMapResolution, compMapLevel, lodFactor, vertexLodMod, maxCompGeometrySize, debugChunks));
             if (Settings::Manager::getBool("object paging", "Terrain"))
             {
-                mObjectPaging.reset(new ObjectPaging(mResourceSystem->getSceneManager()));
+                mObjectPaging.reset(new ObjectPaging(mResourceSystem->getSceneManager(), store));
                 static_cast<Terrain::QuadTreeWorld*>(mTerrain.get())->addChunkManager(mObjectPaging.get());
                 mResourceSystem->addResourceManager(mObjectPaging.get());
             }
@@ -69,6 +69,7 @@ namespace DetourNavigator
 
 namespace MWWorld
 {
+    class ESMStore;
     class GroundcoverStore;
 }
 
@@ -99,7 +100,8 @@ namespace MWRender
     public:
         RenderingManager(osgViewer::Viewer* viewer, osg::ref_ptr<osg::Group> rootNode,
                          Resource::ResourceSystem* resourceSystem, SceneUtil::WorkQueue* workQueue,
-                         const std::string& resourcePath, DetourNavigator::Navigator& navigator, const MWWorld::GroundcoverStore& groundcoverStore);
+                         const std::string& resourcePath, DetourNavigator::Navigator& navigator, const MWWorld::ESMStore& store,
+                         const MWWorld::GroundcoverStore& groundcoverStore);
         ~RenderingManager();
 
         osgUtil::IncrementalCompileOperation* getIncrementalCompileOperation();
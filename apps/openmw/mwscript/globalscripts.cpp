@@ -5,6 +5,7 @@
 #include <components/esm/esmwriter.hpp>
 #include <components/esm/globalscript.hpp>
 
+#include "../mwworld/cellstore.hpp"
 #include "../mwworld/class.hpp"
 #include "../mwworld/esmstore.hpp"
 
@@ -122,6 +123,10 @@ namespace MWScript
     {
         MWWorld::Ptr ptr = boost::apply_visitor(PtrResolvingVisitor(), mTarget);
         mTarget = ptr;
+        // The script may modify its target without looking it up again, even after the target's cell became
+        // inactive. Flag the cell as changed so the modification is included in incremental saved games.
+        if (!ptr.isEmpty() && ptr.isInCell())
+            ptr.getCell()->setChangedState(true);
         return ptr;
     }
 
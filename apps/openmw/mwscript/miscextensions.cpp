@@ -8,6 +8,7 @@
 #include <components/compiler/locals.hpp>
 
 #include <components/debug/debuglog.hpp>
+#include <components/debug/frameprofiler.hpp>
 
 #include <components/interpreter/interpreter.hpp>
 #include <components/interpreter/runtime.hpp>
@@ -1614,6 +1615,46 @@ namespace MWScript
                 }
         };
 
+        class OpLuaMemory : public Interpreter::Opcode0
+        {
+            public:
+
+                void execute (Interpreter::Runtime& runtime) override
+                {
+                    runtime.getContext().report(MWBase::Environment::get().getLuaManager()->getMemoryUsageDescription());
+                }
+        };
+
+        class OpToggleLuaProfiler : public Interpreter::Opcode0
+        {
+            public:
+
+                void execute (Interpreter::Runtime& runtime) override
+                {
+                    runtime.getContext().report(MWBase::Environment::get().getLuaManager()->toggleProfiler());
+                }
+        };
+
+        class OpLuaProfile : public Interpreter::Opcode0
+        {
+            public:
+
+                void execute (Interpreter::Runtime& runtime) override
+                {
+                    runtime.getContext().report(MWBase::Environment::get().getLuaManager()->getProfilerReport());
+                }
+        };
+
+        class OpToggleFrameProfiler : public Interpreter::Opcode0
+        {
+            public:
+
+                void execute (Interpreter::Runtime& runtime) override
+                {
+                    runtime.getContext().report(Debug::FrameProfiler::toggle());
+                }
+        };
+
         void installOpcodes (Interpreter::Interpreter& interpreter)
         {
             interpreter.installSegment5 (Compiler::Misc::opcodeMenuMode, new OpMenuMode);
@@ -1735,6 +1776,10 @@ namespace MWScript
             interpreter.installSegment5 (Compiler::Misc::opcodeToggleRecastMesh, new OpToggleRecastMesh);
             interpreter.installSegment5 (Compiler::Misc::opcodeHelp, new OpHelp);
             interpreter.installSegment5 (Compiler::Misc::opcodeReloadLua, new OpReloadLua);
+            interpreter.installSegment5 (Compiler::Misc::opcodeLuaMemory, new OpLuaMemory);
+            interpreter.installSegment5 (Compiler::Misc::opcodeToggleLuaProfiler, new OpToggleLuaProfiler);
+            interpreter.installSegment5 (Compiler::Misc::opcodeLuaProfile, new OpLuaProfile);
+            interpreter.installSegment5 (Compiler::Misc::opcodeToggleFrameProfiler, new OpToggleFrameProfiler);
         }
     }
 }
@@ -13,8 +13,6 @@
 
 #include <components/debug/debuglog.hpp>
 #include <components/misc/constants.hpp>
-#include <components/misc/resourcehelpers.hpp>
-#include <components/vfs/manager.hpp>
 
 #include "openal_output.hpp"
 #include "sound_decoder.hpp"
@@ -944,42 +942,31 @@ void OpenAL_Output::setHrtf(const std::string &hrtfname, HrtfMode hrtfmode)
 }
 
 
-std::pair<Sound_Handle,size_t> OpenAL_Output::loadSound(const std::string &fname)
+std::pair<Sound_Handle,size_t> OpenAL_Output::loadSound(const DecodedSound &sound)
 {
     getALError();
 
-    std::vector<char> data;
+    const char *data = sound.mData.data();
+    std::size_t dataSize = sound.mData.size();
+    int srate = sound.mSampleRate;
     ALenum format = AL_NONE;
-    int srate = 0;
+    if(dataSize > 0)
+        format = getALFormat(sound.mChannelConfig, sound.mSampleType);
 
-    try
-    {
-        DecoderPtr decoder = mManager.getDecoder();
-        decoder->open(Misc::ResourceHelpers::correctSoundPath(fname, decoder->mResourceMgr));
-
-        ChannelConfig chans;
-        SampleType type;
-        decoder->getInfo(&srate, &chans, &type);
-        format = getALFormat(chans, type);
-        if(format) decoder->readAll(data);
-    }
-    catch(std::exception &e)
-    {
-        Log(Debug::Error) << "Failed to load audio from " << fname << ": " << e.what();
-    }
-
-    if(data.empty())
+    static const std::vector<char> silence(8000, -128);
+    if(!format)
     {
         // If we failed to get any usable audio, substitute with silence.
         format = AL_FORMAT_MONO8;
         srate = 8000;
-        data.assign(8000, -128);
+        data = silence.data();
+        dataSize = silence.size();
     }
 
     ALint size;
     ALuint buf = 0;
     alGenBuffers(1, &buf);
-    alBufferData(buf, format, data.data(), data.size(), srate);
+    alBufferData(buf, format, data, dataSize, srate);
     alGetBufferi(buf, AL_SIZE, &size);
     if(getALError() != AL_NO_ERROR)
     {
@@ -1233,6 +1220,11 @@ void OpenAL_Output::updateSound(Sound *sound)
     getALError();
 }
 
+size_t OpenAL_Output::getSourceCount()
+{
+    return mFreeSources.size() + mActiveSounds.size() + mActiveStreams.size();
+}
+
 
 bool OpenAL_Output::streamSound(DecoderPtr decoder, Stream *sound, bool getLoudnessData)
 {
@@ -66,7 +66,7 @@ namespace MWSound
         std::vector<std::string> enumerateHrtf() override;
         void setHrtf(const std::string &hrtfname, HrtfMode hrtfmode) override;
 
-        std::pair<Sound_Handle,size_t> loadSound(const std::string &fname) override;
+        std::pair<Sound_Handle,size_t> loadSound(const DecodedSound &sound) override;
         size_t unloadSound(Sound_Handle data) override;
 
         bool playSound(Sound *sound, Sound_Handle data, float offset) override;
@@ -75,6 +75,8 @@ namespace MWSound
         bool isSoundPlaying(Sound *sound) override;
         void updateSound(Sound *sound) override;
 
+        size_t getSourceCount() override;
+
         bool streamSound(DecoderPtr decoder, Stream *sound, bool getLoudnessData=false) override;
         bool streamSound3D(DecoderPtr decoder, Stream *sound, bool getLoudnessData) override;
         void finishStream(Stream *sound) override;
@@ -4,7 +4,12 @@
 #include "../mwbase/world.hpp"
 #include "../mwworld/esmstore.hpp"
 
+#include "sound_decoder.hpp"
+#include "soundmanagerimp.hpp"
+
 #include <components/debug/debuglog.hpp>
+#include <components/misc/resourcehelpers.hpp>
+#include <components/sceneutil/workqueue.hpp>
 #include <components/settings/settings.hpp>
 #include <components/vfs/manager.hpp>
 
@@ -35,11 +40,45 @@ namespace MWSound
         }
     }
 
+    class DecodeSoundWorkItem : public SceneUtil::WorkItem
+    {
+        public:
+            DecodeSoundWorkItem(DecoderPtr decoder, const std::string& resourceName)
+                : mDecoder(std::move(decoder)), mResourceName(resourceName)
+            {}
+
+            const char* getProfileName() const override { return "DecodeSoundWorkItem"; }
+
+            void doWork() override
+            {
+                try
+                {
+                    mDecoder->open(Misc::ResourceHelpers::correctSoundPath(mResourceName, mDecoder->mResourceMgr));
+                    mDecoder->getInfo(&mSound.mSampleRate, &mSound.mChannelConfig, &mSound.mSampleType);
+                    mDecoder->readAll(mSound.mData);
+                }
+                catch (const std::exception& e)
+                {
+                    Log(Debug::Error) << "Failed to load audio from " << mResourceName << ": " << e.what();
+                    mSound.mData.clear();
+                }
+                mDecoder.reset();
+            }
+
+            const DecodedSound& getSound() const { return mSound; }
+
+        private:
+            DecoderPtr mDecoder;
+            std::string mResourceName;
+            DecodedSound mSound;
+    };
+
     SoundBufferPool::SoundBufferPool(const VFS::Manager& vfs, Sound_Output& output) :
         mVfs(&vfs),
         mOutput(&output),
         mBufferCacheMax(std::max(Settings::Manager::getInt("buffer cache max", "Sound"), 1) * 1024 * 1024),
-        mBufferCacheMin(std::min(static_cast<std::size_t>(std::max(Settings::Manager::getInt("buffer cache min", "Sound"), 1)) * 1024 * 1024, mBufferCacheMax))
+        mBufferCacheMin(std::min(static_cast<std::size_t>(std::max(Settings::Manager::getInt("buffer cache min", "Sound"), 1)) * 1024 * 1024, mBufferCacheMax)),
+        mWorkQueue(new SceneUtil::WorkQueue(1))
     {
     }
 
@@ -54,13 +93,13 @@ namespace MWSound
         if (it != mBufferNameMap.end())
         {
             Sound_Buffer* sfx = it->second;
-            if (sfx->getHandle() != nullptr)
+            if (sfx->getHandle() != nullptr || isDecoding(*sfx))
                 return sfx;
         }
         return nullptr;
     }
 
-    Sound_Buffer* SoundBufferPool::load(const std::string& soundId)
+    Sound_Buffer* SoundBufferPool::request(const std::string& soundId)
     {
         if (mBufferNameMap.empty())
         {
@@ -80,29 +119,82 @@ namespace MWSound
             sfx = insertSound(soundId, *sound);
         }
 
-        if (sfx->getHandle() == nullptr)
+        if (sfx->getHandle() == nullptr && !isDecoding(*sfx))
         {
-            auto [handle, size] = mOutput->loadSound(sfx->getResourceName());
-            if (handle == nullptr)
-                return {};
+            osg::ref_ptr<DecodeSoundWorkItem> item(new DecodeSoundWorkItem(mOutput->mManager.getDecoder(), sfx->getResourceName()));
+            mWorkQueue->addWorkItem(item);
+            mDecodingBuffers.emplace(sfx, std::move(item));
+        }
+
+        return sfx;
+    }
+
+    void SoundBufferPool::prefetch(const std::vector<std::string>& soundIds)
+    {
+        for (const std::string& soundId : soundIds)
+            request(Misc::StringUtils::lowerCase(soundId));
+    }
 
-            sfx->mHandle = handle;
+    bool SoundBufferPool::waitFor(Sound_Buffer& sfx, std::chrono::steady_clock::duration timeout)
+    {
+        const auto it = mDecodingBuffers.find(&sfx);
+        if (it != mDecodingBuffers.end())
+        {
+            if (!it->second->waitTillDone(timeout))
+                return false;
+            const osg::ref_ptr<DecodeSoundWorkItem> item = std::move(it->second);
+            mDecodingBuffers.erase(it);
+            upload(sfx, *item);
+        }
+        return sfx.getHandle() != nullptr;
+    }
 
-            mBufferCacheSize += size;
-            if (mBufferCacheSize > mBufferCacheMax)
+    void SoundBufferPool::update()
+    {
+        for (auto it = mDecodingBuffers.begin(); it != mDecodingBuffers.end();)
+        {
+            if (!it->second->isDone())
             {
-                unloadUnused();
-                if (!mUnusedBuffers.empty() && mBufferCacheSize > mBufferCacheMax)
-                    Log(Debug::Warning) << "No unused sound buffers to free, using " << mBufferCacheSize << " bytes!";
+                ++it;
+                continue;
             }
-            mUnusedBuffers.push_front(sfx);
+            Sound_Buffer& sfx = *const_cast<Sound_Buffer*>(it->first);
+            const osg::ref_ptr<DecodeSoundWorkItem> item = std::move(it->second);
+            it = mDecodingBuffers.erase(it);
+            upload(sfx, *item);
         }
+    }
 
-        return sfx;
+    void SoundBufferPool::upload(Sound_Buffer& sfx, const DecodeSoundWorkItem& item)
+    {
+        auto [handle, size] = mOutput->loadSound(item.getSound());
+        if (handle == nullptr)
+            return;
+
+        sfx.mHandle = handle;
+
+        const DecodedSound& sound = item.getSound();
+        if (sound.mData.empty() || sound.mSampleRate <= 0)
+            sfx.mDuration = 1; // The output substitutes one second of silence
+        else
+            sfx.mDuration = bytesToFrames(sound.mData.size(), sound.mChannelConfig, sound.mSampleType)
+                / static_cast<float>(sound.mSampleRate);
+
+        mBufferCacheSize += size;
+        if (mBufferCacheSize > mBufferCacheMax)
+        {
+            unloadUnused();
+            if (!mUnusedBuffers.empty() && mBufferCacheSize > mBufferCacheMax)
+                Log(Debug::Warning) << "No unused sound buffers to free, using " << mBufferCacheSize << " bytes!";
+        }
+        if (sfx.mUses == 0)
+            mUnusedBuffers.push_front(&sfx);
     }
 
     void SoundBufferPool::clear()
     {
+        // Decoding results are dropped, the work items finish on their own
+        mDecodingBuffers.clear();
         for (auto &sfx : mSoundBuffers)
         {
             if(sfx.mHandle)
@@ -2,9 +2,13 @@
 #define GAME_SOUND_SOUND_BUFFER_H
 
 #include <algorithm>
+#include <chrono>
 #include <string>
 #include <deque>
 #include <unordered_map>
+#include <vector>
+
+#include <osg/ref_ptr>
 
 #include "sound_output.hpp"
 
@@ -18,9 +22,15 @@ namespace VFS
     class Manager;
 }
 
+namespace SceneUtil
+{
+    class WorkQueue;
+}
+
 namespace MWSound
 {
     class SoundBufferPool;
+    class DecodeSoundWorkItem;
 
     class Sound_Buffer
     {
@@ -40,11 +50,15 @@ namespace MWSound
 
             float getMaxDist() const noexcept { return mMaxDist; }
 
+            /// Length of the sound in seconds, known once the sound is decoded.
+            float getDuration() const noexcept { return mDuration; }
+
         private:
             std::string mResourceName;
             float mVolume;
             float mMinDist;
             float mMaxDist;
+            float mDuration = 0;
             Sound_Handle mHandle = nullptr;
             std::size_t mUses = 0;
 
@@ -61,12 +75,28 @@ namespace MWSound
             ~SoundBufferPool();
 
             /// Lookup a soundId for its sound data (resource name, local volume,
-            /// minRange, and maxRange)
+            /// minRange, and maxRange). Returns only buffers that are loaded or being decoded.
             Sound_Buffer* lookup(const std::string& soundId) const;
 
             /// Lookup a soundId for its sound data (resource name, local volume,
-            /// minRange, and maxRange), and ensure it's ready for use.
-            Sound_Buffer* load(const std::string& soundId);
+            /// minRange, and maxRange), and start decoding it in the background
+            /// if it's not loaded yet. Returns nullptr if there is no such sound.
+            Sound_Buffer* request(const std::string& soundId);
+
+            /// Start decoding the given sounds in the background, so they are
+            /// ready to use when they are played for the first time.
+            void prefetch(const std::vector<std::string>& soundIds);
+
+            /// Wait up to the given time for the buffer to be decoded and upload it.
+            /// Returns true if the buffer is ready for use.
+            bool waitFor(Sound_Buffer& sfx, std::chrono::steady_clock::duration timeout);
+
+            /// Returns true if the buffer is still being decoded.
+            bool isDecoding(const Sound_Buffer& sfx) const { return mDecodingBuffers.count(&sfx) != 0; }
+
+            /// Upload the buffers that have finished decoding. Must be called
+            /// regularly from the main thread.
+            void update();
 
             void use(Sound_Buffer& sfx)
             {
@@ -80,7 +110,7 @@ namespace MWSound
 
             void release(Sound_Buffer& sfx)
             {
-                if (--sfx.mUses == 0)
+                if (--sfx.mUses == 0 && sfx.mHandle != nullptr)
                     mUnusedBuffers.push_front(&sfx);
             }
 
@@ -96,9 +126,13 @@ namespace MWSound
             std::size_t mBufferCacheSize = 0;
             // NOTE: unused buffers are stored in front-newest order.
             std::deque<Sound_Buffer*> mUnusedBuffers;
+            osg::ref_ptr<SceneUtil::WorkQueue> mWorkQueue;
+            std::unordered_map<const Sound_Buffer*, osg::ref_ptr<DecodeSoundWorkItem>> mDecodingBuffers;
 
             inline Sound_Buffer* insertSound(const std::string& soundId, const ESM::Sound& sound);
 
+            void upload(Sound_Buffer& sfx, const DecodeSoundWorkItem& item);
+
             inline void unloadUnused();
     };
 }
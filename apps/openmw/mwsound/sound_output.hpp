@@ -11,6 +11,7 @@ namespace MWSound
 {
     class SoundManager;
     struct Sound_Decoder;
+    struct DecodedSound;
     class Sound;
     class Stream;
 
@@ -42,7 +43,7 @@ namespace MWSound
         virtual std::vector<std::string> enumerateHrtf() = 0;
         virtual void setHrtf(const std::string &hrtfname, HrtfMode hrtfmode) = 0;
 
-        virtual std::pair<Sound_Handle,size_t> loadSound(const std::string &fname) = 0;
+        virtual std::pair<Sound_Handle,size_t> loadSound(const DecodedSound &sound) = 0;
         virtual size_t unloadSound(Sound_Handle data) = 0;
 
         virtual bool playSound(Sound *sound, Sound_Handle data, float offset) = 0;
@@ -51,6 +52,9 @@ namespace MWSound
         virtual bool isSoundPlaying(Sound *sound) = 0;
         virtual void updateSound(Sound *sound) = 0;
 
+        /// Total number of sources available to sounds and streams
+        virtual size_t getSourceCount() = 0;
+
         virtual bool streamSound(DecoderPtr decoder, Stream *sound, bool getLoudnessData=false) = 0;
         virtual bool streamSound3D(DecoderPtr decoder, Stream *sound, bool getLoudnessData) = 0;
         virtual void finishStream(Stream *sound) = 0;
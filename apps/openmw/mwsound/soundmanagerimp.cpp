@@ -1,6 +1,7 @@
 #include "soundmanagerimp.hpp"
 
 #include <algorithm>
+#include <cmath>
 #include <map>
 #include <numeric>
 
@@ -88,6 +89,9 @@ namespace MWSound
         , mTimePassed(0.f)
         , mLastCell(nullptr)
         , mCurrentRegionSound(nullptr)
+        , mDecodingDeadline(std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<float, std::milli>(std::max(Settings::Manager::getFloat("decoding deadline", "Sound"), 0.f))))
+        , mDecodingBudget(mDecodingDeadline)
     {
         if(!useSound)
         {
@@ -107,6 +111,10 @@ namespace MWSound
             return;
         }
 
+        // Keep some sources for music and voices, the rest are bound to the most audible sounds
+        const std::size_t sources = mOutput->getSourceCount();
+        mMaxRealVoices = sources - sources / 4;
+
         std::vector<std::string> names = mOutput->enumerate();
         std::stringstream stream;
 
@@ -494,7 +502,7 @@ namespace MWSound
         if(!mOutput->isInitialized())
             return nullptr;
 
-        Sound_Buffer *sfx = mSoundBuffers.load(Misc::StringUtils::lowerCase(soundId));
+        Sound_Buffer *sfx = mSoundBuffers.request(Misc::StringUtils::lowerCase(soundId));
         if(!sfx) return nullptr;
 
         // Only one copy of given sound can be played at time, so stop previous copy
@@ -509,12 +517,9 @@ namespace MWSound
             params.mFlags = mode | type | Play_2D;
             return params;
         } ());
-        if(!mOutput->playSound(sound.get(), sfx->getHandle(), offset))
-            return nullptr;
-
         Sound* result = sound.get();
-        mActiveSounds[MWWorld::ConstPtr()].emplace_back(std::move(sound), sfx);
-        mSoundBuffers.use(*sfx);
+        if(!startSound(MWWorld::ConstPtr(), std::move(sound), *sfx, offset))
+            return nullptr;
         return result;
     }
 
@@ -531,13 +536,12 @@ namespace MWSound
             return nullptr;
 
         // Look up the sound in the ESM data
-        Sound_Buffer *sfx = mSoundBuffers.load(Misc::StringUtils::lowerCase(soundId));
+        Sound_Buffer *sfx = mSoundBuffers.request(Misc::StringUtils::lowerCase(soundId));
         if(!sfx) return nullptr;
 
         // Only one copy of given sound can be played at time on ptr, so stop previous copy
         stopSound(sfx, ptr);
 
-        bool played;
         SoundPtr sound = getSoundRef();
         if(!(mode&PlayMode::NoPlayerLocal) && ptr == MWMechanics::getPlayer())
         {
@@ -549,7 +553,6 @@ namespace MWSound
                 params.mFlags = mode | type | Play_2D;
                 return params;
             } ());
-            played = mOutput->playSound(sound.get(), sfx->getHandle(), offset);
         }
         else
         {
@@ -565,14 +568,10 @@ namespace MWSound
                 params.mFlags = mode | type | Play_3D;
                 return params;
             } ());
-            played = mOutput->playSound3D(sound.get(), sfx->getHandle(), offset);
         }
-        if(!played)
-            return nullptr;
-
         Sound* result = sound.get();
-        mActiveSounds[ptr].emplace_back(std::move(sound), sfx);
-        mSoundBuffers.use(*sfx);
+        if(!startSound(ptr, std::move(sound), *sfx, offset))
+            return nullptr;
         return result;
     }
 
@@ -584,7 +583,7 @@ namespace MWSound
             return nullptr;
 
         // Look up the sound in the ESM data
-        Sound_Buffer *sfx = mSoundBuffers.load(Misc::StringUtils::lowerCase(soundId));
+        Sound_Buffer *sfx = mSoundBuffers.request(Misc::StringUtils::lowerCase(soundId));
         if(!sfx) return nullptr;
 
         const float squaredDist = (mListenerPos - initialPos).length2();
@@ -602,31 +601,180 @@ namespace MWSound
             params.mFlags = mode | type | Play_3D;
             return params;
         } ());
-        if(!mOutput->playSound3D(sound.get(), sfx->getHandle(), offset))
+        Sound* result = sound.get();
+        if(!startSound(MWWorld::ConstPtr(), std::move(sound), *sfx, offset))
             return nullptr;
+        return result;
+    }
 
-        Sound* result = sound.get();
-        mActiveSounds[MWWorld::ConstPtr()].emplace_back(std::move(sound), sfx);
-        mSoundBuffers.use(*sfx);
+    bool SoundManager::startSound(const MWWorld::ConstPtr &ptr, SoundPtr sound, Sound_Buffer &sfx, float offset)
+    {
+        const auto waitStart = std::chrono::steady_clock::now();
+        const bool ready = mSoundBuffers.waitFor(sfx, mDecodingBudget);
+        mDecodingBudget -= std::min(mDecodingBudget, std::chrono::steady_clock::now() - waitStart);
+        if(!ready && !mSoundBuffers.isDecoding(sfx))
+            return false;
+
+        VoiceState voice;
+        voice.mPriority = sound->getIs3D() ? 0 : 1;
+        voice.mAudibility = getAudibility(*sound);
+        voice.mPlayable = ready;
+
+        mActiveSounds.push_back(ActiveSound {ptr, std::move(sound), &sfx, offset, false});
+        mVoices.push_back(voice);
+        mSoundBuffers.use(sfx);
+
+        // Start the sound right away if a source is free, otherwise the next update decides whether it's important
+        // enough to take a source from another sound
+        if(ready && mRealVoices < mMaxRealVoices)
+            realizeVoice(mActiveSounds.size() - 1);
+
+        return true;
+    }
+
+    std::size_t SoundManager::findSound(const Sound *sound) const
+    {
+        const auto it = std::find_if(mActiveSounds.begin(), mActiveSounds.end(),
+                                     [&] (const ActiveSound& active) { return active.mSound.get() == sound; });
+        return static_cast<std::size_t>(it - mActiveSounds.begin());
+    }
+
+    void SoundManager::finishSound(Sound *sound)
+    {
+        const std::size_t index = findSound(sound);
+        if(index < mActiveSounds.size())
+            finishSound(index);
+    }
+
+    void SoundManager::finishSound(std::size_t index)
+    {
+        mActiveSounds[index].mFinished = true;
+        if(mVoices[index].mReal)
+            virtualizeVoice(index);
+    }
+
+    void SoundManager::removeSound(std::size_t index)
+    {
+        ActiveSound& active = mActiveSounds[index];
+        if(mVoices[index].mReal)
+            virtualizeVoice(index);
+        if(active.mSound.get() == mUnderwaterSound)
+            mUnderwaterSound = nullptr;
+        if(active.mSound.get() == mNearWaterSound)
+            mNearWaterSound = nullptr;
+        mSoundBuffers.release(*active.mSfx);
+
+        if(index + 1 != mActiveSounds.size())
+        {
+            active = std::move(mActiveSounds.back());
+            mVoices[index] = mVoices.back();
+        }
+        mActiveSounds.pop_back();
+        mVoices.pop_back();
+    }
+
+    bool SoundManager::isSoundPlaying(Sound *sound) const
+    {
+        const std::size_t index = findSound(sound);
+        return index < mActiveSounds.size() && isSoundPlaying(index);
+    }
+
+    bool SoundManager::isSoundPlaying(std::size_t index) const
+    {
+        const ActiveSound& active = mActiveSounds[index];
+        if(active.mFinished)
+            return false;
+        if(mVoices[index].mReal)
+            return mOutput->isSoundPlaying(active.mSound.get());
+        // A virtual voice waits while its buffer is being decoded, the sound is over if the buffer failed to load
+        if(active.mSfx->getHandle() == nullptr)
+            return mSoundBuffers.isDecoding(*active.mSfx);
+        return active.mSound->getIsLooping() || active.mOffset < active.mSfx->getDuration();
+    }
+
+    bool SoundManager::realizeVoice(std::size_t index)
+    {
+        const ActiveSound& active = mActiveSounds[index];
+        Sound *sound = active.mSound.get();
+        const bool played = sound->getIs3D()
+            ? mOutput->playSound3D(sound, active.mSfx->getHandle(), active.mOffset)
+            : mOutput->playSound(sound, active.mSfx->getHandle(), active.mOffset);
+        if(played)
+        {
+            mVoices[index].mReal = true;
+            ++mRealVoices;
+        }
+        return played;
+    }
+
+    void SoundManager::virtualizeVoice(std::size_t index)
+    {
+        mOutput->finishSound(mActiveSounds[index].mSound.get());
+        mVoices[index].mReal = false;
+        --mRealVoices;
+    }
+
+    void SoundManager::updateVoices(int pausedTypes)
+    {
+        // Paused sounds keep their sources, so they can be resumed
+        std::size_t pausedRealVoices = 0;
+        for(std::size_t i = 0; i < mActiveSounds.size(); ++i)
+        {
+            const bool paused = pausedTypes & static_cast<int>(mActiveSounds[i].mSound->getPlayType());
+            mVoices[i].mPlayable = !paused && mActiveSounds[i].mSfx->getHandle() != nullptr;
+            if(paused && mVoices[i].mReal)
+                ++pausedRealVoices;
+        }
+
+        mVoiceSelector.select(mVoices, mMaxRealVoices - std::min(pausedRealVoices, mMaxRealVoices));
+
+        // Free the sources before binding them to other sounds
+        for(std::size_t i = 0; i < mVoices.size(); ++i)
+        {
+            if(mVoices[i].mReal && mVoices[i].mPlayable && !mVoices[i].mSelected)
+                virtualizeVoice(i);
+        }
+        for(std::size_t i = 0; i < mVoices.size(); ++i)
+        {
+            if(!mVoices[i].mReal && mVoices[i].mSelected)
+                realizeVoice(i);
+        }
+    }
+
+    float SoundManager::getAudibility(const Sound &sound) const
+    {
+        if(!sound.getIs3D())
+            return sound.getRealVolume();
+        const float distance = (sound.getPosition() - mListenerPos).length();
+        return sound.getRealVolume() * getDistanceGain(distance, sound.getMinDistance(), sound.getMaxDistance());
+    }
+
+    int SoundManager::getPausedSoundTypes() const
+    {
+        int result = 0;
+        for(int types : mPausedSoundTypes)
+            result |= types;
         return result;
     }
 
+    void SoundManager::prefetchSounds(const std::vector<std::string>& soundIds)
+    {
+        if(mOutput->isInitialized())
+            mSoundBuffers.prefetch(soundIds);
+    }
+
     void SoundManager::stopSound(Sound *sound)
     {
         if(sound)
-            mOutput->finishSound(sound);
+            finishSound(sound);
     }
 
     void SoundManager::stopSound(Sound_Buffer *sfx, const MWWorld::ConstPtr &ptr)
     {
-        SoundMap::iterator snditer = mActiveSounds.find(ptr);
-        if(snditer != mActiveSounds.end())
+        for(std::size_t i = 0; i < mActiveSounds.size(); ++i)
         {
-            for(SoundBufferRefPair &snd : snditer->second)
-            {
-                if(snd.second == sfx)
-                    mOutput->finishSound(snd.first.get());
-            }
+            if(mActiveSounds[i].mSfx == sfx && mActiveSounds[i].mPtr == ptr)
+                finishSound(i);
         }
     }
 
@@ -643,11 +791,10 @@ namespace MWSound
 
     void SoundManager::stopSound3D(const MWWorld::ConstPtr &ptr)
     {
-        SoundMap::iterator snditer = mActiveSounds.find(ptr);
-        if(snditer != mActiveSounds.end())
+        for(std::size_t i = 0; i < mActiveSounds.size(); ++i)
         {
-            for(SoundBufferRefPair &snd : snditer->second)
-                mOutput->finishSound(snd.first.get());
+            if(mActiveSounds[i].mPtr == ptr)
+                finishSound(i);
         }
         SaySoundMap::iterator sayiter = mSaySoundsQueue.find(ptr);
         if(sayiter != mSaySoundsQueue.end())
@@ -659,13 +806,11 @@ namespace MWSound
 
     void SoundManager::stopSound(const MWWorld::CellStore *cell)
     {
-        for(SoundMap::value_type &snd : mActiveSounds)
+        for(std::size_t i = 0; i < mActiveSounds.size(); ++i)
         {
-            if(!snd.first.isEmpty() && snd.first != MWMechanics::getPlayer() && snd.first.getCell() == cell)
-            {
-                for(SoundBufferRefPair &sndbuf : snd.second)
-                    mOutput->finishSound(sndbuf.first.get());
-            }
+            const MWWorld::ConstPtr& ptr = mActiveSounds[i].mPtr;
+            if(!ptr.isEmpty() && ptr != MWMechanics::getPlayer() && ptr.getCell() == cell)
+                finishSound(i);
         }
 
         for(SaySoundMap::value_type &snd : mSaySoundsQueue)
@@ -684,30 +829,25 @@ namespace MWSound
     void SoundManager::fadeOutSound3D(const MWWorld::ConstPtr &ptr,
             const std::string& soundId, float duration)
     {
-        SoundMap::iterator snditer = mActiveSounds.find(ptr);
-        if(snditer != mActiveSounds.end())
+        Sound_Buffer *sfx = mSoundBuffers.lookup(Misc::StringUtils::lowerCase(soundId));
+        if (sfx == nullptr)
+            return;
+        for(ActiveSound &active : mActiveSounds)
         {
-            Sound_Buffer *sfx = mSoundBuffers.lookup(Misc::StringUtils::lowerCase(soundId));
-            if (sfx == nullptr)
-                return;
-            for(SoundBufferRefPair &sndbuf : snditer->second)
-            {
-                if(sndbuf.second == sfx)
-                    sndbuf.first->setFadeout(duration);
-            }
+            if(active.mSfx == sfx && active.mPtr == ptr)
+                active.mSound->setFadeout(duration);
         }
     }
 
     bool SoundManager::getSoundPlaying(const MWWorld::ConstPtr &ptr, const std::string& soundId) const
     {
-        SoundMap::const_iterator snditer = mActiveSounds.find(ptr);
-        if(snditer != mActiveSounds.end())
+        Sound_Buffer *sfx = mSoundBuffers.lookup(Misc::StringUtils::lowerCase(soundId));
+        if (sfx == nullptr)
+            return false;
+        for(std::size_t i = 0; i < mActiveSounds.size(); ++i)
         {
-            Sound_Buffer *sfx = mSoundBuffers.lookup(Misc::StringUtils::lowerCase(soundId));
-            return std::find_if(snditer->second.cbegin(), snditer->second.cend(),
-                [this,sfx](const SoundBufferRefPair &snd) -> bool
-                { return snd.second == sfx && mOutput->isSoundPlaying(snd.first.get()); }
-            ) != snditer->second.cend();
+            if(mActiveSounds[i].mSfx == sfx && mActiveSounds[i].mPtr == ptr && isSoundPlaying(i))
+                return true;
         }
         return false;
     }
@@ -767,7 +907,7 @@ namespace MWSound
 
         if (!cell->isExterior())
             return;
-        if (mCurrentRegionSound && mOutput->isSoundPlaying(mCurrentRegionSound))
+        if (mCurrentRegionSound && isSoundPlaying(mCurrentRegionSound))
             return;
 
         if (const auto next = mRegionSoundSelector.getNextRandom(duration, cell->mRegion, *world))
@@ -798,7 +938,7 @@ namespace MWSound
                 break;
             case WaterSoundAction::PlaySound:
                 if (mNearWaterSound)
-                    mOutput->finishSound(mNearWaterSound);
+                    finishSound(mNearWaterSound);
                 mNearWaterSound = playSound(update.mId, update.mVolume, 1.0f, Type::Sfx, PlayMode::Loop);
                 break;
         }
@@ -819,17 +959,9 @@ namespace MWSound
             Sound_Buffer* sfx = mSoundBuffers.lookup(update.mId);
             if (mLastCell != cell)
             {
-                const auto snditer = mActiveSounds.find(MWWorld::ConstPtr());
-                if (snditer != mActiveSounds.end())
-                {
-                    const auto pairiter = std::find_if(
-                        snditer->second.begin(), snditer->second.end(),
-                        [this](const SoundBufferRefPairList::value_type &item) -> bool
-                        { return mNearWaterSound == item.first.get(); }
-                    );
-                    if (pairiter != snditer->second.end() && pairiter->second != sfx)
-                        soundIdChanged = true;
-                }
+                const std::size_t index = findSound(mNearWaterSound);
+                if (index < mActiveSounds.size() && mActiveSounds[index].mSfx != sfx)
+                    soundIdChanged = true;
             }
 
             if (soundIdChanged)
@@ -896,7 +1028,7 @@ namespace MWSound
             env = Env_Underwater;
         else if(mUnderwaterSound)
         {
-            mOutput->finishSound(mUnderwaterSound);
+            finishSound(mUnderwaterSound);
             mUnderwaterSound = nullptr;
         }
 
@@ -911,45 +1043,42 @@ namespace MWSound
         updateMusic(duration);
 
         // Check if any sounds are finished playing, and trash them
-        SoundMap::iterator snditer = mActiveSounds.begin();
-        while(snditer != mActiveSounds.end())
+        const int pausedTypes = getPausedSoundTypes();
+        std::size_t index = 0;
+        while(index < mActiveSounds.size())
         {
-            MWWorld::ConstPtr ptr = snditer->first;
-            SoundBufferRefPairList::iterator sndidx = snditer->second.begin();
-            while(sndidx != snditer->second.end())
+            ActiveSound &active = mActiveSounds[index];
+            Sound *sound = active.mSound.get();
+
+            if (sound->getIs3D())
             {
-                Sound *sound = sndidx->first.get();
+                if (!active.mPtr.isEmpty())
+                    sound->setPosition(active.mPtr.getRefData().getPosition().asVec3());
 
-                if (sound->getIs3D())
-                {
-                    if (!ptr.isEmpty())
-                        sound->setPosition(ptr.getRefData().getPosition().asVec3());
+                cull3DSound(sound);
+            }
 
-                    cull3DSound(sound);
-                }
+            // Virtual voices don't play, so their position is advanced here
+            if(active.mSfx->getHandle() != nullptr && !(pausedTypes & static_cast<int>(sound->getPlayType())))
+            {
+                active.mOffset += duration * sound->getPitch();
+                if(sound->getIsLooping() && active.mSfx->getDuration() > 0)
+                    active.mOffset = std::fmod(active.mOffset, active.mSfx->getDuration());
+            }
 
-                if(!sound->updateFade(duration) || !mOutput->isSoundPlaying(sound))
-                {
-                    mOutput->finishSound(sound);
-                    if (sound == mUnderwaterSound)
-                        mUnderwaterSound = nullptr;
-                    if (sound == mNearWaterSound)
-                        mNearWaterSound = nullptr;
-                    mSoundBuffers.release(*sndidx->second);
-                    sndidx = snditer->second.erase(sndidx);
-                }
-                else
-                {
+            if(!sound->updateFade(duration) || !isSoundPlaying(index))
+                removeSound(index);
+            else
+            {
+                if(mVoices[index].mReal)
                     mOutput->updateSound(sound);
-                    ++sndidx;
-                }
+                mVoices[index].mAudibility = getAudibility(*sound);
+                ++index;
             }
-            if(snditer->second.empty())
-                snditer = mActiveSounds.erase(snditer);
-            else
-                ++snditer;
         }
 
+        updateVoices(pausedTypes);
+
         SaySoundMap::iterator sayiter = mActiveSaySounds.begin();
         while(sayiter != mActiveSaySounds.end())
         {
@@ -1025,9 +1154,12 @@ namespace MWSound
 
     void SoundManager::update(float duration)
     {
+        mDecodingBudget = mDecodingDeadline;
+
         if(!mOutput->isInitialized() || mPlaybackPaused)
             return;
 
+        mSoundBuffers.update();
         updateSounds(duration);
         if (MWBase::Environment::get().getStateManager()->getState()!=
             MWBase::StateManager::State_NoGame)
@@ -1045,14 +1177,11 @@ namespace MWSound
         if(!mOutput->isInitialized())
             return;
         mOutput->startUpdate();
-        for(SoundMap::value_type &snd : mActiveSounds)
+        for(ActiveSound &active : mActiveSounds)
         {
-            for(SoundBufferRefPair &sndbuf : snd.second)
-            {
-                Sound *sound = sndbuf.first.get();
-                sound->setBaseVolume(volumeFromType(sound->getPlayType()));
-                mOutput->updateSound(sound);
-            }
+            Sound *sound = active.mSound.get();
+            sound->setBaseVolume(volumeFromType(sound->getPlayType()));
+            mOutput->updateSound(sound);
         }
         for(SaySoundMap::value_type &snd : mActiveSaySounds)
         {
@@ -1092,12 +1221,10 @@ namespace MWSound
 
     void SoundManager::updatePtr(const MWWorld::ConstPtr &old, const MWWorld::ConstPtr &updated)
     {
-        SoundMap::iterator snditer = mActiveSounds.find(old);
-        if(snditer != mActiveSounds.end())
+        for(ActiveSound &active : mActiveSounds)
         {
-            SoundBufferRefPairList sndlist = std::move(snditer->second);
-            mActiveSounds.erase(snditer);
-            mActiveSounds.emplace(updated, std::move(sndlist));
+            if(active.mPtr == old)
+                active.mPtr = updated;
         }
 
         SaySoundMap::iterator sayiter = mSaySoundsQueue.find(old);
@@ -1186,15 +1313,8 @@ namespace MWSound
     {
         SoundManager::stopMusic();
 
-        for(SoundMap::value_type &snd : mActiveSounds)
-        {
-            for(SoundBufferRefPair &sndbuf : snd.second)
-            {
-                mOutput->finishSound(sndbuf.first.get());
-                mSoundBuffers.release(*sndbuf.second);
-            }
-        }
-        mActiveSounds.clear();
+        while(!mActiveSounds.empty())
+            removeSound(mActiveSounds.size() - 1);
         mUnderwaterSound = nullptr;
         mNearWaterSound = nullptr;
 
@@ -1,6 +1,7 @@
 #ifndef GAME_SOUND_SOUNDMANAGER_H
 #define GAME_SOUND_SOUNDMANAGER_H
 
+#include <chrono>
 #include <memory>
 #include <string>
 #include <utility>
@@ -18,6 +19,7 @@
 #include "type.hpp"
 #include "volumesettings.hpp"
 #include "sound_buffer.hpp"
+#include "voiceselector.hpp"
 
 namespace VFS
 {
@@ -62,10 +64,23 @@ namespace MWSound
 
         Misc::ObjectPool<Stream> mStreams;
 
-        typedef std::pair<SoundPtr, Sound_Buffer*> SoundBufferRefPair;
-        typedef std::vector<SoundBufferRefPair> SoundBufferRefPairList;
-        typedef std::map<MWWorld::ConstPtr,SoundBufferRefPairList> SoundMap;
-        SoundMap mActiveSounds;
+        struct ActiveSound
+        {
+            MWWorld::ConstPtr mPtr;
+            SoundPtr mSound;
+            Sound_Buffer* mSfx;
+            // Playback position in seconds, tracked so a virtual voice continues where it would be playing
+            float mOffset;
+            bool mFinished;
+        };
+
+        // Active sounds and their voice states are parallel arrays, the order of the elements is not significant.
+        // Any number of sounds can be active, but only the most important of them are bound to output sources.
+        std::vector<ActiveSound> mActiveSounds;
+        std::vector<VoiceState> mVoices;
+        VoiceSelector mVoiceSelector;
+        std::size_t mRealVoices = 0;
+        std::size_t mMaxRealVoices = 0;
 
         typedef std::map<MWWorld::ConstPtr, StreamPtr> SaySoundMap;
         SaySoundMap mSaySoundsQueue;
@@ -98,6 +113,10 @@ namespace MWSound
 
         Sound* mCurrentRegionSound;
 
+        std::chrono::steady_clock::duration mDecodingDeadline;
+        // Time left in the current frame to wait for sounds to be decoded, shared by all sounds started in the frame
+        std::chrono::steady_clock::duration mDecodingBudget;
+
         Sound_Buffer *insertSound(const std::string &soundId, const ESM::Sound *sound);
 
         // returns a decoder to start streaming, or nullptr if the sound was not found
@@ -112,6 +131,28 @@ namespace MWSound
         void advanceMusic(const std::string& filename);
         void startRandomTitle();
 
+        bool startSound(const MWWorld::ConstPtr &ptr, SoundPtr sound, Sound_Buffer &sfx, float offset);
+        ///< Add the sound to the active sounds. It's bound to an output source right away if its buffer is decoded
+        /// within the decoding time left in the frame and a source is free, otherwise it starts as a virtual voice.
+        /// Returns false if the sound can't be played.
+
+        std::size_t findSound(const Sound *sound) const;
+
+        void finishSound(Sound *sound);
+        void finishSound(std::size_t index);
+        void removeSound(std::size_t index);
+
+        bool isSoundPlaying(Sound *sound) const;
+        bool isSoundPlaying(std::size_t index) const;
+        ///< Virtual voices are considered playing until they reach the end of the sound.
+
+        bool realizeVoice(std::size_t index);
+        void virtualizeVoice(std::size_t index);
+        void updateVoices(int pausedTypes);
+
+        float getAudibility(const Sound &sound) const;
+        int getPausedSoundTypes() const;
+
         void cull3DSound(SoundBase *sound);
 
         void updateSounds(float duration);
@@ -138,6 +179,7 @@ namespace MWSound
     protected:
         DecoderPtr getDecoder();
         friend class OpenAL_Output;
+        friend class SoundBufferPool;
 
         void stopSound(Sound_Buffer *sfx, const MWWorld::ConstPtr &ptr);
         ///< Stop the given object from playing given sound buffer.
@@ -217,6 +259,9 @@ namespace MWSound
         ///< Stop the given sound from playing
         /// @note no-op if \a sound is null
 
+        void prefetchSounds(const std::vector<std::string>& soundIds) override;
+        ///< Start decoding the given sounds in the background
+
         void stopSound3D(const MWWorld::ConstPtr &reference, const std::string& soundId) override;
         ///< Stop the given object from playing the given sound,
 
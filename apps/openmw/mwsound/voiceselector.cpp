@@ -0,0 +1,44 @@
+#include "voiceselector.hpp"
+
+#include <algorithm>
+
+namespace MWSound
+{
+    float getDistanceGain(float distance, float minDistance, float maxDistance)
+    {
+        if (minDistance <= 0)
+            return 1;
+        return minDistance / std::clamp(distance, minDistance, std::max(minDistance, maxDistance));
+    }
+
+    void VoiceSelector::select(std::vector<VoiceState>& voices, std::size_t maxReal)
+    {
+        mCandidates.clear();
+        for (std::size_t i = 0; i < voices.size(); ++i)
+        {
+            voices[i].mSelected = false;
+            if (voices[i].mPlayable)
+                mCandidates.push_back(i);
+        }
+
+        if (mCandidates.size() > maxReal)
+        {
+            const auto getScore = [&] (std::size_t index)
+            {
+                const VoiceState& voice = voices[index];
+                return voice.mReal ? voice.mAudibility * sRealVoiceBonus : voice.mAudibility;
+            };
+            std::nth_element(mCandidates.begin(), mCandidates.begin() + maxReal, mCandidates.end(),
+                [&] (std::size_t l, std::size_t r)
+                {
+                    if (voices[l].mPriority != voices[r].mPriority)
+                        return voices[l].mPriority > voices[r].mPriority;
+                    return getScore(l) > getScore(r);
+                });
+            mCandidates.resize(maxReal);
+        }
+
+        for (std::size_t index : mCandidates)
+            voices[index].mSelected = true;
+    }
+}
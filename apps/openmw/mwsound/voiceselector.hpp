@@ -0,0 +1,40 @@
+#ifndef GAME_SOUND_VOICESELECTOR_H
+#define GAME_SOUND_VOICESELECTOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace MWSound
+{
+    /// State of a logical sound used to decide whether it's bound to an output source (a real voice)
+    /// or only tracked by the sound manager (a virtual voice).
+    struct VoiceState
+    {
+        float mAudibility = 0;
+        std::uint8_t mPriority = 0;
+        bool mPlayable = false;
+        bool mReal = false;
+        bool mSelected = false;
+    };
+
+    /// Gain of a sound at the given distance for the inverse distance clamped model used by the output.
+    float getDistanceGain(float distance, float minDistance, float maxDistance);
+
+    class VoiceSelector
+    {
+        public:
+            /// Real voices are compared using their audibility multiplied by this factor, so voices that are about
+            /// as audible as each other don't swap sources on every update.
+            static constexpr float sRealVoiceBonus = 1.25f;
+
+            /// Sets mSelected for at most maxReal playable voices. Voices with higher priority are selected first,
+            /// voices with the same priority are selected by audibility. Takes linear time.
+            void select(std::vector<VoiceState>& voices, std::size_t maxReal);
+
+        private:
+            std::vector<std::size_t> mCandidates;
+    };
+}
+
+#endif
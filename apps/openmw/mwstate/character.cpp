@@ -1,5 +1,6 @@
 #include "character.hpp"
 
+#include <algorithm>
 #include <cctype>
 #include <sstream>
 
@@ -141,6 +142,8 @@ void MWState::Character::deleteSlot (const Slot *slot)
     boost::filesystem::remove(slot->mPath);
 
     mSlots.erase (mSlots.begin()+index);
+
+    removeUnusedBaseSaves();
 }
 
 const MWState::Slot *MWState::Character::updateSlot (const Slot *slot, const ESM::SavedGame& profile)
@@ -164,6 +167,43 @@ const MWState::Slot *MWState::Character::updateSlot (const Slot *slot, const ESM
     return &mSlots.back();
 }
 
+boost::filesystem::path MWState::Character::createBaseSavePath() const
+{
+    const std::string ext = ".omwbase";
+    boost::filesystem::path path = mPath / ("Base" + ext);
+
+    // Append an index if necessary to ensure a unique file
+    int i=0;
+    while (boost::filesystem::exists(path))
+        path = mPath / ("Base - " + std::to_string(++i) + ext);
+
+    return path;
+}
+
+void MWState::Character::removeUnusedBaseSaves()
+{
+    if (!boost::filesystem::is_directory (mPath))
+        return;
+
+    std::vector<boost::filesystem::path> unused;
+
+    for (boost::filesystem::directory_iterator iter (mPath);
+        iter!=boost::filesystem::directory_iterator(); ++iter)
+    {
+        const boost::filesystem::path& path = iter->path();
+        if (path.extension()!=".omwbase")
+            continue;
+
+        const std::string name = path.filename().string();
+        if (std::none_of(mSlots.begin(), mSlots.end(),
+                [&] (const Slot& slot) { return slot.mProfile.mBaseSave==name; }))
+            unused.push_back(path);
+    }
+
+    for (const boost::filesystem::path& path : unused)
+        boost::filesystem::remove(path);
+}
+
 MWState::Character::SlotIterator MWState::Character::begin() const
 {
     return mSlots.rbegin();
@@ -55,6 +55,12 @@ namespace MWState
             ///
             /// \attention The \a slot pointer will be invalidated by this call.
 
+            boost::filesystem::path createBaseSavePath() const;
+            ///< Return an unused path for a new base saved game.
+
+            void removeUnusedBaseSaves();
+            ///< Delete base saved games that none of the slots depend on.
+
             SlotIterator begin() const;
             ///<  Any call to createSlot and updateSlot can invalidate the returned iterator.
 
@@ -4,6 +4,8 @@
 
 #include <components/esm/esmwriter.hpp>
 #include <components/esm/esmreader.hpp>
+#include <components/esm/compressedsavedgame.hpp>
+#include <components/esm/basesavestate.hpp>
 #include <components/esm/cellid.hpp>
 #include <components/esm/loadcell.hpp>
 
@@ -29,6 +31,7 @@
 #include "../mwbase/inputmanager.hpp"
 #include "../mwbase/luamanager.hpp"
 
+#include "../mwworld/basesave.hpp"
 #include "../mwworld/player.hpp"
 #include "../mwworld/class.hpp"
 #include "../mwworld/cellstore.hpp"
@@ -41,6 +44,35 @@
 
 #include "quicksavemanager.hpp"
 
+namespace
+{
+    void prepareWriter (ESM::ESMWriter& writer)
+    {
+        for (const std::string& contentFile : MWBase::Environment::get().getWorld()->getContentFiles())
+            writer.addMaster(contentFile, 0); // not using the size information anyway -> use value of 0
+
+        writer.setFormat (ESM::SavedGame::sCurrentFormat);
+
+        // all unused
+        writer.setVersion(0);
+        writer.setType(0);
+        writer.setAuthor("");
+        writer.setDescription("");
+    }
+
+    void writeFile (std::istream& stream, const boost::filesystem::path& path)
+    {
+        boost::filesystem::ofstream filestream (path, std::ios::binary);
+        if (Settings::Manager::getBool("compress", "Saves"))
+            ESM::writeCompressedSavedGame(stream, filestream);
+        else
+            filestream << stream.rdbuf();
+
+        if (filestream.fail())
+            throw std::runtime_error("Write operation failed (file stream)");
+    }
+}
+
 void MWState::StateManager::cleanup (bool force)
 {
     if (mState!=State_NoGame || force)
@@ -57,6 +89,8 @@ void MWState::StateManager::cleanup (bool force)
         mState = State_NoGame;
         mCharacterManager.setCurrentCharacter(nullptr);
         mTimePlayed = 0;
+        mBaseSave.clear();
+        mBaseSaveCells = 0;
 
         MWMechanics::CreatureStats::cleanup();
     }
@@ -88,8 +122,81 @@ std::map<int, int> MWState::StateManager::buildContentFileIndexMap (const ESM::E
     return map;
 }
 
+void MWState::StateManager::updateBaseSave (const Character& character)
+{
+    MWBase::World& world = *MWBase::Environment::get().getWorld();
+
+    const float compaction = Settings::Manager::getFloat("incremental compaction", "Saves");
+    if (!mBaseSave.empty() && mBaseSave.parent_path()==character.getPath() && boost::filesystem::exists(mBaseSave)
+            && !MWWorld::needsNewBaseSave(world.countChangedCells(), world.countBaseSaveCells(), compaction))
+        return;
+
+    // Cell states are flagged as unchanged while writing, so the previous base saved game can't be used anymore
+    // even if writing the new one fails.
+    mBaseSave.clear();
+
+    const boost::filesystem::path path = character.createBaseSavePath();
+    const int cellCount = world.countBaseSaveCells();
+
+    Log(Debug::Info) << "Writing base saved game '" << path.filename().string() << "'";
+
+    std::stringstream stream;
+
+    ESM::ESMWriter writer;
+    prepareWriter(writer);
+    writer.setRecordCount (1 + cellCount);
+    writer.save (stream);
+
+    Loading::Listener& listener = *MWBase::Environment::get().getWindowManager()->getLoadingScreen();
+    listener.setProgressRange(cellCount);
+    listener.setLabel("#{sNotifyMessage4}", true);
+
+    Loading::ScopedLoad load(&listener);
+
+    ESM::BaseSaveState baseSave;
+    baseSave.mName = path.filename().string();
+    baseSave.mCellCount = cellCount;
+
+    writer.startRecord (ESM::REC_BASE);
+    baseSave.save (writer);
+    writer.endRecord (ESM::REC_BASE);
+
+    world.writeBaseSave (writer, listener);
+
+    writer.close();
+
+    if (stream.fail())
+        throw std::runtime_error("Write operation failed (memory stream)");
+
+    writeFile(stream, path);
+
+    mBaseSave = path;
+    mBaseSaveCells = cellCount;
+}
+
+void MWState::StateManager::readBaseSave (const ESM::BaseSaveState& baseSave, const std::map<int, int>& contentFileMap)
+{
+    if (mBaseSave.empty() || baseSave.mName != mBaseSave.filename().string())
+        throw std::runtime_error("The cell states of the saved game reference the base saved game " + baseSave.mName
+            + " instead of " + mBaseSave.filename().string() + ".");
+
+    Log(Debug::Info) << "Reading base saved game " << baseSave.mName;
+
+    ESM::ESMReader reader;
+    reader.open (ESM::openSavedGame(mBaseSave.string()), mBaseSave.string());
+
+    // The content files may have changed since the base saved game was written
+    std::map<int, int> baseContentFileMap = buildContentFileIndexMap (reader);
+    MWBase::Environment::get().getLuaManager()->setContentFileMapping(baseContentFileMap);
+
+    MWBase::Environment::get().getWorld()->readBaseSave (reader, baseSave, baseContentFileMap);
+    mBaseSaveCells = baseSave.mCellCount;
+
+    MWBase::Environment::get().getLuaManager()->setContentFileMapping(contentFileMap);
+}
+
 MWState::StateManager::StateManager (const boost::filesystem::path& saves, const std::vector<std::string>& contentFiles)
-: mQuitRequest (false), mAskLoadRecent(false), mState (State_NoGame), mCharacterManager (saves, contentFiles), mTimePlayed (0)
+: mQuitRequest (false), mAskLoadRecent(false), mState (State_NoGame), mCharacterManager (saves, contentFiles), mTimePlayed (0), mBaseSaveCells (0)
 {
 
 }
@@ -222,14 +329,29 @@ void MWState::StateManager::saveGame (const std::string& description, const Slot
         Log(Debug::Info) << "Making a screenshot for saved game '" << description << "'";
         writeScreenshot(profile.mScreenshot);
 
+        // Make sure the animation state held by references is up to date before saving the game.
+        MWBase::Environment::get().getMechanicsManager()->persistAnimationStates();
+
+        if (Settings::Manager::getBool("incremental", "Saves"))
+            updateBaseSave(*character);
+        else
+            mBaseSave.clear();
+
+        ESM::BaseSaveState baseSave;
+        baseSave.mCellCount = 0;
+        if (!mBaseSave.empty())
+        {
+            baseSave.mName = mBaseSave.filename().string();
+            baseSave.mCellCount = mBaseSaveCells;
+        }
+        world.setBaseSave(baseSave);
+        profile.mBaseSave = baseSave.mName;
+
         if (!slot)
             slot = character->createSlot (profile);
         else
             slot = character->updateSlot (slot, profile);
 
-        // Make sure the animation state held by references is up to date before saving the game.
-        MWBase::Environment::get().getMechanicsManager()->persistAnimationStates();
-
         Log(Debug::Info) << "Writing saved game '" << description << "' for character '" << profile.mPlayerName << "'";
 
         // Write to a memory stream first. If there is an exception during the save process, we don't want to trash the
@@ -237,17 +359,7 @@ void MWState::StateManager::saveGame (const std::string& description, const Slot
         std::stringstream stream;
 
         ESM::ESMWriter writer;
-
-        for (const std::string& contentFile : MWBase::Environment::get().getWorld()->getContentFiles())
-            writer.addMaster(contentFile, 0); // not using the size information anyway -> use value of 0
-
-        writer.setFormat (ESM::SavedGame::sCurrentFormat);
-
-        // all unused
-        writer.setVersion(0);
-        writer.setType(0);
-        writer.setAuthor("");
-        writer.setDescription("");
+        prepareWriter(writer);
 
         int recordCount =         1 // saved game header
                 +MWBase::Environment::get().getJournal()->countSavedGameRecords()
@@ -294,11 +406,10 @@ void MWState::StateManager::saveGame (const std::string& description, const Slot
             throw std::runtime_error("Write operation failed (memory stream)");
 
         // All good, write to file
-        boost::filesystem::ofstream filestream (slot->mPath, std::ios::binary);
-        filestream << stream.rdbuf();
+        writeFile(stream, slot->mPath);
 
-        if (filestream.fail())
-            throw std::runtime_error("Write operation failed (file stream)");
+        // The previous base saved game is not needed anymore if no other slot depends on it
+        character->removeUnusedBaseSaves();
 
         Settings::Manager::setString ("character", "Saves",
             slot->mPath.parent_path().filename().string());
@@ -382,7 +493,7 @@ void MWState::StateManager::loadGame (const Character *character, const std::str
         Log(Debug::Info) << "Reading save file " << boost::filesystem::path(filepath).filename().string();
 
         ESM::ESMReader reader;
-        reader.open (filepath);
+        reader.open (ESM::openSavedGame(filepath), filepath);
 
         if (reader.getFormat() > ESM::SavedGame::sCurrentFormat)
             throw std::runtime_error("This save file was created using a newer version of OpenMW and is thus not supported. Please upgrade to the newest OpenMW version to load this file.");
@@ -398,6 +509,7 @@ void MWState::StateManager::loadGame (const Character *character, const std::str
         Loading::ScopedLoad load(&listener);
 
         bool firstPersonCam = false;
+        bool baseSaveRead = false;
 
         size_t total = reader.getFileSize();
         int currentPercent = 0;
@@ -420,6 +532,19 @@ void MWState::StateManager::loadGame (const Character *character, const std::str
                         }
                         mTimePlayed = profile.mTimePlayed;
                         Log(Debug::Info) << "Loading saved game '" << profile.mDescription << "' for character '" << profile.mPlayerName << "'";
+
+                        // The number of cell states in the base saved game is only known once its REC_BASE record
+                        // has been read
+                        ESM::BaseSaveState baseSave;
+                        baseSave.mName = profile.mBaseSave;
+                        baseSave.mCellCount = 0;
+                        MWBase::Environment::get().getWorld()->setBaseSave(baseSave);
+                        if (!profile.mBaseSave.empty())
+                        {
+                            mBaseSave = boost::filesystem::path(filepath).parent_path() / profile.mBaseSave;
+                            if (!boost::filesystem::exists(mBaseSave))
+                                throw std::runtime_error("The base saved game " + profile.mBaseSave + " this saved game depends on is missing.");
+                        }
                     }
                     break;
 
@@ -464,6 +589,15 @@ void MWState::StateManager::loadGame (const Character *character, const std::str
                     reader.getHNT(firstPersonCam, "FIRS");
                     break;
 
+                case ESM::REC_BASE:
+                    {
+                        ESM::BaseSaveState baseSave;
+                        baseSave.load(reader);
+                        readBaseSave(baseSave, contentFileMap);
+                        baseSaveRead = true;
+                    }
+                    break;
+
                 case ESM::REC_GSCR:
 
                     MWBase::Environment::get().getScriptManager()->getGlobalScripts().readRecord (reader, n.toInt(), contentFileMap);
@@ -505,6 +639,10 @@ void MWState::StateManager::loadGame (const Character *character, const std::str
             }
         }
 
+        if (!mBaseSave.empty() && !baseSaveRead)
+            throw std::runtime_error("The saved game does not reference the base saved game "
+                + mBaseSave.filename().string() + " in its cell states.");
+
         mCharacterManager.setCurrentCharacter(character);
 
         mState = State_Running;
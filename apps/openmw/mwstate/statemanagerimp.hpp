@@ -9,6 +9,11 @@
 
 #include "charactermanager.hpp"
 
+namespace ESM
+{
+    struct BaseSaveState;
+}
+
 namespace MWState
 {
     class StateManager : public MWBase::StateManager
@@ -18,6 +23,10 @@ namespace MWState
             State mState;
             CharacterManager mCharacterManager;
             double mTimePlayed;
+            // Base saved game the cell states of the current game are tracked against; empty if there is none
+            boost::filesystem::path mBaseSave;
+            // Number of cell states in the base saved game
+            int mBaseSaveCells;
 
         private:
 
@@ -29,6 +38,13 @@ namespace MWState
 
             std::map<int, int> buildContentFileIndexMap (const ESM::ESMReader& reader) const;
 
+            void updateBaseSave (const Character& character);
+            ///< Write a new base saved game for \a character unless the current one can still be used.
+
+            void readBaseSave (const ESM::BaseSaveState& baseSave, const std::map<int, int>& contentFileMap);
+            ///< \param baseSave REC_BASE record of the saved game referencing the base saved game.
+            /// \param contentFileMap Content file mapping of the saved game referencing the base saved game.
+
         public:
 
             StateManager (const boost::filesystem::path& saves, const std::vector<std::string>& contentFiles);
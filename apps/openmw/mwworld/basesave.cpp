@@ -0,0 +1,59 @@
+#include "basesave.hpp"
+
+#include <stdexcept>
+
+#include <components/esm/basesavestate.hpp>
+#include <components/esm/cellid.hpp>
+#include <components/esm/defs.hpp>
+#include <components/esm/esmreader.hpp>
+
+namespace MWWorld
+{
+    bool isCellStateSaved(bool hasState, bool hasChangedState, bool incremental)
+    {
+        return hasState && (!incremental || hasChangedState);
+    }
+
+    bool needsNewBaseSave(int changedCells, int baseSaveCells, float compaction)
+    {
+        return changedCells >= compaction * baseSaveCells;
+    }
+
+    void readBaseSave(ESM::ESMReader& reader, const ESM::BaseSaveState& referenced,
+        const std::function<void(const ESM::CellId& id)>& readCellState)
+    {
+        if (!reader.hasMoreRecs() || reader.getRecName().toInt() != ESM::REC_BASE)
+            throw std::runtime_error("The base saved game " + referenced.mName + " has no REC_BASE record");
+
+        reader.getRecHeader();
+        ESM::BaseSaveState found;
+        found.load(reader);
+
+        if (found != referenced)
+            throw std::runtime_error("The base saved game " + found.mName + " with " + std::to_string(found.mCellCount)
+                + " cell states does not match the referenced " + referenced.mName + " with "
+                + std::to_string(referenced.mCellCount) + " cell states");
+
+        int cellCount = 0;
+
+        while (reader.hasMoreRecs())
+        {
+            ESM::NAME n = reader.getRecName();
+            reader.getRecHeader();
+
+            if (n.toInt()==ESM::REC_CSTA)
+            {
+                ESM::CellId id;
+                id.load(reader);
+                readCellState(id);
+                ++cellCount;
+            }
+            else
+                reader.skipRecord();
+        }
+
+        if (cellCount != referenced.mCellCount)
+            throw std::runtime_error("The base saved game " + referenced.mName + " contains "
+                + std::to_string(cellCount) + " cell states instead of " + std::to_string(referenced.mCellCount));
+    }
+}
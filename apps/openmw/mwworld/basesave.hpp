@@ -0,0 +1,32 @@
+#ifndef GAME_MWWORLD_BASESAVE_H
+#define GAME_MWWORLD_BASESAVE_H
+
+#include <functional>
+
+namespace ESM
+{
+    class ESMReader;
+    struct BaseSaveState;
+    struct CellId;
+}
+
+namespace MWWorld
+{
+    /// Whether the state of a cell is written to a saved game. Incremental saved games only include the cells whose
+    /// state changed since the base saved game was written or read.
+    bool isCellStateSaved(bool hasState, bool hasChangedState, bool incremental);
+
+    /// Whether a new base saved game has to be written instead of referencing the current one. This is the case once
+    /// the number of changed cells reaches the given fraction of the cells included in a base saved game, so a
+    /// compaction of 0 writes a new base saved game with every save.
+    bool needsNewBaseSave(int changedCells, int baseSaveCells, float compaction);
+
+    /// Read the cell states of a base saved game. Throws if the REC_BASE record at its start does not match the one
+    /// of the saved game referencing it, or if it does not contain as many cell states as that record says.
+    /// \param readCellState Called for each REC_CSTA record after reading its cell id. Has to read or skip the rest
+    /// of the record.
+    void readBaseSave(ESM::ESMReader& reader, const ESM::BaseSaveState& referenced,
+        const std::function<void(const ESM::CellId& id)>& readCellState);
+}
+
+#endif
@@ -0,0 +1,52 @@
+#ifndef GAME_MWWORLD_BESTITEMS_H
+#define GAME_MWWORLD_BESTITEMS_H
+
+#include <map>
+
+namespace MWWorld
+{
+    /// @brief Item with the highest score for every key, updated while items are added.
+    ///
+    /// Gives the same result as a scan over the items in the order they were added keeping the last item with the
+    /// score not less than the best one. Items with the score below the minimum are ignored. There is no removal,
+    /// the owner should clear and refill it when a best item is removed.
+    template <class Key, class Item>
+    class BestItems
+    {
+        public:
+            explicit BestItems(float minScore) : mMinScore(minScore) {}
+
+            void add(const Key& key, const Item& item, float score)
+            {
+                if (score < mMinScore)
+                    return;
+                const auto it = mItems.find(key);
+                if (it == mItems.end())
+                    mItems.emplace(key, Candidate {item, score});
+                else if (score >= it->second.mScore)
+                    it->second = Candidate {item, score};
+            }
+
+            const Item* find(const Key& key) const
+            {
+                const auto it = mItems.find(key);
+                if (it == mItems.end())
+                    return nullptr;
+                return &it->second.mItem;
+            }
+
+            void clear() { mItems.clear(); }
+
+        private:
+            struct Candidate
+            {
+                Item mItem;
+                float mScore;
+            };
+
+            float mMinScore;
+            std::map<Key, Candidate> mItems;
+    };
+}
+
+#endif
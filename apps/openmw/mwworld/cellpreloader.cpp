@@ -3,6 +3,8 @@
 #include <atomic>
 #include <limits>
 
+#include <osg/Stats>
+
 #include <components/debug/debuglog.hpp>
 #include <components/resource/scenemanager.hpp>
 #include <components/resource/resourcesystem.hpp>
@@ -93,6 +95,8 @@ namespace MWWorld
             mAbort = true;
         }
 
+        const char* getProfileName() const override { return "PreloadItem"; }
+
         /// Preload work to be called from the worker thread.
         void doWork() override
         {
@@ -179,6 +183,8 @@ namespace MWWorld
         {
         }
 
+        const char* getProfileName() const override { return "TerrainPreloadItem"; }
+
         void doWork() override
         {
             for (unsigned int i=0; i<mTerrainViews.size() && i<mPreloadPositions.size() && !mAbort; ++i)
@@ -194,6 +200,11 @@ namespace MWWorld
             mAbort = true;
         }
 
+        bool isAborted() const
+        {
+            return mAbort;
+        }
+
         void wait(Loading::Listener& listener) const
         {
             mLoadingReporter.wait(listener);
@@ -217,6 +228,8 @@ namespace MWWorld
         {
         }
 
+        const char* getProfileName() const override { return "UpdateCacheItem"; }
+
         void doWork() override
         {
             mResourceSystem->updateCache(mReferenceTime);
@@ -238,6 +251,8 @@ namespace MWWorld
         , mPreloadInstances(true)
         , mLastResourceCacheUpdate(0.0)
         , mLoadedTerrainTimestamp(0.0)
+        , mCancelledTerrainPreloads(0)
+        , mFrameCancelledTerrainPreloads(0)
     {
     }
 
@@ -370,7 +385,7 @@ namespace MWWorld
             mLastResourceCacheUpdate = timestamp;
         }
 
-        if (mTerrainPreloadItem && mTerrainPreloadItem->isDone())
+        if (mTerrainPreloadItem && mTerrainPreloadItem->isDone() && !mTerrainPreloadItem->isAborted())
         {
             mLoadedTerrainPositions = mTerrainPreloadPositions;
             mLoadedTerrainTimestamp = timestamp;
@@ -444,7 +459,17 @@ namespace MWWorld
         else if (contains(mTerrainPreloadPositions, positions, 128.f))
             return;
         if (mTerrainPreloadItem && !mTerrainPreloadItem->isDone())
+        {
+            // The player is not going where we expected, don't hold up the workers with chunks that are not needed
+            // anymore. The new positions are preloaded as soon as the worker notices it has been aborted.
+            if (!positions.empty() && !mTerrainPreloadItem->isAborted()
+                && !contains(mTerrainPreloadPositions, std::array {positions.front()}, ESM::Land::REAL_SIZE))
+            {
+                mTerrainPreloadItem->abort();
+                ++mCancelledTerrainPreloads;
+            }
             return;
+        }
         else
         {
             if (mTerrainViews.size() > positions.size())
@@ -469,4 +494,16 @@ namespace MWWorld
         return mLoadedTerrainTimestamp + mResourceSystem->getSceneManager()->getExpiryDelay() > referenceTime && contains(mLoadedTerrainPositions, std::array {position}, ESM::Land::REAL_SIZE);
     }
 
+    void CellPreloader::reportStats(unsigned int frameNumber, osg::Stats& stats)
+    {
+        if (mStatsFrameNumber != frameNumber)
+        {
+            mFrameCancelledTerrainPreloads = mCancelledTerrainPreloads;
+            mCancelledTerrainPreloads = 0;
+            mStatsFrameNumber = frameNumber;
+        }
+        stats.setAttribute(frameNumber, "Terrain Preload Positions", static_cast<double>(mTerrainPreloadPositions.size()));
+        stats.setAttribute(frameNumber, "Terrain Preload Cancelled", static_cast<double>(mFrameCancelledTerrainPreloads));
+    }
+
 }
@@ -2,11 +2,17 @@
 #define OPENMW_MWWORLD_CELLPRELOADER_H
 
 #include <map>
+#include <optional>
 #include <osg/ref_ptr>
 #include <osg/Vec3f>
 #include <osg/Vec4i>
 #include <components/sceneutil/workqueue.hpp>
 
+namespace osg
+{
+    class Stats;
+}
+
 namespace Resource
 {
     class ResourceSystem;
@@ -68,12 +74,18 @@ namespace MWWorld
         void setWorkQueue(osg::ref_ptr<SceneUtil::WorkQueue> workQueue);
 
         typedef std::pair<osg::Vec3f, osg::Vec4i> PositionCellGrid;
+        /// Preload terrain and object chunks around these positions, the most important one first.
+        /// A preloading that is still running is cancelled if it doesn't cover the first position.
         void setTerrainPreloadPositions(const std::vector<PositionCellGrid>& positions);
 
         bool syncTerrainLoad(const std::vector<CellPreloader::PositionCellGrid> &positions, double timestamp, Loading::Listener& listener);
         void abortTerrainPreloadExcept(const PositionCellGrid *exceptPos);
         bool isTerrainLoaded(const CellPreloader::PositionCellGrid &position, double referenceTime) const;
 
+        /// Reports the terrain preloads cancelled since the previous frame, repeated calls for the same frame report
+        /// the same values.
+        void reportStats(unsigned int frameNumber, osg::Stats& stats);
+
     private:
         Resource::ResourceSystem* mResourceSystem;
         Resource::BulletShapeManager* mBulletShapeManager;
@@ -114,6 +126,10 @@ namespace MWWorld
 
         std::vector<PositionCellGrid> mLoadedTerrainPositions;
         double mLoadedTerrainTimestamp;
+        // Since the last frame reported by reportStats
+        std::size_t mCancelledTerrainPreloads;
+        std::optional<unsigned int> mStatsFrameNumber;
+        std::size_t mFrameCancelledTerrainPreloads;
     };
 
 }
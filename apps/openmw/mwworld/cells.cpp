@@ -12,6 +12,7 @@
 #include "../mwbase/environment.hpp"
 #include "../mwbase/world.hpp"
 
+#include "basesave.hpp"
 #include "esmstore.hpp"
 #include "containerstore.hpp"
 #include "cellstore.hpp"
@@ -96,6 +97,9 @@ void MWWorld::Cells::clear()
     mExteriors.clear();
     std::fill(mIdCache.begin(), mIdCache.end(), std::make_pair("", (MWWorld::CellStore*)nullptr));
     mIdCacheIndex = 0;
+    mBaseSave.mName.clear();
+    mBaseSave.mCellCount = 0;
+    mReadStates.clear();
 }
 
 MWWorld::Ptr MWWorld::Cells::getPtrAndCache (const std::string& name, CellStore& cellStore)
@@ -134,6 +138,7 @@ MWWorld::Cells::Cells (const MWWorld::ESMStore& store, std::vector<ESM::ESMReade
 : mStore (store), mReader (reader),
   mIdCacheIndex (0)
 {
+    mBaseSave.mCellCount = 0;
     int cacheSize = std::clamp(Settings::Manager::getInt("pointers cache size", "Cells"), 40, 1000);
     mIdCache = IdCache(cacheSize, std::pair<std::string, CellStore *> ("", (CellStore*)nullptr));
 }
@@ -383,30 +388,85 @@ std::vector<MWWorld::Ptr> MWWorld::Cells::getAll(const std::string& id)
     return visitor.mPtrs;
 }
 
-int MWWorld::Cells::countSavedGameRecords() const
+int MWWorld::Cells::countCellStates (bool changedOnly) const
 {
     int count = 0;
 
     for (std::map<std::string, CellStore>::const_iterator iter (mInteriors.begin());
         iter!=mInteriors.end(); ++iter)
-        if (iter->second.hasState())
+        if (isCellStateSaved(iter->second.hasState(), iter->second.hasChangedState(), changedOnly))
             ++count;
 
     for (std::map<std::pair<int, int>, CellStore>::const_iterator iter (mExteriors.begin());
         iter!=mExteriors.end(); ++iter)
-        if (iter->second.hasState())
+        if (isCellStateSaved(iter->second.hasState(), iter->second.hasChangedState(), changedOnly))
             ++count;
 
     return count;
 }
 
+int MWWorld::Cells::countSavedGameRecords() const
+{
+    if (isIncrementalSave())
+        return countCellStates (true) + 1; // REC_BASE
+
+    return countCellStates (false);
+}
+
+int MWWorld::Cells::countBaseSaveRecords() const
+{
+    return countCellStates (false);
+}
+
+int MWWorld::Cells::countChangedCells() const
+{
+    return countCellStates (true);
+}
+
+void MWWorld::Cells::setBaseSave (const ESM::BaseSaveState& baseSave)
+{
+    mBaseSave = baseSave;
+}
+
+bool MWWorld::Cells::isIncrementalSave() const
+{
+    return !mBaseSave.mName.empty();
+}
+
 void MWWorld::Cells::write (ESM::ESMWriter& writer, Loading::Listener& progress) const
+{
+    for (std::map<std::pair<int, int>, CellStore>::iterator iter (mExteriors.begin());
+        iter!=mExteriors.end(); ++iter)
+        if (isCellStateSaved(iter->second.hasState(), iter->second.hasChangedState(), isIncrementalSave()))
+        {
+            writeCell (writer, iter->second);
+            progress.increaseProgress();
+        }
+
+    for (std::map<std::string, CellStore>::iterator iter (mInteriors.begin());
+        iter!=mInteriors.end(); ++iter)
+        if (isCellStateSaved(iter->second.hasState(), iter->second.hasChangedState(), isIncrementalSave()))
+        {
+            writeCell (writer, iter->second);
+            progress.increaseProgress();
+        }
+
+    if (isIncrementalSave())
+    {
+        writer.startRecord (ESM::REC_BASE);
+        mBaseSave.save (writer);
+        writer.endRecord (ESM::REC_BASE);
+    }
+}
+
+void MWWorld::Cells::writeBaseSave (ESM::ESMWriter& writer, Loading::Listener& progress)
 {
     for (std::map<std::pair<int, int>, CellStore>::iterator iter (mExteriors.begin());
         iter!=mExteriors.end(); ++iter)
         if (iter->second.hasState())
         {
             writeCell (writer, iter->second);
+            iter->second.setChangedState (false);
             progress.increaseProgress();
         }
 
@@ -415,6 +475,7 @@ void MWWorld::Cells::write (ESM::ESMWriter& writer, Loading::Listener& progress)
         if (iter->second.hasState())
         {
             writeCell (writer, iter->second);
+            iter->second.setChangedState (false);
             progress.increaseProgress();
         }
 }
@@ -442,43 +503,71 @@ public:
     }
 };
 
-bool MWWorld::Cells::readRecord (ESM::ESMReader& reader, uint32_t type,
-    const std::map<int, int>& contentFileMap)
+void MWWorld::Cells::readCellState (ESM::ESMReader& reader, const ESM::CellId& id, const std::map<int, int>& contentFileMap,
+    bool baseSave)
 {
-    if (type==ESM::REC_CSTA)
+    ESM::CellState state;
+    state.mId = id;
+
+    CellStore *cellStore = nullptr;
+
+    try
+    {
+        cellStore = getCell (state.mId);
+    }
+    catch (...)
     {
-        ESM::CellState state;
-        state.mId.load (reader);
+        // silently drop cells that don't exist anymore
+        Log(Debug::Warning) << "Warning: Dropping state for cell " << state.mId.mWorldspace << " (cell no longer exists)";
+        reader.skipRecord();
+        return;
+    }
 
-        CellStore *cellStore = nullptr;
+    // Changed cells are read from the saved game before the base saved game, the outdated state in the base
+    // saved game must not be applied on top.
+    if (isIncrementalSave() && !mReadStates.insert(cellStore).second)
+    {
+        reader.skipRecord();
+        return;
+    }
 
-        try
-        {
-            cellStore = getCell (state.mId);
-        }
-        catch (...)
-        {
-            // silently drop cells that don't exist anymore
-            Log(Debug::Warning) << "Warning: Dropping state for cell " << state.mId.mWorldspace << " (cell no longer exists)";
-            reader.skipRecord();
-            return true;
-        }
+    state.load (reader);
+    cellStore->loadState (state);
 
-        state.load (reader);
-        cellStore->loadState (state);
+    if (state.mHasFogOfWar)
+        cellStore->readFog(reader);
 
-        if (state.mHasFogOfWar)
-            cellStore->readFog(reader);
+    if (cellStore->getState()!=CellStore::State_Loaded)
+        cellStore->load ();
 
-        if (cellStore->getState()!=CellStore::State_Loaded)
-            cellStore->load ();
+    GetCellStoreCallback callback(*this);
 
-        GetCellStoreCallback callback(*this);
+    cellStore->readReferences (reader, contentFileMap, &callback);
 
-        cellStore->readReferences (reader, contentFileMap, &callback);
+    if (baseSave)
+        cellStore->setChangedState(false);
+}
 
+bool MWWorld::Cells::readRecord (ESM::ESMReader& reader, uint32_t type,
+    const std::map<int, int>& contentFileMap)
+{
+    if (type==ESM::REC_CSTA)
+    {
+        ESM::CellId id;
+        id.load (reader);
+        readCellState (reader, id, contentFileMap, false);
         return true;
     }
 
     return false;
 }
+
+void MWWorld::Cells::readBaseSave (ESM::ESMReader& reader, const ESM::BaseSaveState& baseSave,
+    const std::map<int, int>& contentFileMap)
+{
+    MWWorld::readBaseSave (reader, baseSave,
+        [&] (const ESM::CellId& id) { readCellState (reader, id, contentFileMap, true); });
+
+    mReadStates.clear();
+    mBaseSave = baseSave;
+}
@@ -3,8 +3,11 @@
 
 #include <map>
 #include <list>
+#include <set>
 #include <string>
 
+#include <components/esm/basesavestate.hpp>
+
 #include "ptr.hpp"
 
 namespace ESM
@@ -35,6 +38,10 @@ namespace MWWorld
             mutable std::map<std::pair<int, int>, CellStore> mExteriors;
             IdCache mIdCache;
             std::size_t mIdCacheIndex;
+            // Base saved game the saved game written or read references; the name is empty if there is none
+            ESM::BaseSaveState mBaseSave;
+            // Cells whose state has been read while loading the current incremental saved game
+            std::set<const CellStore*> mReadStates;
 
             Cells (const Cells&);
             Cells& operator= (const Cells&);
@@ -47,6 +54,13 @@ namespace MWWorld
 
             void writeCell (ESM::ESMWriter& writer, CellStore& cell) const;
 
+            int countCellStates (bool changedOnly) const;
+
+            void readCellState (ESM::ESMReader& reader, const ESM::CellId& id, const std::map<int, int>& contentFileMap,
+                bool baseSave);
+
+            bool isIncrementalSave() const;
+
         public:
 
             void clear();
@@ -85,10 +99,30 @@ namespace MWWorld
 
             int countSavedGameRecords() const;
 
+            int countBaseSaveRecords() const;
+
+            int countChangedCells() const;
+            ///< Number of cells whose state might have changed since the base saved game was written or read.
+
+            void setBaseSave (const ESM::BaseSaveState& baseSave);
+            ///< If the name is not empty, write() only includes the state of changed cells, followed by a REC_BASE
+            /// record referencing the base saved game the state of the other cells is read from. Must also be set
+            /// while loading a saved game referencing a base saved game.
+
             void write (ESM::ESMWriter& writer, Loading::Listener& progress) const;
 
+            void writeBaseSave (ESM::ESMWriter& writer, Loading::Listener& progress);
+            ///< Write the state of all cells and flag them as unchanged.
+
             bool readRecord (ESM::ESMReader& reader, uint32_t type,
                 const std::map<int, int>& contentFileMap);
+
+            void readBaseSave (ESM::ESMReader& reader, const ESM::BaseSaveState& baseSave,
+                const std::map<int, int>& contentFileMap);
+            ///< Read the cell states from a base saved game, skipping cells whose state was already read from the
+            /// saved game referencing it. Cells read from the base saved game are flagged as unchanged.
+            /// \param baseSave REC_BASE record of the saved game referencing the base saved game.
+            /// \note Throws if the base saved game does not match it.
     };
 }
 
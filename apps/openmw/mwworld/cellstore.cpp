@@ -273,7 +273,7 @@ namespace MWWorld
         if (mState != State_Loaded)
             load();
 
-        mHasState = true;
+        setHasState();
         MovedRefTracker::iterator found = mMovedToAnotherCell.find(object.getBase());
         if (found != mMovedToAnotherCell.end())
         {
@@ -383,7 +383,7 @@ namespace MWWorld
     }
 
     CellStore::CellStore (const ESM::Cell *cell, const MWWorld::ESMStore& esmStore, std::vector<ESM::ESMReader>& readerList)
-        : mStore(esmStore), mReader(readerList), mCell (cell), mState (State_Unloaded), mHasState (false), mLastRespawn(0,0), mRechargingItemsUpToDate(false)
+        : mStore(esmStore), mReader(readerList), mCell (cell), mState (State_Unloaded), mHasState (false), mChangedState (false), mLastRespawn(0,0), mRechargingItemsUpToDate(false)
     {
         mWaterLevel = cell->mWater;
     }
@@ -408,6 +408,16 @@ namespace MWWorld
         return mHasState;
     }
 
+    bool CellStore::hasChangedState() const
+    {
+        return mChangedState;
+    }
+
+    void CellStore::setChangedState(bool changed)
+    {
+        mChangedState = changed;
+    }
+
     bool CellStore::hasId (const std::string& id) const
     {
         if (mState==State_Unloaded)
@@ -507,7 +517,7 @@ namespace MWWorld
     void CellStore::setWaterLevel (float level)
     {
         mWaterLevel = level;
-        mHasState = true;
+        setHasState();
     }
 
     std::size_t CellStore::count() const
@@ -663,22 +673,19 @@ namespace MWWorld
 
     Ptr CellStore::searchInContainer (const std::string& id)
     {
-        bool oldState = mHasState;
-
-        mHasState = true;
+        Ptr ptr = searchInContainerList (mContainers, id);
 
-        if (Ptr ptr = searchInContainerList (mContainers, id))
-            return ptr;
-
-        if (Ptr ptr = searchInContainerList (mCreatures, id))
-            return ptr;
+        if (ptr.isEmpty())
+            ptr = searchInContainerList (mCreatures, id);
 
-        if (Ptr ptr = searchInContainerList (mNpcs, id))
-            return ptr;
+        if (ptr.isEmpty())
+            ptr = searchInContainerList (mNpcs, id);
 
-        mHasState = oldState;
+        // The item is handed out for modification
+        if (!ptr.isEmpty())
+            setHasState();
 
-        return Ptr();
+        return ptr;
     }
 
     void CellStore::loadRef (ESM::CellRef& ref, bool deleted, std::map<ESM::RefNum, std::string>& refNumToID)
@@ -758,7 +765,7 @@ namespace MWWorld
 
     void CellStore::loadState (const ESM::CellState& state)
     {
-        mHasState = true;
+        setHasState();
 
         if (mCell->mData.mFlags & ESM::Cell::Interior && mCell->mData.mFlags & ESM::Cell::HasWater)
             mWaterLevel = state.mWaterLevel;
@@ -827,7 +834,7 @@ namespace MWWorld
 
     void CellStore::readReferences (ESM::ESMReader& reader, const std::map<int, int>& contentFileMap, GetCellStoreCallback* callback)
     {
-        mHasState = true;
+        setHasState();
 
         while (reader.isNextSub ("OBJE"))
         {
@@ -71,6 +71,7 @@ namespace MWWorld
             const ESM::Cell *mCell;
             State mState;
             bool mHasState;
+            bool mChangedState;
             std::vector<std::string> mIds;
             float mWaterLevel;
 
@@ -129,6 +130,12 @@ namespace MWWorld
             void rechargeItems(float duration);
             void checkItem(const Ptr& ptr);
 
+            void setHasState()
+            {
+                mHasState = true;
+                mChangedState = true;
+            }
+
             // helper function for forEachInternal
             template<class Visitor, class List>
             bool forEachImp (Visitor& visitor, List& list)
@@ -203,7 +210,7 @@ namespace MWWorld
             template <typename T>
             LiveCellRefBase* insert(const LiveCellRef<T>* ref)
             {
-                mHasState = true;
+                setHasState();
                 CellRefList<T>& list = get<T>();
                 LiveCellRefBase* ret = &list.insert(*ref);
                 updateMergedRefs();
@@ -225,6 +232,12 @@ namespace MWWorld
             bool hasState() const;
             ///< Does this cell have state that needs to be stored in a saved game file?
 
+            bool hasChangedState() const;
+            ///< Might the state of this cell have changed since it was last written to or read from a base saved
+            /// game? Set whenever the hasState flag is triggered.
+
+            void setChangedState(bool changed);
+
             bool hasId (const std::string& id) const;
             ///< May return true for deleted IDs when in preload state. Will return false, if cell is
             /// unloaded.
@@ -283,7 +296,7 @@ namespace MWWorld
                 if (mMergedRefs.empty())
                     return true;
 
-                mHasState = true;
+                setHasState();
 
                 for (unsigned int i=0; i<mMergedRefs.size(); ++i)
                 {
@@ -333,7 +346,7 @@ namespace MWWorld
                 if (mMergedRefs.empty())
                     return true;
 
-                mHasState = true;
+                setHasState();
 
                 CellRefList<T>& list = get<T>();
 
@@ -372,6 +385,7 @@ namespace MWWorld
             bool isExterior() const;
 
             Ptr searchInContainer (const std::string& id);
+            ///< @note Triggers CellStore hasState flag if an item is found.
 
             void loadState (const ESM::CellState& state);
 
@@ -415,147 +429,147 @@ namespace MWWorld
     template<>
     inline CellRefList<ESM::Activator>& CellStore::get<ESM::Activator>()
     {
-        mHasState = true;
+        setHasState();
         return mActivators;
     }
 
     template<>
     inline CellRefList<ESM::Potion>& CellStore::get<ESM::Potion>()
     {
-        mHasState = true;
+        setHasState();
         return mPotions;
     }
 
     template<>
     inline CellRefList<ESM::Apparatus>& CellStore::get<ESM::Apparatus>()
     {
-        mHasState = true;
+        setHasState();
         return mAppas;
     }
 
     template<>
     inline CellRefList<ESM::Armor>& CellStore::get<ESM::Armor>()
     {
-        mHasState = true;
+        setHasState();
         return mArmors;
     }
 
     template<>
     inline CellRefList<ESM::Book>& CellStore::get<ESM::Book>()
     {
-        mHasState = true;
+        setHasState();
         return mBooks;
     }
 
     template<>
     inline CellRefList<ESM::Clothing>& CellStore::get<ESM::Clothing>()
     {
-        mHasState = true;
+        setHasState();
         return mClothes;
     }
 
     template<>
     inline CellRefList<ESM::Container>& CellStore::get<ESM::Container>()
     {
-        mHasState = true;
+        setHasState();
         return mContainers;
     }
 
     template<>
     inline CellRefList<ESM::Creature>& CellStore::get<ESM::Creature>()
     {
-        mHasState = true;
+        setHasState();
         return mCreatures;
     }
 
     template<>
     inline CellRefList<ESM::Door>& CellStore::get<ESM::Door>()
     {
-        mHasState = true;
+        setHasState();
         return mDoors;
     }
 
     template<>
     inline CellRefList<ESM::Ingredient>& CellStore::get<ESM::Ingredient>()
     {
-        mHasState = true;
+        setHasState();
         return mIngreds;
     }
 
     template<>
     inline CellRefList<ESM::CreatureLevList>& CellStore::get<ESM::CreatureLevList>()
     {
-        mHasState = true;
+        setHasState();
         return mCreatureLists;
     }
 
     template<>
     inline CellRefList<ESM::ItemLevList>& CellStore::get<ESM::ItemLevList>()
     {
-        mHasState = true;
+        setHasState();
         return mItemLists;
     }
 
     template<>
     inline CellRefList<ESM::Light>& CellStore::get<ESM::Light>()
     {
-        mHasState = true;
+        setHasState();
         return mLights;
     }
 
     template<>
     inline CellRefList<ESM::Lockpick>& CellStore::get<ESM::Lockpick>()
     {
-        mHasState = true;
+        setHasState();
         return mLockpicks;
     }
 
     template<>
     inline CellRefList<ESM::Miscellaneous>& CellStore::get<ESM::Miscellaneous>()
     {
-        mHasState = true;
+        setHasState();
         return mMiscItems;
     }
 
     template<>
     inline CellRefList<ESM::NPC>& CellStore::get<ESM::NPC>()
     {
-        mHasState = true;
+        setHasState();
         return mNpcs;
     }
 
     template<>
     inline CellRefList<ESM::Probe>& CellStore::get<ESM::Probe>()
     {
-        mHasState = true;
+        setHasState();
         return mProbes;
     }
 
     template<>
     inline CellRefList<ESM::Repair>& CellStore::get<ESM::Repair>()
     {
-        mHasState = true;
+        setHasState();
         return mRepairs;
     }
 
     template<>
     inline CellRefList<ESM::Static>& CellStore::get<ESM::Static>()
     {
-        mHasState = true;
+        setHasState();
         return mStatics;
     }
 
     template<>
     inline CellRefList<ESM::Weapon>& CellStore::get<ESM::Weapon>()
     {
-        mHasState = true;
+        setHasState();
         return mWeapons;
     }
 
     template<>
     inline CellRefList<ESM::BodyPart>& CellStore::get<ESM::BodyPart>()
     {
-        mHasState = true;
+        setHasState();
         return mBodyParts;
     }
 
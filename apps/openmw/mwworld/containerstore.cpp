@@ -1,6 +1,8 @@
 #include "containerstore.hpp"
 
+#include <algorithm>
 #include <cassert>
+#include <cmath>
 #include <stdexcept>
 
 #include <components/debug/debuglog.hpp>
@@ -38,17 +40,10 @@ namespace
     }
 
     template<typename T>
-    float getTotalWeight (const MWWorld::CellRefList<T>& cellRefList)
+    void addTotalWeight (const MWWorld::CellRefList<T>& cellRefList, MWWorld::ContainerWeight& weight)
     {
-        float sum = 0;
-
         for (const auto& iter : cellRefList.mList)
-        {
-            if (iter.mData.getCount()>0)
-                sum += iter.mData.getCount()*iter.mBase->mData.mWeight;
-        }
-
-        return sum;
+            weight.add(iter.mData.getCount(), iter.mBase->mData.mWeight);
     }
 
     template<typename T>
@@ -140,7 +135,6 @@ const std::string MWWorld::ContainerStore::sGoldId = "gold_001";
 MWWorld::ContainerStore::ContainerStore()
     : mListener(nullptr)
     , mRechargingItemsUpToDate(false)
-    , mCachedWeight (0)
     , mWeightUpToDate (false)
     , mModified(false)
     , mResolved(false)
@@ -149,6 +143,14 @@ MWWorld::ContainerStore::ContainerStore()
 
 MWWorld::ContainerStore::~ContainerStore() {}
 
+std::unique_ptr<MWWorld::ContainerStore> MWWorld::ContainerStore::clone()
+{
+    auto result = std::make_unique<ContainerStore>(*this);
+    // Recharging items point to this store
+    result->mRechargingItemsUpToDate = false;
+    return result;
+}
+
 MWWorld::ConstContainerStoreIterator MWWorld::ContainerStore::cbegin (int mask) const
 {
     return ConstContainerStoreIterator (mask, this);
@@ -234,8 +236,8 @@ MWWorld::ContainerStoreIterator MWWorld::ContainerStore::restack(const MWWorld::
     {
         if (stacks(*iter, item))
         {
-            iter->getRefData().setCount(addItems(iter->getRefData().getCount(false), item.getRefData().getCount(false)));
-            item.getRefData().setCount(0);
+            setItemCount(*iter, addItems(iter->getRefData().getCount(false), item.getRefData().getCount(false)));
+            setItemCount(item, 0);
             retval = iter;
             break;
         }
@@ -365,8 +367,7 @@ MWWorld::ContainerStoreIterator MWWorld::ContainerStore::addImp (const Ptr& ptr,
         {
             if (Misc::StringUtils::ciEqual(iter->getCellRef().getRefIdRef(), MWWorld::ContainerStore::sGoldId))
             {
-                iter->getRefData().setCount(addItems(iter->getRefData().getCount(false), realCount));
-                flagAsModified();
+                setItemCount(*iter, addItems(iter->getRefData().getCount(false), realCount));
                 return iter;
             }
         }
@@ -381,9 +382,7 @@ MWWorld::ContainerStoreIterator MWWorld::ContainerStore::addImp (const Ptr& ptr,
         if (stacks(*iter, ptr))
         {
             // stack
-            iter->getRefData().setCount(addItems(iter->getRefData().getCount(false), count));
-
-            flagAsModified();
+            setItemCount(*iter, addItems(iter->getRefData().getCount(false), count));
             return iter;
         }
     }
@@ -413,10 +412,41 @@ MWWorld::ContainerStoreIterator MWWorld::ContainerStore::addNewStack (const Cons
 
     it->getRefData().setCount(count);
 
-    flagAsModified();
+    if (mWeightUpToDate)
+        mCachedWeight.add(count, it->getClass().getWeight(*it));
+
+    if (count != 0)
+        onStackAdded(it);
+
     return it;
 }
 
+void MWWorld::ContainerStore::setItemCount(const Ptr& item, int count)
+{
+    const int oldCount = item.getRefData().getCount();
+    item.getRefData().setCount(count);
+
+    if (mWeightUpToDate)
+    {
+        const float weight = item.getClass().getWeight(item);
+        mCachedWeight.remove(oldCount, weight);
+        mCachedWeight.add(count, weight);
+    }
+
+    if (oldCount != 0 && count == 0)
+        onStackRemoved(item);
+}
+
+void MWWorld::ContainerStore::onStackAdded(const ContainerStoreIterator& iter)
+{
+    if (mRechargingItemsUpToDate)
+        addRechargingItem(iter);
+}
+
+void MWWorld::ContainerStore::onStackRemoved(const ConstPtr& item)
+{
+}
+
 void MWWorld::ContainerStore::rechargeItems(float duration)
 {
     if (!mRechargingItemsUpToDate)
@@ -424,6 +454,13 @@ void MWWorld::ContainerStore::rechargeItems(float duration)
         updateRechargingItems();
         mRechargingItemsUpToDate = true;
     }
+    else
+    {
+        // Removed stacks stay in the list until the next recharge
+        mRechargingItems.erase(std::remove_if(mRechargingItems.begin(), mRechargingItems.end(),
+            [] (const auto& v) { return v.first->getRefData().getCount() == 0; }), mRechargingItems.end());
+    }
+    bool restacked = false;
     for (auto& it : mRechargingItems)
     {
         if (!MWMechanics::rechargeItem(*it.first, it.second, duration))
@@ -431,30 +468,40 @@ void MWWorld::ContainerStore::rechargeItems(float duration)
 
         // attempt to restack when fully recharged
         if (it.first->getCellRef().getEnchantmentCharge() == it.second)
-            it.first = restack(*it.first);
+        {
+            const ContainerStoreIterator stack = restack(*it.first);
+            restacked = restacked || stack != it.first;
+            it.first = stack;
+        }
     }
+    // Restacked items may be in the list twice
+    if (restacked)
+        mRechargingItemsUpToDate = false;
 }
 
 void MWWorld::ContainerStore::updateRechargingItems()
 {
     mRechargingItems.clear();
     for (ContainerStoreIterator it = begin(); it != end(); ++it)
-    {
-        const std::string& enchantmentId = it->getClass().getEnchantment(*it);
-        if (!enchantmentId.empty())
-        {
-            const ESM::Enchantment* enchantment = MWBase::Environment::get().getWorld()->getStore().get<ESM::Enchantment>().search(enchantmentId);
-            if (!enchantment)
-            {
-                Log(Debug::Warning) << "Warning: Can't find enchantment '" << enchantmentId << "' on item " << it->getCellRef().getRefId();
-                continue;
-            }
+        addRechargingItem(it);
+}
 
-            if (enchantment->mData.mType == ESM::Enchantment::WhenUsed
-                    || enchantment->mData.mType == ESM::Enchantment::WhenStrikes)
-                mRechargingItems.emplace_back(it, static_cast<float>(enchantment->mData.mCharge));
-        }
+void MWWorld::ContainerStore::addRechargingItem(const ContainerStoreIterator& it)
+{
+    const std::string& enchantmentId = it->getClass().getEnchantment(*it);
+    if (enchantmentId.empty())
+        return;
+
+    const ESM::Enchantment* enchantment = MWBase::Environment::get().getWorld()->getStore().get<ESM::Enchantment>().search(enchantmentId);
+    if (!enchantment)
+    {
+        Log(Debug::Warning) << "Warning: Can't find enchantment '" << enchantmentId << "' on item " << it->getCellRef().getRefId();
+        return;
     }
+
+    if (enchantment->mData.mType == ESM::Enchantment::WhenUsed
+            || enchantment->mData.mType == ESM::Enchantment::WhenStrikes)
+        mRechargingItems.emplace_back(it, static_cast<float>(enchantment->mData.mCharge));
 }
 
 int MWWorld::ContainerStore::remove(const std::string& itemId, int count, const Ptr& actor, bool equipReplacement, bool resolveFirst)
@@ -467,8 +514,6 @@ int MWWorld::ContainerStore::remove(const std::string& itemId, int count, const
         if (Misc::StringUtils::ciEqual(iter->getCellRef().getRefIdRef(), itemId))
             toRemove -= remove(*iter, toRemove, actor, equipReplacement, resolveFirst);
 
-    flagAsModified();
-
     // number of removed items
     return count - toRemove;
 }
@@ -496,16 +541,14 @@ int MWWorld::ContainerStore::remove(const Ptr& item, int count, const Ptr& actor
     if (itemRef.getCount() <= toRemove)
     {
         toRemove -= itemRef.getCount();
-        itemRef.setCount(0);
+        setItemCount(item, 0);
     }
     else
     {
-        itemRef.setCount(subtractItems(itemRef.getCount(false), toRemove));
+        setItemCount(item, subtractItems(itemRef.getCount(false), toRemove));
         toRemove = 0;
     }
 
-    flagAsModified();
-
     // we should not fire event for InventoryStore yet - it has some custom logic
     if (mListener && !actor.getClass().hasInventoryStore(actor))
         mListener->itemRemoved(item, count - toRemove);
@@ -666,25 +709,25 @@ float MWWorld::ContainerStore::getWeight() const
 {
     if (!mWeightUpToDate)
     {
-        mCachedWeight = 0;
-
-        mCachedWeight += getTotalWeight (potions);
-        mCachedWeight += getTotalWeight (appas);
-        mCachedWeight += getTotalWeight (armors);
-        mCachedWeight += getTotalWeight (books);
-        mCachedWeight += getTotalWeight (clothes);
-        mCachedWeight += getTotalWeight (ingreds);
-        mCachedWeight += getTotalWeight (lights);
-        mCachedWeight += getTotalWeight (lockpicks);
-        mCachedWeight += getTotalWeight (miscItems);
-        mCachedWeight += getTotalWeight (probes);
-        mCachedWeight += getTotalWeight (repairs);
-        mCachedWeight += getTotalWeight (weapons);
+        mCachedWeight.clear();
+
+        addTotalWeight (potions, mCachedWeight);
+        addTotalWeight (appas, mCachedWeight);
+        addTotalWeight (armors, mCachedWeight);
+        addTotalWeight (books, mCachedWeight);
+        addTotalWeight (clothes, mCachedWeight);
+        addTotalWeight (ingreds, mCachedWeight);
+        addTotalWeight (lights, mCachedWeight);
+        addTotalWeight (lockpicks, mCachedWeight);
+        addTotalWeight (miscItems, mCachedWeight);
+        addTotalWeight (probes, mCachedWeight);
+        addTotalWeight (repairs, mCachedWeight);
+        addTotalWeight (weapons, mCachedWeight);
 
         mWeightUpToDate = true;
     }
 
-    return mCachedWeight;
+    return mCachedWeight.get();
 }
 
 int MWWorld::ContainerStore::getType (const ConstPtr& ptr)
@@ -904,6 +947,8 @@ void MWWorld::ContainerStore::readState (const ESM::InventoryState& inventory)
                 break;
         }
     }
+
+    flagAsModified();
 }
 
 template<class PtrType>
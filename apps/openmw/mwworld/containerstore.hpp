@@ -23,6 +23,7 @@
 
 #include "ptr.hpp"
 #include "cellreflist.hpp"
+#include "containerweight.hpp"
 
 namespace ESM
 {
@@ -116,7 +117,7 @@ namespace MWWorld
             MWWorld::CellRefList<ESM::Repair>            repairs;
             MWWorld::CellRefList<ESM::Weapon>            weapons;
 
-            mutable float mCachedWeight;
+            mutable ContainerWeight mCachedWeight;
             mutable bool mWeightUpToDate;
 
             bool mModified;
@@ -143,6 +144,8 @@ namespace MWWorld
 
             void updateRechargingItems();
 
+            void addRechargingItem(const ContainerStoreIterator& it);
+
             virtual void storeEquipmentState (const MWWorld::LiveCellRefBase& ref, int index, ESM::InventoryState& inventory) const;
 
             virtual void readEquipmentState (const MWWorld::ContainerStoreIterator& iter, int index, const ESM::InventoryState& inventory);
@@ -153,7 +156,7 @@ namespace MWWorld
 
             virtual ~ContainerStore();
 
-            virtual std::unique_ptr<ContainerStore> clone() { return std::make_unique<ContainerStore>(*this); }
+            virtual std::unique_ptr<ContainerStore> clone();
 
             ConstContainerStoreIterator cbegin (int mask = Type_All) const;
             ConstContainerStoreIterator cend() const;
@@ -210,7 +213,17 @@ namespace MWWorld
             ContainerStoreIterator addNewStack (const ConstPtr& ptr, int count);
             ///< Add the item to this container (do not try to stack it onto existing items)
 
+            void setItemCount (const Ptr& item, int count);
+            ///< Change count of a stack in this container updating the cached weight.
+
+            virtual void onStackAdded (const ContainerStoreIterator& iter);
+            ///< Called when a new stack is added to this container.
+
+            virtual void onStackRemoved (const ConstPtr& item);
+            ///< Called when count of a stack in this container becomes zero.
+
             virtual void flagAsModified();
+            ///< Invalidate the cached aggregates after changing many stacks at once.
 
             /// + and - operations that can deal with negative stacks
             /// Note that negativity is infectious
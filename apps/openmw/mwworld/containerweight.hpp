@@ -0,0 +1,32 @@
+#ifndef GAME_MWWORLD_CONTAINERWEIGHT_H
+#define GAME_MWWORLD_CONTAINERWEIGHT_H
+
+namespace MWWorld
+{
+    /// @brief Total weight of the stacks in a container, updated while stacks are added, removed or restacked.
+    ///
+    /// Sums in double precision, where the products of float weights and counts and their sums are exact for realistic
+    /// inventories. So the result doesn't depend on the order of the updates and is the same as a full recount.
+    class ContainerWeight
+    {
+        public:
+            /// Stacks with a negative count are restocking items that are not in the container, they weigh nothing.
+            static double getStackWeight(int count, float weight)
+            {
+                return count > 0 ? static_cast<double>(count) * weight : 0;
+            }
+
+            void add(int count, float weight) { mWeight += getStackWeight(count, weight); }
+
+            void remove(int count, float weight) { mWeight -= getStackWeight(count, weight); }
+
+            void clear() { mWeight = 0; }
+
+            float get() const { return static_cast<float>(mWeight); }
+
+        private:
+            double mWeight = 0;
+    };
+}
+
+#endif
@@ -51,4 +51,11 @@ namespace MWWorld
         if (searchCell != mCellContexts.end())
             cell.mContextList = searchCell->second;
     }
+
+    void GroundcoverStore::listCells(std::vector<std::pair<int, int>>& cells) const
+    {
+        cells.reserve(cells.size() + mCellContexts.size());
+        for (const auto& [cellIndex, contexts] : mCellContexts)
+            cells.push_back(cellIndex);
+    }
 }
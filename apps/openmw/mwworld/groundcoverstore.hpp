@@ -23,6 +23,7 @@ namespace MWWorld
             void init(const Store<ESM::Static>& statics, const Files::Collections& fileCollections, const std::vector<std::string>& groundcoverFiles, ToUTF8::Utf8Encoder* encoder);
             std::string getGroundcoverModel(const std::string& id) const;
             void initCell(ESM::Cell& cell, int cellX, int cellY) const;
+            void listCells(std::vector<std::pair<int, int>>& cells) const;
     };
 }
 
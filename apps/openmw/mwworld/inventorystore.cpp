@@ -88,7 +88,7 @@ void MWWorld::InventoryStore::readEquipmentState(const MWWorld::ContainerStoreIt
         {
             int count = iter->getRefData().getCount(false);
             MWWorld::ContainerStoreIterator newIter = addNewStack(*iter, count > 0 ? 1 : -1);
-            iter->getRefData().setCount(subtractItems(count, 1));
+            setItemCount(*iter, subtractItems(count, 1));
             mSlots[slot] = newIter;
         }
         else
@@ -101,6 +101,9 @@ MWWorld::InventoryStore::InventoryStore()
  , mInventoryListener(nullptr)
  , mUpdatesEnabled (true)
  , mFirstAutoEquip(true)
+ , mBestWeapons(0)
+ , mBestAmmunition(0)
+ , mBestWeaponsUpToDate(false)
  , mSelectedEnchantItem(end())
 {
     initSlots (mSlots);
@@ -111,8 +114,13 @@ MWWorld::InventoryStore::InventoryStore (const InventoryStore& store)
  , mInventoryListener(store.mInventoryListener)
  , mUpdatesEnabled(store.mUpdatesEnabled)
  , mFirstAutoEquip(store.mFirstAutoEquip)
+ , mBestWeapons(0)
+ , mBestAmmunition(0)
+ , mBestWeaponsUpToDate(false)
  , mSelectedEnchantItem(end())
 {
+    // Cached iterators point to the other store
+    mRechargingItemsUpToDate = false;
     copySlots (store);
 }
 
@@ -124,8 +132,9 @@ MWWorld::InventoryStore& MWWorld::InventoryStore::operator= (const InventoryStor
     mListener = store.mListener;
     mInventoryListener = store.mInventoryListener;
     mFirstAutoEquip = store.mFirstAutoEquip;
-    mRechargingItemsUpToDate = false;
     ContainerStore::operator= (store);
+    mRechargingItemsUpToDate = false;
+    mBestWeaponsUpToDate = false;
     mSlots.clear();
     copySlots (store);
     return *this;
@@ -179,8 +188,6 @@ void MWWorld::InventoryStore::equip (int slot, const ContainerStoreIterator& ite
 
     mSlots[slot] = iterator;
 
-    flagAsModified();
-
     fireEquipmentChangedEvent(actor);
 }
 
@@ -223,6 +230,49 @@ MWWorld::ContainerStoreIterator MWWorld::InventoryStore::findSlot (int slot) con
     return mSlots[slot];
 }
 
+void MWWorld::InventoryStore::addBestWeapon(const ContainerStoreIterator& iter)
+{
+    const ESM::Weapon* esmWeapon = iter->get<ESM::Weapon>()->mBase;
+
+    if (esmWeapon->mData.mType == ESM::Weapon::Arrow || esmWeapon->mData.mType == ESM::Weapon::Bolt)
+        mBestAmmunition.add(esmWeapon->mData.mType, iter, esmWeapon->mData.mChop[1]);
+
+    if (MWMechanics::getWeaponType(esmWeapon->mData.mType)->mWeaponClass == ESM::WeaponType::Ammo)
+        return;
+
+    const int damage = std::max({esmWeapon->mData.mChop[1], esmWeapon->mData.mSlash[1], esmWeapon->mData.mThrust[1]});
+    mBestWeapons.add(iter->getClass().getEquipmentSkill(*iter), iter, damage);
+}
+
+void MWWorld::InventoryStore::updateBestWeapons()
+{
+    mBestWeapons.clear();
+    mBestAmmunition.clear();
+    for (ContainerStoreIterator iter(begin(ContainerStore::Type_Weapon)); iter != end(); ++iter)
+        addBestWeapon(iter);
+    mBestWeaponsUpToDate = true;
+}
+
+void MWWorld::InventoryStore::onStackAdded(const ContainerStoreIterator& iter)
+{
+    ContainerStore::onStackAdded(iter);
+    if (mBestWeaponsUpToDate && iter.getType() == ContainerStore::Type_Weapon)
+        addBestWeapon(iter);
+}
+
+void MWWorld::InventoryStore::onStackRemoved(const ConstPtr& item)
+{
+    ContainerStore::onStackRemoved(item);
+    if (item.getType() == ESM::Weapon::sRecordId)
+        mBestWeaponsUpToDate = false;
+}
+
+void MWWorld::InventoryStore::flagAsModified()
+{
+    ContainerStore::flagAsModified();
+    mBestWeaponsUpToDate = false;
+}
+
 void MWWorld::InventoryStore::autoEquipWeapon (const MWWorld::Ptr& actor, TSlots& slots_)
 {
     if (!actor.getClass().isNpc())
@@ -249,34 +299,14 @@ void MWWorld::InventoryStore::autoEquipWeapon (const MWWorld::Ptr& actor, TSlots
 
     bool weaponSkillVisited[weaponSkillsLength] = { false };
 
-    // give arrows/bolt with max damage by default
-    int arrowMax = 0;
-    int boltMax = 0;
-    ContainerStoreIterator arrow(end());
-    ContainerStoreIterator bolt(end());
-
-    // rate ammo
-    for (ContainerStoreIterator iter(begin(ContainerStore::Type_Weapon)); iter!=end(); ++iter)
-    {
-        const ESM::Weapon* esmWeapon = iter->get<ESM::Weapon>()->mBase;
+    if (!mBestWeaponsUpToDate)
+        updateBestWeapons();
 
-        if (esmWeapon->mData.mType == ESM::Weapon::Arrow)
-        {
-            if (esmWeapon->mData.mChop[1] >= arrowMax)
-            {
-                arrowMax = esmWeapon->mData.mChop[1];
-                arrow = iter;
-            }
-        }
-        else if (esmWeapon->mData.mType == ESM::Weapon::Bolt)
-        {
-            if (esmWeapon->mData.mChop[1] >= boltMax)
-            {
-                boltMax = esmWeapon->mData.mChop[1];
-                bolt = iter;
-            }
-        }
-    }
+    // give arrows/bolt with max damage by default
+    const ContainerStoreIterator* const bestArrow = mBestAmmunition.find(ESM::Weapon::Arrow);
+    const ContainerStoreIterator* const bestBolt = mBestAmmunition.find(ESM::Weapon::Bolt);
+    const ContainerStoreIterator arrow = bestArrow != nullptr ? *bestArrow : end();
+    const ContainerStoreIterator bolt = bestBolt != nullptr ? *bestBolt : end();
 
     // rate weapon
     for (int i = 0; i < static_cast<int>(weaponSkillsLength); ++i)
@@ -297,37 +327,9 @@ void MWWorld::InventoryStore::autoEquipWeapon (const MWWorld::Ptr& actor, TSlots
         if (maxWeaponSkill == -1)
             break;
 
-        max = 0;
-        ContainerStoreIterator weapon(end());
-
-        for (ContainerStoreIterator iter(begin(ContainerStore::Type_Weapon)); iter!=end(); ++iter)
-        {
-            const ESM::Weapon* esmWeapon = iter->get<ESM::Weapon>()->mBase;
-
-            if (MWMechanics::getWeaponType(esmWeapon->mData.mType)->mWeaponClass == ESM::WeaponType::Ammo)
-                continue;
-
-            if (iter->getClass().getEquipmentSkill(*iter) == weaponSkills[maxWeaponSkill])
-            {
-                if (esmWeapon->mData.mChop[1] >= max)
-                {
-                    max = esmWeapon->mData.mChop[1];
-                    weapon = iter;
-                }
-
-                if (esmWeapon->mData.mSlash[1] >= max)
-                {
-                    max = esmWeapon->mData.mSlash[1];
-                    weapon = iter;
-                }
-
-                if (esmWeapon->mData.mThrust[1] >= max)
-                {
-                    max = esmWeapon->mData.mThrust[1];
-                    weapon = iter;
-                }
-            }
-        }
+        // Copy because unstacking below may change the best weapons
+        const ContainerStoreIterator* const bestWeapon = mBestWeapons.find(weaponSkills[maxWeaponSkill]);
+        const ContainerStoreIterator weapon = bestWeapon != nullptr ? *bestWeapon : end();
 
         if (weapon != end() && weapon->getClass().canBeEquipped(*weapon, actor).first)
         {
@@ -547,7 +549,6 @@ void MWWorld::InventoryStore::autoEquip (const MWWorld::Ptr& actor)
     {
         mSlots.swap (slots_);
         fireEquipmentChangedEvent(actor);
-        flagAsModified();
     }
 }
 
@@ -707,8 +708,8 @@ MWWorld::ContainerStoreIterator MWWorld::InventoryStore::unequipItemQuantity(con
     {
         if (stacks(*iter, item) && !isEquipped(*iter))
         {
-            iter->getRefData().setCount(addItems(iter->getRefData().getCount(false), count));
-            item.getRefData().setCount(subtractItems(item.getRefData().getCount(false), count));
+            setItemCount(*iter, addItems(iter->getRefData().getCount(false), count));
+            setItemCount(item, subtractItems(item.getRefData().getCount(false), count));
             return iter;
         }
     }
@@ -1,6 +1,7 @@
 #ifndef GAME_MWWORLD_INVENTORYSTORE_H
 #define GAME_MWWORLD_INVENTORYSTORE_H
 
+#include "bestitems.hpp"
 #include "containerstore.hpp"
 
 #include "../mwmechanics/magiceffects.hpp"
@@ -71,6 +72,15 @@ namespace MWWorld
 
             TSlots mSlots;
 
+            // Candidates for autoEquipWeapon: the best weapon for every skill and the best ammunition by the weapon type.
+            // Updated when weapon stacks are added, rebuilt on demand after a weapon stack is removed.
+            BestItems<int, ContainerStoreIterator> mBestWeapons;
+            BestItems<int, ContainerStoreIterator> mBestAmmunition;
+            bool mBestWeaponsUpToDate;
+
+            void addBestWeapon(const ContainerStoreIterator& iter);
+            void updateBestWeapons();
+
             void autoEquipWeapon(const MWWorld::Ptr& actor, TSlots& slots_);
             void autoEquipArmor(const MWWorld::Ptr& actor, TSlots& slots_);
             void autoEquipShield(const MWWorld::Ptr& actor, TSlots& slots_);
@@ -89,6 +99,12 @@ namespace MWWorld
 
             ContainerStoreIterator findSlot (int slot) const;
 
+            void onStackAdded (const ContainerStoreIterator& iter) override;
+
+            void onStackRemoved (const ConstPtr& item) override;
+
+            void flagAsModified() override;
+
         public:
 
             InventoryStore();
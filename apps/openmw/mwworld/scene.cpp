@@ -1,9 +1,12 @@
 #include "scene.hpp"
 
+#include <algorithm>
 #include <limits>
 #include <chrono>
 #include <thread>
 #include <atomic>
+#include <set>
+#include <vector>
 
 #include <BulletCollision/CollisionDispatch/btCollisionObject.h>
 #include <BulletCollision/CollisionShapes/btCompoundShape.h>
@@ -11,6 +14,7 @@
 #include <components/debug/debuglog.hpp>
 #include <components/loadinglistener/loadinglistener.hpp>
 #include <components/misc/resourcehelpers.hpp>
+#include <components/misc/stringops.hpp>
 #include <components/settings/settings.hpp>
 #include <components/resource/resourcesystem.hpp>
 #include <components/resource/scenemanager.hpp>
@@ -254,6 +258,29 @@ namespace
         }
         return false;
     }
+
+    // Creature sound generators are played as soon as the creatures start moving, decode them in advance
+    void prefetchCreatureSounds(MWWorld::CellStore& cell)
+    {
+        std::set<std::string, Misc::StringUtils::CiComp> creatures;
+        auto visitor = [&] (const MWWorld::Ptr& ptr)
+        {
+            const MWWorld::LiveCellRef<ESM::Creature>* ref = ptr.get<ESM::Creature>();
+            creatures.insert(ref->mBase->mOriginal.empty() ? ref->mBase->mId : ref->mBase->mOriginal);
+            return true;
+        };
+        cell.forEachType<ESM::Creature>(visitor);
+        if (creatures.empty())
+            return;
+
+        std::vector<std::string> sounds;
+        for (const ESM::SoundGenerator& soundGenerator : MWBase::Environment::get().getWorld()->getStore().get<ESM::SoundGenerator>())
+        {
+            if (!soundGenerator.mCreature.empty() && creatures.count(soundGenerator.mCreature) != 0)
+                sounds.push_back(soundGenerator.mSound);
+        }
+        MWBase::Environment::get().getSoundManager()->prefetchSounds(sounds);
+    }
 }
 
 
@@ -432,6 +459,8 @@ namespace MWWorld
 
         insertCell(*cell, loadingListener);
 
+        prefetchCreatureSounds(*cell);
+
         mRendering.addCell(cell);
 
         MWBase::Environment::get().getWindowManager()->addCell(cell);
@@ -743,7 +772,7 @@ namespace MWWorld
 
         world->adjustSky();
 
-        mLastPlayerPos = player.getRefData().getPosition().asVec3();
+        mPlayerTrajectory.reset(player.getRefData().getPosition().asVec3());
     }
 
     Scene::Scene (MWRender::RenderingManager& rendering, MWPhysics::PhysicsSystem *physics,
@@ -756,6 +785,8 @@ namespace MWWorld
     , mPreloadDoors(Settings::Manager::getBool("preload doors", "Cells"))
     , mPreloadFastTravel(Settings::Manager::getBool("preload fast travel", "Cells"))
     , mPredictionTime(Settings::Manager::getFloat("prediction time", "Cells"))
+    , mPredictionSteps(std::max(1, Settings::Manager::getInt("prediction steps", "Cells")))
+    , mPlayerTrajectory(0.5f, Constants::CellSizeInUnits)
     {
         mPreloader.reset(new CellPreloader(rendering.getResourceSystem(), physics->getShapeManager(), rendering.getTerrain(), rendering.getLandManager()));
         mPreloader->setWorkQueue(mRendering.getWorkQueue());
@@ -957,6 +988,8 @@ namespace MWWorld
         {
         }
 
+        const char* getProfileName() const override { return "PreloadMeshItem"; }
+
         void doWork() override
         {
             if (mAborted)
@@ -1005,14 +1038,12 @@ namespace MWWorld
 
         const MWWorld::ConstPtr player = MWBase::Environment::get().getWorld()->getPlayerPtr();
         osg::Vec3f playerPos = player.getRefData().getPosition().asVec3();
-        osg::Vec3f moved = playerPos - mLastPlayerPos;
-        osg::Vec3f predictedPos = playerPos + moved / dt * mPredictionTime;
+        mPlayerTrajectory.update(playerPos, dt);
+        osg::Vec3f predictedPos = mPlayerTrajectory.predict(mPredictionTime);
 
         if (mCurrentCell->isExterior())
             exteriorPositions.emplace_back(predictedPos, gridCenterToBounds(getNewGridCenter(predictedPos, &mCurrentGridCenter)));
 
-        mLastPlayerPos = playerPos;
-
         if (mPreloadEnabled)
         {
             if (mPreloadDoors)
@@ -1023,9 +1054,31 @@ namespace MWWorld
                 preloadFastTravelDestinations(playerPos, predictedPos, exteriorPositions);
         }
 
+        if (mCurrentCell->isExterior())
+            preloadTerrainAhead(predictedPos, exteriorPositions);
+
         mPreloader->setTerrainPreloadPositions(exteriorPositions);
     }
 
+    void Scene::preloadTerrainAhead(const osg::Vec3f& predictedPos, std::vector<PositionCellGrid>& exteriorPositions)
+    {
+        // Positions further along the trajectory are speculative, so they go last and only use otherwise idle workers.
+        // The preloader cancels them when the player changes direction.
+        if (mRendering.getWorkQueue()->getNumItems() > 0)
+            return;
+
+        osg::Vec3f lastPos = predictedPos;
+        for (int step = 2; step <= mPredictionSteps; ++step)
+        {
+            const osg::Vec3f pos = mPlayerTrajectory.predict(mPredictionTime * step);
+            // The terrain and objects needed at positions that close are already preloaded
+            if ((pos - lastPos).length2() < mCellLoadingThreshold * mCellLoadingThreshold)
+                break;
+            exteriorPositions.emplace_back(pos, gridCenterToBounds(getNewGridCenter(pos, &mCurrentGridCenter)));
+            lastPos = pos;
+        }
+    }
+
     void Scene::preloadTeleportDoorDestinations(const osg::Vec3f& playerPos, const osg::Vec3f& predictedPos, std::vector<PositionCellGrid>& exteriorPositions)
     {
         std::vector<MWWorld::ConstPtr> teleportDoors;
@@ -1147,6 +1200,11 @@ namespace MWWorld
         mPreloader->setTerrainPreloadPositions(std::vector<PositionCellGrid>());
     }
 
+    void Scene::reportStats(unsigned int frameNumber, osg::Stats& stats)
+    {
+        mPreloader->reportStats(frameNumber, stats);
+    }
+
     struct ListFastTravelDestinationsVisitor
     {
         ListFastTravelDestinationsVisitor(float preloadDist, const osg::Vec3f& playerPos)
@@ -7,6 +7,7 @@
 
 #include "ptr.hpp"
 #include "globals.hpp"
+#include "trajectorypredictor.hpp"
 
 #include <set>
 #include <memory>
@@ -18,6 +19,7 @@
 namespace osg
 {
     class Vec3f;
+    class Stats;
 }
 
 namespace ESM
@@ -90,10 +92,11 @@ namespace MWWorld
             bool mPreloadDoors;
             bool mPreloadFastTravel;
             float mPredictionTime;
+            int mPredictionSteps;
 
             static const int mHalfGridSize = Constants::CellGridRadius;
 
-            osg::Vec3f mLastPlayerPos;
+            TrajectoryPredictor mPlayerTrajectory;
 
             std::set<ESM::RefNum> mPagedRefs;
 
@@ -111,6 +114,7 @@ namespace MWWorld
             void preloadTeleportDoorDestinations(const osg::Vec3f& playerPos, const osg::Vec3f& predictedPos, std::vector<PositionCellGrid>& exteriorPositions);
             void preloadExteriorGrid(const osg::Vec3f& playerPos, const osg::Vec3f& predictedPos);
             void preloadFastTravelDestinations(const osg::Vec3f& playerPos, const osg::Vec3f& predictedPos, std::vector<PositionCellGrid>& exteriorPositions);
+            void preloadTerrainAhead(const osg::Vec3f& predictedPos, std::vector<PositionCellGrid>& exteriorPositions);
 
             osg::Vec4i gridCenterToBounds(const osg::Vec2i &centerCell) const;
             osg::Vec2i getNewGridCenter(const osg::Vec3f &pos, const osg::Vec2i *currentGridCenter = nullptr) const;
@@ -129,6 +133,8 @@ namespace MWWorld
             void preloadTerrain(const osg::Vec3f& pos, bool sync=false);
             void reloadTerrain();
 
+            void reportStats(unsigned int frameNumber, osg::Stats& stats);
+
             void playerMoved (const osg::Vec3f& pos);
 
             void changePlayerCell (CellStore* newCell, const ESM::Position& position, bool adjustPlayerPos);
@@ -0,0 +1,33 @@
+#include "trajectorypredictor.hpp"
+
+#include <algorithm>
+
+namespace MWWorld
+{
+    TrajectoryPredictor::TrajectoryPredictor(float smoothingTime, float teleportDistance)
+        : mSmoothingTime(smoothingTime)
+        , mTeleportDistance(teleportDistance)
+    {
+    }
+
+    void TrajectoryPredictor::reset(const osg::Vec3f& position)
+    {
+        mPosition = position;
+        mVelocity = osg::Vec3f();
+    }
+
+    void TrajectoryPredictor::update(const osg::Vec3f& position, float duration)
+    {
+        const osg::Vec3f moved = position - mPosition;
+        if (duration <= 0.f || moved.length2() > mTeleportDistance * mTeleportDistance)
+        {
+            reset(position);
+            return;
+        }
+
+        // Exponential moving average, so the result doesn't depend much on the framerate
+        const float weight = mSmoothingTime > 0.f ? std::min(1.f, duration / mSmoothingTime) : 1.f;
+        mVelocity += (moved / duration - mVelocity) * weight;
+        mPosition = position;
+    }
+}
@@ -0,0 +1,38 @@
+#ifndef OPENMW_MWWORLD_TRAJECTORYPREDICTOR_H
+#define OPENMW_MWWORLD_TRAJECTORYPREDICTOR_H
+
+#include <osg/Vec3f>
+
+namespace MWWorld
+{
+    /// @brief Extrapolates the player trajectory to find out where distant terrain and objects will be needed.
+    /// The velocity is averaged over a short time, so that a single frame of jumping or turning around doesn't
+    /// make us preload positions that are never reached.
+    class TrajectoryPredictor
+    {
+    public:
+        /// @param smoothingTime Time (in seconds) over which the velocity is averaged.
+        /// @param teleportDistance Moving further than this in one update is a teleport and resets the prediction.
+        TrajectoryPredictor(float smoothingTime, float teleportDistance);
+
+        /// Forget the velocity, e.g. after a teleport.
+        void reset(const osg::Vec3f& position);
+
+        void update(const osg::Vec3f& position, float duration);
+
+        const osg::Vec3f& getPosition() const { return mPosition; }
+
+        const osg::Vec3f& getVelocity() const { return mVelocity; }
+
+        /// Predicted position in `time` seconds.
+        osg::Vec3f predict(float time) const { return mPosition + mVelocity * time; }
+
+    private:
+        float mSmoothingTime;
+        float mTeleportDistance;
+        osg::Vec3f mPosition;
+        osg::Vec3f mVelocity;
+    };
+}
+
+#endif
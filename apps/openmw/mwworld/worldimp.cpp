@@ -24,6 +24,9 @@
 
 #include <components/files/collections.hpp>
 
+#include <components/terrain/bakedterrain.hpp>
+#include <components/terrain/world.hpp>
+
 #include <components/resource/bulletshape.hpp>
 #include <components/resource/resourcesystem.hpp>
 
@@ -121,6 +124,22 @@ namespace MWWorld
         }
     };
 
+    namespace
+    {
+        std::vector<boost::filesystem::path> getContentPaths(const Files::Collections& fileCollections,
+                                                             const std::vector<std::string>& contentFiles)
+        {
+            std::vector<boost::filesystem::path> result;
+            for (const std::string& file : contentFiles)
+            {
+                const Files::MultiDirCollection& col = fileCollections.getCollection(boost::filesystem::path(file).extension().string());
+                if (col.doesExist(file))
+                    result.push_back(col.getPath(file));
+            }
+            return result;
+        }
+    }
+
     void World::adjustSky()
     {
         if (mSky && (isCellExterior() || isCellQuasiExterior()))
@@ -194,7 +213,16 @@ namespace MWWorld
             mNavigator = DetourNavigator::makeNavigatorStub();
         }
 
-        mRendering.reset(new MWRender::RenderingManager(viewer, rootNode, resourceSystem, workQueue, resourcePath, *mNavigator, mGroundcoverStore));
+        mRendering.reset(new MWRender::RenderingManager(viewer, rootNode, resourceSystem, workQueue, resourcePath, *mNavigator, mStore, mGroundcoverStore));
+        if (Settings::Manager::getBool("use baked terrain", "Terrain"))
+        {
+            const std::string contentKey = Terrain::BakedTerrain::makeContentKey(getContentPaths(fileCollections, contentFiles));
+            std::shared_ptr<const Terrain::BakedTerrain> bakedTerrain
+                = Terrain::BakedTerrain::load(boost::filesystem::path(userDataPath) / "terrain.bake", contentKey);
+            if (bakedTerrain != nullptr)
+                mRendering->getTerrain()->setBakedTerrain(std::move(bakedTerrain));
+        }
+
         mProjectileManager.reset(new ProjectileManager(mRendering->getLightRoot(), resourceSystem, mRendering.get(), mPhysics.get()));
         mRendering->preloadCommonAssets();
 
@@ -336,6 +364,21 @@ namespace MWWorld
         return mCells.countSavedGameRecords();
     }
 
+    int World::countBaseSaveCells() const
+    {
+        return mCells.countBaseSaveRecords();
+    }
+
+    int World::countChangedCells() const
+    {
+        return mCells.countChangedCells();
+    }
+
+    void World::setBaseSave (const ESM::BaseSaveState& baseSave)
+    {
+        mCells.setBaseSave(baseSave);
+    }
+
     void World::write (ESM::ESMWriter& writer, Loading::Listener& progress) const
     {
         // Active cells could have a dirty fog of war, sync it to the CellStore first
@@ -364,6 +407,27 @@ namespace MWWorld
         writer.endRecord(ESM::REC_CAM_);
     }
 
+    void World::writeBaseSave (ESM::ESMWriter& writer, Loading::Listener& progress)
+    {
+        for (CellStore* cellstore : mWorldScene->getActiveCells())
+        {
+            MWBase::Environment::get().getWindowManager()->writeFog(cellstore);
+        }
+
+        mCells.writeBaseSave (writer, progress);
+
+        // Objects in active cells are modified all the time without going through their CellStore. Cells are flagged
+        // as changed when they become active, so only the currently active ones need to be flagged again.
+        for (CellStore* cellstore : mWorldScene->getActiveCells())
+            cellstore->setChangedState(true);
+    }
+
+    void World::readBaseSave (ESM::ESMReader& reader, const ESM::BaseSaveState& baseSave,
+        const std::map<int, int>& contentFileMap)
+    {
+        mCells.readBaseSave (reader, baseSave, contentFileMap);
+    }
+
     void World::readRecord (ESM::ESMReader& reader, uint32_t type,
         const std::map<int, int>& contentFileMap)
     {
@@ -2763,6 +2827,29 @@ namespace MWWorld
         return mPhysics->getLineOfSight(actor, targetActor);
     }
 
+    void World::getLOS(const MWWorld::ConstPtr& actor, const std::vector<MWWorld::Ptr>& targetActors, std::vector<bool>& result)
+    {
+        result.assign(targetActors.size(), false);
+        if (!actor.getRefData().isEnabled() || !actor.getRefData().getBaseNode())
+            return;
+
+        std::vector<MWWorld::ConstPtr> targets;
+        std::vector<std::size_t> indices;
+        for (std::size_t i = 0; i < targetActors.size(); ++i)
+        {
+            const MWWorld::Ptr& target = targetActors[i];
+            if (!target.getRefData().isEnabled() || !target.getRefData().getBaseNode())
+                continue;
+            targets.push_back(target);
+            indices.push_back(i);
+        }
+
+        std::vector<bool> lineOfSight;
+        mPhysics->getLinesOfSight(actor, targets, lineOfSight);
+        for (std::size_t i = 0; i < indices.size(); ++i)
+            result[indices[i]] = lineOfSight[i];
+    }
+
     float World::getDistToNearestRayHit(const osg::Vec3f& from, const osg::Vec3f& dir, float maxDist, bool includeWater)
     {
         osg::Vec3f to (dir);
@@ -3973,10 +4060,11 @@ namespace MWWorld
         return mPhysics->isAreaOccupiedByOtherActor(position, radius, ignore, occupyingActors);
     }
 
-    void World::reportStats(unsigned int frameNumber, osg::Stats& stats) const
+    void World::reportStats(unsigned int frameNumber, osg::Stats& stats)
     {
         mNavigator->reportStats(frameNumber, stats);
         mPhysics->reportStats(frameNumber, stats);
+        mWorldScene->reportStats(frameNumber, stats);
     }
 
     void World::updateSkyDate()
@@ -200,12 +200,28 @@ namespace MWWorld
 
             int countSavedGameRecords() const override;
             int countSavedGameCells() const override;
+            int countBaseSaveCells() const override;
+
+            int countChangedCells() const override;
+            ///< Number of cells whose state might have changed since the base saved game was written or read.
+
+            void setBaseSave (const ESM::BaseSaveState& baseSave) override;
+            ///< If the name is not empty, write() only includes the state of changed cells and references the base
+            /// saved game for the others.
 
             void write (ESM::ESMWriter& writer, Loading::Listener& progress) const override;
 
+            void writeBaseSave (ESM::ESMWriter& writer, Loading::Listener& progress) override;
+            ///< Write the state of all cells to a base saved game.
+
             void readRecord (ESM::ESMReader& reader, uint32_t type,
                 const std::map<int, int>& contentFileMap) override;
 
+            void readBaseSave (ESM::ESMReader& reader, const ESM::BaseSaveState& baseSave,
+                const std::map<int, int>& contentFileMap) override;
+            ///< Read the state of cells that have not changed since the base saved game was written.
+            /// \param baseSave REC_BASE record of the saved game referencing the base saved game.
+
             CellStore *getExterior (int x, int y) override;
 
             CellStore *getInterior (const std::string& name) override;
@@ -572,6 +588,10 @@ namespace MWWorld
             bool getLOS(const MWWorld::ConstPtr& actor,const MWWorld::ConstPtr& targetActor) override;
             ///< get Line of Sight (morrowind stupid implementation)
 
+            void getLOS(const MWWorld::ConstPtr& actor, const std::vector<MWWorld::Ptr>& targetActors,
+                std::vector<bool>& result) override;
+            ///< get Line of Sight for every target actor at once
+
             float getDistToNearestRayHit(const osg::Vec3f& from, const osg::Vec3f& dir, float maxDist, bool includeWater = false) override;
 
             void enableActorCollision(const MWWorld::Ptr& actor, bool enable) override;
@@ -733,7 +753,7 @@ namespace MWWorld
             bool isAreaOccupiedByOtherActor(const osg::Vec3f& position, const float radius,
                 const MWWorld::ConstPtr& ignore, std::vector<MWWorld::Ptr>* occupyingActors) const override;
 
-            void reportStats(unsigned int frameNumber, osg::Stats& stats) const override;
+            void reportStats(unsigned int frameNumber, osg::Stats& stats) override;
 
             std::vector<MWWorld::Ptr> getAll(const std::string& id) override;
     };
@@ -106,6 +106,21 @@ namespace OpenMW
             ("random-seed", bpo::value <unsigned int> ()
                 ->default_value(Misc::Rng::generateDefaultSeed()),
                 "seed value for random number generator")
+
+            ("benchmark-frames", bpo::value<unsigned int>()->default_value(0),
+                "run the given number of frames with a fixed time step, write a summary of frame times and quit; "
+                "use together with --load-savegame or --skip-menu")
+
+            ("benchmark-fps", bpo::value<float>()->default_value(60, "60"), "simulated frame rate of the benchmark")
+
+            ("benchmark-path", bpo::value<Files::MaybeQuotedPath>()->default_value(Files::MaybeQuotedPath(), ""),
+                "file with the player path to follow during the benchmark: \"time x y z rotx roty rotz\" per line, rotations in degrees")
+
+            ("benchmark-report", bpo::value<Files::MaybeQuotedPath>()->default_value(Files::MaybeQuotedPath(), ""),
+                "JSON file to write the benchmark summary to, standard output is used by default")
+
+            ("benchmark-hidden-window", bpo::value<bool>()->implicit_value(true)
+                ->default_value(false), "don't show the window during the benchmark")
         ;
 
         return desc;
@@ -0,0 +1,122 @@
+#include <components/debug/frameprofiler.hpp>
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <string>
+#include <thread>
+
+namespace
+{
+    using namespace testing;
+    using namespace Debug;
+
+    std::string getTrace()
+    {
+        std::ostringstream stream;
+        FrameProfiler::writeChromeTrace(stream);
+        return stream.str();
+    }
+
+    std::size_t count(const std::string& value, const std::string& pattern)
+    {
+        std::size_t result = 0;
+        for (std::size_t pos = value.find(pattern); pos != std::string::npos; pos = value.find(pattern, pos + 1))
+            ++result;
+        return result;
+    }
+
+    struct DebugFrameProfilerTest : Test
+    {
+        ~DebugFrameProfilerTest()
+        {
+            FrameProfiler::stop();
+        }
+    };
+
+    TEST_F(DebugFrameProfilerTest, zoneShouldNotBeRecordedWhenProfilerIsStopped)
+    {
+        FrameProfiler::start();
+        FrameProfiler::stop();
+        {
+            const ProfileZone zone("stopped");
+        }
+        EXPECT_EQ(getTrace(), "{\"traceEvents\":[\n],\"displayTimeUnit\":\"ms\"}\n");
+    }
+
+    TEST_F(DebugFrameProfilerTest, zoneShouldBeWrittenAsCompleteEventWithThreadName)
+    {
+        FrameProfiler::start();
+        FrameProfiler::setThreadName("Test \"thread\"");
+        {
+            const ProfileZone zone("zone");
+        }
+        FrameProfiler::stop();
+        const std::string trace = getTrace();
+        EXPECT_NE(trace.find("{\"name\":\"thread_name\",\"ph\":\"M\""), std::string::npos) << trace;
+        EXPECT_NE(trace.find("\"args\":{\"name\":\"Test \\\"thread\\\"\"}}"), std::string::npos) << trace;
+        EXPECT_NE(trace.find("{\"name\":\"zone\",\"ph\":\"X\""), std::string::npos) << trace;
+    }
+
+    TEST_F(DebugFrameProfilerTest, startShouldDiscardPreviousZones)
+    {
+        FrameProfiler::start();
+        {
+            const ProfileZone zone("first");
+        }
+        FrameProfiler::start();
+        {
+            const ProfileZone zone("second");
+        }
+        FrameProfiler::stop();
+        const std::string trace = getTrace();
+        EXPECT_EQ(trace.find("\"first\""), std::string::npos) << trace;
+        EXPECT_NE(trace.find("\"second\""), std::string::npos) << trace;
+    }
+
+    TEST_F(DebugFrameProfilerTest, zonesOfDifferentThreadsShouldHaveDifferentThreadIds)
+    {
+        FrameProfiler::start();
+        {
+            const ProfileZone zone("main");
+        }
+        std::thread([] { const ProfileZone zone("worker"); }).join();
+        FrameProfiler::stop();
+        const std::string trace = getTrace();
+        EXPECT_EQ(count(trace, "\"thread_name\""), 2) << trace;
+        const std::size_t main = trace.find("{\"name\":\"main\"");
+        const std::size_t worker = trace.find("{\"name\":\"worker\"");
+        ASSERT_NE(main, std::string::npos);
+        ASSERT_NE(worker, std::string::npos);
+        const auto getTid = [&] (std::size_t pos)
+        {
+            const std::size_t begin = trace.find("\"tid\":", pos) + 6;
+            return trace.substr(begin, trace.find(',', begin) - begin);
+        };
+        EXPECT_NE(getTid(main), getTid(worker));
+    }
+
+    TEST_F(DebugFrameProfilerTest, shouldKeepOnlyLatestZonesOfThread)
+    {
+        FrameProfiler::start();
+        {
+            const ProfileZone zone("old");
+        }
+        for (std::size_t i = 0; i < FrameProfiler::sEventsPerThread; ++i)
+        {
+            const ProfileZone zone("new");
+        }
+        FrameProfiler::stop();
+        const std::string trace = getTrace();
+        EXPECT_EQ(count(trace, "\"old\""), 0);
+        EXPECT_EQ(count(trace, "\"new\""), FrameProfiler::sEventsPerThread);
+    }
+
+    TEST_F(DebugFrameProfilerTest, internShouldReturnSamePointerForEqualNames)
+    {
+        const std::string name = "handler";
+        const char* const interned = FrameProfiler::intern(name);
+        EXPECT_STREQ(interned, "handler");
+        EXPECT_EQ(FrameProfiler::intern(std::string(name)), interned);
+    }
+}
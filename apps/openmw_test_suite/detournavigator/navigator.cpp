@@ -5,10 +5,12 @@
 #include <components/detournavigator/exceptions.hpp>
 #include <components/detournavigator/navigatorutils.hpp>
 #include <components/detournavigator/navmeshdb.hpp>
+#include <components/detournavigator/settingsutils.hpp>
 #include <components/misc/rng.hpp>
 #include <components/loadinglistener/loadinglistener.hpp>
 #include <components/esm/loadland.hpp>
 #include <components/resource/bulletshape.hpp>
+#include <components/sceneutil/workqueue.hpp>
 #include <components/bullethelpers/heightfield.hpp>
 
 #include <osg/ref_ptr>
@@ -20,6 +22,7 @@
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
 
+#include <algorithm>
 #include <array>
 #include <deque>
 #include <memory>
@@ -188,6 +191,119 @@ namespace
         )) << mPath;
     }
 
+    TEST_F(DetourNavigatorNavigatorTest, find_paths_should_return_same_paths_as_find_path)
+    {
+        constexpr std::array<float, 5 * 5> heightfieldData {{
+            0,   0,    0,    0,    0,
+            0, -25,  -25,  -25,  -25,
+            0, -25, -100, -100, -100,
+            0, -25, -100, -100, -100,
+            0, -25, -100, -100, -100,
+        }};
+        const HeightfieldSurface surface = makeSquareHeightfieldSurface(heightfieldData);
+        const int cellSize = mHeightfieldTileSize * (surface.mSize - 1);
+
+        mNavigator->addAgent(mAgentHalfExtents);
+        mNavigator->addHeightfield(mCellPosition, cellSize, surface);
+        mNavigator->update(mPlayerPosition);
+        mNavigator->wait(mListener, WaitConditionType::requiredTilesPresent);
+
+        std::vector<PathRequest> requests;
+        for (int i = 0; i < 16; ++i)
+        {
+            const float shift = 16.0f * i;
+            requests.push_back(PathRequest {mAgentHalfExtents, mStepSize, mStart + osg::Vec3f(shift, 0, 0),
+                mEnd + osg::Vec3f(0, shift, 0), Flag_walk, mAreaCosts, mEndTolerance});
+        }
+        requests.push_back(PathRequest {osg::Vec3f(1, 1, 1), mStepSize, mStart, mEnd, Flag_walk, mAreaCosts, mEndTolerance});
+
+        const osg::ref_ptr<SceneUtil::WorkQueue> workQueue(new SceneUtil::WorkQueue(3));
+        const std::vector<PathResult> results = findPaths(*mNavigator, requests, workQueue.get(), 3);
+
+        ASSERT_EQ(results.size(), requests.size());
+        for (std::size_t i = 0; i < requests.size(); ++i)
+        {
+            std::vector<osg::Vec3f> path;
+            auto out = std::back_inserter(path);
+            const PathRequest& request = requests[i];
+            EXPECT_EQ(results[i].mStatus, findPath(*mNavigator, request.mAgentHalfExtents, request.mStepSize, request.mStart,
+                request.mEnd, request.mIncludeFlags, request.mAreaCosts, request.mEndTolerance, out)) << i;
+            EXPECT_EQ(results[i].mPath, path) << i;
+        }
+        EXPECT_EQ(results.back().mStatus, Status::NavMeshNotFound);
+    }
+
+    TEST_F(DetourNavigatorNavigatorTest, find_path_should_reuse_cached_path_for_same_request)
+    {
+        mSettings.mPathCacheSize = 16;
+        mNavigator.reset(new NavigatorImpl(mSettings, std::make_unique<NavMeshDb>(":memory:")));
+
+        constexpr std::array<float, 5 * 5> heightfieldData {{
+            0,   0,    0,    0,    0,
+            0, -25,  -25,  -25,  -25,
+            0, -25, -100, -100, -100,
+            0, -25, -100, -100, -100,
+            0, -25, -100, -100, -100,
+        }};
+        const HeightfieldSurface surface = makeSquareHeightfieldSurface(heightfieldData);
+        const int cellSize = mHeightfieldTileSize * (surface.mSize - 1);
+
+        mNavigator->addAgent(mAgentHalfExtents);
+        mNavigator->addHeightfield(mCellPosition, cellSize, surface);
+        mNavigator->update(mPlayerPosition);
+        mNavigator->wait(mListener, WaitConditionType::requiredTilesPresent);
+
+        EXPECT_EQ(findPath(*mNavigator, mAgentHalfExtents, mStepSize, mStart, mEnd, Flag_walk, mAreaCosts, mEndTolerance, mOut),
+                  Status::Success);
+        const std::deque<osg::Vec3f> firstPath = mPath;
+        mPath.clear();
+        EXPECT_EQ(findPath(*mNavigator, mAgentHalfExtents, mStepSize, mStart, mEnd, Flag_walk, mAreaCosts, mEndTolerance, mOut),
+                  Status::Success);
+
+        EXPECT_EQ(mPath, firstPath);
+        const PathCache::Stats stats = mNavigator->getNavMesh(mAgentHalfExtents)->lockConst()->getPathCache().getStats();
+        EXPECT_EQ(stats.mSize, 1);
+        EXPECT_EQ(stats.mHitCount, 1);
+        EXPECT_EQ(stats.mGetCount, 2);
+    }
+
+    TEST_F(DetourNavigatorNavigatorTest, tile_graph_should_have_same_tiles_as_navmesh)
+    {
+        constexpr std::array<float, 5 * 5> heightfieldData {{
+            0,   0,    0,    0,    0,
+            0, -25,  -25,  -25,  -25,
+            0, -25, -100, -100, -100,
+            0, -25, -100, -100, -100,
+            0, -25, -100, -100, -100,
+        }};
+        const HeightfieldSurface surface = makeSquareHeightfieldSurface(heightfieldData);
+        const int cellSize = mHeightfieldTileSize * (surface.mSize - 1);
+
+        mNavigator->addAgent(mAgentHalfExtents);
+        mNavigator->addHeightfield(mCellPosition, cellSize, surface);
+        mNavigator->update(mPlayerPosition);
+        mNavigator->wait(mListener, WaitConditionType::allJobsDone);
+
+        const auto navMesh = mNavigator->getNavMesh(mAgentHalfExtents);
+        {
+            const auto locked = navMesh->lockConst();
+            std::size_t usedTiles = 0;
+            locked->forEachUsedTile([&] (const TilePosition& position, const Version&, const dtMeshTile&)
+            {
+                ++usedTiles;
+                EXPECT_NE(locked->getTileGraph().getTile(position), nullptr);
+            });
+            EXPECT_GT(usedTiles, 0);
+            EXPECT_EQ(locked->getTileGraph().getTilesCount(), usedTiles);
+        }
+
+        mNavigator->removeHeightfield(mCellPosition);
+        mNavigator->update(mPlayerPosition);
+        mNavigator->wait(mListener, WaitConditionType::allJobsDone);
+
+        EXPECT_EQ(navMesh->lockConst()->getTileGraph().getTilesCount(), 0);
+    }
+
     TEST_F(DetourNavigatorNavigatorTest, add_object_should_change_navmesh)
     {
         const std::array<float, 5 * 5> heightfieldData {{
@@ -1132,4 +1248,92 @@ namespace
             Vec3fEq(306, 56.66666412353515625, -2.6667339801788330078125)
         )) << mPath;
     }
+
+    TEST_F(DetourNavigatorNavigatorTest, find_path_for_far_tiles_should_go_through_tile_graph_route)
+    {
+        mSettings.mDetour.mHierarchicalPathMinTilesDistance = 16;
+        mSettings.mMaxTilesNumber = 1024;
+        mNavigator.reset(new NavigatorImpl(mSettings, std::make_unique<NavMeshDb>(":memory:")));
+
+        const HeightfieldPlane plane {100};
+        const int cellSize = 4096;
+        const osg::Vec3f playerPosition(2 * cellSize, cellSize / 2, 0);
+        const osg::Vec3f start(600, cellSize / 2, 101);
+        const osg::Vec3f end(4 * cellSize - 600, cellSize / 2, 101);
+        const float stepSize = 64;
+
+        mNavigator->addAgent(mAgentHalfExtents);
+        for (int x = 0; x < 4; ++x)
+            mNavigator->addHeightfield(osg::Vec2i(x, 0), cellSize, plane);
+        mNavigator->update(playerPosition);
+        mNavigator->wait(mListener, WaitConditionType::allJobsDone);
+
+        const RecastSettings& recast = mSettings.mRecast;
+        const osg::Vec3f navMeshStart = toNavMeshCoordinates(recast, start);
+        const osg::Vec3f navMeshEnd = toNavMeshCoordinates(recast, end);
+        const TilePosition startTile = getTilePosition(recast, navMeshStart);
+        const TilePosition endTile = getTilePosition(recast, navMeshEnd);
+        ASSERT_GT(std::abs(endTile.x() - startTile.x()), mSettings.mDetour.mHierarchicalPathMinTilesDistance);
+
+        const auto route = mNavigator->getNavMesh(mAgentHalfExtents)->lockConst()->getTileGraph().findRoute(startTile,
+            navMeshStart, endTile, navMeshEnd, Flag_walk, static_cast<std::size_t>(mSettings.mDetour.mMaxNavMeshQueryNodes));
+        ASSERT_TRUE(route.has_value());
+        ASSERT_FALSE(route->empty());
+
+        EXPECT_EQ(findPath(*mNavigator, mAgentHalfExtents, stepSize, start, end, Flag_walk, mAreaCosts, mEndTolerance, mOut),
+                  Status::Success);
+
+        ASSERT_FALSE(mPath.empty());
+        EXPECT_NEAR(mPath.front().x(), start.x(), 1);
+        EXPECT_NEAR(mPath.front().y(), start.y(), 1);
+        EXPECT_NEAR(mPath.back().x(), end.x(), 1);
+        EXPECT_NEAR(mPath.back().y(), end.y(), 1);
+        for (std::size_t i = 1; i < mPath.size(); ++i)
+            EXPECT_LE((mPath[i] - mPath[i - 1]).length(), stepSize + 1) << i << " " << mPath;
+
+        // Portals are in the middle of the tile sides, a direct path along the strip doesn't go through them.
+        const auto isRoutePoint = [&] (const osg::Vec3f& point)
+        {
+            return std::any_of(route->begin(), route->end(), [&] (const osg::Vec3f& v)
+            {
+                const osg::Vec3f routePoint = fromNavMeshCoordinates(recast, v);
+                return std::abs(point.x() - routePoint.x()) < 0.1f && std::abs(point.y() - routePoint.y()) < 0.1f;
+            });
+        };
+        EXPECT_TRUE(std::any_of(mPath.begin(), mPath.end(), isRoutePoint)) << mPath;
+    }
+
+    TEST_F(DetourNavigatorNavigatorTest, find_path_for_far_tiles_without_tile_graph_route_should_return_direct_search_result)
+    {
+        mSettings.mMaxTilesNumber = 1024;
+
+        const HeightfieldPlane plane {100};
+        const int cellSize = 4096;
+        const osg::Vec3f playerPosition(2 * cellSize, cellSize / 2, 0);
+        const osg::Vec3f start(600, cellSize / 2, 101);
+        const osg::Vec3f end(4 * cellSize - 600, cellSize / 2, 101);
+        const float stepSize = 64;
+
+        const auto find = [&] (int hierarchicalPathMinTilesDistance, std::deque<osg::Vec3f>& path)
+        {
+            Settings settings = mSettings;
+            settings.mDetour.mHierarchicalPathMinTilesDistance = hierarchicalPathMinTilesDistance;
+            NavigatorImpl navigator(settings, std::make_unique<NavMeshDb>(":memory:"));
+            navigator.addAgent(mAgentHalfExtents);
+            // Cells in the middle are missing so the end is not reachable.
+            navigator.addHeightfield(osg::Vec2i(0, 0), cellSize, plane);
+            navigator.addHeightfield(osg::Vec2i(3, 0), cellSize, plane);
+            navigator.update(playerPosition);
+            navigator.wait(mListener, WaitConditionType::allJobsDone);
+            auto out = std::back_inserter(path);
+            return findPath(navigator, mAgentHalfExtents, stepSize, start, end, Flag_walk, mAreaCosts, mEndTolerance, out);
+        };
+
+        std::deque<osg::Vec3f> directPath;
+        EXPECT_EQ(find(0, directPath), Status::PartialPath);
+        ASSERT_FALSE(directPath.empty());
+
+        EXPECT_EQ(find(16, mPath), Status::PartialPath);
+        EXPECT_EQ(mPath, directPath);
+    }
 }
@@ -109,4 +109,80 @@ namespace
         EXPECT_THROW(mDb.insertTile(tileId, worldspace, tilePosition, version, input, data), std::runtime_error);
         EXPECT_NO_THROW(insertTile(TileId {54}, version));
     }
+
+    TEST_F(DetourNavigatorNavMeshDbTest, inserted_tile_portals_should_be_found_by_tile_id)
+    {
+        const TileId tileId {13};
+        insertTile(tileId, TileVersion {1});
+        const std::vector<std::byte> portals = generateData();
+        ASSERT_EQ(mDb.insertTilePortals(tileId, portals), 1);
+        EXPECT_EQ(mDb.getTilePortals(tileId), portals);
+    }
+
+    TEST_F(DetourNavigatorNavMeshDbTest, insert_tile_portals_should_replace_existing)
+    {
+        const TileId tileId {13};
+        insertTile(tileId, TileVersion {1});
+        ASSERT_EQ(mDb.insertTilePortals(tileId, generateData()), 1);
+        const std::vector<std::byte> portals = generateData();
+        ASSERT_EQ(mDb.insertTilePortals(tileId, portals), 1);
+        EXPECT_EQ(mDb.getTilePortals(tileId), portals);
+    }
+
+    TEST_F(DetourNavigatorNavMeshDbTest, insert_tile_portals_for_absent_tile_should_do_nothing)
+    {
+        EXPECT_EQ(mDb.insertTilePortals(TileId {13}, generateData()), 0);
+        EXPECT_EQ(mDb.getTilePortals(TileId {13}), std::nullopt);
+    }
+
+    TEST_F(DetourNavigatorNavMeshDbTest, tile_portals_should_not_be_found_after_tile_update)
+    {
+        const TileId tileId {13};
+        const TileVersion version {1};
+        insertTile(tileId, version);
+        ASSERT_EQ(mDb.insertTilePortals(tileId, generateData()), 1);
+        ASSERT_EQ(mDb.updateTile(tileId, version, generateData()), 1);
+        EXPECT_EQ(mDb.getTilePortals(tileId), std::nullopt);
+    }
+
+    TEST_F(DetourNavigatorNavMeshDbTest, inserted_cells_tiles_should_be_returned)
+    {
+        const CellTiles cellTiles {"sys::default", "1,2", "Morrowind.esm", generateData(), TilePosition(3, 4),
+            TilePosition(5, 6)};
+        ASSERT_EQ(mDb.insertCellTiles(cellTiles), 1);
+        const std::vector<CellTiles> result = mDb.getCellsTiles();
+        ASSERT_EQ(result.size(), 1);
+        EXPECT_EQ(result[0].mWorldspace, cellTiles.mWorldspace);
+        EXPECT_EQ(result[0].mCellId, cellTiles.mCellId);
+        EXPECT_EQ(result[0].mContentFiles, cellTiles.mContentFiles);
+        EXPECT_EQ(result[0].mDigest, cellTiles.mDigest);
+        EXPECT_EQ(result[0].mMinTile, cellTiles.mMinTile);
+        EXPECT_EQ(result[0].mMaxTile, cellTiles.mMaxTile);
+    }
+
+    TEST_F(DetourNavigatorNavMeshDbTest, insert_cells_tiles_should_replace_existing_for_the_same_cell)
+    {
+        ASSERT_EQ(mDb.insertCellTiles(CellTiles {"sys::default", "1,2", "Morrowind.esm", generateData(),
+            TilePosition(3, 4), TilePosition(5, 6)}), 1);
+        const std::vector<std::byte> digest = generateData();
+        ASSERT_EQ(mDb.insertCellTiles(CellTiles {"sys::default", "1,2", "Morrowind.esm\nTribunal.esm", digest,
+            TilePosition(3, 4), TilePosition(7, 8)}), 1);
+        const std::vector<CellTiles> result = mDb.getCellsTiles();
+        ASSERT_EQ(result.size(), 1);
+        EXPECT_EQ(result[0].mContentFiles, "Morrowind.esm\nTribunal.esm");
+        EXPECT_EQ(result[0].mDigest, digest);
+        EXPECT_EQ(result[0].mMaxTile, TilePosition(7, 8));
+    }
+
+    TEST_F(DetourNavigatorNavMeshDbTest, deleted_cells_tiles_should_not_be_returned)
+    {
+        ASSERT_EQ(mDb.insertCellTiles(CellTiles {"sys::default", "1,2", "Morrowind.esm", generateData(),
+            TilePosition(3, 4), TilePosition(5, 6)}), 1);
+        ASSERT_EQ(mDb.insertCellTiles(CellTiles {"sys::default", "2,2", "Morrowind.esm", generateData(),
+            TilePosition(3, 4), TilePosition(5, 6)}), 1);
+        ASSERT_EQ(mDb.deleteCellTiles("sys::default", "1,2"), 1);
+        const std::vector<CellTiles> result = mDb.getCellsTiles();
+        ASSERT_EQ(result.size(), 1);
+        EXPECT_EQ(result[0].mCellId, "2,2");
+    }
 }
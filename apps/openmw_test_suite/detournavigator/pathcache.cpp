@@ -0,0 +1,98 @@
+#include <components/detournavigator/pathcache.hpp>
+
+#include <gtest/gtest.h>
+
+#include <functional>
+#include <map>
+#include <optional>
+
+namespace
+{
+    using namespace testing;
+    using namespace DetourNavigator;
+
+    struct DetourNavigatorPathCacheTest : Test
+    {
+        std::map<TilePosition, Version> mTiles {{TilePosition(0, 0), Version {1, 1}}, {TilePosition(1, 0), Version {1, 2}}};
+        const std::function<std::optional<Version> (const TilePosition&)> mGetTileVersion = [this] (const TilePosition& position)
+        {
+            const auto it = mTiles.find(position);
+            return it == mTiles.end() ? std::optional<Version>() : it->second;
+        };
+
+        static PathCacheKey makeKey(dtPolyRef startRef)
+        {
+            return PathCacheKey {startRef, 2, osg::Vec3i(0, 0, 0), osg::Vec3i(1, 1, 1), 10, Flag_walk, AreaCosts {}, 0};
+        }
+
+        CachedPath makeValue() const
+        {
+            return CachedPath {Status::Success, {osg::Vec3f(0, 0, 0), osg::Vec3f(1, 1, 1)},
+                {mTiles.begin(), mTiles.end()}, true};
+        }
+    };
+
+    TEST_F(DetourNavigatorPathCacheTest, get_from_empty_should_return_empty)
+    {
+        PathCache cache(2);
+        EXPECT_FALSE(cache.get(makeKey(1), mGetTileVersion).has_value());
+    }
+
+    TEST_F(DetourNavigatorPathCacheTest, get_should_return_set_value)
+    {
+        PathCache cache(2);
+        cache.set(makeKey(1), makeValue());
+        const auto result = cache.get(makeKey(1), mGetTileVersion);
+        ASSERT_TRUE(result.has_value());
+        EXPECT_EQ(result->mStatus, Status::Success);
+        EXPECT_EQ(result->mPath, makeValue().mPath);
+    }
+
+    TEST_F(DetourNavigatorPathCacheTest, set_with_zero_capacity_should_not_store_value)
+    {
+        PathCache cache(0);
+        cache.set(makeKey(1), makeValue());
+        EXPECT_FALSE(cache.get(makeKey(1), mGetTileVersion).has_value());
+    }
+
+    TEST_F(DetourNavigatorPathCacheTest, set_should_remove_least_recently_used_when_full)
+    {
+        PathCache cache(2);
+        cache.set(makeKey(1), makeValue());
+        cache.set(makeKey(2), makeValue());
+        ASSERT_TRUE(cache.get(makeKey(1), mGetTileVersion).has_value());
+        cache.set(makeKey(3), makeValue());
+        EXPECT_TRUE(cache.get(makeKey(1), mGetTileVersion).has_value());
+        EXPECT_FALSE(cache.get(makeKey(2), mGetTileVersion).has_value());
+        EXPECT_TRUE(cache.get(makeKey(3), mGetTileVersion).has_value());
+    }
+
+    TEST_F(DetourNavigatorPathCacheTest, get_should_remove_value_when_tile_version_is_changed)
+    {
+        PathCache cache(2);
+        cache.set(makeKey(1), makeValue());
+        ++mTiles[TilePosition(1, 0)].mRevision;
+        EXPECT_FALSE(cache.get(makeKey(1), mGetTileVersion).has_value());
+        EXPECT_EQ(cache.getStats().mSize, 0);
+    }
+
+    TEST_F(DetourNavigatorPathCacheTest, get_should_remove_value_when_tile_is_removed)
+    {
+        PathCache cache(2);
+        cache.set(makeKey(1), makeValue());
+        mTiles.erase(TilePosition(0, 0));
+        EXPECT_FALSE(cache.get(makeKey(1), mGetTileVersion).has_value());
+    }
+
+    TEST_F(DetourNavigatorPathCacheTest, get_stats_should_count_hits)
+    {
+        PathCache cache(2);
+        cache.set(makeKey(1), makeValue());
+        cache.get(makeKey(1), mGetTileVersion);
+        cache.get(makeKey(2), mGetTileVersion);
+        const PathCache::Stats stats = cache.getStats();
+        EXPECT_EQ(stats.mSize, 1);
+        EXPECT_EQ(stats.mHitCount, 1);
+        EXPECT_EQ(stats.mGetCount, 2);
+    }
+}
@@ -8,6 +8,11 @@
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
 
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <thread>
+
 namespace
 {
     using namespace testing;
@@ -381,4 +386,64 @@ namespace
             for (int y = -1; y < 1; ++y)
                 ASSERT_EQ(manager.getMesh("other", TilePosition(x, y)), nullptr);
     }
+
+    TEST_F(DetourNavigatorTileCachedRecastMeshManagerTest, get_mesh_concurrently_with_modifications_should_return_consistent_result)
+    {
+        TileCachedRecastMeshManager manager(mSettings);
+        manager.setWorldspace("worldspace");
+        const btBoxShape boxShape(btVector3(20, 20, 100));
+        const CollisionShape shape(mInstance, boxShape, mObjectTransform);
+        const btTransform transform(btMatrix3x3::getIdentity(), btVector3(1000, 0, 0));
+        ASSERT_TRUE(manager.addObject(ObjectId(&boxShape), shape, btTransform::getIdentity(), AreaType::AreaType_ground));
+        std::atomic_bool stop {false};
+        std::size_t inconsistentMeshes = 0;
+        std::size_t outdatedMeshes = 0;
+        std::thread reader([&]
+        {
+            std::map<TilePosition, Version> lastVersions;
+            while (!stop)
+                for (int x = -1; x < 2; ++x)
+                    for (int y = -1; y < 1; ++y)
+                    {
+                        if (const auto mesh = manager.getMesh("worldspace", TilePosition(x, y)))
+                        {
+                            const Mesh& data = mesh->getMesh();
+                            const std::size_t verticesCount = data.getVerticesCount();
+                            if (data.getIndices().size() != data.getTrianglesCount() * 3
+                                    || std::any_of(data.getIndices().begin(), data.getIndices().end(),
+                                        [&] (int index) { return index < 0 || static_cast<std::size_t>(index) >= verticesCount; })
+                                    || mesh->getWater().size() > 1 || mesh->getMeshSources().size() > 1)
+                                ++inconsistentMeshes;
+                            // Meshes of a tile are only replaced by newer ones, even when the tile is removed and added again
+                            const Version version {mesh->getGeneration(), mesh->getRevision()};
+                            const auto [last, inserted] = lastVersions.emplace(TilePosition(x, y), version);
+                            if (!inserted)
+                            {
+                                if (version < last->second)
+                                    ++outdatedMeshes;
+                                last->second = version;
+                            }
+                            manager.reportNavMeshChange(TilePosition(x, y), version, Version {0, 0});
+                        }
+                        manager.getNewMesh("worldspace", TilePosition(x, y));
+                    }
+        });
+        const osg::Vec2i cellPosition(0, 0);
+        for (int i = 0; i < 100; ++i)
+        {
+            manager.updateObject(ObjectId(&boxShape), shape, i % 2 == 0 ? transform : btTransform::getIdentity(),
+                AreaType::AreaType_ground, [] (const TilePosition&) {});
+            manager.addWater(cellPosition, 256, 0.0f);
+            manager.removeWater(cellPosition);
+        }
+        const bool removed = manager.removeObject(ObjectId(&boxShape)).has_value();
+        stop = true;
+        reader.join();
+        EXPECT_TRUE(removed);
+        EXPECT_EQ(inconsistentMeshes, 0u);
+        EXPECT_EQ(outdatedMeshes, 0u);
+        for (int x = -1; x < 2; ++x)
+            for (int y = -1; y < 1; ++y)
+                EXPECT_EQ(manager.getMesh("worldspace", TilePosition(x, y)), nullptr);
+    }
 }
@@ -0,0 +1,193 @@
+#include <components/detournavigator/navmeshtileview.hpp>
+#include <components/detournavigator/tilegraph.hpp>
+
+#include <DetourNavMesh.h>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <array>
+#include <vector>
+
+namespace
+{
+    using namespace testing;
+    using namespace DetourNavigator;
+
+    constexpr float tileSize = 10;
+
+    TilePortal makePortal(TileSide side, std::uint32_t component, const osg::Vec3f& position)
+    {
+        const int axis = side == TileSide::PositiveX || side == TileSide::NegativeX ? 2 : 0;
+        return TilePortal {side, component, Flag_walk, position[axis] - tileSize / 2, position[axis] + tileSize / 2,
+            position.y() - 1, position.y() + 1, position};
+    }
+
+    struct DetourNavigatorTileGraphTest : Test
+    {
+        TileGraph mGraph;
+        const osg::Vec3f mStart {5, 0, 5};
+        const osg::Vec3f mEnd {25, 0, 5};
+
+        // Three tiles along x with portals at the middle of the borders.
+        DetourNavigatorTileGraphTest()
+        {
+            mGraph.setTile(TilePosition(0, 0), {makePortal(TileSide::PositiveX, 0, osg::Vec3f(10, 0, 5))});
+            mGraph.setTile(TilePosition(1, 0), {
+                makePortal(TileSide::NegativeX, 0, osg::Vec3f(10, 0, 5)),
+                makePortal(TileSide::PositiveX, 0, osg::Vec3f(20, 0, 5)),
+            });
+            mGraph.setTile(TilePosition(2, 0), {makePortal(TileSide::NegativeX, 0, osg::Vec3f(20, 0, 5))});
+        }
+
+        std::optional<std::vector<osg::Vec3f>> findRoute(Flags includeFlags = Flag_walk) const
+        {
+            return mGraph.findRoute(TilePosition(0, 0), mStart, TilePosition(2, 0), mEnd, includeFlags, 100);
+        }
+    };
+
+    TEST_F(DetourNavigatorTileGraphTest, find_route_in_the_same_tile_should_return_empty_route)
+    {
+        const auto result = mGraph.findRoute(TilePosition(0, 0), mStart, TilePosition(0, 0), osg::Vec3f(1, 0, 1),
+            Flag_walk, 100);
+        ASSERT_TRUE(result.has_value());
+        EXPECT_THAT(*result, IsEmpty());
+    }
+
+    TEST_F(DetourNavigatorTileGraphTest, find_route_should_go_through_overlapping_portals_of_neighbour_tiles)
+    {
+        const auto result = findRoute();
+        ASSERT_TRUE(result.has_value());
+        EXPECT_THAT(*result, ElementsAre(osg::Vec3f(10, 0, 5), osg::Vec3f(20, 0, 5)));
+    }
+
+    TEST_F(DetourNavigatorTileGraphTest, find_route_to_absent_tile_should_return_empty)
+    {
+        EXPECT_EQ(mGraph.findRoute(TilePosition(0, 0), mStart, TilePosition(3, 0), osg::Vec3f(35, 0, 5), Flag_walk, 100),
+                  std::nullopt);
+    }
+
+    TEST_F(DetourNavigatorTileGraphTest, find_route_should_not_connect_portals_of_different_components)
+    {
+        mGraph.setTile(TilePosition(1, 0), {
+            makePortal(TileSide::NegativeX, 0, osg::Vec3f(10, 0, 5)),
+            makePortal(TileSide::PositiveX, 1, osg::Vec3f(20, 0, 5)),
+        });
+        EXPECT_EQ(findRoute(), std::nullopt);
+    }
+
+    TEST_F(DetourNavigatorTileGraphTest, find_route_should_not_cross_portals_with_different_heights)
+    {
+        mGraph.setTile(TilePosition(2, 0), {makePortal(TileSide::NegativeX, 0, osg::Vec3f(20, 10, 5))});
+        EXPECT_EQ(findRoute(), std::nullopt);
+    }
+
+    TEST_F(DetourNavigatorTileGraphTest, find_route_should_not_use_portals_without_include_flags)
+    {
+        EXPECT_EQ(findRoute(Flag_swim), std::nullopt);
+    }
+
+    TEST_F(DetourNavigatorTileGraphTest, find_route_should_stop_after_max_nodes)
+    {
+        EXPECT_EQ(mGraph.findRoute(TilePosition(0, 0), mStart, TilePosition(2, 0), mEnd, Flag_walk, 2), std::nullopt);
+    }
+
+    TEST_F(DetourNavigatorTileGraphTest, find_route_should_not_go_through_removed_tile)
+    {
+        mGraph.removeTile(TilePosition(1, 0));
+        EXPECT_EQ(findRoute(), std::nullopt);
+    }
+
+    TEST_F(DetourNavigatorTileGraphTest, find_route_should_choose_shorter_way)
+    {
+        for (int x = 0; x < 3; ++x)
+        {
+            TilePortals portals = *mGraph.getTile(TilePosition(x, 0));
+            portals.push_back(makePortal(TileSide::PositiveZ, 0, osg::Vec3f(x * tileSize + 5, 0, 10)));
+            mGraph.setTile(TilePosition(x, 0), std::move(portals));
+            mGraph.setTile(TilePosition(x, 1), {
+                makePortal(TileSide::NegativeZ, 0, osg::Vec3f(x * tileSize + 5, 0, 10)),
+                makePortal(TileSide::PositiveX, 0, osg::Vec3f(x * tileSize + 10, 0, 15)),
+                makePortal(TileSide::NegativeX, 0, osg::Vec3f(x * tileSize, 0, 15)),
+            });
+        }
+        const auto result = findRoute();
+        ASSERT_TRUE(result.has_value());
+        EXPECT_THAT(*result, ElementsAre(osg::Vec3f(10, 0, 5), osg::Vec3f(20, 0, 5)));
+    }
+
+    struct DetourNavigatorMakeTilePortalsTest : Test
+    {
+        const std::array<float, 6 * 3> mVerts {
+            0, 0, 0,
+            0, 0, 10,
+            5, 0, 10,
+            5, 0, 0,
+            10, 0, 10,
+            10, 0, 0,
+        };
+        std::array<dtPoly, 2> mPolys {};
+        dtMeshHeader mHeader {};
+
+        // Two quads sharing an edge at x = 5 with edges on the +x and +z sides of the tile.
+        DetourNavigatorMakeTilePortalsTest()
+        {
+            mHeader.polyCount = static_cast<int>(mPolys.size());
+            mHeader.vertCount = static_cast<int>(mVerts.size() / 3);
+            mHeader.walkableClimb = 1;
+            setPoly(mPolys[0], {0, 1, 2, 3}, {0, DT_EXT_LINK | 2, 2, 0});
+            setPoly(mPolys[1], {3, 2, 4, 5}, {1, DT_EXT_LINK | 2, DT_EXT_LINK | 0, 0});
+        }
+
+        static void setPoly(dtPoly& poly, const std::array<unsigned short, 4>& verts,
+            const std::array<unsigned short, 4>& neis)
+        {
+            poly.vertCount = static_cast<unsigned char>(verts.size());
+            for (std::size_t i = 0; i < verts.size(); ++i)
+            {
+                poly.verts[i] = verts[i];
+                poly.neis[i] = neis[i];
+            }
+            poly.flags = Flag_walk;
+            poly.setType(DT_POLYTYPE_GROUND);
+        }
+
+        TilePortals makeTilePortals() const
+        {
+            NavMeshTileConstView view {};
+            view.mHeader = &mHeader;
+            view.mPolys = mPolys.data();
+            view.mVerts = mVerts.data();
+            return DetourNavigator::makeTilePortals(view);
+        }
+    };
+
+    TEST_F(DetourNavigatorMakeTilePortalsTest, should_merge_edges_of_connected_polygons_on_the_same_side)
+    {
+        EXPECT_THAT(makeTilePortals(), ElementsAre(
+            TilePortal {TileSide::PositiveX, 0, Flag_walk, 0, 10, -1, 1, osg::Vec3f(10, 0, 5)},
+            TilePortal {TileSide::PositiveZ, 0, Flag_walk, 0, 10, -1, 1, osg::Vec3f(5, 0, 10)}
+        ));
+    }
+
+    TEST_F(DetourNavigatorMakeTilePortalsTest, should_make_separate_portals_for_not_connected_polygons)
+    {
+        mPolys[0].neis[2] = 0;
+        mPolys[1].neis[0] = 0;
+        const TilePortals portals = makeTilePortals();
+        ASSERT_EQ(portals.size(), 3);
+        EXPECT_EQ(portals[1].mSide, TileSide::PositiveZ);
+        EXPECT_EQ(portals[2].mSide, TileSide::PositiveZ);
+        EXPECT_NE(portals[1].mComponent, portals[2].mComponent);
+        EXPECT_EQ(portals[1].mPosition, osg::Vec3f(2.5f, 0, 10));
+        EXPECT_EQ(portals[2].mPosition, osg::Vec3f(7.5f, 0, 10));
+    }
+
+    TEST_F(DetourNavigatorMakeTilePortalsTest, should_ignore_off_mesh_connections)
+    {
+        mPolys[1].setType(DT_POLYTYPE_OFFMESH_CONNECTION);
+        EXPECT_THAT(makeTilePortals(), ElementsAre(
+            TilePortal {TileSide::PositiveZ, 0, Flag_walk, 0, 5, -1, 1, osg::Vec3f(2.5f, 0, 10)}
+        ));
+    }
+}
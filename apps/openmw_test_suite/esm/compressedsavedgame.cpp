@@ -0,0 +1,168 @@
+#include <components/esm/compressedsavedgame.hpp>
+#include <components/esm/esmreader.hpp>
+#include <components/esm/esmwriter.hpp>
+#include <components/esm/defs.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+    using namespace testing;
+    using namespace ESM;
+
+    std::string makeSavedGame(std::size_t records, std::size_t recordSize)
+    {
+        std::ostringstream stream;
+        ESMWriter writer;
+        writer.setFormat(19);
+        writer.setRecordCount(static_cast<int>(records + 1));
+        writer.save(stream);
+        writer.startRecord(REC_SAVE);
+        writer.writeHNString("PLNA", "player");
+        writer.endRecord(REC_SAVE);
+        for (std::size_t i = 0; i < records; ++i)
+        {
+            writer.startRecord(REC_CSTA);
+            writer.writeHNT("INDX", static_cast<std::uint32_t>(i));
+            writer.writeHNString("DATA", std::string(recordSize, static_cast<char>('a' + i % 26)));
+            writer.endRecord(REC_CSTA);
+        }
+        writer.close();
+        return stream.str();
+    }
+
+    std::string compress(const std::string& data, std::size_t blockSize)
+    {
+        std::istringstream source(data);
+        std::ostringstream dest;
+        writeCompressedSavedGame(source, dest, blockSize);
+        return dest.str();
+    }
+
+    std::string readAll(std::istream& stream)
+    {
+        std::ostringstream result;
+        result << stream.rdbuf();
+        return result.str();
+    }
+
+    struct ESMCompressedSavedGameTest : Test
+    {
+        const std::string mData = makeSavedGame(100, 1000);
+    };
+
+    TEST_F(ESMCompressedSavedGameTest, compressed_should_be_smaller)
+    {
+        EXPECT_LT(compress(mData, 4096).size(), mData.size());
+    }
+
+    TEST_F(ESMCompressedSavedGameTest, open_uncompressed_should_return_same_data)
+    {
+        const Files::IStreamPtr stream = openSavedGame(std::make_unique<std::istringstream>(mData));
+        EXPECT_EQ(readAll(*stream), mData);
+    }
+
+    TEST_F(ESMCompressedSavedGameTest, open_compressed_should_return_original_data)
+    {
+        const Files::IStreamPtr stream = openSavedGame(std::make_unique<std::istringstream>(compress(mData, 4096)));
+        EXPECT_EQ(readAll(*stream), mData);
+    }
+
+    TEST_F(ESMCompressedSavedGameTest, compressed_stream_should_report_original_size)
+    {
+        const Files::IStreamPtr stream = openSavedGame(std::make_unique<std::istringstream>(compress(mData, 4096)));
+        stream->seekg(0, std::ios_base::end);
+        EXPECT_EQ(static_cast<std::size_t>(stream->tellg()), mData.size());
+    }
+
+    TEST_F(ESMCompressedSavedGameTest, compressed_stream_should_support_seek_backwards)
+    {
+        const Files::IStreamPtr stream = openSavedGame(std::make_unique<std::istringstream>(compress(mData, 4096)));
+        const std::size_t offset = mData.size() / 2;
+        stream->seekg(offset);
+        std::string second(100, '\0');
+        stream->read(second.data(), static_cast<std::streamsize>(second.size()));
+        EXPECT_EQ(second, mData.substr(offset, second.size()));
+        stream->seekg(10);
+        std::string first(10000, '\0');
+        stream->read(first.data(), static_cast<std::streamsize>(first.size()));
+        EXPECT_EQ(first, mData.substr(10, first.size()));
+    }
+
+    // Replaces the first compressed block by the given block size and data.
+    std::string corruptFirstBlock(const std::string& compressed, const std::string& original, std::uint32_t size,
+        const std::string& data)
+    {
+        // TES3 and SAVE records are copied as is, CMPR record has 16 bytes of header and 8 bytes of data.
+        std::size_t offset = 0;
+        for (int i = 0; i < 2; ++i)
+        {
+            std::uint32_t recordSize = 0;
+            std::memcpy(&recordSize, original.data() + offset + 4, sizeof(recordSize));
+            offset += 16 + recordSize;
+        }
+        offset += 16 + 8;
+        std::string result = compressed.substr(0, offset);
+        result.append(reinterpret_cast<const char*>(&size), sizeof(size));
+        result += data;
+        return result;
+    }
+
+    TEST_F(ESMCompressedSavedGameTest, block_smaller_than_header_should_be_rejected)
+    {
+        const std::string corrupted = corruptFirstBlock(compress(mData, 4096), mData, 4, std::string(4, '\0'));
+        const Files::IStreamPtr stream = openSavedGame(std::make_unique<std::istringstream>(corrupted));
+        std::string data(mData.size(), '\0');
+        EXPECT_ANY_THROW(stream->read(data.data(), static_cast<std::streamsize>(data.size())));
+    }
+
+    TEST_F(ESMCompressedSavedGameTest, block_with_too_large_original_size_should_be_rejected)
+    {
+        const std::size_t originalSize = maxCompressedSavedGameBlockSize + 1;
+        std::string block(reinterpret_cast<const char*>(&originalSize), sizeof(originalSize));
+        block += std::string(8, '\0');
+        const std::string corrupted = corruptFirstBlock(compress(mData, 4096), mData,
+            static_cast<std::uint32_t>(block.size()), block);
+        const Files::IStreamPtr stream = openSavedGame(std::make_unique<std::istringstream>(corrupted));
+        std::string data(mData.size(), '\0');
+        EXPECT_ANY_THROW(stream->read(data.data(), static_cast<std::streamsize>(data.size())));
+    }
+
+    TEST_F(ESMCompressedSavedGameTest, too_large_block_should_be_rejected)
+    {
+        const std::string corrupted = corruptFirstBlock(compress(mData, 4096), mData,
+            std::numeric_limits<std::uint32_t>::max(), std::string(16, '\0'));
+        const Files::IStreamPtr stream = openSavedGame(std::make_unique<std::istringstream>(corrupted));
+        std::string data(mData.size(), '\0');
+        EXPECT_ANY_THROW(stream->read(data.data(), static_cast<std::streamsize>(data.size())));
+    }
+
+    TEST_F(ESMCompressedSavedGameTest, reader_should_load_all_records_from_compressed)
+    {
+        ESMReader reader;
+        reader.open(openSavedGame(std::make_unique<std::istringstream>(compress(mData, 4096))), "save");
+        EXPECT_EQ(reader.getFormat(), 19);
+        ASSERT_TRUE(reader.hasMoreRecs());
+        EXPECT_EQ(reader.getRecName().toInt(), REC_SAVE);
+        reader.getRecHeader();
+        EXPECT_EQ(reader.getHNString("PLNA"), "player");
+        std::uint32_t count = 0;
+        while (reader.hasMoreRecs())
+        {
+            EXPECT_EQ(reader.getRecName().toInt(), REC_CSTA);
+            reader.getRecHeader();
+            std::uint32_t index = 0;
+            reader.getHNT(index, "INDX");
+            EXPECT_EQ(index, count);
+            EXPECT_EQ(reader.getHNString("DATA"), std::string(1000, static_cast<char>('a' + count % 26)));
+            ++count;
+        }
+        EXPECT_EQ(count, 100u);
+    }
+}
@@ -0,0 +1,71 @@
+#include <components/esm/savedgame.hpp>
+#include <components/esm/esmreader.hpp>
+#include <components/esm/esmwriter.hpp>
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <sstream>
+#include <string>
+
+namespace
+{
+    using namespace testing;
+    using namespace ESM;
+
+    struct ESMSavedGameTest : Test
+    {
+        SavedGame mProfile;
+
+        ESMSavedGameTest()
+        {
+            mProfile.mPlayerName = "player";
+            mProfile.mPlayerLevel = 3;
+            mProfile.mPlayerClassId = "warrior";
+            mProfile.mPlayerCell = "cell";
+            mProfile.mInGameTime = EpochTimeStamp {};
+            mProfile.mTimePlayed = 42;
+            mProfile.mDescription = "description";
+            mProfile.mContentFiles = {"Morrowind.esm", "Tribunal.esm"};
+            mProfile.mScreenshot = {'j', 'p', 'g'};
+        }
+
+        SavedGame saveAndLoad(const SavedGame& profile)
+        {
+            auto stream = std::make_unique<std::stringstream>();
+            ESMWriter writer;
+            writer.setFormat(SavedGame::sCurrentFormat);
+            writer.save(*stream);
+            writer.startRecord(REC_SAVE);
+            profile.save(writer);
+            writer.endRecord(REC_SAVE);
+            writer.close();
+
+            ESMReader reader;
+            reader.open(std::move(stream), "save");
+            EXPECT_EQ(reader.getRecName().toInt(), REC_SAVE);
+            reader.getRecHeader();
+            SavedGame result;
+            result.load(reader);
+            EXPECT_FALSE(reader.hasMoreSubs());
+            return result;
+        }
+    };
+
+    TEST_F(ESMSavedGameTest, save_and_load_should_keep_empty_base_save)
+    {
+        const SavedGame result = saveAndLoad(mProfile);
+        EXPECT_EQ(result.mBaseSave, "");
+        EXPECT_EQ(result.mContentFiles, mProfile.mContentFiles);
+        EXPECT_EQ(result.mScreenshot, mProfile.mScreenshot);
+    }
+
+    TEST_F(ESMSavedGameTest, save_and_load_should_keep_base_save)
+    {
+        mProfile.mBaseSave = "Base - 1.omwbase";
+        const SavedGame result = saveAndLoad(mProfile);
+        EXPECT_EQ(result.mBaseSave, mProfile.mBaseSave);
+        EXPECT_EQ(result.mContentFiles, mProfile.mContentFiles);
+        EXPECT_EQ(result.mScreenshot, mProfile.mScreenshot);
+    }
+}
@@ -0,0 +1,132 @@
+#include <components/lua/luaallocator.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstring>
+
+namespace
+{
+    using namespace testing;
+    using namespace LuaUtil;
+
+    struct LuaAllocatorTest : Test
+    {
+        LuaAllocator mAllocator;
+    };
+
+    TEST_F(LuaAllocatorTest, allocate_should_return_aligned_pointer)
+    {
+        void* ptr = mAllocator.reallocate(nullptr, 0, 1);
+        ASSERT_NE(ptr, nullptr);
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(ptr) % 8, 0);
+        mAllocator.reallocate(ptr, 1, 0);
+    }
+
+    TEST_F(LuaAllocatorTest, small_allocation_should_be_served_by_pool)
+    {
+        void* ptr = mAllocator.reallocate(nullptr, 0, 100);
+        ASSERT_NE(ptr, nullptr);
+        EXPECT_EQ(mAllocator.getStats().mUsed, 100);
+        EXPECT_EQ(mAllocator.getStats().mPoolAllocations, 1);
+        EXPECT_EQ(mAllocator.getStats().mPoolReserved, LuaAllocator::sChunkSize);
+        EXPECT_EQ(mAllocator.getStats().mLargeUsed, 0);
+        mAllocator.reallocate(ptr, 100, 0);
+        EXPECT_EQ(mAllocator.getStats().mUsed, 0);
+        EXPECT_EQ(mAllocator.getStats().mPoolUsed, 0);
+    }
+
+    TEST_F(LuaAllocatorTest, large_allocation_should_not_be_served_by_pool)
+    {
+        void* ptr = mAllocator.reallocate(nullptr, 0, 1000);
+        ASSERT_NE(ptr, nullptr);
+        EXPECT_EQ(mAllocator.getStats().mUsed, 1000);
+        EXPECT_EQ(mAllocator.getStats().mPoolAllocations, 0);
+        EXPECT_EQ(mAllocator.getStats().mPoolReserved, 0);
+        EXPECT_GE(mAllocator.getStats().mLargeUsed, 1000);
+        mAllocator.reallocate(ptr, 1000, 0);
+        EXPECT_EQ(mAllocator.getStats().mUsed, 0);
+        EXPECT_EQ(mAllocator.getStats().mLargeUsed, 0);
+    }
+
+    TEST_F(LuaAllocatorTest, freed_block_should_be_reused)
+    {
+        void* first = mAllocator.reallocate(nullptr, 0, 32);
+        mAllocator.reallocate(first, 32, 0);
+        void* second = mAllocator.reallocate(nullptr, 0, 30);
+        EXPECT_EQ(first, second);
+        mAllocator.reallocate(second, 30, 0);
+    }
+
+    TEST_F(LuaAllocatorTest, reallocate_should_keep_data)
+    {
+        constexpr char data[] = "0123456789";
+        char* ptr = static_cast<char*>(mAllocator.reallocate(nullptr, 0, sizeof(data)));
+        std::memcpy(ptr, data, sizeof(data));
+        const std::size_t sizes[] = {100, 500, 5000, 50, sizeof(data)};
+        for (std::size_t size : sizes)
+        {
+            ptr = static_cast<char*>(mAllocator.reallocate(ptr, sizeof(data), size));
+            ASSERT_NE(ptr, nullptr);
+            EXPECT_EQ(std::memcmp(ptr, data, sizeof(data)), 0) << size;
+            ptr = static_cast<char*>(mAllocator.reallocate(ptr, size, sizeof(data)));
+        }
+        mAllocator.reallocate(ptr, sizeof(data), 0);
+        EXPECT_EQ(mAllocator.getStats().mUsed, 0);
+    }
+
+    TEST_F(LuaAllocatorTest, memory_should_be_attributed_to_active_script)
+    {
+        void* engine = mAllocator.reallocate(nullptr, 0, 10);
+        void* first = nullptr;
+        void* second = nullptr;
+        {
+            ActiveScriptScope scope(mAllocator, 1);
+            first = mAllocator.reallocate(nullptr, 0, 20);
+            {
+                ActiveScriptScope nested(mAllocator, 3);
+                second = mAllocator.reallocate(nullptr, 0, 300);
+            }
+            EXPECT_EQ(mAllocator.getActiveScript(), 1);
+        }
+        EXPECT_EQ(mAllocator.getActiveScript(), LuaAllocator::sNoScript);
+        EXPECT_EQ(mAllocator.getScriptMemoryUsage(0), 0);
+        EXPECT_EQ(mAllocator.getScriptMemoryUsage(1), 20);
+        EXPECT_EQ(mAllocator.getScriptMemoryUsage(3), 300);
+        EXPECT_EQ(mAllocator.getStats().mUsed, 330);
+
+        // Memory stays attributed to the script that allocated it
+        {
+            ActiveScriptScope scope(mAllocator, 3);
+            first = mAllocator.reallocate(first, 20, 200);
+            mAllocator.reallocate(second, 300, 0);
+        }
+        EXPECT_EQ(mAllocator.getScriptMemoryUsage(1), 200);
+        EXPECT_EQ(mAllocator.getScriptMemoryUsage(3), 0);
+
+        mAllocator.reallocate(first, 200, 0);
+        mAllocator.reallocate(engine, 10, 0);
+        EXPECT_EQ(mAllocator.getScriptMemoryUsage(1), 0);
+        EXPECT_EQ(mAllocator.getStats().mUsed, 0);
+    }
+
+    TEST_F(LuaAllocatorTest, allocation_should_fail_when_script_memory_limit_is_exceeded)
+    {
+        mAllocator.setScriptMemoryLimit(1000);
+        void* engine = mAllocator.reallocate(nullptr, 0, 2000);
+        EXPECT_NE(engine, nullptr);
+
+        ActiveScriptScope scope(mAllocator, 0);
+        void* ptr = mAllocator.reallocate(nullptr, 0, 600);
+        ASSERT_NE(ptr, nullptr);
+        EXPECT_EQ(mAllocator.reallocate(nullptr, 0, 600), nullptr);
+        EXPECT_EQ(mAllocator.reallocate(ptr, 600, 1200), nullptr);
+        EXPECT_EQ(mAllocator.getStats().mFailedAllocations, 2);
+        EXPECT_EQ(mAllocator.getScriptMemoryUsage(0), 600);
+
+        ptr = mAllocator.reallocate(ptr, 600, 100);
+        ASSERT_NE(ptr, nullptr);
+        mAllocator.reallocate(ptr, 100, 0);
+        mAllocator.reallocate(engine, 2000, 0);
+    }
+}
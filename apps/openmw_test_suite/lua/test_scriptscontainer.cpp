@@ -460,4 +460,28 @@ return {
         EXPECT_EQ(internal::GetCapturedStdout(), "Ignored callback to the removed script some_script.lua\n");
     }
 
+    TEST_F(LuaScriptsContainerTest, Profiler)
+    {
+        LuaUtil::ScriptsContainer scripts(&mLua, "Test");
+        mLua.getProfiler().start();
+        testing::internal::CaptureStdout();
+        EXPECT_TRUE(scripts.addCustomScript(*mCfg.findId("test1.lua")));
+        scripts.update(1.5f);
+        scripts.update(2.5f);
+        scripts.receiveEvent("Print", "");
+        internal::GetCapturedStdout();
+        mLua.getProfiler().stop();
+
+        const std::string report = mLua.getProfiler().getReport(10);
+        EXPECT_THAT(report, HasSubstr("| 2 | "));
+        EXPECT_THAT(report, HasSubstr("test1.lua onUpdate"));
+        EXPECT_THAT(report, HasSubstr("test1.lua Print"));
+        EXPECT_THAT(report, HasSubstr("test1.lua start"));
+
+        std::ostringstream trace;
+        mLua.getProfiler().writeChromeTrace(trace);
+        EXPECT_THAT(trace.str(), HasSubstr(R"("name":"onUpdate","cat":"test1.lua","ph":"X")"));
+        EXPECT_THAT(trace.str(), HasSubstr(R"("name":"Print","cat":"test1.lua","ph":"X")"));
+    }
+
 }
@@ -217,4 +217,37 @@ namespace
         EXPECT_EQ(ry.b, 3);
     }
 
+    TEST(LuaSerializationTest, Copy)
+    {
+        sol::state lua;
+        EXPECT_EQ(LuaUtil::copy(lua, sol::nil), sol::nil);
+
+        sol::table table(lua, sol::create);
+        table["aa"] = 1;
+        table["bb"] = "something";
+        table["nested"] = sol::table(lua, sol::create);
+        table["nested"]["x"] = TestStruct1{1.5, 2.5};
+        table["nested"][5] = osg::Vec3f(1, 2, 3);
+        TestSerializer serializer;
+
+        EXPECT_ERROR(LuaUtil::copy(lua, table), "Value is not serializable.");
+        sol::table res = LuaUtil::copy(lua, table, &serializer);
+        EXPECT_EQ(res.get<int>("aa"), 1);
+        EXPECT_EQ(res.get<std::string>("bb"), "something");
+        EXPECT_EQ(res.get<sol::table>("nested").get<TestStruct1>("x").a, 1.5);
+        EXPECT_EQ(res.get<sol::table>("nested").get<TestStruct1>("x").b, 2.5);
+        EXPECT_EQ(res.get<sol::table>("nested").get<osg::Vec3f>(5), osg::Vec3f(1, 2, 3));
+
+        // The copy doesn't share tables with the original
+        res["nested"]["y"] = 2;
+        EXPECT_EQ(table.get<sol::table>("nested").get<sol::object>("y"), sol::nil);
+
+        lua["f"] = [] {};
+        table["f"] = lua["f"];
+        EXPECT_ERROR(LuaUtil::copy(lua, table, &serializer), "Functions are not allowed to be serialized.");
+        sol::table recursive(lua, sol::create);
+        recursive["self"] = recursive;
+        EXPECT_ERROR(LuaUtil::copy(lua, recursive), "Can not serialize more than 32 nested tables.");
+    }
+
 }
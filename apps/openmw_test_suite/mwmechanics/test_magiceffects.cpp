@@ -0,0 +1,132 @@
+#include "apps/openmw/mwmechanics/magiceffects.hpp"
+
+#include <components/esm/loadskil.hpp>
+#include <components/esm/magiceffects.hpp>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+    using namespace testing;
+    using namespace MWMechanics;
+
+    const EffectKey light(ESM::MagicEffect::Light);
+    const EffectKey fortifyAcrobatics(ESM::MagicEffect::FortifySkill, ESM::Skill::Acrobatics);
+    const EffectKey fortifyAlchemy(ESM::MagicEffect::FortifySkill, ESM::Skill::Alchemy);
+
+    TEST(MWMechanicsMagicEffectsTest, get_absent_should_return_zero)
+    {
+        const MagicEffects effects;
+        EXPECT_EQ(effects.get(light).getMagnitude(), 0);
+        EXPECT_EQ(effects.get(fortifyAcrobatics).getMagnitude(), 0);
+    }
+
+    TEST(MWMechanicsMagicEffectsTest, add_should_sum_magnitudes_per_key)
+    {
+        MagicEffects effects;
+        effects.add(light, EffectParam(5));
+        effects.add(light, EffectParam(2));
+        effects.add(fortifyAcrobatics, EffectParam(3));
+        effects.modifyBase(fortifyAcrobatics, 1);
+        EXPECT_EQ(effects.get(light).getMagnitude(), 7);
+        EXPECT_EQ(effects.get(fortifyAcrobatics).getMagnitude(), 4);
+        EXPECT_EQ(effects.get(fortifyAlchemy).getMagnitude(), 0);
+        EXPECT_EQ(effects.get(ESM::MagicEffect::FortifySkill).getMagnitude(), 0);
+    }
+
+    TEST(MWMechanicsMagicEffectsTest, remove_should_reset_only_given_key)
+    {
+        MagicEffects effects;
+        effects.add(light, EffectParam(5));
+        effects.add(fortifyAcrobatics, EffectParam(3));
+        effects.add(fortifyAlchemy, EffectParam(2));
+        effects.remove(light);
+        effects.remove(fortifyAcrobatics);
+        EXPECT_EQ(effects.get(light).getMagnitude(), 0);
+        EXPECT_EQ(effects.get(fortifyAcrobatics).getMagnitude(), 0);
+        EXPECT_EQ(effects.get(fortifyAlchemy).getMagnitude(), 2);
+    }
+
+    TEST(MWMechanicsMagicEffectsTest, set_modifiers_should_copy_modifiers_and_keep_base)
+    {
+        MagicEffects effects;
+        effects.modifyBase(light, 1);
+        effects.add(light, EffectParam(5));
+        effects.add(fortifyAlchemy, EffectParam(2));
+        MagicEffects modifiers;
+        modifiers.add(fortifyAcrobatics, EffectParam(3));
+        effects.setModifiers(modifiers);
+        EXPECT_EQ(effects.get(light).getBase(), 1);
+        EXPECT_EQ(effects.get(light).getModifier(), 0);
+        EXPECT_EQ(effects.get(fortifyAlchemy).getModifier(), 0);
+        EXPECT_EQ(effects.get(fortifyAcrobatics).getModifier(), 3);
+    }
+
+    TEST(MWMechanicsMagicEffectsTest, diff_should_include_added_changed_and_removed)
+    {
+        MagicEffects prev;
+        prev.add(light, EffectParam(5));
+        prev.add(fortifyAlchemy, EffectParam(2));
+        MagicEffects now;
+        now.add(light, EffectParam(7));
+        now.add(fortifyAcrobatics, EffectParam(3));
+        const MagicEffects diff = MagicEffects::diff(prev, now);
+        EXPECT_EQ(diff.get(light).getMagnitude(), 2);
+        EXPECT_EQ(diff.get(fortifyAcrobatics).getMagnitude(), 3);
+        EXPECT_EQ(diff.get(fortifyAlchemy).getMagnitude(), -2);
+    }
+
+    TEST(MWMechanicsMagicEffectsTest, add_should_keep_modifier_of_new_effect_and_truncate_sums)
+    {
+        MagicEffects effects;
+        effects.add(light, EffectParam(0.1f));
+        effects.add(fortifyAcrobatics, EffectParam(0.1f));
+        EXPECT_EQ(effects.get(light).getModifier(), 0.1f);
+        EXPECT_EQ(effects.get(fortifyAcrobatics).getModifier(), 0.1f);
+        effects.add(light, EffectParam(0.1f));
+        EXPECT_EQ(effects.get(light).getModifier(), 204 / 1024.f);
+    }
+
+    TEST(MWMechanicsMagicEffectsTest, add_effects_should_keep_modifier_of_new_effect)
+    {
+        MagicEffects effects;
+        effects.add(light, EffectParam(1));
+        MagicEffects other;
+        other.add(light, EffectParam(0.1f));
+        other.add(ESM::MagicEffect::Jump, EffectParam(0.1f));
+        other.add(fortifyAcrobatics, EffectParam(0.1f));
+        effects += other;
+        EXPECT_EQ(effects.get(light).getModifier(), 1126 / 1024.f);
+        EXPECT_EQ(effects.get(ESM::MagicEffect::Jump).getModifier(), 0.1f);
+        EXPECT_EQ(effects.get(fortifyAcrobatics).getModifier(), 0.1f);
+    }
+
+    TEST(MWMechanicsMagicEffectsTest, diff_should_keep_modifier_of_added_effect)
+    {
+        MagicEffects prev;
+        prev.add(light, EffectParam(1));
+        MagicEffects now;
+        now.add(light, EffectParam(1.1f));
+        now.add(ESM::MagicEffect::Jump, EffectParam(0.1f));
+        now.add(fortifyAcrobatics, EffectParam(0.1f));
+        const MagicEffects diff = MagicEffects::diff(prev, now);
+        EXPECT_EQ(diff.get(light).getModifier(), 102 / 1024.f);
+        EXPECT_EQ(diff.get(ESM::MagicEffect::Jump).getModifier(), 0.1f);
+        EXPECT_EQ(diff.get(fortifyAcrobatics).getModifier(), 0.1f);
+    }
+
+    TEST(MWMechanicsMagicEffectsTest, write_state_should_skip_zero_effects)
+    {
+        MagicEffects effects;
+        effects.add(light, EffectParam(5));
+        effects.modifyBase(ESM::MagicEffect::Jump, 2);
+        effects.add(fortifyAlchemy, EffectParam(0));
+        ESM::MagicEffects state;
+        effects.writeState(state);
+        EXPECT_EQ(state.mEffects.size(), 2);
+        MagicEffects result;
+        result.readState(state);
+        EXPECT_EQ(result.get(light).getModifier(), 5);
+        EXPECT_EQ(result.get(ESM::MagicEffect::Jump).getBase(), 2);
+    }
+}
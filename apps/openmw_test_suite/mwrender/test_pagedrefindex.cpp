@@ -0,0 +1,95 @@
+#include "apps/openmw/mwrender/pagedrefindex.hpp"
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+namespace
+{
+    using namespace testing;
+    using namespace MWRender;
+
+    ESM::Position makePosition(float x, float y)
+    {
+        ESM::Position pos;
+        pos.pos[0] = x;
+        pos.pos[1] = y;
+        pos.pos[2] = 0;
+        pos.rot[0] = 0.5f;
+        pos.rot[1] = 0;
+        pos.rot[2] = 1;
+        return pos;
+    }
+
+    struct MWRenderPagedRefIndexTest : Test
+    {
+        PagedRefIndex mIndex;
+
+        std::vector<unsigned int> collect(const osg::Vec2i& begin, const osg::Vec2i& end) const
+        {
+            std::vector<unsigned int> result;
+            mIndex.forEachInCells(begin, end, [&] (std::size_t ref) { result.push_back(mIndex.getRefNum(ref).mIndex); });
+            return result;
+        }
+    };
+
+    TEST_F(MWRenderPagedRefIndexTest, should_store_reference_data)
+    {
+        mIndex.addCell(0, 0);
+        mIndex.addRef(ESM::RefNum {1, 0}, "meshes/a.nif", makePosition(10, 20), 2.f, 42);
+        mIndex.finish();
+        ASSERT_EQ(mIndex.size(), 1);
+        EXPECT_EQ(mIndex.getRefNum(0).mIndex, 1);
+        EXPECT_EQ(mIndex.getModel(0), "meshes/a.nif");
+        EXPECT_EQ(mIndex.getPosition(0), osg::Vec3f(10, 20, 0));
+        EXPECT_EQ(mIndex.getRotation(0), osg::Vec3f(0.5f, 0, 1));
+        EXPECT_EQ(mIndex.getScale(0), 2.f);
+        EXPECT_EQ(mIndex.getType(0), 42);
+        EXPECT_EQ(mIndex.getPos(0).asVec3(), osg::Vec3f(10, 20, 0));
+    }
+
+    TEST_F(MWRenderPagedRefIndexTest, should_store_flags)
+    {
+        mIndex.addCell(0, 0);
+        mIndex.addRef(ESM::RefNum {1, 0}, "meshes/a.nif", makePosition(0, 0), 1.f, 0);
+        mIndex.addRef(ESM::RefNum {2, 0}, "meshes/container.nif", makePosition(0, 0), 1.f, 0, PagedRefIndex::Flag_Near);
+        mIndex.addRef(ESM::RefNum {2, 0}, "meshes/static.nif", makePosition(0, 0), 1.f, 0, PagedRefIndex::Flag_Far);
+        mIndex.finish();
+        ASSERT_EQ(mIndex.size(), 3);
+        EXPECT_EQ(mIndex.getFlags(0), PagedRefIndex::Flag_Near | PagedRefIndex::Flag_Far);
+        EXPECT_EQ(mIndex.getFlags(1), PagedRefIndex::Flag_Near);
+        EXPECT_EQ(mIndex.getFlags(2), PagedRefIndex::Flag_Far);
+    }
+
+    TEST_F(MWRenderPagedRefIndexTest, should_share_models)
+    {
+        mIndex.addCell(0, 0);
+        mIndex.addRef(ESM::RefNum {1, 0}, "meshes/a.nif", makePosition(0, 0), 1.f, 0);
+        mIndex.addRef(ESM::RefNum {2, 0}, "meshes/b.nif", makePosition(0, 0), 1.f, 0);
+        mIndex.addRef(ESM::RefNum {3, 0}, "meshes/a.nif", makePosition(0, 0), 1.f, 0);
+        mIndex.finish();
+        EXPECT_EQ(mIndex.getModelIndex(0), mIndex.getModelIndex(2));
+        EXPECT_NE(mIndex.getModelIndex(0), mIndex.getModelIndex(1));
+    }
+
+    TEST_F(MWRenderPagedRefIndexTest, for_each_in_cells_should_visit_only_references_of_cells_in_range)
+    {
+        mIndex.addCell(2, 1);
+        mIndex.addRef(ESM::RefNum {1, 0}, "", makePosition(0, 0), 1.f, 0);
+        mIndex.addRef(ESM::RefNum {2, 0}, "", makePosition(0, 0), 1.f, 0);
+        mIndex.addCell(0, 0);
+        mIndex.addCell(1, 0);
+        mIndex.addRef(ESM::RefNum {3, 0}, "", makePosition(0, 0), 1.f, 0);
+        mIndex.addCell(1, 1);
+        mIndex.addRef(ESM::RefNum {4, 0}, "", makePosition(0, 0), 1.f, 0);
+        mIndex.addCell(-1, 5);
+        mIndex.addRef(ESM::RefNum {5, 0}, "", makePosition(0, 0), 1.f, 0);
+        mIndex.finish();
+
+        EXPECT_EQ(mIndex.getCellsCount(), 4);
+        EXPECT_EQ(collect(osg::Vec2i(1, 0), osg::Vec2i(3, 2)), std::vector<unsigned int>({3, 4, 1, 2}));
+        EXPECT_EQ(collect(osg::Vec2i(1, 1), osg::Vec2i(2, 2)), std::vector<unsigned int>({4}));
+        EXPECT_EQ(collect(osg::Vec2i(-1, 0), osg::Vec2i(0, 5)), std::vector<unsigned int>());
+        EXPECT_EQ(collect(osg::Vec2i(-10, -10), osg::Vec2i(10, 10)), std::vector<unsigned int>({5, 3, 4, 1, 2}));
+    }
+}
@@ -0,0 +1,85 @@
+#include "apps/openmw/mwsound/voiceselector.hpp"
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+namespace
+{
+    using namespace testing;
+    using namespace MWSound;
+
+    VoiceState makeVoice(float audibility, std::uint8_t priority = 0, bool real = false)
+    {
+        VoiceState voice;
+        voice.mAudibility = audibility;
+        voice.mPriority = priority;
+        voice.mPlayable = true;
+        voice.mReal = real;
+        return voice;
+    }
+
+    std::vector<bool> getSelected(const std::vector<VoiceState>& voices)
+    {
+        std::vector<bool> result;
+        for (const VoiceState& voice : voices)
+            result.push_back(voice.mSelected);
+        return result;
+    }
+
+    TEST(MWSoundGetDistanceGainTest, should_be_one_within_min_distance)
+    {
+        EXPECT_FLOAT_EQ(getDistanceGain(50, 100, 1000), 1);
+    }
+
+    TEST(MWSoundGetDistanceGainTest, should_decrease_inversely_with_distance)
+    {
+        EXPECT_FLOAT_EQ(getDistanceGain(400, 100, 1000), 0.25f);
+    }
+
+    TEST(MWSoundGetDistanceGainTest, should_be_clamped_at_max_distance)
+    {
+        EXPECT_FLOAT_EQ(getDistanceGain(5000, 100, 1000), 0.1f);
+    }
+
+    TEST(MWSoundVoiceSelectorTest, should_select_all_playable_voices_when_there_are_enough_sources)
+    {
+        std::vector<VoiceState> voices {makeVoice(0.1f), makeVoice(0.5f), makeVoice(1)};
+        voices[1].mPlayable = false;
+        VoiceSelector selector;
+        selector.select(voices, 3);
+        EXPECT_EQ(getSelected(voices), std::vector<bool>({true, false, true}));
+    }
+
+    TEST(MWSoundVoiceSelectorTest, should_select_most_audible_voices)
+    {
+        std::vector<VoiceState> voices {makeVoice(0.1f), makeVoice(0.5f), makeVoice(1), makeVoice(0.3f)};
+        VoiceSelector selector;
+        selector.select(voices, 2);
+        EXPECT_EQ(getSelected(voices), std::vector<bool>({false, true, true, false}));
+    }
+
+    TEST(MWSoundVoiceSelectorTest, should_prefer_higher_priority)
+    {
+        std::vector<VoiceState> voices {makeVoice(0.1f, 1), makeVoice(0.5f), makeVoice(1)};
+        VoiceSelector selector;
+        selector.select(voices, 2);
+        EXPECT_EQ(getSelected(voices), std::vector<bool>({true, false, true}));
+    }
+
+    TEST(MWSoundVoiceSelectorTest, should_keep_real_voice_over_slightly_more_audible_virtual_one)
+    {
+        std::vector<VoiceState> voices {makeVoice(0.45f, 0, true), makeVoice(0.5f)};
+        VoiceSelector selector;
+        selector.select(voices, 1);
+        EXPECT_EQ(getSelected(voices), std::vector<bool>({true, false}));
+    }
+
+    TEST(MWSoundVoiceSelectorTest, should_replace_real_voice_by_much_more_audible_virtual_one)
+    {
+        std::vector<VoiceState> voices {makeVoice(0.2f, 0, true), makeVoice(0.5f)};
+        VoiceSelector selector;
+        selector.select(voices, 1);
+        EXPECT_EQ(getSelected(voices), std::vector<bool>({false, true}));
+    }
+}
@@ -0,0 +1,221 @@
+#include "apps/openmw/mwworld/basesave.hpp"
+
+#include <components/esm/basesavestate.hpp>
+#include <components/esm/cellstate.hpp>
+#include <components/esm/esmreader.hpp>
+#include <components/esm/esmwriter.hpp>
+#include <components/esm/savedgame.hpp>
+
+#include <gtest/gtest.h>
+
+#include <map>
+#include <memory>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace
+{
+    using namespace testing;
+    using namespace MWWorld;
+
+    TEST(MWWorldIsCellStateSavedTest, should_skip_cell_without_state)
+    {
+        EXPECT_FALSE(isCellStateSaved(false, false, false));
+        EXPECT_FALSE(isCellStateSaved(false, true, false));
+        EXPECT_FALSE(isCellStateSaved(false, true, true));
+    }
+
+    TEST(MWWorldIsCellStateSavedTest, should_save_all_cells_with_state_when_not_incremental)
+    {
+        EXPECT_TRUE(isCellStateSaved(true, false, false));
+        EXPECT_TRUE(isCellStateSaved(true, true, false));
+    }
+
+    TEST(MWWorldIsCellStateSavedTest, should_save_only_changed_cells_when_incremental)
+    {
+        EXPECT_FALSE(isCellStateSaved(true, false, true));
+        EXPECT_TRUE(isCellStateSaved(true, true, true));
+    }
+
+    TEST(MWWorldNeedsNewBaseSaveTest, should_reuse_base_save_while_changed_cells_are_below_compaction)
+    {
+        EXPECT_FALSE(needsNewBaseSave(0, 100, 0.25f));
+        EXPECT_FALSE(needsNewBaseSave(24, 100, 0.25f));
+    }
+
+    TEST(MWWorldNeedsNewBaseSaveTest, should_write_new_base_save_when_changed_cells_reach_compaction)
+    {
+        EXPECT_TRUE(needsNewBaseSave(25, 100, 0.25f));
+        EXPECT_TRUE(needsNewBaseSave(100, 100, 0.25f));
+    }
+
+    TEST(MWWorldNeedsNewBaseSaveTest, should_always_write_new_base_save_for_zero_compaction)
+    {
+        EXPECT_TRUE(needsNewBaseSave(0, 100, 0));
+        EXPECT_TRUE(needsNewBaseSave(0, 0, 0));
+    }
+
+    TEST(MWWorldNeedsNewBaseSaveTest, should_write_new_base_save_when_there_are_no_cells)
+    {
+        EXPECT_TRUE(needsNewBaseSave(0, 0, 0.25f));
+    }
+
+    ESM::CellState makeCellState(const std::string& name, float waterLevel)
+    {
+        ESM::CellState state;
+        state.mId.mWorldspace = name;
+        state.mId.mIndex.mX = 0;
+        state.mId.mIndex.mY = 0;
+        state.mId.mPaged = false;
+        state.mWaterLevel = waterLevel;
+        state.mHasFogOfWar = 0;
+        state.mLastRespawn.mDay = 0;
+        state.mLastRespawn.mHour = 0;
+        return state;
+    }
+
+    void writeCellState(ESM::ESMWriter& writer, const ESM::CellState& state)
+    {
+        writer.startRecord(ESM::REC_CSTA);
+        state.mId.save(writer);
+        state.save(writer);
+        writer.endRecord(ESM::REC_CSTA);
+    }
+
+    void writeBaseSaveState(ESM::ESMWriter& writer, const ESM::BaseSaveState& baseSave)
+    {
+        writer.startRecord(ESM::REC_BASE);
+        baseSave.save(writer);
+        writer.endRecord(ESM::REC_BASE);
+    }
+
+    struct MWWorldReadBaseSaveTest : Test
+    {
+        ESM::BaseSaveState mBaseSave;
+        std::map<std::string, float> mWaterLevels;
+        std::set<std::string> mReadCells;
+
+        MWWorldReadBaseSaveTest()
+        {
+            mBaseSave.mName = "base.omwbase";
+            mBaseSave.mCellCount = 2;
+        }
+
+        static std::unique_ptr<std::stringstream> makeStream(ESM::ESMWriter& writer)
+        {
+            auto stream = std::make_unique<std::stringstream>();
+            writer.setFormat(ESM::SavedGame::sCurrentFormat);
+            writer.save(*stream);
+            return stream;
+        }
+
+        std::unique_ptr<std::stringstream> writeBaseSave(const ESM::BaseSaveState& baseSave,
+            const std::vector<ESM::CellState>& cells)
+        {
+            ESM::ESMWriter writer;
+            auto stream = makeStream(writer);
+            writeBaseSaveState(writer, baseSave);
+            for (const ESM::CellState& cell : cells)
+                writeCellState(writer, cell);
+            writer.close();
+            return stream;
+        }
+
+        // Same as Cells::readCellState, the state of a cell is only applied from the first saved game containing it
+        void readCellState(ESM::ESMReader& reader, const ESM::CellId& id)
+        {
+            if (!mReadCells.insert(id.mWorldspace).second)
+            {
+                reader.skipRecord();
+                return;
+            }
+            ESM::CellState state;
+            state.mId = id;
+            state.load(reader);
+            mWaterLevels[id.mWorldspace] = state.mWaterLevel;
+        }
+
+        void readBaseSave(std::unique_ptr<std::stringstream> stream, const ESM::BaseSaveState& referenced)
+        {
+            ESM::ESMReader reader;
+            reader.open(std::move(stream), referenced.mName);
+            MWWorld::readBaseSave(reader, referenced,
+                [&] (const ESM::CellId& id) { readCellState(reader, id); });
+        }
+
+        // Follows the record handling of StateManager::loadGame
+        void load(std::unique_ptr<std::stringstream> stream, std::unique_ptr<std::stringstream> baseStream)
+        {
+            ESM::ESMReader reader;
+            reader.open(std::move(stream), "save");
+            while (reader.hasMoreRecs())
+            {
+                ESM::NAME n = reader.getRecName();
+                reader.getRecHeader();
+                if (n.toInt() == ESM::REC_CSTA)
+                {
+                    ESM::CellId id;
+                    id.load(reader);
+                    readCellState(reader, id);
+                }
+                else if (n.toInt() == ESM::REC_BASE)
+                {
+                    ESM::BaseSaveState referenced;
+                    referenced.load(reader);
+                    readBaseSave(std::move(baseStream), referenced);
+                }
+                else
+                    reader.skipRecord();
+            }
+        }
+    };
+
+    TEST_F(MWWorldReadBaseSaveTest, incremental_save_should_keep_changes_to_cells_in_base_save)
+    {
+        auto baseStream = writeBaseSave(mBaseSave, {makeCellState("active", 1), makeCellState("inactive", 2)});
+
+        ESM::ESMWriter writer;
+        auto stream = makeStream(writer);
+        writeCellState(writer, makeCellState("inactive", 3));
+        writeBaseSaveState(writer, mBaseSave);
+        writer.close();
+
+        load(std::move(stream), std::move(baseStream));
+
+        EXPECT_EQ(mWaterLevels, (std::map<std::string, float> {{"active", 1}, {"inactive", 3}}));
+    }
+
+    TEST_F(MWWorldReadBaseSaveTest, should_throw_for_other_base_save)
+    {
+        ESM::BaseSaveState other = mBaseSave;
+        other.mName = "other.omwbase";
+        auto stream = writeBaseSave(other, {makeCellState("active", 1), makeCellState("inactive", 2)});
+        EXPECT_THROW(readBaseSave(std::move(stream), mBaseSave), std::runtime_error);
+    }
+
+    TEST_F(MWWorldReadBaseSaveTest, should_throw_for_different_cell_count)
+    {
+        ESM::BaseSaveState other = mBaseSave;
+        other.mCellCount = 3;
+        auto stream = writeBaseSave(other, {makeCellState("active", 1), makeCellState("inactive", 2)});
+        EXPECT_THROW(readBaseSave(std::move(stream), mBaseSave), std::runtime_error);
+    }
+
+    TEST_F(MWWorldReadBaseSaveTest, should_throw_for_missing_cell_states)
+    {
+        auto stream = writeBaseSave(mBaseSave, {makeCellState("active", 1)});
+        EXPECT_THROW(readBaseSave(std::move(stream), mBaseSave), std::runtime_error);
+    }
+
+    TEST_F(MWWorldReadBaseSaveTest, should_throw_without_base_save_record)
+    {
+        ESM::ESMWriter writer;
+        auto stream = makeStream(writer);
+        writeCellState(writer, makeCellState("active", 1));
+        writer.close();
+        EXPECT_THROW(readBaseSave(std::move(stream), mBaseSave), std::runtime_error);
+    }
+}
@@ -0,0 +1,82 @@
+#include "apps/openmw/mwworld/containerweight.hpp"
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+namespace
+{
+    using namespace testing;
+    using namespace MWWorld;
+
+    struct Stack
+    {
+        int mCount;
+        float mWeight;
+    };
+
+    float recount(const std::vector<Stack>& stacks)
+    {
+        ContainerWeight weight;
+        for (const Stack& stack : stacks)
+            weight.add(stack.mCount, stack.mWeight);
+        return weight.get();
+    }
+
+    TEST(MWWorldContainerWeightTest, stack_with_negative_count_should_weigh_nothing)
+    {
+        EXPECT_EQ(ContainerWeight::getStackWeight(-3, 2.5f), 0);
+        EXPECT_EQ(ContainerWeight::getStackWeight(0, 2.5f), 0);
+        EXPECT_EQ(ContainerWeight::getStackWeight(3, 2.5f), 7.5);
+    }
+
+    TEST(MWWorldContainerWeightTest, removed_stacks_should_not_leave_remainder)
+    {
+        ContainerWeight weight;
+        weight.add(3, 0.1f);
+        weight.add(7, 0.3f);
+        weight.remove(3, 0.1f);
+        weight.remove(7, 0.3f);
+        EXPECT_EQ(weight.get(), 0);
+    }
+
+    TEST(MWWorldContainerWeightTest, incremental_updates_should_match_recount)
+    {
+        std::minstd_rand random;
+        std::uniform_real_distribution<float> weightDistribution(0.01f, 100);
+        std::uniform_int_distribution<int> countDistribution(-5, 50);
+        std::uniform_int_distribution<int> operationDistribution(0, 2);
+
+        std::vector<Stack> stacks;
+        ContainerWeight weight;
+        for (int i = 0; i < 10000; ++i)
+        {
+            const int operation = stacks.empty() ? 0 : operationDistribution(random);
+            if (operation == 0)
+            {
+                stacks.push_back(Stack {countDistribution(random), weightDistribution(random)});
+                weight.add(stacks.back().mCount, stacks.back().mWeight);
+            }
+            else
+            {
+                std::uniform_int_distribution<std::size_t> indexDistribution(0, stacks.size() - 1);
+                const std::size_t index = indexDistribution(random);
+                Stack& stack = stacks[index];
+                weight.remove(stack.mCount, stack.mWeight);
+                if (operation == 1)
+                {
+                    // Restack
+                    stack.mCount = countDistribution(random);
+                    weight.add(stack.mCount, stack.mWeight);
+                }
+                else
+                {
+                    stack = stacks.back();
+                    stacks.pop_back();
+                }
+            }
+            ASSERT_EQ(weight.get(), recount(stacks)) << i;
+        }
+    }
+}
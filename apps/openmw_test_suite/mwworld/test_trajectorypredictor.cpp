@@ -0,0 +1,48 @@
+#include "apps/openmw/mwworld/trajectorypredictor.hpp"
+
+#include <gtest/gtest.h>
+
+namespace
+{
+    using namespace testing;
+    using namespace MWWorld;
+
+    struct TrajectoryPredictorTest : Test
+    {
+        TrajectoryPredictor mPredictor {0.5f, 1000.f};
+    };
+
+    TEST_F(TrajectoryPredictorTest, prediction_without_movement_should_be_current_position)
+    {
+        mPredictor.reset(osg::Vec3f(1, 2, 3));
+        EXPECT_EQ(mPredictor.predict(10), osg::Vec3f(1, 2, 3));
+    }
+
+    TEST_F(TrajectoryPredictorTest, constant_movement_should_be_extrapolated)
+    {
+        mPredictor.reset(osg::Vec3f(0, 0, 0));
+        for (int i = 1; i <= 100; ++i)
+            mPredictor.update(osg::Vec3f(10.f * i, 0, 0), 0.1f);
+        EXPECT_NEAR(mPredictor.getVelocity().x(), 100.f, 1e-3f);
+        EXPECT_NEAR(mPredictor.predict(2).x(), 1200.f, 1e-2f);
+    }
+
+    TEST_F(TrajectoryPredictorTest, single_frame_movement_should_be_smoothed)
+    {
+        mPredictor.reset(osg::Vec3f(0, 0, 0));
+        mPredictor.update(osg::Vec3f(0, 10, 0), 0.1f);
+        EXPECT_NEAR(mPredictor.getVelocity().y(), 20.f, 1e-3f);
+        mPredictor.update(osg::Vec3f(0, 10, 0), 0.1f);
+        EXPECT_NEAR(mPredictor.getVelocity().y(), 16.f, 1e-3f);
+    }
+
+    TEST_F(TrajectoryPredictorTest, teleport_should_reset_velocity)
+    {
+        mPredictor.reset(osg::Vec3f(0, 0, 0));
+        for (int i = 1; i <= 10; ++i)
+            mPredictor.update(osg::Vec3f(10.f * i, 0, 0), 0.1f);
+        mPredictor.update(osg::Vec3f(5000, 0, 0), 0.1f);
+        EXPECT_EQ(mPredictor.getVelocity(), osg::Vec3f());
+        EXPECT_EQ(mPredictor.getPosition(), osg::Vec3f(5000, 0, 0));
+    }
+}
@@ -0,0 +1,84 @@
+#include <apps/openmw/benchmark.hpp>
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <stdexcept>
+
+namespace
+{
+    using namespace testing;
+    using namespace OMW;
+
+    TEST(OpenMWCameraPathTest, readShouldSkipEmptyLinesAndComments)
+    {
+        std::istringstream stream("# time x y z rotx roty rotz\n\n0 1 2 3 0 0 90\n");
+        const CameraPath path = CameraPath::read(stream);
+        ASSERT_FALSE(path.empty());
+        const CameraPathPoint point = path.get(0);
+        EXPECT_EQ(point.mPosition, osg::Vec3f(1, 2, 3));
+        EXPECT_FLOAT_EQ(point.mRotation.z(), osg::PI_2f);
+    }
+
+    TEST(OpenMWCameraPathTest, readShouldThrowOnMalformedLine)
+    {
+        std::istringstream stream("0 1 2 3 0 0 0\n1 2 3\n");
+        EXPECT_THROW(CameraPath::read(stream), std::runtime_error);
+    }
+
+    TEST(OpenMWCameraPathTest, getShouldInterpolateBetweenPoints)
+    {
+        std::istringstream stream("2 100 0 0 0 0 0\n0 0 0 0 0 0 0\n");
+        const CameraPath path = CameraPath::read(stream);
+        EXPECT_EQ(path.get(0.5).mPosition, osg::Vec3f(25, 0, 0));
+        EXPECT_EQ(path.get(1).mPosition, osg::Vec3f(50, 0, 0));
+    }
+
+    TEST(OpenMWCameraPathTest, getShouldClampToFirstAndLastPoints)
+    {
+        std::istringstream stream("1 10 0 0 0 0 0\n2 20 0 0 0 0 0\n");
+        const CameraPath path = CameraPath::read(stream);
+        EXPECT_EQ(path.get(0).mPosition, osg::Vec3f(10, 0, 0));
+        EXPECT_EQ(path.get(3).mPosition, osg::Vec3f(20, 0, 0));
+    }
+
+    TEST(OpenMWBenchmarkTest, getPercentilesShouldUseNearestRank)
+    {
+        std::vector<double> values;
+        for (int i = 100; i >= 1; --i)
+            values.push_back(i);
+        const Percentiles percentiles = getPercentiles(values);
+        EXPECT_EQ(percentiles.mCount, 100);
+        EXPECT_DOUBLE_EQ(percentiles.mMean, 50.5);
+        EXPECT_DOUBLE_EQ(percentiles.mP50, 50);
+        EXPECT_DOUBLE_EQ(percentiles.mP90, 90);
+        EXPECT_DOUBLE_EQ(percentiles.mP99, 99);
+        EXPECT_DOUBLE_EQ(percentiles.mMax, 100);
+    }
+
+    TEST(OpenMWBenchmarkTest, getPercentilesForEmptyValuesShouldReturnZeros)
+    {
+        const Percentiles percentiles = getPercentiles({});
+        EXPECT_EQ(percentiles.mCount, 0);
+        EXPECT_EQ(percentiles.mMax, 0);
+    }
+
+    TEST(OpenMWBenchmarkTest, reportShouldWriteSubsystemsInOrderOfAddition)
+    {
+        BenchmarkReport report;
+        report.add("physics", 2);
+        report.add("frame", 16);
+        report.add("physics", 4);
+        std::ostringstream stream;
+        report.write(stream, 2, 0.5f);
+        EXPECT_EQ(stream.str(),
+            "{\n"
+            "  \"frames\": 2,\n"
+            "  \"timestep\": 0.500,\n"
+            "  \"subsystems\": {\n"
+            "    \"physics\": {\"samples\": 2, \"mean\": 3.000, \"p50\": 2.000, \"p90\": 4.000, \"p99\": 4.000, \"max\": 4.000},\n"
+            "    \"frame\": {\"samples\": 1, \"mean\": 16.000, \"p50\": 16.000, \"p90\": 16.000, \"p99\": 16.000, \"max\": 16.000}\n"
+            "  }\n"
+            "}\n");
+    }
+}
@@ -0,0 +1,124 @@
+#include <components/terrain/bakedterrain.hpp>
+
+#include <boost/filesystem/operations.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <string>
+
+namespace
+{
+    using namespace testing;
+    using namespace Terrain;
+
+    constexpr float cellWorldSize = 8192;
+    constexpr unsigned int compositeMapSize = 512;
+
+    struct TerrainBakedTerrainTest : Test
+    {
+        const std::string mContentKey = "content.esm:42:13;";
+        const float mSize = 2;
+        const osg::Vec2f mCenter {3, -1};
+        const unsigned int mLod = 1;
+        const unsigned int mNumVerts = 5;
+        osg::Vec3Array mPositions;
+        osg::Vec3Array mNormals;
+        osg::Vec4ubArray mColours;
+        boost::filesystem::path mDirectory;
+        std::string mFileName;
+
+        TerrainBakedTerrainTest()
+        {
+            mDirectory = boost::filesystem::temp_directory_path()
+                / boost::filesystem::unique_path("openmw-test-baked-terrain-%%%%-%%%%-%%%%-%%%%");
+            boost::filesystem::create_directories(mDirectory);
+            std::string name = UnitTest::GetInstance()->current_test_info()->name();
+            std::replace(name.begin(), name.end(), '/', '_');
+            mFileName = (mDirectory / name).string();
+
+            for (unsigned int vertX = 0; vertX < mNumVerts; ++vertX)
+            {
+                for (unsigned int vertY = 0; vertY < mNumVerts; ++vertY)
+                {
+                    mPositions.push_back(osg::Vec3f((vertX / float(mNumVerts - 1) - 0.5f) * mSize * cellWorldSize,
+                                                    (vertY / float(mNumVerts - 1) - 0.5f) * mSize * cellWorldSize,
+                                                    static_cast<float>(vertX * 100) - static_cast<float>(vertY) * 0.25f));
+                    osg::Vec3f normal(static_cast<float>(vertX), -static_cast<float>(vertY), 10);
+                    normal.normalize();
+                    mNormals.push_back(normal);
+                    osg::Vec4ub colour;
+                    colour[0] = static_cast<unsigned char>(vertX * 50);
+                    colour[1] = static_cast<unsigned char>(vertY * 60);
+                    colour[2] = 7;
+                    colour[3] = 255;
+                    mColours.push_back(colour);
+                }
+            }
+        }
+
+        ~TerrainBakedTerrainTest()
+        {
+            boost::system::error_code ec;
+            boost::filesystem::remove_all(mDirectory, ec);
+        }
+
+        void write()
+        {
+            BakedTerrainWriter writer(mFileName, mContentKey, cellWorldSize, compositeMapSize);
+            writer.addVertices(mSize, mCenter, mLod, mPositions, mNormals, mColours);
+            writer.finish();
+        }
+    };
+
+    TEST_F(TerrainBakedTerrainTest, load_should_return_nullptr_for_missing_file)
+    {
+        EXPECT_EQ(BakedTerrain::load(mFileName + ".missing", mContentKey), nullptr);
+    }
+
+    TEST_F(TerrainBakedTerrainTest, load_should_return_nullptr_for_other_content)
+    {
+        write();
+        EXPECT_EQ(BakedTerrain::load(mFileName, "other.esm:42:13;"), nullptr);
+    }
+
+    TEST_F(TerrainBakedTerrainTest, get_vertices_should_return_written_data)
+    {
+        write();
+        const auto bakedTerrain = BakedTerrain::load(mFileName, mContentKey);
+        ASSERT_NE(bakedTerrain, nullptr);
+        EXPECT_EQ(bakedTerrain->getCompositeMapSize(), compositeMapSize);
+        EXPECT_EQ(bakedTerrain->getVerticesCount(), 1);
+        EXPECT_EQ(bakedTerrain->getCompositeMapsCount(), 0);
+
+        osg::Vec3Array positions;
+        osg::Vec3Array normals;
+        osg::Vec4ubArray colours;
+        ASSERT_TRUE(bakedTerrain->getVertices(mSize, mCenter, mLod, positions, normals, colours));
+        ASSERT_EQ(positions.size(), mPositions.size());
+        ASSERT_EQ(normals.size(), mNormals.size());
+        ASSERT_EQ(colours.size(), mColours.size());
+        for (std::size_t i = 0; i < mPositions.size(); ++i)
+        {
+            // Positions have to match exactly, otherwise there are seams between baked and generated chunks
+            EXPECT_EQ(positions[i], mPositions[i]) << i;
+            for (int j = 0; j < 3; ++j)
+                EXPECT_NEAR(normals[i][j], mNormals[i][j], 0.02f) << i << " " << j;
+            for (int j = 0; j < 4; ++j)
+                EXPECT_EQ(colours[i][j], mColours[i][j]) << i << " " << j;
+        }
+    }
+
+    TEST_F(TerrainBakedTerrainTest, get_vertices_should_return_false_for_not_baked_chunk)
+    {
+        write();
+        const auto bakedTerrain = BakedTerrain::load(mFileName, mContentKey);
+        ASSERT_NE(bakedTerrain, nullptr);
+        osg::Vec3Array positions;
+        osg::Vec3Array normals;
+        osg::Vec4ubArray colours;
+        EXPECT_FALSE(bakedTerrain->getVertices(mSize, mCenter, mLod + 1, positions, normals, colours));
+        EXPECT_FALSE(bakedTerrain->getVertices(mSize, osg::Vec2f(1, -1), mLod, positions, normals, colours));
+        EXPECT_EQ(bakedTerrain->getCompositeMap(mSize, mCenter), nullptr);
+    }
+}
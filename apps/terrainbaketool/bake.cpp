@@ -0,0 +1,215 @@
+#include "bake.hpp"
+
+#include <components/debug/debuglog.hpp>
+#include <components/misc/progressreporter.hpp>
+#include <components/terrain/bakedterrain.hpp>
+#include <components/terrain/chunkmanager.hpp>
+#include <components/terrain/compositemaprenderer.hpp>
+#include <components/terrain/quadtreeworld.hpp>
+#include <components/terrain/storage.hpp>
+#include <components/terrain/texturemanager.hpp>
+
+#include <osg/GraphicsContext>
+#include <osg/Image>
+#include <osg/State>
+#include <osg/Texture2D>
+#include <osgViewer/Viewer>
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace TerrainBakeTool
+{
+    namespace
+    {
+        // Composite maps rendered in one frame, limits the memory used by the images waiting to be written.
+        constexpr std::size_t compositeMapsPerFrame = 16;
+
+        struct Chunk
+        {
+            float mSize;
+            osg::Vec2f mCenter;
+            unsigned int mVertexLod;
+        };
+
+        struct LogBaked
+        {
+            std::string_view mName;
+
+            void operator()(std::size_t provided, std::size_t expected) const
+            {
+                Log(Debug::Info) << provided << "/" << expected << " ("
+                    << (static_cast<double>(provided) / static_cast<double>(expected) * 100)
+                    << "%) " << mName << " are baked";
+            }
+        };
+
+        /// Renders composite maps with CompositeMapRenderer the same way as the game does and reads them back.
+        class CompositeMapReader : public osg::Drawable
+        {
+        public:
+            explicit CompositeMapReader(Terrain::CompositeMapRenderer* renderer)
+                : mRenderer(renderer)
+            {
+                setSupportsDisplayList(false);
+                setCullingActive(false);
+                getOrCreateStateSet()->setMode(GL_LIGHTING, osg::StateAttribute::OFF);
+            }
+
+            void add(osg::ref_ptr<Terrain::CompositeMap> map)
+            {
+                mMaps.push_back(std::move(map));
+            }
+
+            /// Images in the order the maps are added, nullptr for the maps that failed to render.
+            std::vector<osg::ref_ptr<osg::Image>> takeImages()
+            {
+                mMaps.clear();
+                return std::exchange(mImages, {});
+            }
+
+            void drawImplementation(osg::RenderInfo& renderInfo) const override
+            {
+                osg::State& state = *renderInfo.getState();
+                for (const osg::ref_ptr<Terrain::CompositeMap>& map : mMaps)
+                {
+                    // The renderer skips the maps which texture is not referenced by anything else
+                    const osg::ref_ptr<osg::Texture2D> texture = map->mTexture;
+                    mRenderer->compile(*map, renderInfo, nullptr);
+                    if (map->mCompiled == 0)
+                    {
+                        mImages.emplace_back();
+                        continue;
+                    }
+                    state.applyTextureAttribute(0, texture);
+                    osg::ref_ptr<osg::Image> image = new osg::Image;
+                    image->readImageFromCurrentTexture(renderInfo.getContextID(), false, GL_UNSIGNED_BYTE);
+                    mImages.push_back(std::move(image));
+                }
+            }
+
+        private:
+            osg::ref_ptr<Terrain::CompositeMapRenderer> mRenderer;
+            std::vector<osg::ref_ptr<Terrain::CompositeMap>> mMaps;
+            mutable std::vector<osg::ref_ptr<osg::Image>> mImages;
+        };
+
+        osg::ref_ptr<osg::GraphicsContext> createOffscreenContext(unsigned int size)
+        {
+            osg::ref_ptr<osg::GraphicsContext::Traits> traits = new osg::GraphicsContext::Traits;
+            traits->readDISPLAY();
+            traits->setUndefinedScreenDetailsToDefaultScreen();
+            traits->x = 0;
+            traits->y = 0;
+            traits->width = static_cast<int>(size);
+            traits->height = static_cast<int>(size);
+            traits->pbuffer = true;
+            traits->doubleBuffer = false;
+            traits->windowDecoration = false;
+
+            osg::ref_ptr<osg::GraphicsContext> context = osg::GraphicsContext::createGraphicsContext(traits);
+            if (context == nullptr || !context->valid())
+                throw std::runtime_error("Failed to create an offscreen graphics context to render composite maps, "
+                                         "use --skip-composite-maps to bake only vertex buffers");
+            return context;
+        }
+
+        void bakeVertices(const std::vector<Chunk>& chunks, Terrain::Storage& storage, Terrain::BakedTerrainWriter& writer)
+        {
+            Log(Debug::Info) << "Baking vertex buffers of " << chunks.size() << " terrain chunks...";
+
+            Misc::ProgressReporter<LogBaked> reporter(LogBaked {"terrain chunk vertex buffers"});
+            osg::ref_ptr<osg::Vec3Array> positions(new osg::Vec3Array);
+            osg::ref_ptr<osg::Vec3Array> normals(new osg::Vec3Array);
+            osg::ref_ptr<osg::Vec4ubArray> colours(new osg::Vec4ubArray);
+            for (std::size_t i = 0; i < chunks.size(); ++i)
+            {
+                const Chunk& chunk = chunks[i];
+                storage.fillVertexBuffers(static_cast<int>(chunk.mVertexLod), chunk.mSize, chunk.mCenter, positions, normals, colours);
+                writer.addVertices(chunk.mSize, chunk.mCenter, chunk.mVertexLod, *positions, *normals, *colours);
+                reporter(i + 1, chunks.size());
+            }
+        }
+
+        void bakeCompositeMaps(const BakeSettings& settings, const std::vector<Chunk>& chunks, Terrain::Storage& storage,
+                               Resource::SceneManager& sceneManager, Terrain::BakedTerrainWriter& writer)
+        {
+            std::vector<Chunk> compositeChunks;
+            std::copy_if(chunks.begin(), chunks.end(), std::back_inserter(compositeChunks),
+                         [&] (const Chunk& chunk) { return chunk.mSize >= settings.mCompositeMapLevel; });
+
+            Log(Debug::Info) << "Baking " << compositeChunks.size() << " composite maps...";
+
+            osg::ref_ptr<Terrain::CompositeMapRenderer> renderer = new Terrain::CompositeMapRenderer;
+            Terrain::TextureManager textureManager(&sceneManager);
+            Terrain::ChunkManager chunkManager(&storage, &sceneManager, &textureManager, renderer);
+            chunkManager.setCompositeMapSize(settings.mCompositeMapSize);
+            chunkManager.setCompositeMapLevel(settings.mCompositeMapLevel);
+            chunkManager.setMaxCompositeGeometrySize(settings.mMaxCompGeometrySize);
+
+            osg::ref_ptr<CompositeMapReader> reader = new CompositeMapReader(renderer);
+            // Same camera setup as Terrain::World uses for the composite map renderer
+            osgViewer::Viewer viewer;
+            viewer.setThreadingModel(osgViewer::ViewerBase::SingleThreaded);
+            viewer.setLightingMode(osg::View::NO_LIGHT);
+            osg::Camera* camera = viewer.getCamera();
+            camera->setGraphicsContext(createOffscreenContext(settings.mCompositeMapSize));
+            camera->setViewport(0, 0, settings.mCompositeMapSize, settings.mCompositeMapSize);
+            camera->setProjectionMatrix(osg::Matrix::identity());
+            camera->setViewMatrix(osg::Matrix::identity());
+            camera->setReferenceFrame(osg::Camera::ABSOLUTE_RF);
+            camera->setComputeNearFarMode(osg::Camera::DO_NOT_COMPUTE_NEAR_FAR);
+            camera->setClearMask(0);
+            viewer.setSceneData(reader);
+            viewer.realize();
+
+            Misc::ProgressReporter<LogBaked> reporter(LogBaked {"composite maps"});
+            std::size_t failed = 0;
+            for (std::size_t begin = 0; begin < compositeChunks.size(); begin += compositeMapsPerFrame)
+            {
+                const std::size_t end = std::min(begin + compositeMapsPerFrame, compositeChunks.size());
+                for (std::size_t i = begin; i < end; ++i)
+                    reader->add(chunkManager.createCompositeMap(compositeChunks[i].mSize, compositeChunks[i].mCenter));
+
+                viewer.frame();
+
+                const std::vector<osg::ref_ptr<osg::Image>> images = reader->takeImages();
+                for (std::size_t i = begin; i < end; ++i)
+                {
+                    const osg::ref_ptr<osg::Image>& image = images[i - begin];
+                    if (image == nullptr || image->data() == nullptr)
+                        ++failed;
+                    else
+                        writer.addCompositeMap(compositeChunks[i].mSize, compositeChunks[i].mCenter, *image);
+                }
+
+                reporter(end, compositeChunks.size());
+            }
+
+            if (failed != 0)
+                Log(Debug::Warning) << "Failed to render " << failed << " composite maps, they will be rendered by the game";
+        }
+    }
+
+    void bakeTerrain(const BakeSettings& settings, Terrain::Storage& storage, Resource::SceneManager& sceneManager,
+                     Terrain::BakedTerrainWriter& writer)
+    {
+        std::vector<Chunk> chunks;
+        Terrain::QuadTreeWorld::forEachChunk(&storage, settings.mVertexLodMod,
+            [&] (float size, const osg::Vec2f& center, unsigned int vertexLod)
+            {
+                if (size >= settings.mMinChunkSize)
+                    chunks.push_back(Chunk {size, center, vertexLod});
+            });
+
+        bakeVertices(chunks, storage, writer);
+
+        if (settings.mBakeCompositeMaps)
+            bakeCompositeMaps(settings, chunks, storage, sceneManager, writer);
+    }
+}
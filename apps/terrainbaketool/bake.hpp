@@ -0,0 +1,33 @@
+#ifndef OPENMW_TERRAINBAKETOOL_BAKE_H
+#define OPENMW_TERRAINBAKETOOL_BAKE_H
+
+namespace Resource
+{
+    class SceneManager;
+}
+
+namespace Terrain
+{
+    class BakedTerrainWriter;
+    class Storage;
+}
+
+namespace TerrainBakeTool
+{
+    struct BakeSettings
+    {
+        float mMinChunkSize = 2;
+        int mVertexLodMod = 0;
+        bool mBakeCompositeMaps = true;
+        unsigned int mCompositeMapSize = 512;
+        float mCompositeMapLevel = 1;
+        float mMaxCompGeometrySize = 4;
+    };
+
+    /// Bakes vertex buffers of all terrain chunks of at least mMinChunkSize cells and composite maps of the chunks
+    /// which use them. Composite maps are rendered in an offscreen graphics context.
+    void bakeTerrain(const BakeSettings& settings, Terrain::Storage& storage, Resource::SceneManager& sceneManager,
+                     Terrain::BakedTerrainWriter& writer);
+}
+
+#endif
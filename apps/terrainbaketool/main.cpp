@@ -0,0 +1,228 @@
+#include "bake.hpp"
+#include "terrainstorage.hpp"
+
+#include <components/debug/debugging.hpp>
+#include <components/esm/esmreader.hpp>
+#include <components/esmloader/esmdata.hpp>
+#include <components/esmloader/load.hpp>
+#include <components/fallback/fallback.hpp>
+#include <components/fallback/validate.hpp>
+#include <components/files/collections.hpp>
+#include <components/files/configurationmanager.hpp>
+#include <components/files/multidircollection.hpp>
+#include <components/resource/imagemanager.hpp>
+#include <components/resource/niffilemanager.hpp>
+#include <components/resource/scenemanager.hpp>
+#include <components/settings/settings.hpp>
+#include <components/terrain/bakedterrain.hpp>
+#include <components/to_utf8/to_utf8.hpp>
+#include <components/version/version.hpp>
+#include <components/vfs/manager.hpp>
+#include <components/vfs/registerarchives.hpp>
+
+#include <boost/filesystem.hpp>
+#include <boost/program_options.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace TerrainBakeTool
+{
+    namespace
+    {
+        namespace bpo = boost::program_options;
+
+        using StringsVector = std::vector<std::string>;
+
+        bpo::options_description makeOptionsDescription()
+        {
+            using Fallback::FallbackMap;
+
+            bpo::options_description result;
+
+            result.add_options()
+                ("help", "print help message")
+
+                ("version", "print version information and quit")
+
+                ("data", bpo::value<Files::MaybeQuotedPathContainer>()->default_value(Files::MaybeQuotedPathContainer(), "data")
+                    ->multitoken()->composing(), "set data directories (later directories have higher priority)")
+
+                ("data-local", bpo::value<Files::MaybeQuotedPathContainer::value_type>()->default_value(Files::MaybeQuotedPathContainer::value_type(), ""),
+                    "set local data directory (highest priority)")
+
+                ("fallback-archive", bpo::value<StringsVector>()->default_value(StringsVector(), "fallback-archive")
+                    ->multitoken()->composing(), "set fallback BSA archives (later archives have higher priority)")
+
+                ("resources", bpo::value<Files::MaybeQuotedPath>()->default_value(Files::MaybeQuotedPath(), "resources"),
+                    "set resources directory")
+
+                ("content", bpo::value<StringsVector>()->default_value(StringsVector(), "")
+                    ->multitoken()->composing(), "content file(s): esm/esp, or omwgame/omwaddon/omwscripts")
+
+                ("fs-strict", bpo::value<bool>()->implicit_value(true)
+                    ->default_value(false), "strict file system handling (no case folding)")
+
+                ("encoding", bpo::value<std::string>()->
+                    default_value("win1252"),
+                    "Character encoding used in OpenMW game messages:\n"
+                    "\n\twin1250 - Central and Eastern European such as Polish, Czech, Slovak, Hungarian, Slovene, Bosnian, Croatian, Serbian (Latin script), Romanian and Albanian languages\n"
+                    "\n\twin1251 - Cyrillic alphabet such as Russian, Bulgarian, Serbian Cyrillic and other languages\n"
+                    "\n\twin1252 - Western European (Latin) alphabet, used by default")
+
+                ("fallback", bpo::value<Fallback::FallbackMap>()->default_value(Fallback::FallbackMap(), "")
+                    ->multitoken()->composing(), "fallback values")
+
+                ("min-chunk-size", bpo::value<float>()->default_value(2.f),
+                    "bake terrain chunks covering at least this number of cells in each direction, "
+                    "smaller chunks are close to the player and are quickly generated by the game")
+
+                ("skip-composite-maps", bpo::value<bool>()->implicit_value(true)
+                    ->default_value(false), "bake only vertex buffers, composite maps require a graphics context")
+            ;
+
+            return result;
+        }
+
+        void loadSettings(const Files::ConfigurationManager& config, Settings::Manager& settings)
+        {
+            const std::string localDefault = (config.getLocalPath() / "defaults.bin").string();
+            const std::string globalDefault = (config.getGlobalPath() / "defaults.bin").string();
+
+            if (boost::filesystem::exists(localDefault))
+                settings.loadDefault(localDefault);
+            else if (boost::filesystem::exists(globalDefault))
+                settings.loadDefault(globalDefault);
+            else
+                throw std::runtime_error("No default settings file found! Make sure the file \"defaults.bin\" was properly installed.");
+
+            const std::string settingsPath = (config.getUserConfigPath() / "settings.cfg").string();
+            if (boost::filesystem::exists(settingsPath))
+                settings.loadUser(settingsPath);
+        }
+
+        std::vector<boost::filesystem::path> getContentPaths(const Files::Collections& fileCollections,
+                                                             const StringsVector& contentFiles)
+        {
+            std::vector<boost::filesystem::path> result;
+            for (const std::string& file : contentFiles)
+            {
+                const Files::MultiDirCollection& collection = fileCollections.getCollection(boost::filesystem::path(file).extension().string());
+                if (collection.doesExist(file))
+                    result.push_back(collection.getPath(file));
+            }
+            return result;
+        }
+
+        int runTerrainBakeTool(int argc, char *argv[])
+        {
+            bpo::options_description desc = makeOptionsDescription();
+
+            bpo::parsed_options options = bpo::command_line_parser(argc, argv)
+                .options(desc).allow_unregistered().run();
+            bpo::variables_map variables;
+
+            bpo::store(options, variables);
+            bpo::notify(variables);
+
+            if (variables.find("help") != variables.end())
+            {
+                getRawStdout() << desc << std::endl;
+                return 0;
+            }
+
+            Files::ConfigurationManager config;
+
+            bpo::variables_map composingVariables = Files::separateComposingVariables(variables, desc);
+            config.readConfiguration(variables, desc);
+            Files::mergeComposingVariables(variables, composingVariables, desc);
+
+            const std::string encoding(variables["encoding"].as<std::string>());
+            Log(Debug::Info) << ToUTF8::encodingUsingMessage(encoding);
+            ToUTF8::Utf8Encoder encoder(ToUTF8::calculateEncoding(encoding));
+
+            Files::PathContainer dataDirs(asPathContainer(variables["data"].as<Files::MaybeQuotedPathContainer>()));
+
+            auto local = variables["data-local"].as<Files::MaybeQuotedPathContainer::value_type>();
+            if (!local.empty())
+                dataDirs.push_back(std::move(local));
+
+            config.processPaths(dataDirs);
+
+            const auto fsStrict = variables["fs-strict"].as<bool>();
+            const auto resDir = variables["resources"].as<Files::MaybeQuotedPath>();
+            Version::Version v = Version::getOpenmwVersion(resDir.string());
+            Log(Debug::Info) << v.describe();
+            dataDirs.insert(dataDirs.begin(), resDir / "vfs");
+            const auto fileCollections = Files::Collections(dataDirs, !fsStrict);
+            const auto archives = variables["fallback-archive"].as<StringsVector>();
+            const auto contentFiles = variables["content"].as<StringsVector>();
+            const float minChunkSize = variables["min-chunk-size"].as<float>();
+
+            if (!(minChunkSize > 0))
+            {
+                std::cerr << "Invalid min chunk size: " << minChunkSize << ", expected > 0";
+                return -1;
+            }
+
+            Fallback::Map::init(variables["fallback"].as<Fallback::FallbackMap>().mMap);
+
+            VFS::Manager vfs(fsStrict);
+
+            VFS::registerArchives(&vfs, fileCollections, archives, true);
+
+            Settings::Manager settings;
+            loadSettings(config, settings);
+
+            BakeSettings bakeSettings;
+            bakeSettings.mMinChunkSize = minChunkSize;
+            bakeSettings.mBakeCompositeMaps = !variables["skip-composite-maps"].as<bool>();
+            // Use the same values as RenderingManager does
+            bakeSettings.mVertexLodMod = Settings::Manager::getInt("vertex lod mod", "Terrain");
+            bakeSettings.mCompositeMapSize = static_cast<unsigned int>(Settings::Manager::getInt("composite map resolution", "Terrain"));
+            bakeSettings.mCompositeMapLevel = std::pow(2.f, std::max(-3, Settings::Manager::getInt("composite map level", "Terrain")));
+            bakeSettings.mMaxCompGeometrySize = std::max(Settings::Manager::getFloat("max composite geometry size", "Terrain"), 1.f);
+
+            std::vector<ESM::ESMReader> readers(contentFiles.size());
+            EsmLoader::Query query;
+            query.mLoadLands = true;
+            query.mLoadLandTextures = true;
+            const EsmLoader::EsmData esmData = EsmLoader::loadEsmData(query, contentFiles, fileCollections, readers, &encoder);
+
+            Resource::ImageManager imageManager(&vfs);
+            Resource::NifFileManager nifFileManager(&vfs);
+            Resource::SceneManager sceneManager(&vfs, &imageManager, &nifFileManager);
+
+            TerrainStorage storage(&vfs, esmData,
+                Settings::Manager::getString("normal map pattern", "Shaders"),
+                Settings::Manager::getString("normal height map pattern", "Shaders"),
+                Settings::Manager::getBool("auto use terrain normal maps", "Shaders"),
+                Settings::Manager::getString("terrain specular map pattern", "Shaders"),
+                Settings::Manager::getBool("auto use terrain specular maps", "Shaders"));
+
+            const boost::filesystem::path path = config.getUserDataPath() / "terrain.bake";
+            const boost::filesystem::path tmpPath = config.getUserDataPath() / "terrain.bake.tmp";
+
+            {
+                Terrain::BakedTerrainWriter writer(tmpPath, Terrain::BakedTerrain::makeContentKey(getContentPaths(fileCollections, contentFiles)),
+                                                   storage.getCellWorldSize(), bakeSettings.mCompositeMapSize);
+                bakeTerrain(bakeSettings, storage, sceneManager, writer);
+                writer.finish();
+            }
+
+            boost::filesystem::rename(tmpPath, path);
+
+            Log(Debug::Info) << "Done, baked terrain is written to " << path;
+
+            return 0;
+        }
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    return wrapApplication(TerrainBakeTool::runTerrainBakeTool, argc, argv, "TerrainBakeTool");
+}
@@ -0,0 +1,83 @@
+#include "terrainstorage.hpp"
+
+#include <components/esm/loadland.hpp>
+#include <components/esm/loadltex.hpp>
+#include <components/esmloader/esmdata.hpp>
+
+#include <algorithm>
+
+namespace TerrainBakeTool
+{
+    namespace
+    {
+        // Chunks are baked in the quad tree order, so lands of nearby cells are used together and there is no need
+        // to keep all of them loaded.
+        constexpr std::size_t maxLoadedLands = 1024;
+
+        constexpr int landLoadFlags = ESM::Land::DATA_VCLR | ESM::Land::DATA_VHGT | ESM::Land::DATA_VNML | ESM::Land::DATA_VTEX;
+    }
+
+    TerrainStorage::TerrainStorage(const VFS::Manager* vfs, const EsmLoader::EsmData& esmData,
+            const std::string& normalMapPattern, const std::string& normalHeightMapPattern, bool autoUseNormalMaps,
+            const std::string& specularMapPattern, bool autoUseSpecularMaps)
+        : ESMTerrain::Storage(vfs, normalMapPattern, normalHeightMapPattern, autoUseNormalMaps, specularMapPattern, autoUseSpecularMaps)
+        , mEsmData(esmData)
+    {
+        for (const ESM::Land& land : mEsmData.mLands)
+            mLands.emplace(std::make_pair(land.mX, land.mY), &land);
+    }
+
+    osg::ref_ptr<const ESMTerrain::LandObject> TerrainStorage::getLand(int cellX, int cellY)
+    {
+        const std::pair<int, int> position(cellX, cellY);
+        const auto loaded = mLandObjects.find(position);
+        if (loaded != mLandObjects.end())
+            return loaded->second;
+
+        const auto land = mLands.find(position);
+        if (land == mLands.end())
+            return nullptr;
+
+        if (mLandObjects.size() >= maxLoadedLands)
+            mLandObjects.clear();
+
+        osg::ref_ptr<const ESMTerrain::LandObject> result(new ESMTerrain::LandObject(land->second, landLoadFlags));
+        mLandObjects.emplace(position, result);
+        return result;
+    }
+
+    const ESM::LandTexture* TerrainStorage::getLandTexture(int index, short plugin)
+    {
+        if (plugin < 0 || static_cast<std::size_t>(plugin) >= mEsmData.mLandTextures.size())
+            return nullptr;
+        const std::vector<ESM::LandTexture>& textures = mEsmData.mLandTextures[plugin];
+        if (index < 0 || static_cast<std::size_t>(index) >= textures.size())
+            return nullptr;
+        return &textures[index];
+    }
+
+    bool TerrainStorage::hasData(int cellX, int cellY)
+    {
+        return mLands.find(std::make_pair(cellX, cellY)) != mLands.end();
+    }
+
+    void TerrainStorage::getBounds(float& minX, float& maxX, float& minY, float& maxY)
+    {
+        minX = 0;
+        minY = 0;
+        maxX = 0;
+        maxY = 0;
+
+        for (const auto& [position, land] : mLands)
+        {
+            minX = std::min(minX, static_cast<float>(position.first));
+            maxX = std::max(maxX, static_cast<float>(position.first));
+            minY = std::min(minY, static_cast<float>(position.second));
+            maxY = std::max(maxY, static_cast<float>(position.second));
+        }
+
+        // since grid coords are at cell origin, we need to add 1 cell
+        maxX += 1;
+        maxY += 1;
+    }
+}
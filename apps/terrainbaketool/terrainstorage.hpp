@@ -0,0 +1,38 @@
+#ifndef OPENMW_TERRAINBAKETOOL_TERRAINSTORAGE_H
+#define OPENMW_TERRAINBAKETOOL_TERRAINSTORAGE_H
+
+#include <components/esmterrain/storage.hpp>
+
+#include <map>
+#include <utility>
+
+namespace EsmLoader
+{
+    struct EsmData;
+}
+
+namespace TerrainBakeTool
+{
+    /// @brief Feeds the terrain component with lands and land textures loaded by EsmLoader.
+    class TerrainStorage final : public ESMTerrain::Storage
+    {
+    public:
+        TerrainStorage(const VFS::Manager* vfs, const EsmLoader::EsmData& esmData,
+                       const std::string& normalMapPattern, const std::string& normalHeightMapPattern,
+                       bool autoUseNormalMaps, const std::string& specularMapPattern, bool autoUseSpecularMaps);
+
+        osg::ref_ptr<const ESMTerrain::LandObject> getLand(int cellX, int cellY) override;
+        const ESM::LandTexture* getLandTexture(int index, short plugin) override;
+
+        bool hasData(int cellX, int cellY) override;
+
+        void getBounds(float& minX, float& maxX, float& minY, float& maxY) override;
+
+    private:
+        const EsmLoader::EsmData& mEsmData;
+        std::map<std::pair<int, int>, const ESM::Land*> mLands;
+        std::map<std::pair<int, int>, osg::ref_ptr<const ESMTerrain::LandObject>> mLandObjects;
+    };
+}
+
+#endif
@@ -339,6 +339,10 @@ namespace Compiler
             extensions.registerInstruction ("togglerecastmesh", "", opcodeToggleRecastMesh);
             extensions.registerInstruction ("help", "", opcodeHelp);
             extensions.registerInstruction ("reloadlua", "", opcodeReloadLua);
+            extensions.registerInstruction ("luamemory", "", opcodeLuaMemory);
+            extensions.registerInstruction ("toggleluaprofiler", "", opcodeToggleLuaProfiler);
+            extensions.registerInstruction ("luaprofile", "", opcodeLuaProfile);
+            extensions.registerInstruction ("toggleframeprofiler", "", opcodeToggleFrameProfiler);
         }
     }
 
@@ -320,6 +320,10 @@ namespace Compiler
         const int opcodeStartScriptExplicit = 0x200031d;
         const int opcodeHelp = 0x2000320;
         const int opcodeReloadLua = 0x2000321;
+        const int opcodeLuaMemory = 0x2000322;
+        const int opcodeToggleLuaProfiler = 0x2000323;
+        const int opcodeLuaProfile = 0x2000324;
+        const int opcodeToggleFrameProfiler = 0x2000325;
     }
 
     namespace Sky
@@ -0,0 +1,201 @@
+#include "frameprofiler.hpp"
+
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <vector>
+
+namespace Debug
+{
+    namespace
+    {
+        struct Event
+        {
+            const char* mName;
+            FrameProfiler::Clock::time_point mStart;
+            FrameProfiler::Clock::duration mDuration;
+        };
+
+        struct ThreadBuffer
+        {
+            // Locked by the owning thread for every event, so it is almost never contended.
+            std::mutex mMutex;
+            std::size_t mThreadId;
+            std::string mThreadName;
+            std::vector<Event> mEvents;
+            std::size_t mNext = 0;
+        };
+
+        struct Registry
+        {
+            std::mutex mMutex;
+            std::vector<std::shared_ptr<ThreadBuffer>> mBuffers;
+            std::set<std::string, std::less<>> mNames;
+            FrameProfiler::Clock::time_point mStartTime;
+            std::string mTraceFile = "frameprofile.json";
+        };
+
+        Registry& getRegistry()
+        {
+            static Registry registry;
+            return registry;
+        }
+
+        ThreadBuffer& getThreadBuffer()
+        {
+            // The registry owns the buffer, so events of a finished thread are still saved.
+            thread_local ThreadBuffer* buffer = nullptr;
+            if (buffer == nullptr)
+            {
+                Registry& registry = getRegistry();
+                std::lock_guard<std::mutex> lock(registry.mMutex);
+                auto& result = registry.mBuffers.emplace_back(std::make_shared<ThreadBuffer>());
+                result->mThreadId = registry.mBuffers.size();
+                result->mThreadName = "Thread " + std::to_string(result->mThreadId);
+                buffer = result.get();
+            }
+            return *buffer;
+        }
+
+        double toMicroseconds(FrameProfiler::Clock::duration duration)
+        {
+            return std::chrono::duration<double, std::micro>(duration).count();
+        }
+
+        void writeJsonString(std::ostream& stream, std::string_view value)
+        {
+            stream << '"';
+            for (char c : value)
+            {
+                if (c == '"' || c == '\\')
+                    stream << '\\' << c;
+                else if (static_cast<unsigned char>(c) < 0x20)
+                    stream << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c) << std::dec;
+                else
+                    stream << c;
+            }
+            stream << '"';
+        }
+    }
+
+    void FrameProfiler::start()
+    {
+        Registry& registry = getRegistry();
+        std::lock_guard<std::mutex> lock(registry.mMutex);
+        for (const auto& buffer : registry.mBuffers)
+        {
+            std::lock_guard<std::mutex> bufferLock(buffer->mMutex);
+            buffer->mEvents.clear();
+            buffer->mNext = 0;
+        }
+        registry.mStartTime = Clock::now();
+        sRunning = true;
+    }
+
+    void FrameProfiler::stop()
+    {
+        sRunning = false;
+    }
+
+    std::string FrameProfiler::toggle()
+    {
+        if (!isRunning())
+        {
+            start();
+            return "Frame profiler is started";
+        }
+        stop();
+        std::string path;
+        {
+            Registry& registry = getRegistry();
+            std::lock_guard<std::mutex> lock(registry.mMutex);
+            path = registry.mTraceFile;
+        }
+        std::ofstream stream(path);
+        writeChromeTrace(stream);
+        if (stream.good())
+            return "Frame profiler is stopped, trace is saved to " + path;
+        return "Frame profiler is stopped, can't save trace to " + path;
+    }
+
+    void FrameProfiler::setTraceFile(const std::string& path)
+    {
+        Registry& registry = getRegistry();
+        std::lock_guard<std::mutex> lock(registry.mMutex);
+        registry.mTraceFile = path;
+    }
+
+    void FrameProfiler::setThreadName(std::string_view name)
+    {
+        ThreadBuffer& buffer = getThreadBuffer();
+        std::lock_guard<std::mutex> lock(buffer.mMutex);
+        buffer.mThreadName = name;
+    }
+
+    const char* FrameProfiler::intern(std::string_view name)
+    {
+        Registry& registry = getRegistry();
+        std::lock_guard<std::mutex> lock(registry.mMutex);
+        auto it = registry.mNames.find(name);
+        if (it == registry.mNames.end())
+            it = registry.mNames.emplace(name).first;
+        return it->c_str();
+    }
+
+    void FrameProfiler::record(const char* name, Clock::time_point start, Clock::time_point end)
+    {
+        ThreadBuffer& buffer = getThreadBuffer();
+        std::lock_guard<std::mutex> lock(buffer.mMutex);
+        if (!isRunning())
+            return;
+        const Event event {name, start, end - start};
+        if (buffer.mEvents.size() < sEventsPerThread)
+        {
+            buffer.mEvents.push_back(event);
+            return;
+        }
+        buffer.mEvents[buffer.mNext] = event;
+        buffer.mNext = (buffer.mNext + 1) % sEventsPerThread;
+    }
+
+    void FrameProfiler::writeChromeTrace(std::ostream& stream)
+    {
+        Registry& registry = getRegistry();
+        std::lock_guard<std::mutex> lock(registry.mMutex);
+        stream << std::fixed << std::setprecision(3) << "{\"traceEvents\":[";
+        bool first = true;
+        const auto separate = [&]
+        {
+            if (!first)
+                stream << ",";
+            first = false;
+        };
+        for (const auto& buffer : registry.mBuffers)
+        {
+            std::lock_guard<std::mutex> bufferLock(buffer->mMutex);
+            if (buffer->mEvents.empty())
+                continue;
+            separate();
+            stream << "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->mThreadId
+                   << ",\"args\":{\"name\":";
+            writeJsonString(stream, buffer->mThreadName);
+            stream << "}}";
+            // Events after mNext are older when the ring buffer has wrapped around.
+            for (std::size_t i = 0; i < buffer->mEvents.size(); ++i)
+            {
+                const Event& event = buffer->mEvents[(buffer->mNext + i) % buffer->mEvents.size()];
+                if (event.mStart < registry.mStartTime)
+                    continue;
+                separate();
+                stream << "\n{\"name\":";
+                writeJsonString(stream, event.mName);
+                stream << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->mThreadId
+                       << ",\"ts\":" << toMicroseconds(event.mStart - registry.mStartTime)
+                       << ",\"dur\":" << toMicroseconds(event.mDuration) << "}";
+            }
+        }
+        stream << "\n],\"displayTimeUnit\":\"ms\"}\n";
+    }
+}
@@ -0,0 +1,81 @@
+#ifndef OPENMW_COMPONENTS_DEBUG_FRAMEPROFILER_H
+#define OPENMW_COMPONENTS_DEBUG_FRAMEPROFILER_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+namespace Debug
+{
+    // Collects timings of ProfileZone scopes from all threads. Every thread writes to its own ring buffer, so
+    // only the latest sEventsPerThread zones of each thread are kept. The trace is saved in the Chrome trace
+    // format and shows how the work of the main thread, the Lua worker, physics and navigator threads and
+    // the work queue overlaps (can be viewed in chrome://tracing or https://ui.perfetto.dev).
+    // When the profiler is not running a zone costs a single atomic load.
+    class FrameProfiler
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        static constexpr std::size_t sEventsPerThread = 1 << 16;
+
+        static bool isRunning() { return sRunning.load(std::memory_order_relaxed); }
+
+        // Discards all previously collected zones.
+        static void start();
+
+        static void stop();
+
+        // Starts the profiler if it isn't running, otherwise stops it and saves the trace to the file set by
+        // setTraceFile. Returns a message for the console.
+        static std::string toggle();
+
+        static void setTraceFile(const std::string& path);
+
+        // Sets the name the current thread has in the trace.
+        static void setThreadName(std::string_view name);
+
+        // Returns a pointer to a copy of the name that stays valid until the program exits. Zone names
+        // have to live that long, so names that are not string literals should be passed through this.
+        static const char* intern(std::string_view name);
+
+        static void record(const char* name, Clock::time_point start, Clock::time_point end);
+
+        // Should be called when the profiler is stopped.
+        static void writeChromeTrace(std::ostream& stream);
+
+    private:
+        static inline std::atomic_bool sRunning {false};
+    };
+
+    // Measures the time between construction and destruction. `name` must outlive the trace (see
+    // FrameProfiler::intern), nullptr disables the zone.
+    class ProfileZone
+    {
+    public:
+        explicit ProfileZone(const char* name)
+            : mName(FrameProfiler::isRunning() ? name : nullptr)
+        {
+            if (mName != nullptr)
+                mStart = FrameProfiler::Clock::now();
+        }
+
+        ProfileZone(const ProfileZone&) = delete;
+        ProfileZone& operator=(const ProfileZone&) = delete;
+
+        ~ProfileZone()
+        {
+            if (mName != nullptr)
+                FrameProfiler::record(mName, mStart, FrameProfiler::Clock::now());
+        }
+
+    private:
+        const char* const mName;
+        FrameProfiler::Clock::time_point mStart;
+    };
+}
+
+#endif
@@ -8,6 +8,7 @@
 #include "dbrefgeometryobject.hpp"
 
 #include <components/debug/debuglog.hpp>
+#include <components/debug/frameprofiler.hpp>
 #include <components/misc/thread.hpp>
 #include <components/loadinglistener/loadinglistener.hpp>
 
@@ -323,6 +324,7 @@ namespace DetourNavigator
     {
         Log(Debug::Debug) << "Start process navigator jobs by thread=" << std::this_thread::get_id();
         Misc::setCurrentThreadIdlePriority();
+        Debug::FrameProfiler::setThreadName("Navigator");
         while (!mShouldStop)
         {
             try
@@ -363,6 +365,7 @@ namespace DetourNavigator
 
     JobStatus AsyncNavMeshUpdater::processJob(Job& job)
     {
+        const Debug::ProfileZone zone("AsyncNavMeshUpdater::processJob");
         Log(Debug::Debug) << "Processing job " << job.mId << " by thread=" << std::this_thread::get_id();
 
         const auto navMeshCacheItem = job.mNavMeshCacheItem.lock();
@@ -461,13 +464,18 @@ namespace DetourNavigator
         Log(Debug::Debug) << "Processing job with db result " << job.mId;
 
         std::unique_ptr<PreparedNavMeshData> preparedNavMeshData;
+        std::optional<TilePortals> tilePortals;
         bool generatedNavMeshData = false;
 
         if (job.mCachedTileData.has_value() && job.mCachedTileData->mVersion == mSettings.get().mNavMeshVersion)
         {
             preparedNavMeshData = std::make_unique<PreparedNavMeshData>();
             if (deserialize(job.mCachedTileData->mData, *preparedNavMeshData))
+            {
                 ++mDbGetTileHits;
+                if (job.mCachedTilePortals.has_value() && !deserialize(*job.mCachedTilePortals, tilePortals.emplace()))
+                    tilePortals.reset();
+            }
             else
                 preparedNavMeshData = nullptr;
         }
@@ -492,13 +500,18 @@ namespace DetourNavigator
 
         const PreparedNavMeshData* preparedNavMeshDataPtr = cachedNavMeshData ? &cachedNavMeshData.get() : preparedNavMeshData.get();
         const UpdateNavMeshStatus status = navMeshCacheItem.lock()->updateTile(job.mChangedTile, std::move(cachedNavMeshData),
-            makeNavMeshTileData(*preparedNavMeshDataPtr, offMeshConnections, job.mAgentHalfExtents, job.mChangedTile, mSettings.get().mRecast));
+            makeNavMeshTileData(*preparedNavMeshDataPtr, offMeshConnections, job.mAgentHalfExtents, job.mChangedTile, mSettings.get().mRecast),
+            std::move(tilePortals));
 
         const JobStatus result = handleUpdateNavMeshStatus(status, job, navMeshCacheItem, *job.mRecastMesh);
 
         if (result == JobStatus::Done && job.mChangeType != ChangeType::update
                 && mDbWorker != nullptr && mSettings.get().mWriteToNavMeshDb && generatedNavMeshData)
+        {
             job.mGeneratedNavMeshData = std::make_unique<PreparedNavMeshData>(*preparedNavMeshDataPtr);
+            if (const TilePortals* portals = navMeshCacheItem.lockConst()->getTileGraph().getTile(job.mChangedTile))
+                job.mGeneratedTilePortals = *portals;
+        }
 
         return result;
     }
@@ -746,6 +759,7 @@ namespace DetourNavigator
     void DbWorker::run() noexcept
     {
         constexpr std::size_t writesPerTransaction = 100;
+        Debug::FrameProfiler::setThreadName("NavigatorDb");
         auto transaction = mDb->startTransaction();
         while (!mShouldStop)
         {
@@ -770,6 +784,7 @@ namespace DetourNavigator
 
     void DbWorker::processJob(JobIt job)
     {
+        const Debug::ProfileZone zone("DbWorker::processJob");
         const auto process = [&] (auto f)
         {
             try
@@ -821,6 +836,8 @@ namespace DetourNavigator
         }
 
         job->mCachedTileData = mDb->getTileData(job->mWorldspace, job->mChangedTile, job->mInput);
+        if (job->mCachedTileData.has_value())
+            job->mCachedTilePortals = mDb->getTilePortals(job->mCachedTileData->mTileId);
         ++mGetTileCount;
     }
 
@@ -843,6 +860,7 @@ namespace DetourNavigator
             Log(Debug::Debug) << "Update db tile by job " << job->mId;
             job->mGeneratedNavMeshData->mUserId = cachedTileData->mTileId;
             mDb->updateTile(cachedTileData->mTileId, mVersion, serialize(*job->mGeneratedNavMeshData));
+            writeTilePortals(cachedTileData->mTileId, *job);
             return;
         }
 
@@ -857,6 +875,15 @@ namespace DetourNavigator
         Log(Debug::Debug) << "Insert db tile by job " << job->mId;
         mDb->insertTile(mNextTileId, job->mWorldspace, job->mChangedTile,
                         mVersion, job->mInput, serialize(*job->mGeneratedNavMeshData));
+        writeTilePortals(mNextTileId, *job);
         ++mNextTileId.t;
     }
+
+    void DbWorker::writeTilePortals(TileId tileId, const Job& job)
+    {
+        if (!job.mGeneratedTilePortals.has_value())
+            return;
+        Log(Debug::Debug) << "Write db tile portals by job " << job.mId;
+        mDb->insertTilePortals(tileId, serialize(*job.mGeneratedTilePortals));
+    }
 }
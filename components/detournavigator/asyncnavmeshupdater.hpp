@@ -5,6 +5,7 @@
 #include "offmeshconnectionsmanager.hpp"
 #include "tilecachedrecastmeshmanager.hpp"
 #include "tileposition.hpp"
+#include "tilegraph.hpp"
 #include "navmeshtilescache.hpp"
 #include "waitconditiontype.hpp"
 #include "navmeshdb.hpp"
@@ -77,7 +78,9 @@ namespace DetourNavigator
         std::vector<std::byte> mInput;
         std::shared_ptr<RecastMesh> mRecastMesh;
         std::optional<TileData> mCachedTileData;
+        std::optional<std::vector<std::byte>> mCachedTilePortals;
         std::unique_ptr<PreparedNavMeshData> mGeneratedNavMeshData;
+        std::optional<TilePortals> mGeneratedTilePortals;
 
         Job(const osg::Vec3f& agentHalfExtents, std::weak_ptr<GuardedNavMeshCacheItem> navMeshCacheItem,
             std::string_view worldspace, const TilePosition& changedTile, ChangeType changeType, int distanceToPlayer,
@@ -169,6 +172,8 @@ namespace DetourNavigator
         inline void processReadingJob(JobIt job);
 
         inline void processWritingJob(JobIt job);
+
+        inline void writeTilePortals(TileId tileId, const Job& job);
     };
 
     class AsyncNavMeshUpdater
@@ -1,6 +1,7 @@
 #include "findrandompointaroundcircle.hpp"
 #include "settings.hpp"
 #include "findsmoothpath.hpp"
+#include "navmeshquery.hpp"
 
 #include <components/misc/rng.hpp>
 
@@ -12,9 +13,10 @@ namespace DetourNavigator
     std::optional<osg::Vec3f> findRandomPointAroundCircle(const dtNavMesh& navMesh, const osg::Vec3f& halfExtents,
         const osg::Vec3f& start, const float maxRadius, const Flags includeFlags, const DetourSettings& settings)
     {
-        dtNavMeshQuery navMeshQuery;
-        if (!initNavMeshQuery(navMeshQuery, navMesh, settings.mMaxNavMeshQueryNodes))
+        dtNavMeshQuery* const query = getNavMeshQuery(navMesh, settings.mMaxNavMeshQueryNodes);
+        if (query == nullptr)
             return std::optional<osg::Vec3f>();
+        const dtNavMeshQuery& navMeshQuery = *query;
 
         dtQueryFilter queryFilter;
         queryFilter.setIncludeFlags(includeFlags);
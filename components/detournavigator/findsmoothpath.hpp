@@ -9,6 +9,7 @@
 #include "debug.hpp"
 #include "status.hpp"
 #include "areatype.hpp"
+#include "navmeshquery.hpp"
 
 #include <DetourCommon.h>
 #include <DetourNavMesh.h>
@@ -94,10 +95,18 @@ namespace DetourNavigator
         std::reference_wrapper<const RecastSettings> mSettings;
     };
 
-    inline bool initNavMeshQuery(dtNavMeshQuery& value, const dtNavMesh& navMesh, const int maxNodes)
+    // Polygons for start and end are searched within agent half extents multiplied by this.
+    constexpr float polyDistanceFactor = 4;
+
+    inline dtQueryFilter makeQueryFilter(const Flags includeFlags, const AreaCosts& areaCosts)
     {
-        const auto status = value.init(&navMesh, maxNodes);
-        return dtStatusSucceed(status);
+        dtQueryFilter queryFilter;
+        queryFilter.setIncludeFlags(includeFlags);
+        queryFilter.setAreaCost(AreaType_water, areaCosts.mWater);
+        queryFilter.setAreaCost(AreaType_door, areaCosts.mDoor);
+        queryFilter.setAreaCost(AreaType_pathgrid, areaCosts.mPathgrid);
+        queryFilter.setAreaCost(AreaType_ground, areaCosts.mGround);
+        return queryFilter;
     }
 
     dtPolyRef findNearestPoly(const dtNavMeshQuery& query, const dtQueryFilter& filter,
@@ -260,18 +269,13 @@ namespace DetourNavigator
             const osg::Vec3f& start, const osg::Vec3f& end, const Flags includeFlags, const AreaCosts& areaCosts,
             const Settings& settings, float endTolerance, OutputIterator& out)
     {
-        dtNavMeshQuery navMeshQuery;
-        if (!initNavMeshQuery(navMeshQuery, navMesh, settings.mDetour.mMaxNavMeshQueryNodes))
+        dtNavMeshQuery* const query = getNavMeshQuery(navMesh, settings.mDetour.mMaxNavMeshQueryNodes);
+        if (query == nullptr)
             return Status::InitNavMeshQueryFailed;
+        const dtNavMeshQuery& navMeshQuery = *query;
 
-        dtQueryFilter queryFilter;
-        queryFilter.setIncludeFlags(includeFlags);
-        queryFilter.setAreaCost(AreaType_water, areaCosts.mWater);
-        queryFilter.setAreaCost(AreaType_door, areaCosts.mDoor);
-        queryFilter.setAreaCost(AreaType_pathgrid, areaCosts.mPathgrid);
-        queryFilter.setAreaCost(AreaType_ground, areaCosts.mGround);
+        const dtQueryFilter queryFilter = makeQueryFilter(includeFlags, areaCosts);
 
-        constexpr float polyDistanceFactor = 4;
         const osg::Vec3f polyHalfExtents = halfExtents * polyDistanceFactor;
 
         const dtPolyRef startRef = findNearestPoly(navMeshQuery, queryFilter, start, polyHalfExtents);
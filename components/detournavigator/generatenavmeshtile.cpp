@@ -2,10 +2,12 @@
 
 #include "dbrefgeometryobject.hpp"
 #include "makenavmesh.hpp"
+#include "navmeshtileview.hpp"
 #include "offmeshconnectionsmanager.hpp"
 #include "preparednavmeshdata.hpp"
 #include "serialization.hpp"
 #include "settings.hpp"
+#include "tilegraph.hpp"
 #include "tilecachedrecastmeshmanager.hpp"
 
 #include <components/debug/debuglog.hpp>
@@ -13,6 +15,7 @@
 #include <osg/Vec3f>
 #include <osg/io_utils>
 
+#include <chrono>
 #include <memory>
 #include <stdexcept>
 #include <vector>
@@ -33,6 +36,18 @@ namespace DetourNavigator
                     mConsumer->ignore();
             }
         };
+
+        struct ReportTimes
+        {
+            NavMeshTileConsumer& mConsumer;
+            std::chrono::steady_clock::duration mSerialize {0};
+            std::chrono::steady_clock::duration mGenerate {0};
+
+            ~ReportTimes() noexcept
+            {
+                mConsumer.reportTimes(mSerialize, mGenerate);
+            }
+        };
     }
 
     GenerateNavMeshTile::GenerateNavMeshTile(std::string worldspace, const TilePosition& tilePosition,
@@ -60,6 +75,9 @@ namespace DetourNavigator
         try
         {
             Ignore ignore {consumer};
+            ReportTimes times {*consumer};
+
+            const auto serializeStart = std::chrono::steady_clock::now();
 
             const std::shared_ptr<RecastMesh> recastMesh = mRecastMeshProvider.getMesh(mWorldspace, mTilePosition);
 
@@ -69,20 +87,29 @@ namespace DetourNavigator
             const std::vector<DbRefGeometryObject> objects = makeDbRefGeometryObjects(recastMesh->getMeshSources(),
                 [&] (const MeshSource& v) { return consumer->resolveMeshSource(v); });
             std::vector<std::byte> input = serialize(mSettings.mRecast, *recastMesh, objects);
+            times.mSerialize = std::chrono::steady_clock::now() - serializeStart;
             const std::optional<NavMeshTileInfo> info = consumer->find(mWorldspace, mTilePosition, input);
 
             if (info.has_value() && info->mVersion == mSettings.mNavMeshVersion)
                 return;
 
+            const auto generateStart = std::chrono::steady_clock::now();
+
             const auto data = prepareNavMeshTileData(*recastMesh, mTilePosition, mAgentHalfExtents, mSettings.mRecast);
 
             if (data == nullptr)
                 return;
 
+            // Off-mesh connections are added by the game and are not used by the tile graph.
+            const TilePortals portals = makeTilePortals(asNavMeshTileConstView(
+                makeNavMeshTileData(*data, {}, mAgentHalfExtents, mTilePosition, mSettings.mRecast).mValue.get()));
+
+            times.mGenerate = std::chrono::steady_clock::now() - generateStart;
+
             if (info.has_value())
-                consumer->update(info->mTileId, mSettings.mNavMeshVersion, *data);
+                consumer->update(info->mTileId, mSettings.mNavMeshVersion, *data, portals);
             else
-                consumer->insert(mWorldspace, mTilePosition, mSettings.mNavMeshVersion, input, *data);
+                consumer->insert(mWorldspace, mTilePosition, mSettings.mNavMeshVersion, input, *data, portals);
 
             ignore.mConsumer = nullptr;
         }
@@ -2,12 +2,14 @@
 #define OPENMW_COMPONENTS_DETOURNAVIGATOR_GENERATENAVMESHTILE_H
 
 #include "recastmeshprovider.hpp"
+#include "tilegraph.hpp"
 #include "tileposition.hpp"
 
 #include <components/sceneutil/workqueue.hpp>
 
 #include <osg/Vec3f>
 
+#include <chrono>
 #include <cstdint>
 #include <functional>
 #include <memory>
@@ -42,9 +44,15 @@ namespace DetourNavigator
         virtual void ignore() = 0;
 
         virtual void insert(const std::string& worldspace, const TilePosition& tilePosition,
-                            std::int64_t version, const std::vector<std::byte>& input, PreparedNavMeshData& data) = 0;
+                            std::int64_t version, const std::vector<std::byte>& input, PreparedNavMeshData& data,
+                            const TilePortals& portals) = 0;
 
-        virtual void update(std::int64_t tileId, std::int64_t version, PreparedNavMeshData& data) = 0;
+        virtual void update(std::int64_t tileId, std::int64_t version, PreparedNavMeshData& data,
+                            const TilePortals& portals) = 0;
+
+        // Called once per tile with time spent to build and serialize the recast mesh and to generate the tile data.
+        virtual void reportTimes(std::chrono::steady_clock::duration serialize,
+                                 std::chrono::steady_clock::duration generate) = 0;
     };
 
     class GenerateNavMeshTile final : public SceneUtil::WorkItem
@@ -54,6 +62,8 @@ namespace DetourNavigator
                 RecastMeshProvider recastMeshProvider, const osg::Vec3f& agentHalfExtents, const Settings& settings,
                 std::weak_ptr<NavMeshTileConsumer> consumer);
 
+        const char* getProfileName() const final { return "GenerateNavMeshTile"; }
+
         void doWork() final;
 
     private:
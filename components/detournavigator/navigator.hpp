@@ -189,7 +189,7 @@ namespace DetourNavigator
 
         virtual const Settings& getSettings() const = 0;
 
-        virtual void reportStats(unsigned int frameNumber, osg::Stats& stats) const = 0;
+        virtual void reportStats(unsigned int frameNumber, osg::Stats& stats) = 0;
 
         virtual RecastMeshTiles getRecastMeshTiles() const = 0;
 
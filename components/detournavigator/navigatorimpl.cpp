@@ -186,7 +186,7 @@ namespace DetourNavigator
         return mSettings;
     }
 
-    void NavigatorImpl::reportStats(unsigned int frameNumber, osg::Stats& stats) const
+    void NavigatorImpl::reportStats(unsigned int frameNumber, osg::Stats& stats)
     {
         mNavMeshManager.reportStats(frameNumber, stats);
     }
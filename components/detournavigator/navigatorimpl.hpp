@@ -60,7 +60,7 @@ namespace DetourNavigator
 
         const Settings& getSettings() const override;
 
-        void reportStats(unsigned int frameNumber, osg::Stats& stats) const override;
+        void reportStats(unsigned int frameNumber, osg::Stats& stats) override;
 
         RecastMeshTiles getRecastMeshTiles() const override;
 
@@ -93,7 +93,7 @@ namespace DetourNavigator
             return mDefaultSettings;
         }
 
-        void reportStats(unsigned int /*frameNumber*/, osg::Stats& /*stats*/) const override {}
+        void reportStats(unsigned int /*frameNumber*/, osg::Stats& /*stats*/) override {}
 
         RecastMeshTiles getRecastMeshTiles() const override
         {
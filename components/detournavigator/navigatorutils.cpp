@@ -2,9 +2,329 @@
 #include "findrandompointaroundcircle.hpp"
 #include "navigator.hpp"
 #include "raycast.hpp"
+#include "navmeshquery.hpp"
+
+#include <components/sceneutil/workqueue.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <condition_variable>
+#include <functional>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <mutex>
 
 namespace DetourNavigator
 {
+    namespace
+    {
+        // Requests with start and end within the same cubes of this size in world units share the cached path.
+        constexpr float pathCacheQuantum = 8;
+
+        // Requests of a batch are processed by the calling thread and by work items. Work items only run the batch while
+        // it's open, so closing it doesn't wait for items that are still queued behind other work.
+        class PathBatch
+        {
+        public:
+            explicit PathBatch(std::function<void()> process)
+                : mProcess(std::move(process))
+            {}
+
+            void run()
+            {
+                {
+                    const std::lock_guard<std::mutex> lock(mMutex);
+                    if (mClosed)
+                        return;
+                    ++mRunning;
+                }
+                try
+                {
+                    mProcess();
+                }
+                catch (...)
+                {
+                    finish();
+                    throw;
+                }
+                finish();
+            }
+
+            void close()
+            {
+                std::unique_lock<std::mutex> lock(mMutex);
+                mClosed = true;
+                mHasFinished.wait(lock, [&] { return mRunning == 0; });
+            }
+
+        private:
+            const std::function<void()> mProcess;
+            std::mutex mMutex;
+            std::condition_variable mHasFinished;
+            std::size_t mRunning = 0;
+            bool mClosed = false;
+
+            void finish()
+            {
+                {
+                    const std::lock_guard<std::mutex> lock(mMutex);
+                    --mRunning;
+                }
+                mHasFinished.notify_all();
+            }
+        };
+
+        class FindPathsWorkItem final : public SceneUtil::WorkItem
+        {
+        public:
+            explicit FindPathsWorkItem(std::shared_ptr<PathBatch> batch)
+                : mBatch(std::move(batch))
+            {}
+
+            void doWork() override { mBatch->run(); }
+
+            const char* getProfileName() const override { return "FindPaths"; }
+
+        private:
+            const std::shared_ptr<PathBatch> mBatch;
+        };
+
+        osg::Vec3i quantize(const osg::Vec3f& value)
+        {
+            return osg::Vec3i(static_cast<int>(std::floor(value.x() / pathCacheQuantum)),
+                              static_cast<int>(std::floor(value.y() / pathCacheQuantum)),
+                              static_cast<int>(std::floor(value.z() / pathCacheQuantum)));
+        }
+
+        std::optional<std::vector<std::pair<TilePosition, Version>>> getPathTiles(const NavMeshCacheItem& navMesh,
+            const RecastSettings& settings, const std::vector<osg::Vec3f>& path)
+        {
+            // Path points are closer to each other than the tile size, so every tile the path goes through is found.
+            std::vector<TilePosition> positions;
+            positions.reserve(path.size());
+            for (const osg::Vec3f& point : path)
+                positions.push_back(getTilePosition(settings, toNavMeshCoordinates(settings, point)));
+            std::sort(positions.begin(), positions.end());
+            positions.erase(std::unique(positions.begin(), positions.end()), positions.end());
+            std::vector<std::pair<TilePosition, Version>> result;
+            result.reserve(positions.size());
+            for (const TilePosition& position : positions)
+            {
+                const std::optional<Version> version = navMesh.getTileVersion(position);
+                if (!version.has_value())
+                    return std::nullopt;
+                result.emplace_back(position, *version);
+            }
+            return result;
+        }
+
+        int getTilesDistance(const TilePosition& lhs, const TilePosition& rhs)
+        {
+            return std::max(std::abs(lhs.x() - rhs.x()), std::abs(lhs.y() - rhs.y()));
+        }
+
+        float getHorizontalDistance(const osg::Vec3f& lhs, const osg::Vec3f& rhs)
+        {
+            return std::max(std::abs(lhs.x() - rhs.x()), std::abs(lhs.z() - rhs.z()));
+        }
+
+        // Takes the farthest route points that are closer to the previous one than maxDistance.
+        std::vector<osg::Vec3f> getWaypoints(const osg::Vec3f& start, const std::vector<osg::Vec3f>& route,
+            const osg::Vec3f& end, float maxDistance)
+        {
+            std::vector<osg::Vec3f> result;
+            osg::Vec3f last = start;
+            for (std::size_t i = 0; i < route.size(); ++i)
+            {
+                const osg::Vec3f& next = i + 1 < route.size() ? route[i + 1] : end;
+                if (getHorizontalDistance(last, next) < maxDistance)
+                    continue;
+                result.push_back(route[i]);
+                last = route[i];
+            }
+            result.push_back(end);
+            return result;
+        }
+
+        // All positions are in navmesh coordinates, found path is in world coordinates.
+        Status findHierarchicalPath(const NavMeshCacheItem& navMesh, const Settings& settings,
+            const osg::Vec3f& halfExtents, float stepSize, const osg::Vec3f& start, const osg::Vec3f& end,
+            const Flags includeFlags, const AreaCosts& areaCosts, float endTolerance, std::vector<osg::Vec3f>& path)
+        {
+            const auto findDirectly = [&]
+            {
+                auto out = std::back_inserter(path);
+                return findSmoothPath(navMesh.getImpl(), halfExtents, stepSize, start, end, includeFlags, areaCosts,
+                    settings, endTolerance, out);
+            };
+
+            const int minTilesDistance = settings.mDetour.mHierarchicalPathMinTilesDistance;
+            const TilePosition startTile = getTilePosition(settings.mRecast, start);
+            const TilePosition endTile = getTilePosition(settings.mRecast, end);
+            if (minTilesDistance <= 0 || getTilesDistance(startTile, endTile) < minTilesDistance)
+                return findDirectly();
+
+            const std::optional<std::vector<osg::Vec3f>> route = navMesh.getTileGraph().findRoute(startTile, start,
+                endTile, end, includeFlags, static_cast<std::size_t>(settings.mDetour.mMaxNavMeshQueryNodes));
+            if (!route.has_value())
+                return findDirectly();
+
+            const std::vector<osg::Vec3f> waypoints = getWaypoints(start, *route, end,
+                minTilesDistance * getTileSize(settings.mRecast));
+
+            osg::Vec3f segmentStart = start;
+            for (std::size_t i = 0; i < waypoints.size(); ++i)
+            {
+                const bool last = i + 1 == waypoints.size();
+                std::vector<osg::Vec3f> segment;
+                auto out = std::back_inserter(segment);
+                const Status status = findSmoothPath(navMesh.getImpl(), halfExtents, stepSize, segmentStart,
+                    waypoints[i], includeFlags, areaCosts, settings, last ? endTolerance : 0.0f, out);
+                if (!last && (status != Status::Success || segment.empty()))
+                {
+                    // Route over the tile graph ignores off-mesh connections and areas not allowed by the flags
+                    // inside tiles, so it may be not walkable.
+                    path.clear();
+                    return findDirectly();
+                }
+                // Every segment starts where the previous one ends.
+                path.insert(path.end(), segment.begin() + (i == 0 || segment.empty() ? 0 : 1), segment.end());
+                if (last)
+                    return status;
+                segmentStart = toNavMeshCoordinates(settings.mRecast, segment.back());
+            }
+
+            return Status::Success;
+        }
+    }
+
+    Status findPath(const NavMeshCacheItem& navMesh, const Settings& settings, const osg::Vec3f& agentHalfExtents,
+        const float stepSize, const osg::Vec3f& start, const osg::Vec3f& end, const Flags includeFlags,
+        const AreaCosts& areaCosts, float endTolerance, std::vector<osg::Vec3f>& path)
+    {
+        const osg::Vec3f halfExtents = toNavMeshCoordinates(settings.mRecast, agentHalfExtents);
+        const osg::Vec3f navMeshStart = toNavMeshCoordinates(settings.mRecast, start);
+        const osg::Vec3f navMeshEnd = toNavMeshCoordinates(settings.mRecast, end);
+        const auto find = [&]
+        {
+            return findHierarchicalPath(navMesh, settings, halfExtents, toNavMeshCoordinates(settings.mRecast, stepSize),
+                navMeshStart, navMeshEnd, includeFlags, areaCosts, endTolerance, path);
+        };
+
+        PathCache& cache = navMesh.getPathCache();
+        if (cache.getCapacity() == 0)
+            return find();
+
+        dtNavMeshQuery* const query = getNavMeshQuery(navMesh.getImpl(), settings.mDetour.mMaxNavMeshQueryNodes);
+        if (query == nullptr)
+            return Status::InitNavMeshQueryFailed;
+
+        const dtQueryFilter queryFilter = makeQueryFilter(includeFlags, areaCosts);
+        const osg::Vec3f polyHalfExtents = halfExtents * polyDistanceFactor;
+        const dtPolyRef startRef = findNearestPoly(*query, queryFilter, navMeshStart, polyHalfExtents);
+        const dtPolyRef endRef = findNearestPoly(*query, queryFilter, navMeshEnd,
+            polyHalfExtents + osg::Vec3f(endTolerance, endTolerance, endTolerance));
+        // Let findSmoothPath report the failure.
+        if (startRef == 0 || endRef == 0)
+            return find();
+
+        // Smooth path starts and ends at the closest points of the polygons, these depend on the exact start and end.
+        osg::Vec3f startPoint;
+        query->closestPointOnPoly(startRef, navMeshStart.ptr(), startPoint.ptr(), nullptr);
+        startPoint = fromNavMeshCoordinates(settings.mRecast, startPoint);
+        osg::Vec3f endPoint;
+        query->closestPointOnPoly(endRef, navMeshEnd.ptr(), endPoint.ptr(), nullptr);
+        endPoint = fromNavMeshCoordinates(settings.mRecast, endPoint);
+
+        const PathCacheKey key {startRef, endRef, quantize(start), quantize(end), stepSize, includeFlags, areaCosts,
+            endTolerance};
+        const auto getTileVersion = [&] (const TilePosition& position) { return navMesh.getTileVersion(position); };
+
+        if (std::optional<CachedPath> cached = cache.get(key, getTileVersion))
+        {
+            path = std::move(cached->mPath);
+            if (!path.empty())
+                path.front() = startPoint;
+            if (cached->mReachesEnd)
+                path.back() = endPoint;
+            return cached->mStatus;
+        }
+
+        const Status status = find();
+        if (status != Status::Success && status != Status::PartialPath)
+            return status;
+
+        if (auto tiles = getPathTiles(navMesh, settings.mRecast, path))
+        {
+            const bool reachesEnd = status == Status::Success && path.size() > 1 && path.back() == endPoint;
+            cache.set(key, CachedPath {status, path, std::move(*tiles), reachesEnd});
+        }
+
+        return status;
+    }
+
+    std::vector<PathResult> findPaths(const Navigator& navigator, const std::vector<PathRequest>& requests,
+        SceneUtil::WorkQueue* workQueue, std::size_t workersNumber)
+    {
+        std::vector<PathResult> results(requests.size());
+
+        std::map<osg::Vec3f, std::vector<std::size_t>> agentRequests;
+        for (std::size_t i = 0; i < requests.size(); ++i)
+            agentRequests[requests[i].mAgentHalfExtents].push_back(i);
+
+        const auto& settings = navigator.getSettings();
+
+        for (const auto& [agentHalfExtents, indices] : agentRequests)
+        {
+            const auto navMesh = navigator.getNavMesh(agentHalfExtents);
+            if (navMesh == nullptr)
+            {
+                for (const std::size_t index : indices)
+                    results[index].mStatus = Status::NavMeshNotFound;
+                continue;
+            }
+
+            const auto locked = navMesh->lockConst();
+            std::atomic_size_t next {0};
+
+            const auto process = [&]
+            {
+                for (std::size_t i = next++; i < indices.size(); i = next++)
+                {
+                    const PathRequest& request = requests[indices[i]];
+                    PathResult& result = results[indices[i]];
+                    result.mStatus = findPath(*locked, settings, agentHalfExtents, request.mStepSize, request.mStart,
+                        request.mEnd, request.mIncludeFlags, request.mAreaCosts, request.mEndTolerance, result.mPath);
+                }
+            };
+
+            if (workQueue == nullptr || workersNumber == 0 || indices.size() == 1)
+            {
+                process();
+                continue;
+            }
+
+            const auto batch = std::make_shared<PathBatch>(process);
+            const std::size_t workItems = std::min(workersNumber, indices.size() - 1);
+            for (std::size_t i = 0; i < workItems; ++i)
+                workQueue->addWorkItem(new FindPathsWorkItem(batch));
+            try
+            {
+                batch->run();
+            }
+            catch (...)
+            {
+                batch->close();
+                throw;
+            }
+            batch->close();
+        }
+
+        return results;
+    }
+
     std::optional<osg::Vec3f> findRandomPointAroundCircle(const Navigator& navigator, const osg::Vec3f& agentHalfExtents,
         const osg::Vec3f& start, const float maxRadius, const Flags includeFlags)
     {
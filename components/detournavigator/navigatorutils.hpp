@@ -7,9 +7,25 @@
 #include "navigator.hpp"
 
 #include <optional>
+#include <vector>
+
+namespace SceneUtil
+{
+    class WorkQueue;
+}
 
 namespace DetourNavigator
 {
+    /**
+     * @brief findPath does the same as the findPath below for the locked navmesh of the agent.
+     * Cached path is used for requests with the same polygons and close enough start and end.
+     * Path between far tiles is planned over the tile graph and refined by searches between the route points.
+     * @param path receives the found path, should be empty.
+     */
+    Status findPath(const NavMeshCacheItem& navMesh, const Settings& settings, const osg::Vec3f& agentHalfExtents,
+        const float stepSize, const osg::Vec3f& start, const osg::Vec3f& end, const Flags includeFlags,
+        const AreaCosts& areaCosts, float endTolerance, std::vector<osg::Vec3f>& path);
+
     /**
      * @brief findPath fills output iterator with points of scene surfaces to be used for actor to walk through.
      * @param agentHalfExtents allows to find navmesh for given actor.
@@ -37,11 +53,44 @@ namespace DetourNavigator
         if (navMesh == nullptr)
             return Status::NavMeshNotFound;
         const auto settings = navigator.getSettings();
-        return findSmoothPath(navMesh->lockConst()->getImpl(), toNavMeshCoordinates(settings.mRecast, agentHalfExtents),
-            toNavMeshCoordinates(settings.mRecast, stepSize), toNavMeshCoordinates(settings.mRecast, start),
-            toNavMeshCoordinates(settings.mRecast, end), includeFlags, areaCosts, settings, endTolerance, out);
+        std::vector<osg::Vec3f> path;
+        const Status status = findPath(*navMesh->lockConst(), settings, agentHalfExtents, stepSize, start, end,
+            includeFlags, areaCosts, endTolerance, path);
+        for (const osg::Vec3f& point : path)
+            *out++ = point;
+        return status;
     }
 
+    struct PathRequest
+    {
+        osg::Vec3f mAgentHalfExtents;
+        float mStepSize;
+        osg::Vec3f mStart;
+        osg::Vec3f mEnd;
+        Flags mIncludeFlags;
+        AreaCosts mAreaCosts;
+        float mEndTolerance;
+    };
+
+    struct PathResult
+    {
+        Status mStatus;
+        std::vector<osg::Vec3f> mPath;
+    };
+
+    /**
+     * @brief findPaths resolves path requests in parallel, each one the same way as findPath.
+     * Navmesh of each agent is locked once for all its requests, so updates of the navmesh wait until they are done.
+     * Requests are resolved by the calling thread and by up to workersNumber work items added to workQueue. The calling
+     * thread doesn't wait for work items that haven't started when all requests are taken.
+     * @param workQueue persistent worker threads to use in addition to the calling one, may be nullptr.
+     * @param workersNumber defines how many work items are added for each agent, should not exceed the number of
+     * threads of workQueue.
+     * @return results in the same order as requests.
+     */
+    std::vector<PathResult> findPaths(const Navigator& navigator, const std::vector<PathRequest>& requests,
+        SceneUtil::WorkQueue* workQueue, std::size_t workersNumber);
+
     /**
      * @brief findRandomPointAroundCircle returns random location on navmesh within the reach of specified location.
      * @param agentHalfExtents allows to find navmesh for given actor.
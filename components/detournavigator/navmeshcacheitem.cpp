@@ -42,7 +42,7 @@ namespace DetourNavigator
     }
 
     UpdateNavMeshStatus NavMeshCacheItem::updateTile(const TilePosition& position, NavMeshTilesCache::Value&& cached,
-        NavMeshData&& navMeshData)
+        NavMeshData&& navMeshData, std::optional<TilePortals>&& portals)
     {
         const dtMeshTile* currentTile = getTile(*mImpl, position);
         if (currentTile != nullptr
@@ -55,6 +55,10 @@ namespace DetourNavigator
         const auto addStatus = addTile(*mImpl, navMeshData.mValue.get(), navMeshData.mSize);
         if (dtStatusSucceed(addStatus))
         {
+            if (portals.has_value())
+                mTileGraph.setTile(position, std::move(*portals));
+            else
+                mTileGraph.setTile(position, makeTilePortals(asNavMeshTileConstView(navMeshData.mValue.get())));
             auto tile = mUsedTiles.find(position);
             if (tile == mUsedTiles.end())
             {
@@ -75,6 +79,7 @@ namespace DetourNavigator
             if (removed)
             {
                 mUsedTiles.erase(position);
+                mTileGraph.removeTile(position);
                 ++mVersion.mRevision;
             }
             return UpdateNavMeshStatusBuilder().removed(removed).failed((addStatus & DT_OUT_OF_MEMORY) != 0).getResult();
@@ -88,6 +93,7 @@ namespace DetourNavigator
         if (removed)
         {
             mUsedTiles.erase(position);
+            mTileGraph.removeTile(position);
             ++mVersion.mRevision;
         }
         return UpdateNavMeshStatusBuilder().removed(removed).getResult();
@@ -100,6 +106,7 @@ namespace DetourNavigator
         if (removed)
         {
             mUsedTiles.erase(position);
+            mTileGraph.removeTile(position);
             ++mVersion.mRevision;
         }
         return UpdateNavMeshStatusBuilder().removed(removed).getResult();
@@ -109,4 +116,12 @@ namespace DetourNavigator
     {
         return mEmptyTiles.find(position) != mEmptyTiles.end();
     }
+
+    std::optional<Version> NavMeshCacheItem::getTileVersion(const TilePosition& position) const
+    {
+        const auto it = mUsedTiles.find(position);
+        if (it == mUsedTiles.end())
+            return std::nullopt;
+        return it->second.mVersion;
+    }
 }
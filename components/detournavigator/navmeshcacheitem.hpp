@@ -7,10 +7,13 @@
 #include "dtstatus.hpp"
 #include "navmeshdata.hpp"
 #include "version.hpp"
+#include "pathcache.hpp"
+#include "tilegraph.hpp"
 
 #include <components/misc/guarded.hpp>
 
 #include <map>
+#include <optional>
 #include <ostream>
 #include <set>
 
@@ -130,9 +133,10 @@ namespace DetourNavigator
     class NavMeshCacheItem
     {
     public:
-        NavMeshCacheItem(const NavMeshPtr& impl, std::size_t generation)
+        NavMeshCacheItem(const NavMeshPtr& impl, std::size_t generation, std::size_t pathCacheCapacity = 0)
             : mImpl(impl)
             , mVersion {generation, 0}
+            , mPathCache(pathCacheCapacity)
         {
         }
 
@@ -143,8 +147,9 @@ namespace DetourNavigator
 
         const Version& getVersion() const { return mVersion; }
 
+        // Portals of the tile are made from navMeshData when they are not given.
         UpdateNavMeshStatus updateTile(const TilePosition& position, NavMeshTilesCache::Value&& cached,
-                                       NavMeshData&& navMeshData);
+                                       NavMeshData&& navMeshData, std::optional<TilePortals>&& portals = std::nullopt);
 
         UpdateNavMeshStatus removeTile(const TilePosition& position);
 
@@ -152,6 +157,14 @@ namespace DetourNavigator
 
         bool isEmptyTile(const TilePosition& position) const;
 
+        std::optional<Version> getTileVersion(const TilePosition& position) const;
+
+        // Has own lock, so can be used by several threads holding the const lock of the navmesh.
+        PathCache& getPathCache() const { return mPathCache; }
+
+        // Has the same tiles as the navmesh.
+        const TileGraph& getTileGraph() const { return mTileGraph; }
+
         template <class Function>
         void forEachUsedTile(Function&& function) const
         {
@@ -172,6 +185,8 @@ namespace DetourNavigator
         Version mVersion;
         std::map<TilePosition, Tile> mUsedTiles;
         std::set<TilePosition> mEmptyTiles;
+        mutable PathCache mPathCache;
+        TileGraph mTileGraph;
     };
 
     using GuardedNavMeshCacheItem = Misc::ScopeGuarded<NavMeshCacheItem>;
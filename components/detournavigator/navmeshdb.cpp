@@ -10,8 +10,11 @@
 #include <sqlite3.h>
 
 #include <cstddef>
+#include <iterator>
+#include <limits>
 #include <string>
 #include <string_view>
+#include <tuple>
 #include <vector>
 
 namespace DetourNavigator
@@ -35,6 +38,24 @@ namespace DetourNavigator
             CREATE UNIQUE INDEX IF NOT EXISTS index_unique_tiles_by_worldspace_and_tile_position_and_input
                 ON tiles (worldspace, tile_position_x, tile_position_y, input);
 
+            CREATE TABLE IF NOT EXISTS tile_portals (
+                tile_id INTEGER PRIMARY KEY,
+                revision INTEGER NOT NULL,
+                data BLOB
+            );
+
+            CREATE TABLE IF NOT EXISTS cells_tiles (
+                worldspace TEXT NOT NULL,
+                cell_id TEXT NOT NULL,
+                content_files TEXT NOT NULL,
+                digest BLOB NOT NULL,
+                min_tile_position_x INTEGER NOT NULL,
+                min_tile_position_y INTEGER NOT NULL,
+                max_tile_position_x INTEGER NOT NULL,
+                max_tile_position_y INTEGER NOT NULL,
+                PRIMARY KEY (worldspace, cell_id)
+            );
+
             CREATE TABLE IF NOT EXISTS shapes (
                 shape_id INTEGER PRIMARY KEY,
                 name TEXT NOT NULL,
@@ -83,6 +104,43 @@ namespace DetourNavigator
              WHERE tile_id = :tile_id
         )";
 
+        constexpr std::string_view getTilePortalsQuery = R"(
+            SELECT tile_portals.data
+              FROM tile_portals
+              JOIN tiles
+                ON tiles.tile_id = tile_portals.tile_id
+               AND tiles.revision = tile_portals.revision
+             WHERE tile_portals.tile_id = :tile_id
+        )";
+
+        constexpr std::string_view insertTilePortalsQuery = R"(
+            INSERT OR REPLACE INTO tile_portals (tile_id, revision, data)
+                SELECT tile_id, revision, :data
+                  FROM tiles
+                 WHERE tile_id = :tile_id
+        )";
+
+        constexpr std::string_view getCellsTilesQuery = R"(
+            SELECT worldspace, cell_id, content_files, digest,
+                   min_tile_position_x, min_tile_position_y, max_tile_position_x, max_tile_position_y
+              FROM cells_tiles
+        )";
+
+        constexpr std::string_view insertCellTilesQuery = R"(
+            INSERT OR REPLACE INTO cells_tiles ( worldspace,  cell_id,  content_files,  digest,
+                                                 min_tile_position_x,  min_tile_position_y,
+                                                 max_tile_position_x,  max_tile_position_y)
+                   VALUES                      (:worldspace, :cell_id, :content_files, :digest,
+                                                :min_tile_position_x, :min_tile_position_y,
+                                                :max_tile_position_x, :max_tile_position_y)
+        )";
+
+        constexpr std::string_view deleteCellTilesQuery = R"(
+            DELETE FROM cells_tiles
+             WHERE worldspace = :worldspace
+               AND cell_id = :cell_id
+        )";
+
         constexpr std::string_view getMaxShapeIdQuery = R"(
             SELECT max(shape_id) FROM shapes
         )";
@@ -118,6 +176,11 @@ namespace DetourNavigator
         , mGetTileData(*mDb, DbQueries::GetTileData {})
         , mInsertTile(*mDb, DbQueries::InsertTile {})
         , mUpdateTile(*mDb, DbQueries::UpdateTile {})
+        , mGetTilePortals(*mDb, DbQueries::GetTilePortals {})
+        , mInsertTilePortals(*mDb, DbQueries::InsertTilePortals {})
+        , mGetCellsTiles(*mDb, DbQueries::GetCellsTiles {})
+        , mInsertCellTiles(*mDb, DbQueries::InsertCellTiles {})
+        , mDeleteCellTiles(*mDb, DbQueries::DeleteCellTiles {})
         , mGetMaxShapeId(*mDb, DbQueries::GetMaxShapeId {})
         , mFindShapeId(*mDb, DbQueries::FindShapeId {})
         , mInsertShape(*mDb, DbQueries::InsertShape {})
@@ -173,6 +236,43 @@ namespace DetourNavigator
         return execute(*mDb, mUpdateTile, tileId, version, compressedData);
     }
 
+    std::optional<std::vector<std::byte>> NavMeshDb::getTilePortals(TileId tileId)
+    {
+        std::vector<std::byte> result;
+        if (&result == request(*mDb, mGetTilePortals, &result, 1, tileId))
+            return {};
+        return Misc::decompress(result);
+    }
+
+    int NavMeshDb::insertTilePortals(TileId tileId, const std::vector<std::byte>& data)
+    {
+        const std::vector<std::byte> compressedData = Misc::compress(data);
+        return execute(*mDb, mInsertTilePortals, tileId, compressedData);
+    }
+
+    std::vector<CellTiles> NavMeshDb::getCellsTiles()
+    {
+        using Row = std::tuple<std::string, std::string, std::string, std::vector<std::byte>, int, int, int, int>;
+        std::vector<Row> rows;
+        request(*mDb, mGetCellsTiles, std::back_inserter(rows), std::numeric_limits<std::size_t>::max());
+        std::vector<CellTiles> result;
+        result.reserve(rows.size());
+        for (auto& [worldspace, cellId, contentFiles, digest, minX, minY, maxX, maxY] : rows)
+            result.push_back(CellTiles {std::move(worldspace), std::move(cellId), std::move(contentFiles),
+                std::move(digest), TilePosition(minX, minY), TilePosition(maxX, maxY)});
+        return result;
+    }
+
+    int NavMeshDb::insertCellTiles(const CellTiles& value)
+    {
+        return execute(*mDb, mInsertCellTiles, value);
+    }
+
+    int NavMeshDb::deleteCellTiles(const std::string& worldspace, const std::string& cellId)
+    {
+        return execute(*mDb, mDeleteCellTiles, worldspace, cellId);
+    }
+
     ShapeId NavMeshDb::getMaxShapeId()
     {
         ShapeId shapeId {0};
@@ -261,6 +361,62 @@ namespace DetourNavigator
             Sqlite3::bindParameter(db, statement, ":data", data);
         }
 
+        std::string_view GetTilePortals::text() noexcept
+        {
+            return getTilePortalsQuery;
+        }
+
+        void GetTilePortals::bind(sqlite3& db, sqlite3_stmt& statement, TileId tileId)
+        {
+            Sqlite3::bindParameter(db, statement, ":tile_id", tileId);
+        }
+
+        std::string_view InsertTilePortals::text() noexcept
+        {
+            return insertTilePortalsQuery;
+        }
+
+        void InsertTilePortals::bind(sqlite3& db, sqlite3_stmt& statement, TileId tileId,
+            const std::vector<std::byte>& data)
+        {
+            Sqlite3::bindParameter(db, statement, ":tile_id", tileId);
+            Sqlite3::bindParameter(db, statement, ":data", data);
+        }
+
+        std::string_view GetCellsTiles::text() noexcept
+        {
+            return getCellsTilesQuery;
+        }
+
+        std::string_view InsertCellTiles::text() noexcept
+        {
+            return insertCellTilesQuery;
+        }
+
+        void InsertCellTiles::bind(sqlite3& db, sqlite3_stmt& statement, const CellTiles& value)
+        {
+            Sqlite3::bindParameter(db, statement, ":worldspace", value.mWorldspace);
+            Sqlite3::bindParameter(db, statement, ":cell_id", value.mCellId);
+            Sqlite3::bindParameter(db, statement, ":content_files", value.mContentFiles);
+            Sqlite3::bindParameter(db, statement, ":digest", value.mDigest);
+            Sqlite3::bindParameter(db, statement, ":min_tile_position_x", value.mMinTile.x());
+            Sqlite3::bindParameter(db, statement, ":min_tile_position_y", value.mMinTile.y());
+            Sqlite3::bindParameter(db, statement, ":max_tile_position_x", value.mMaxTile.x());
+            Sqlite3::bindParameter(db, statement, ":max_tile_position_y", value.mMaxTile.y());
+        }
+
+        std::string_view DeleteCellTiles::text() noexcept
+        {
+            return deleteCellTilesQuery;
+        }
+
+        void DeleteCellTiles::bind(sqlite3& db, sqlite3_stmt& statement, const std::string& worldspace,
+            const std::string& cellId)
+        {
+            Sqlite3::bindParameter(db, statement, ":worldspace", worldspace);
+            Sqlite3::bindParameter(db, statement, ":cell_id", cellId);
+        }
+
         std::string_view GetMaxShapeId::text() noexcept
         {
             return getMaxShapeIdQuery;
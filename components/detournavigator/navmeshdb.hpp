@@ -45,6 +45,20 @@ namespace DetourNavigator
         std::vector<std::byte> mData;
     };
 
+    // Tiles touched by the content of a cell, used by navmeshtool to regenerate only tiles of the changed cells.
+    struct CellTiles
+    {
+        std::string mWorldspace;
+        std::string mCellId;
+        // Names of the content files defining the cell separated by new line.
+        std::string mContentFiles;
+        // Hash of the cell records and of the settings affecting the navmesh.
+        std::vector<std::byte> mDigest;
+        // Range is empty when min is greater than max.
+        TilePosition mMinTile;
+        TilePosition mMaxTile;
+    };
+
     enum class ShapeType
     {
         Collision = 1,
@@ -90,6 +104,37 @@ namespace DetourNavigator
                 const std::vector<std::byte>& data);
         };
 
+        struct GetTilePortals
+        {
+            static std::string_view text() noexcept;
+            static void bind(sqlite3& db, sqlite3_stmt& statement, TileId tileId);
+        };
+
+        struct InsertTilePortals
+        {
+            static std::string_view text() noexcept;
+            static void bind(sqlite3& db, sqlite3_stmt& statement, TileId tileId, const std::vector<std::byte>& data);
+        };
+
+        struct GetCellsTiles
+        {
+            static std::string_view text() noexcept;
+            static void bind(sqlite3&, sqlite3_stmt&) {}
+        };
+
+        struct InsertCellTiles
+        {
+            static std::string_view text() noexcept;
+            static void bind(sqlite3& db, sqlite3_stmt& statement, const CellTiles& value);
+        };
+
+        struct DeleteCellTiles
+        {
+            static std::string_view text() noexcept;
+            static void bind(sqlite3& db, sqlite3_stmt& statement, const std::string& worldspace,
+                const std::string& cellId);
+        };
+
         struct GetMaxShapeId
         {
             static std::string_view text() noexcept;
@@ -131,6 +176,19 @@ namespace DetourNavigator
 
         int updateTile(TileId tileId, TileVersion version, const std::vector<std::byte>& data);
 
+        // Returns nothing when portals are not written for the current tile revision.
+        std::optional<std::vector<std::byte>> getTilePortals(TileId tileId);
+
+        // Replaces portals of the current tile revision, the tile has to exist.
+        int insertTilePortals(TileId tileId, const std::vector<std::byte>& data);
+
+        std::vector<CellTiles> getCellsTiles();
+
+        // Replaces the existing record for the same worldspace and cell id.
+        int insertCellTiles(const CellTiles& value);
+
+        int deleteCellTiles(const std::string& worldspace, const std::string& cellId);
+
         ShapeId getMaxShapeId();
 
         std::optional<ShapeId> findShapeId(const std::string& name, ShapeType type, const Sqlite3::ConstBlob& hash);
@@ -144,6 +202,11 @@ namespace DetourNavigator
         Sqlite3::Statement<DbQueries::GetTileData> mGetTileData;
         Sqlite3::Statement<DbQueries::InsertTile> mInsertTile;
         Sqlite3::Statement<DbQueries::UpdateTile> mUpdateTile;
+        Sqlite3::Statement<DbQueries::GetTilePortals> mGetTilePortals;
+        Sqlite3::Statement<DbQueries::InsertTilePortals> mInsertTilePortals;
+        Sqlite3::Statement<DbQueries::GetCellsTiles> mGetCellsTiles;
+        Sqlite3::Statement<DbQueries::InsertCellTiles> mInsertCellTiles;
+        Sqlite3::Statement<DbQueries::DeleteCellTiles> mDeleteCellTiles;
         Sqlite3::Statement<DbQueries::GetMaxShapeId> mGetMaxShapeId;
         Sqlite3::Statement<DbQueries::FindShapeId> mFindShapeId;
         Sqlite3::Statement<DbQueries::InsertShape> mInsertShape;
@@ -54,7 +54,8 @@ namespace DetourNavigator
             return;
         mRecastMeshManager.setWorldspace(worldspace);
         for (auto& [agent, cache] : mCache)
-            cache = std::make_shared<GuardedNavMeshCacheItem>(makeEmptyNavMesh(mSettings), ++mGenerationCounter);
+            cache = std::make_shared<GuardedNavMeshCacheItem>(makeEmptyNavMesh(mSettings), ++mGenerationCounter,
+                mSettings.mPathCacheSize);
         mWorldspace = worldspace;
     }
 
@@ -128,7 +129,8 @@ namespace DetourNavigator
         if (cached != mCache.end())
             return;
         mCache.insert(std::make_pair(agentHalfExtents,
-            std::make_shared<GuardedNavMeshCacheItem>(makeEmptyNavMesh(mSettings), ++mGenerationCounter)));
+            std::make_shared<GuardedNavMeshCacheItem>(makeEmptyNavMesh(mSettings), ++mGenerationCounter,
+                mSettings.mPathCacheSize)));
         Log(Debug::Debug) << "cache add for agent=" << agentHalfExtents;
     }
 
@@ -241,9 +243,37 @@ namespace DetourNavigator
         return mCache;
     }
 
-    void NavMeshManager::reportStats(unsigned int frameNumber, osg::Stats& stats) const
+    void NavMeshManager::reportStats(unsigned int frameNumber, osg::Stats& stats)
     {
         DetourNavigator::reportStats(mAsyncNavMeshUpdater.getStats(), frameNumber, stats);
+
+        if (mPathCacheStatsFrameNumber == frameNumber)
+        {
+            DetourNavigator::reportStats(mFramePathCacheStats, frameNumber, stats);
+            return;
+        }
+
+        PathCache::Stats pathCacheStats {};
+        std::map<osg::Vec3f, PathCache::Stats> reportedPathCacheStats;
+        for (const auto& [agentHalfExtents, cached] : mCache)
+        {
+            const PathCache::Stats agentStats = cached->lockConst()->getPathCache().getStats();
+            pathCacheStats.mSize += agentStats.mSize;
+            pathCacheStats.mHitCount += agentStats.mHitCount;
+            pathCacheStats.mGetCount += agentStats.mGetCount;
+            // Counters start over when the navmesh of the agent is recreated
+            const auto reported = mReportedPathCacheStats.find(agentHalfExtents);
+            if (reported != mReportedPathCacheStats.end() && reported->second.mGetCount <= agentStats.mGetCount)
+            {
+                pathCacheStats.mHitCount -= reported->second.mHitCount;
+                pathCacheStats.mGetCount -= reported->second.mGetCount;
+            }
+            reportedPathCacheStats.emplace(agentHalfExtents, agentStats);
+        }
+        mReportedPathCacheStats = std::move(reportedPathCacheStats);
+        mFramePathCacheStats = pathCacheStats;
+        mPathCacheStatsFrameNumber = frameNumber;
+        DetourNavigator::reportStats(pathCacheStats, frameNumber, stats);
     }
 
     RecastMeshTiles NavMeshManager::getRecastMeshTiles() const
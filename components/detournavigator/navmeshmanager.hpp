@@ -4,6 +4,7 @@
 #include "asyncnavmeshupdater.hpp"
 #include "cachedrecastmeshmanager.hpp"
 #include "offmeshconnectionsmanager.hpp"
+#include "pathcache.hpp"
 #include "recastmeshtiles.hpp"
 #include "waitconditiontype.hpp"
 #include "heightfieldshape.hpp"
@@ -14,6 +15,7 @@
 
 #include <map>
 #include <memory>
+#include <optional>
 
 class dtNavMesh;
 
@@ -58,7 +60,9 @@ namespace DetourNavigator
 
         std::map<osg::Vec3f, SharedNavMeshCacheItem> getNavMeshes() const;
 
-        void reportStats(unsigned int frameNumber, osg::Stats& stats) const;
+        /// Path cache hit rate is reported for the path requests since the previous frame. Repeated calls for the same
+        /// frame report the same values.
+        void reportStats(unsigned int frameNumber, osg::Stats& stats);
 
         RecastMeshTiles getRecastMeshTiles() const;
 
@@ -73,6 +77,9 @@ namespace DetourNavigator
         std::size_t mGenerationCounter = 0;
         std::map<osg::Vec3f, TilePosition> mPlayerTile;
         std::map<osg::Vec3f, std::size_t> mLastRecastMeshManagerRevision;
+        std::optional<unsigned int> mPathCacheStatsFrameNumber;
+        PathCache::Stats mFramePathCacheStats {};
+        std::map<osg::Vec3f, PathCache::Stats> mReportedPathCacheStats;
 
         void addChangedTiles(const btCollisionShape& shape, const btTransform& transform, const ChangeType changeType);
 
@@ -0,0 +1,20 @@
+#include "navmeshquery.hpp"
+
+#include <DetourNavMesh.h>
+#include <DetourNavMeshQuery.h>
+
+#include <memory>
+
+namespace DetourNavigator
+{
+    dtNavMeshQuery* getNavMeshQuery(const dtNavMesh& navMesh, int maxNodes)
+    {
+        thread_local std::unique_ptr<dtNavMeshQuery> query;
+        if (query == nullptr)
+            query = std::make_unique<dtNavMeshQuery>();
+        // Reinitialization only clears the node pool and the open list when they have enough capacity.
+        if (!dtStatusSucceed(query->init(&navMesh, maxNodes)))
+            return nullptr;
+        return query.get();
+    }
+}
@@ -0,0 +1,18 @@
+#ifndef OPENMW_COMPONENTS_DETOURNAVIGATOR_NAVMESHQUERY_H
+#define OPENMW_COMPONENTS_DETOURNAVIGATOR_NAVMESHQUERY_H
+
+class dtNavMesh;
+class dtNavMeshQuery;
+
+namespace DetourNavigator
+{
+    /**
+     * @brief getNavMeshQuery returns a query owned by the calling thread initialized for the given navmesh.
+     * Node pool is allocated by the first query of the thread and reused by the next ones until more nodes are required.
+     * Returned query is valid until the next call from the same thread.
+     * @return nullptr if query initialization is failed.
+     */
+    dtNavMeshQuery* getNavMeshQuery(const dtNavMesh& navMesh, int maxNodes);
+}
+
+#endif
@@ -0,0 +1,45 @@
+#include "pathcache.hpp"
+
+#include <osg/Stats>
+
+namespace DetourNavigator
+{
+    void PathCache::set(const PathCacheKey& key, CachedPath&& value)
+    {
+        if (mCapacity == 0)
+            return;
+        const std::lock_guard<std::mutex> lock(mMutex);
+        if (const auto it = mValues.find(key); it != mValues.end())
+        {
+            it->second->second = std::move(value);
+            mItems.splice(mItems.begin(), mItems, it->second);
+            return;
+        }
+        if (mItems.size() >= mCapacity)
+        {
+            mValues.erase(mItems.back().first);
+            mItems.pop_back();
+        }
+        mItems.emplace_front(key, std::move(value));
+        mValues.emplace(key, mItems.begin());
+    }
+
+    PathCache::Stats PathCache::getStats() const
+    {
+        Stats result;
+        {
+            const std::lock_guard<std::mutex> lock(mMutex);
+            result.mSize = mItems.size();
+            result.mHitCount = mHitCount;
+            result.mGetCount = mGetCount;
+        }
+        return result;
+    }
+
+    void reportStats(const PathCache::Stats& stats, unsigned int frameNumber, osg::Stats& out)
+    {
+        out.setAttribute(frameNumber, "NavMesh PathCacheSize", static_cast<double>(stats.mSize));
+        if (stats.mGetCount > 0)
+            out.setAttribute(frameNumber, "NavMesh PathCacheHitRate", static_cast<double>(stats.mHitCount) / stats.mGetCount * 100.0);
+    }
+}
@@ -0,0 +1,125 @@
+#ifndef OPENMW_COMPONENTS_DETOURNAVIGATOR_PATHCACHE_H
+#define OPENMW_COMPONENTS_DETOURNAVIGATOR_PATHCACHE_H
+
+#include "areatype.hpp"
+#include "flags.hpp"
+#include "status.hpp"
+#include "tileposition.hpp"
+#include "version.hpp"
+
+#include <DetourNavMesh.h>
+
+#include <osg/Vec3f>
+#include <osg/Vec3i>
+
+#include <cstddef>
+#include <list>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace osg
+{
+    class Stats;
+}
+
+namespace DetourNavigator
+{
+    struct PathCacheKey
+    {
+        dtPolyRef mStartRef;
+        dtPolyRef mEndRef;
+        osg::Vec3i mStart;
+        osg::Vec3i mEnd;
+        float mStepSize;
+        Flags mIncludeFlags;
+        AreaCosts mAreaCosts;
+        float mEndTolerance;
+
+        friend inline auto tie(const PathCacheKey& value)
+        {
+            return std::tie(value.mStartRef, value.mEndRef, value.mStart, value.mEnd, value.mStepSize,
+                value.mIncludeFlags, value.mAreaCosts.mWater, value.mAreaCosts.mDoor, value.mAreaCosts.mPathgrid,
+                value.mAreaCosts.mGround, value.mEndTolerance);
+        }
+
+        friend inline bool operator<(const PathCacheKey& lhs, const PathCacheKey& rhs)
+        {
+            return tie(lhs) < tie(rhs);
+        }
+    };
+
+    struct CachedPath
+    {
+        Status mStatus;
+        std::vector<osg::Vec3f> mPath;
+        // Versions of the tiles the path goes through at the moment it is found.
+        std::vector<std::pair<TilePosition, Version>> mTiles;
+        // The last point is the closest to the end point of the end polygon.
+        bool mReachesEnd;
+    };
+
+    /// @brief Least recently used paths of an agent. A path is valid while all tiles it goes through have the same version.
+    class PathCache
+    {
+    public:
+        struct Stats
+        {
+            std::size_t mSize;
+            std::size_t mHitCount;
+            std::size_t mGetCount;
+        };
+
+        explicit PathCache(std::size_t capacity)
+            : mCapacity(capacity)
+        {}
+
+        std::size_t getCapacity() const { return mCapacity; }
+
+        /// @param getTileVersion returns std::optional<Version> for a tile position, empty if there is no such tile.
+        template <class GetTileVersion>
+        std::optional<CachedPath> get(const PathCacheKey& key, GetTileVersion&& getTileVersion)
+        {
+            const std::lock_guard<std::mutex> lock(mMutex);
+            ++mGetCount;
+            const auto it = mValues.find(key);
+            if (it == mValues.end())
+                return std::nullopt;
+            const CachedPath& value = it->second->second;
+            for (const auto& [position, version] : value.mTiles)
+            {
+                if (getTileVersion(position) != version)
+                {
+                    mItems.erase(it->second);
+                    mValues.erase(it);
+                    return std::nullopt;
+                }
+            }
+            mItems.splice(mItems.begin(), mItems, it->second);
+            ++mHitCount;
+            return value;
+        }
+
+        void set(const PathCacheKey& key, CachedPath&& value);
+
+        Stats getStats() const;
+
+    private:
+        using Items = std::list<std::pair<PathCacheKey, CachedPath>>;
+
+        mutable std::mutex mMutex;
+        const std::size_t mCapacity;
+        std::size_t mHitCount = 0;
+        std::size_t mGetCount = 0;
+        // Most recently used go first.
+        Items mItems;
+        std::map<PathCacheKey, Items::iterator> mValues;
+    };
+
+    void reportStats(const PathCache::Stats& stats, unsigned int frameNumber, osg::Stats& out);
+}
+
+#endif
@@ -5,6 +5,7 @@
 #include "recast.hpp"
 #include "recastmesh.hpp"
 #include "settings.hpp"
+#include "tilegraph.hpp"
 
 #include <components/serialization/binaryreader.hpp>
 #include <components/serialization/binarywriter.hpp>
@@ -228,6 +229,52 @@ namespace
             visitor(*this, value.mPolyMesh);
             visitor(*this, value.mPolyMeshDetail);
         }
+
+        template <class Visitor, class T>
+        auto operator()(Visitor&& visitor, T& value) const
+            -> std::enable_if_t<std::is_same_v<std::decay_t<T>, TilePortal>>
+        {
+            if constexpr (mode == Serialization::Mode::Write)
+                visitor(*this, static_cast<std::uint8_t>(value.mSide));
+            else
+            {
+                static_assert(mode == Serialization::Mode::Read);
+                std::uint8_t side = 0;
+                visitor(*this, side);
+                value.mSide = static_cast<TileSide>(side);
+            }
+            visitor(*this, value.mComponent);
+            visitor(*this, value.mFlags);
+            visitor(*this, value.mMin);
+            visitor(*this, value.mMax);
+            visitor(*this, value.mMinHeight);
+            visitor(*this, value.mMaxHeight);
+            visitor(*this, value.mPosition.ptr(), 3);
+        }
+
+        template <class Visitor, class T>
+        auto operator()(Visitor&& visitor, T& value) const
+            -> std::enable_if_t<std::is_same_v<std::decay_t<T>, std::vector<TilePortal>>>
+        {
+            if constexpr (mode == Serialization::Mode::Write)
+            {
+                visitor(*this, DetourNavigator::tilePortalsMagic);
+                visitor(*this, DetourNavigator::tilePortalsVersion);
+            }
+            else
+            {
+                static_assert(mode == Serialization::Mode::Read);
+                char magic[std::size(DetourNavigator::tilePortalsMagic)];
+                visitor(*this, magic);
+                if (std::memcmp(magic, DetourNavigator::tilePortalsMagic, sizeof(magic)) != 0)
+                    throw std::runtime_error("Bad TilePortals magic");
+                std::uint32_t version = 0;
+                visitor(*this, version);
+                if (version != DetourNavigator::tilePortalsVersion)
+                    throw std::runtime_error("Bad TilePortals version");
+            }
+            Serialization::Format<mode, Format<mode>>::operator()(visitor, value);
+        }
     };
 }
 } // namespace DetourNavigator
@@ -269,4 +316,28 @@ namespace DetourNavigator
             return false;
         }
     }
+
+    std::vector<std::byte> serialize(const std::vector<TilePortal>& value)
+    {
+        constexpr Format<Serialization::Mode::Write> format;
+        Serialization::SizeAccumulator sizeAccumulator;
+        format(sizeAccumulator, value);
+        std::vector<std::byte> result(sizeAccumulator.value());
+        format(Serialization::BinaryWriter(result.data(), result.data() + result.size()), value);
+        return result;
+    }
+
+    bool deserialize(const std::vector<std::byte>& data, std::vector<TilePortal>& value)
+    {
+        try
+        {
+            constexpr Format<Serialization::Mode::Read> format;
+            format(Serialization::BinaryReader(data.data(), data.data() + data.size()), value);
+            return true;
+        }
+        catch (const std::exception&)
+        {
+            return false;
+        }
+    }
 }
@@ -11,6 +11,7 @@ namespace DetourNavigator
     struct DbRefGeometryObject;
     struct PreparedNavMeshData;
     struct RecastSettings;
+    struct TilePortal;
 
     constexpr char recastMeshMagic[] = {'r', 'c', 's', 't'};
     constexpr std::uint32_t recastMeshVersion = 1;
@@ -18,12 +19,19 @@ namespace DetourNavigator
     constexpr char preparedNavMeshDataMagic[] = {'p', 'n', 'a', 'v'};
     constexpr std::uint32_t preparedNavMeshDataVersion = 1;
 
+    constexpr char tilePortalsMagic[] = {'t', 'p', 'r', 't'};
+    constexpr std::uint32_t tilePortalsVersion = 1;
+
     std::vector<std::byte> serialize(const RecastSettings& settings, const RecastMesh& value,
         const std::vector<DbRefGeometryObject>& dbRefGeometryObjects);
 
     std::vector<std::byte> serialize(const PreparedNavMeshData& value);
 
     bool deserialize(const std::vector<std::byte>& data, PreparedNavMeshData& value);
+
+    std::vector<std::byte> serialize(const std::vector<TilePortal>& value);
+
+    bool deserialize(const std::vector<std::byte>& data, std::vector<TilePortal>& value);
 }
 
 #endif
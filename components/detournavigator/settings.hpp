@@ -31,6 +31,7 @@ namespace DetourNavigator
         int mMaxNavMeshQueryNodes = 0;
         std::size_t mMaxPolygonPathSize = 0;
         std::size_t mMaxSmoothPathSize = 0;
+        int mHierarchicalPathMinTilesDistance = 0;
     };
 
     struct Settings
@@ -47,6 +48,7 @@ namespace DetourNavigator
         int mMaxTilesNumber = 0;
         std::size_t mAsyncNavMeshUpdaterThreads = 0;
         std::size_t mMaxNavMeshTilesCacheSize = 0;
+        std::size_t mPathCacheSize = 0;
         std::string mRecastMeshPathPrefix;
         std::string mNavMeshPathPrefix;
         std::chrono::milliseconds mMinUpdateInterval;
@@ -22,25 +22,25 @@ namespace DetourNavigator
 
     void TileCachedRecastMeshManager::setWorldspace(std::string_view worldspace)
     {
-        const std::lock_guard lock(mMutex);
-        if (mWorldspace == worldspace)
-            return;
-        mTiles.clear();
-        mWorldspace = worldspace;
+        TilesMap tiles;
+        {
+            const std::lock_guard lock(mMutex);
+            if (mWorldspace == worldspace)
+                return;
+            std::swap(mTiles, tiles);
+            mWorldspace = worldspace;
+        }
     }
 
     bool TileCachedRecastMeshManager::addObject(const ObjectId id, const CollisionShape& shape,
                                                 const btTransform& transform, const AreaType areaType)
     {
         std::vector<TilePosition> tilesPositions;
-        {
-            const std::lock_guard lock(mMutex);
-            getTilesPositions(shape.getShape(), transform, mSettings, [&] (const TilePosition& tilePosition)
-                {
-                    if (addTile(id, shape, transform, areaType, tilePosition, mTiles))
-                        tilesPositions.push_back(tilePosition);
-                });
-        }
+        getTilesPositions(shape.getShape(), transform, mSettings, [&] (const TilePosition& tilePosition)
+            {
+                if (addTile(id, shape, transform, areaType, tilePosition))
+                    tilesPositions.push_back(tilePosition);
+            });
         if (tilesPositions.empty())
             return false;
         std::sort(tilesPositions.begin(), tilesPositions.end());
@@ -55,14 +55,11 @@ namespace DetourNavigator
         if (object == mObjectsTilesPositions.end())
             return std::nullopt;
         std::optional<RemovedRecastMeshObject> result;
+        for (const auto& tilePosition : object->second)
         {
-            const std::lock_guard lock(mMutex);
-            for (const auto& tilePosition : object->second)
-            {
-                const auto removed = removeTile(id, tilePosition, mTiles);
-                if (removed && !result)
-                    result = removed;
-            }
+            const auto removed = removeTile(id, tilePosition);
+            if (removed && !result)
+                result = removed;
         }
         if (result)
             ++mRevision;
@@ -77,7 +74,6 @@ namespace DetourNavigator
 
         if (cellSize == std::numeric_limits<int>::max())
         {
-            const std::lock_guard lock(mMutex);
             for (auto& tile : mTiles)
             {
                 if (tile.second->addWater(cellPosition, cellSize, level))
@@ -92,14 +88,7 @@ namespace DetourNavigator
             const btVector3 shift = Misc::Convert::toBullet(getWaterShift3d(cellPosition, cellSize, level));
             getTilesPositions(cellSize, shift, mSettings, [&] (const TilePosition& tilePosition)
                 {
-                    const std::lock_guard lock(mMutex);
-                    auto tile = mTiles.find(tilePosition);
-                    if (tile == mTiles.end())
-                    {
-                        const TileBounds tileBounds = makeRealTileBoundsWithBorder(mSettings, tilePosition);
-                        tile = mTiles.emplace_hint(tile, tilePosition,
-                                std::make_shared<CachedRecastMeshManager>(tileBounds, mTilesGeneration));
-                    }
+                    const auto tile = getOrAddTile(tilePosition);
                     if (tile->second->addWater(cellPosition, cellSize, level))
                     {
                         tilesPositions.push_back(tilePosition);
@@ -122,16 +111,11 @@ namespace DetourNavigator
         std::optional<Water> result;
         for (const auto& tilePosition : object->second)
         {
-            const std::lock_guard lock(mMutex);
             const auto tile = mTiles.find(tilePosition);
             if (tile == mTiles.end())
                 continue;
             const auto tileResult = tile->second->removeWater(cellPosition);
-            if (tile->second->isEmpty())
-            {
-                mTiles.erase(tile);
-                ++mTilesGeneration;
-            }
+            removeTileIfEmpty(tile);
             if (tileResult && !result)
                 result = tileResult;
         }
@@ -150,14 +134,7 @@ namespace DetourNavigator
 
         getTilesPositions(cellSize, shift, mSettings, [&] (const TilePosition& tilePosition)
             {
-                const std::lock_guard lock(mMutex);
-                auto tile = mTiles.find(tilePosition);
-                if (tile == mTiles.end())
-                {
-                    const TileBounds tileBounds = makeRealTileBoundsWithBorder(mSettings, tilePosition);
-                    tile = mTiles.emplace_hint(tile, tilePosition,
-                            std::make_shared<CachedRecastMeshManager>(tileBounds, mTilesGeneration));
-                }
+                const auto tile = getOrAddTile(tilePosition);
                 if (tile->second->addHeightfield(cellPosition, cellSize, shape))
                 {
                     tilesPositions.push_back(tilePosition);
@@ -179,16 +156,11 @@ namespace DetourNavigator
         std::optional<SizedHeightfieldShape> result;
         for (const auto& tilePosition : object->second)
         {
-            const std::lock_guard lock(mMutex);
             const auto tile = mTiles.find(tilePosition);
             if (tile == mTiles.end())
                 continue;
             const auto tileResult = tile->second->removeHeightfield(cellPosition);
-            if (tile->second->isEmpty())
-            {
-                mTiles.erase(tile);
-                ++mTilesGeneration;
-            }
+            removeTileIfEmpty(tile);
             if (tileResult && !result)
                 result = tileResult;
         }
@@ -225,46 +197,64 @@ namespace DetourNavigator
 
     void TileCachedRecastMeshManager::reportNavMeshChange(const TilePosition& tilePosition, Version recastMeshVersion, Version navMeshVersion) const
     {
+        std::shared_ptr<CachedRecastMeshManager> manager;
+        {
+            const std::lock_guard lock(mMutex);
+            const auto it = mTiles.find(tilePosition);
+            if (it == mTiles.end())
+                return;
+            manager = it->second;
+        }
+        manager->reportNavMeshChange(recastMeshVersion, navMeshVersion);
+    }
+
+    TileCachedRecastMeshManager::TilesMap::iterator TileCachedRecastMeshManager::getOrAddTile(
+        const TilePosition& tilePosition)
+    {
+        // Only the modifying thread changes mTiles so it can search without lock.
+        auto tile = mTiles.find(tilePosition);
+        if (tile != mTiles.end())
+            return tile;
+        const TileBounds tileBounds = makeRealTileBoundsWithBorder(mSettings, tilePosition);
+        auto manager = std::make_shared<CachedRecastMeshManager>(tileBounds, mTilesGeneration);
         const std::lock_guard lock(mMutex);
-        const auto it = mTiles.find(tilePosition);
-        if (it == mTiles.end())
-            return;
-        it->second->reportNavMeshChange(recastMeshVersion, navMeshVersion);
+        return mTiles.emplace_hint(tile, tilePosition, std::move(manager));
     }
 
-    bool TileCachedRecastMeshManager::addTile(const ObjectId id, const CollisionShape& shape,
-        const btTransform& transform, const AreaType areaType, const TilePosition& tilePosition,
-        TilesMap& tiles)
+    void TileCachedRecastMeshManager::removeTileIfEmpty(TilesMap::iterator tile)
     {
-        auto tile = tiles.find(tilePosition);
-        if (tile == tiles.end())
+        if (!tile->second->isEmpty())
+            return;
+        // Reading threads may still use the manager, it is destructed with the last reference.
+        const std::shared_ptr<CachedRecastMeshManager> manager = tile->second;
         {
-            const TileBounds tileBounds = makeRealTileBoundsWithBorder(mSettings, tilePosition);
-            tile = tiles.emplace_hint(tile, tilePosition,
-                    std::make_shared<CachedRecastMeshManager>(tileBounds, mTilesGeneration));
+            const std::lock_guard lock(mMutex);
+            mTiles.erase(tile);
         }
-        return tile->second->addObject(id, shape, transform, areaType);
+        ++mTilesGeneration;
+    }
+
+    bool TileCachedRecastMeshManager::addTile(const ObjectId id, const CollisionShape& shape,
+        const btTransform& transform, const AreaType areaType, const TilePosition& tilePosition)
+    {
+        return getOrAddTile(tilePosition)->second->addObject(id, shape, transform, areaType);
     }
 
     bool TileCachedRecastMeshManager::updateTile(const ObjectId id, const btTransform& transform,
-        const AreaType areaType, const TilePosition& tilePosition, TilesMap& tiles)
+        const AreaType areaType, const TilePosition& tilePosition)
     {
-        const auto tile = tiles.find(tilePosition);
-        return tile != tiles.end() && tile->second->updateObject(id, transform, areaType);
+        const auto tile = mTiles.find(tilePosition);
+        return tile != mTiles.end() && tile->second->updateObject(id, transform, areaType);
     }
 
     std::optional<RemovedRecastMeshObject> TileCachedRecastMeshManager::removeTile(const ObjectId id,
-        const TilePosition& tilePosition, TilesMap& tiles)
+        const TilePosition& tilePosition)
     {
-        const auto tile = tiles.find(tilePosition);
-        if (tile == tiles.end())
+        const auto tile = mTiles.find(tilePosition);
+        if (tile == mTiles.end())
             return std::optional<RemovedRecastMeshObject>();
         auto tileResult = tile->second->removeObject(id);
-        if (tile->second->isEmpty())
-        {
-            tiles.erase(tile);
-            ++mTilesGeneration;
-        }
+        removeTileIfEmpty(tile);
         return tileResult;
     }
 
@@ -15,6 +15,13 @@
 
 namespace DetourNavigator
 {
+    /**
+     * @brief Keeps recast mesh managers for the tiles touched by the added objects, water and heightfields.
+     * All modifications and forEachTile should be done from the same thread. Other methods can be called from any
+     * thread. mMutex is locked only to change the set of tiles or to find a tile from a reading thread so building
+     * recast meshes and updating objects of the different tiles do not block each other. Tile content is guarded by
+     * the CachedRecastMeshManager itself.
+     */
     class TileCachedRecastMeshManager
     {
     public:
@@ -37,35 +44,32 @@ namespace DetourNavigator
             auto& currentTiles = object->second;
             bool changed = false;
             std::vector<TilePosition> newTiles;
+            const auto onTilePosition = [&] (const TilePosition& tilePosition)
             {
-                const std::lock_guard lock(mMutex);
-                const auto onTilePosition = [&] (const TilePosition& tilePosition)
+                if (std::binary_search(currentTiles.begin(), currentTiles.end(), tilePosition))
                 {
-                    if (std::binary_search(currentTiles.begin(), currentTiles.end(), tilePosition))
+                    newTiles.push_back(tilePosition);
+                    if (updateTile(id, transform, areaType, tilePosition))
                     {
-                        newTiles.push_back(tilePosition);
-                        if (updateTile(id, transform, areaType, tilePosition, mTiles))
-                        {
-                            onChangedTile(tilePosition);
-                            changed = true;
-                        }
-                    }
-                    else if (addTile(id, shape, transform, areaType, tilePosition, mTiles))
-                    {
-                        newTiles.push_back(tilePosition);
                         onChangedTile(tilePosition);
                         changed = true;
                     }
-                };
-                getTilesPositions(shape.getShape(), transform, mSettings, onTilePosition);
-                std::sort(newTiles.begin(), newTiles.end());
-                for (const auto& tile : currentTiles)
+                }
+                else if (addTile(id, shape, transform, areaType, tilePosition))
                 {
-                    if (!std::binary_search(newTiles.begin(), newTiles.end(), tile) && removeTile(id, tile, mTiles))
-                    {
-                        onChangedTile(tile);
-                        changed = true;
-                    }
+                    newTiles.push_back(tilePosition);
+                    onChangedTile(tilePosition);
+                    changed = true;
+                }
+            };
+            getTilesPositions(shape.getShape(), transform, mSettings, onTilePosition);
+            std::sort(newTiles.begin(), newTiles.end());
+            for (const auto& tile : currentTiles)
+            {
+                if (!std::binary_search(newTiles.begin(), newTiles.end(), tile) && removeTile(id, tile))
+                {
+                    onChangedTile(tile);
+                    changed = true;
                 }
             }
             if (changed)
@@ -95,7 +99,6 @@ namespace DetourNavigator
         template <class Function>
         void forEachTile(Function&& function) const
         {
-            const std::lock_guard lock(mMutex);
             for (auto& [tilePosition, recastMeshManager] : mTiles)
                 function(tilePosition, *recastMeshManager);
         }
@@ -117,14 +120,17 @@ namespace DetourNavigator
         std::size_t mRevision = 0;
         std::size_t mTilesGeneration = 0;
 
+        TilesMap::iterator getOrAddTile(const TilePosition& tilePosition);
+
+        void removeTileIfEmpty(TilesMap::iterator tile);
+
         bool addTile(const ObjectId id, const CollisionShape& shape, const btTransform& transform,
-                const AreaType areaType, const TilePosition& tilePosition, TilesMap& tiles);
+                const AreaType areaType, const TilePosition& tilePosition);
 
         bool updateTile(const ObjectId id, const btTransform& transform, const AreaType areaType,
-                const TilePosition& tilePosition, TilesMap& tiles);
+                const TilePosition& tilePosition);
 
-        std::optional<RemovedRecastMeshObject> removeTile(const ObjectId id, const TilePosition& tilePosition,
-                TilesMap& tiles);
+        std::optional<RemovedRecastMeshObject> removeTile(const ObjectId id, const TilePosition& tilePosition);
 
         inline std::shared_ptr<CachedRecastMeshManager> getManager(std::string_view worldspace,
                 const TilePosition& tilePosition) const;
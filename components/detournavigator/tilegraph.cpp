@@ -0,0 +1,343 @@
+#include "tilegraph.hpp"
+#include "navmeshtileview.hpp"
+
+#include <DetourNavMesh.h>
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <map>
+#include <queue>
+#include <tuple>
+#include <utility>
+
+namespace DetourNavigator
+{
+    namespace
+    {
+        struct BorderEdge
+        {
+            TileSide mSide;
+            std::uint32_t mComponent;
+            Flags mFlags;
+            float mMin;
+            float mMax;
+            // Edge ends ordered along the border.
+            osg::Vec3f mBegin;
+            osg::Vec3f mEnd;
+        };
+
+        class DisjointSets
+        {
+        public:
+            explicit DisjointSets(std::size_t size)
+                : mParents(size)
+            {
+                for (std::size_t i = 0; i < size; ++i)
+                    mParents[i] = i;
+            }
+
+            std::size_t find(std::size_t value)
+            {
+                while (mParents[value] != value)
+                {
+                    mParents[value] = mParents[mParents[value]];
+                    value = mParents[value];
+                }
+                return value;
+            }
+
+            void unite(std::size_t lhs, std::size_t rhs)
+            {
+                mParents[find(lhs)] = find(rhs);
+            }
+
+        private:
+            std::vector<std::size_t> mParents;
+        };
+
+        // Axis in navmesh coordinates along the border on the given side.
+        int getBorderAxis(TileSide side)
+        {
+            return side == TileSide::PositiveX || side == TileSide::NegativeX ? 2 : 0;
+        }
+
+        bool isTileSide(unsigned value)
+        {
+            return value == static_cast<unsigned>(TileSide::PositiveX) || value == static_cast<unsigned>(TileSide::PositiveZ)
+                || value == static_cast<unsigned>(TileSide::NegativeX) || value == static_cast<unsigned>(TileSide::NegativeZ);
+        }
+
+        float getDistance(const BorderEdge& edge, int axis, float value)
+        {
+            if (value < edge.mBegin[axis])
+                return edge.mBegin[axis] - value;
+            if (value > edge.mEnd[axis])
+                return value - edge.mEnd[axis];
+            return 0;
+        }
+
+        osg::Vec3f getPoint(const BorderEdge& edge, int axis, float value)
+        {
+            const float length = edge.mEnd[axis] - edge.mBegin[axis];
+            if (length <= 0)
+                return edge.mBegin;
+            const float factor = std::clamp((value - edge.mBegin[axis]) / length, 0.0f, 1.0f);
+            return edge.mBegin + (edge.mEnd - edge.mBegin) * factor;
+        }
+
+        // Edges should have the same side and component and be sorted along the border.
+        TilePortal makePortal(const BorderEdge* begin, const BorderEdge* end, float walkableClimb)
+        {
+            const int axis = getBorderAxis(begin->mSide);
+            TilePortal result;
+            result.mSide = begin->mSide;
+            result.mComponent = begin->mComponent;
+            result.mFlags = 0;
+            result.mMin = begin->mMin;
+            result.mMax = begin->mMax;
+            result.mMinHeight = std::numeric_limits<float>::max();
+            result.mMaxHeight = -std::numeric_limits<float>::max();
+            for (const BorderEdge* edge = begin; edge != end; ++edge)
+            {
+                result.mFlags |= edge->mFlags;
+                result.mMax = std::max(result.mMax, edge->mMax);
+                result.mMinHeight = std::min({result.mMinHeight, edge->mBegin.y(), edge->mEnd.y()});
+                result.mMaxHeight = std::max({result.mMaxHeight, edge->mBegin.y(), edge->mEnd.y()});
+            }
+            result.mMinHeight -= walkableClimb;
+            result.mMaxHeight += walkableClimb;
+            const float middle = (result.mMin + result.mMax) / 2;
+            const BorderEdge* const closest = std::min_element(begin, end,
+                [&] (const BorderEdge& l, const BorderEdge& r)
+                {
+                    return getDistance(l, axis, middle) < getDistance(r, axis, middle);
+                });
+            result.mPosition = getPoint(*closest, axis, middle);
+            return result;
+        }
+
+        bool overlaps(const TilePortal& lhs, const TilePortal& rhs)
+        {
+            return lhs.mMin <= rhs.mMax && rhs.mMin <= lhs.mMax
+                && lhs.mMinHeight <= rhs.mMaxHeight && rhs.mMinHeight <= lhs.mMaxHeight;
+        }
+    }
+
+    TilePosition getNeighbourTile(const TilePosition& position, TileSide side)
+    {
+        switch (side)
+        {
+            case TileSide::PositiveX: return TilePosition(position.x() + 1, position.y());
+            case TileSide::PositiveZ: return TilePosition(position.x(), position.y() + 1);
+            case TileSide::NegativeX: return TilePosition(position.x() - 1, position.y());
+            case TileSide::NegativeZ: return TilePosition(position.x(), position.y() - 1);
+        }
+        return position;
+    }
+
+    TileSide getOppositeSide(TileSide side)
+    {
+        return static_cast<TileSide>((static_cast<unsigned>(side) + 4) % 8);
+    }
+
+    TilePortals makeTilePortals(const NavMeshTileConstView& tile)
+    {
+        const std::size_t polyCount = static_cast<std::size_t>(tile.mHeader->polyCount);
+        DisjointSets components(polyCount);
+        std::vector<std::pair<std::size_t, BorderEdge>> edges;
+
+        for (std::size_t i = 0; i < polyCount; ++i)
+        {
+            const dtPoly& poly = tile.mPolys[i];
+            if (poly.getType() == DT_POLYTYPE_OFFMESH_CONNECTION)
+                continue;
+            for (unsigned j = 0; j < poly.vertCount; ++j)
+            {
+                const unsigned short neighbour = poly.neis[j];
+                if ((neighbour & DT_EXT_LINK) == 0)
+                {
+                    if (neighbour != 0)
+                        components.unite(i, neighbour - 1u);
+                    continue;
+                }
+                const unsigned side = neighbour & 0xff;
+                if (!isTileSide(side))
+                    continue;
+                BorderEdge edge;
+                edge.mSide = static_cast<TileSide>(side);
+                edge.mComponent = 0;
+                edge.mFlags = poly.flags;
+                const float* const a = &tile.mVerts[poly.verts[j] * 3];
+                const float* const b = &tile.mVerts[poly.verts[(j + 1) % poly.vertCount] * 3];
+                edge.mBegin = osg::Vec3f(a[0], a[1], a[2]);
+                edge.mEnd = osg::Vec3f(b[0], b[1], b[2]);
+                const int axis = getBorderAxis(edge.mSide);
+                if (edge.mEnd[axis] < edge.mBegin[axis])
+                    std::swap(edge.mBegin, edge.mEnd);
+                edge.mMin = edge.mBegin[axis];
+                edge.mMax = edge.mEnd[axis];
+                edges.emplace_back(i, edge);
+            }
+        }
+
+        std::vector<BorderEdge> borderEdges;
+        borderEdges.reserve(edges.size());
+        std::map<std::size_t, std::uint32_t> componentIds;
+        for (auto& [poly, edge] : edges)
+        {
+            const auto it = componentIds.emplace(components.find(poly), static_cast<std::uint32_t>(componentIds.size())).first;
+            edge.mComponent = it->second;
+            borderEdges.push_back(edge);
+        }
+
+        std::sort(borderEdges.begin(), borderEdges.end(), [] (const BorderEdge& l, const BorderEdge& r)
+        {
+            return std::tie(l.mSide, l.mComponent, l.mMin) < std::tie(r.mSide, r.mComponent, r.mMin);
+        });
+
+        // Neighbour polygons share vertices, so edges of a continuous portal touch each other.
+        constexpr float maxGap = 1e-3f;
+        TilePortals result;
+        for (auto begin = borderEdges.begin(); begin != borderEdges.end();)
+        {
+            auto end = std::next(begin);
+            float max = begin->mMax;
+            while (end != borderEdges.end() && end->mSide == begin->mSide && end->mComponent == begin->mComponent
+                   && end->mMin <= max + maxGap)
+            {
+                max = std::max(max, end->mMax);
+                ++end;
+            }
+            result.push_back(makePortal(&*begin, &*begin + (end - begin), tile.mHeader->walkableClimb));
+            begin = end;
+        }
+
+        return result;
+    }
+
+    void TileGraph::setTile(const TilePosition& position, TilePortals&& portals)
+    {
+        mTiles.insert_or_assign(position, std::move(portals));
+    }
+
+    void TileGraph::removeTile(const TilePosition& position)
+    {
+        mTiles.erase(position);
+    }
+
+    const TilePortals* TileGraph::getTile(const TilePosition& position) const
+    {
+        const auto it = mTiles.find(position);
+        if (it == mTiles.end())
+            return nullptr;
+        return &it->second;
+    }
+
+    std::optional<std::vector<osg::Vec3f>> TileGraph::findRoute(const TilePosition& startTile, const osg::Vec3f& start,
+        const TilePosition& endTile, const osg::Vec3f& end, Flags includeFlags, std::size_t maxNodes) const
+    {
+        if (startTile == endTile)
+            return std::vector<osg::Vec3f>();
+
+        const auto startPortals = mTiles.find(startTile);
+        if (startPortals == mTiles.end() || mTiles.find(endTile) == mTiles.end())
+            return std::nullopt;
+
+        constexpr std::size_t noNode = std::numeric_limits<std::size_t>::max();
+
+        struct Node
+        {
+            TilePosition mTile;
+            const TilePortal* mPortal;
+            float mCost;
+            std::size_t mParent;
+            bool mClosed;
+        };
+
+        std::vector<Node> nodes;
+        std::map<const TilePortal*, std::size_t> nodeIndices;
+        // Items with noNode index are for the end point.
+        using Item = std::pair<float, std::size_t>;
+        std::priority_queue<Item, std::vector<Item>, std::greater<>> queue;
+        float endCost = std::numeric_limits<float>::max();
+        std::size_t endParent = noNode;
+
+        const auto push = [&] (const TilePosition& tile, const TilePortal& portal, float cost, std::size_t parent)
+        {
+            const auto [it, inserted] = nodeIndices.emplace(&portal, nodes.size());
+            if (inserted)
+                nodes.push_back(Node {tile, &portal, cost, parent, false});
+            else
+            {
+                Node& node = nodes[it->second];
+                if (node.mClosed || node.mCost <= cost)
+                    return;
+                node.mCost = cost;
+                node.mParent = parent;
+            }
+            queue.emplace(cost + (end - portal.mPosition).length(), it->second);
+        };
+
+        for (const TilePortal& portal : startPortals->second)
+            if ((portal.mFlags & includeFlags) != 0)
+                push(startTile, portal, (portal.mPosition - start).length(), noNode);
+
+        std::size_t visited = 0;
+
+        while (!queue.empty())
+        {
+            const std::size_t index = queue.top().second;
+            queue.pop();
+
+            if (index == noNode)
+            {
+                std::vector<osg::Vec3f> result;
+                // Overlapping portals of the neighbour tiles are usually at the same position.
+                for (std::size_t i = endParent; i != noNode; i = nodes[i].mParent)
+                    if (result.empty() || result.back() != nodes[i].mPortal->mPosition)
+                        result.push_back(nodes[i].mPortal->mPosition);
+                std::reverse(result.begin(), result.end());
+                return result;
+            }
+
+            if (nodes[index].mClosed)
+                continue;
+            nodes[index].mClosed = true;
+
+            if (++visited > maxNodes)
+                return std::nullopt;
+
+            // Copy because push may reallocate nodes.
+            const Node node = nodes[index];
+            const TilePortal& portal = *node.mPortal;
+
+            if (node.mTile == endTile)
+            {
+                const float cost = node.mCost + (end - portal.mPosition).length();
+                if (cost < endCost)
+                {
+                    endCost = cost;
+                    endParent = index;
+                    queue.emplace(cost, noNode);
+                }
+            }
+
+            const TilePosition neighbourTile = getNeighbourTile(node.mTile, portal.mSide);
+            if (const auto neighbour = mTiles.find(neighbourTile); neighbour != mTiles.end())
+            {
+                const TileSide oppositeSide = getOppositeSide(portal.mSide);
+                for (const TilePortal& other : neighbour->second)
+                    if (other.mSide == oppositeSide && (other.mFlags & includeFlags) != 0 && overlaps(portal, other))
+                        push(neighbourTile, other, node.mCost + (other.mPosition - portal.mPosition).length(), index);
+            }
+
+            for (const TilePortal& other : mTiles.find(node.mTile)->second)
+                if (&other != &portal && other.mComponent == portal.mComponent && (other.mFlags & includeFlags) != 0)
+                    push(node.mTile, other, node.mCost + (other.mPosition - portal.mPosition).length(), index);
+        }
+
+        return std::nullopt;
+    }
+}
@@ -0,0 +1,91 @@
+#ifndef OPENMW_COMPONENTS_DETOURNAVIGATOR_TILEGRAPH_H
+#define OPENMW_COMPONENTS_DETOURNAVIGATOR_TILEGRAPH_H
+
+#include "flags.hpp"
+#include "tileposition.hpp"
+
+#include <osg/Vec3f>
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <vector>
+
+namespace DetourNavigator
+{
+    struct NavMeshTileConstView;
+
+    // Uses the same values as detour for links to the neighbour tiles.
+    enum class TileSide : std::uint8_t
+    {
+        PositiveX = 0,
+        PositiveZ = 2,
+        NegativeX = 4,
+        NegativeZ = 6,
+    };
+
+    // Continuous part of a tile border crossed by the connected polygons. Coordinates are in navmesh space.
+    struct TilePortal
+    {
+        TileSide mSide;
+        // Portals of a tile with the same component are connected by the tile polygons.
+        std::uint32_t mComponent;
+        // Union of the flags of the polygons having edges on the portal.
+        Flags mFlags;
+        // Extent along the border.
+        float mMin;
+        float mMax;
+        // Extent by height including the walkable climb.
+        float mMinHeight;
+        float mMaxHeight;
+        osg::Vec3f mPosition;
+    };
+
+    using TilePortals = std::vector<TilePortal>;
+
+    inline bool operator==(const TilePortal& lhs, const TilePortal& rhs)
+    {
+        return lhs.mSide == rhs.mSide && lhs.mComponent == rhs.mComponent && lhs.mFlags == rhs.mFlags
+            && lhs.mMin == rhs.mMin && lhs.mMax == rhs.mMax && lhs.mMinHeight == rhs.mMinHeight
+            && lhs.mMaxHeight == rhs.mMaxHeight && lhs.mPosition == rhs.mPosition;
+    }
+
+    TilePosition getNeighbourTile(const TilePosition& position, TileSide side);
+
+    TileSide getOppositeSide(TileSide side);
+
+    // Off-mesh connections are ignored.
+    TilePortals makeTilePortals(const NavMeshTileConstView& tile);
+
+    /**
+     * @brief Abstract graph over the navmesh tiles small enough to plan a route through the whole worldspace.
+     * Portals are nodes, edges connect portals of the same tile component and overlapping portals of the neighbour
+     * tiles.
+     */
+    class TileGraph
+    {
+    public:
+        void setTile(const TilePosition& position, TilePortals&& portals);
+
+        void removeTile(const TilePosition& position);
+
+        const TilePortals* getTile(const TilePosition& position) const;
+
+        std::size_t getTilesCount() const { return mTiles.size(); }
+
+        /**
+         * @brief findRoute finds the shortest sequence of portals between start and end points using A*.
+         * Start and end are connected to all portals of their tiles.
+         * @return positions of the portals to go through, empty when start and end are in the same tile.
+         * Empty optional if there is no route or it is not found by visiting up to maxNodes portals.
+         */
+        std::optional<std::vector<osg::Vec3f>> findRoute(const TilePosition& startTile, const osg::Vec3f& start,
+            const TilePosition& endTile, const osg::Vec3f& end, Flags includeFlags, std::size_t maxNodes) const;
+
+    private:
+        std::map<TilePosition, TilePortals> mTiles;
+    };
+}
+
+#endif
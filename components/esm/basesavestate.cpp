@@ -0,0 +1,28 @@
+#include "basesavestate.hpp"
+
+#include "esmreader.hpp"
+#include "esmwriter.hpp"
+
+void ESM::BaseSaveState::load (ESMReader &esm)
+{
+    mName = esm.getHNString ("NAME");
+
+    mCellCount = 0;
+    esm.getHNT (mCellCount, "CELL");
+}
+
+void ESM::BaseSaveState::save (ESMWriter &esm) const
+{
+    esm.writeHNString ("NAME", mName);
+    esm.writeHNT ("CELL", mCellCount);
+}
+
+bool ESM::operator== (const BaseSaveState& left, const BaseSaveState& right)
+{
+    return left.mName == right.mName && left.mCellCount == right.mCellCount;
+}
+
+bool ESM::operator!= (const BaseSaveState& left, const BaseSaveState& right)
+{
+    return !(left == right);
+}
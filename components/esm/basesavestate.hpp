@@ -0,0 +1,28 @@
+#ifndef OPENMW_ESM_BASESAVESTATE_H
+#define OPENMW_ESM_BASESAVESTATE_H
+
+#include <string>
+
+namespace ESM
+{
+    class ESMReader;
+    class ESMWriter;
+
+    // format 0, saved games only
+
+    /// Identifies a base saved game. Stored in the REC_BASE record at the start of the base saved game and at the end
+    /// of the cell states of every saved game referencing it.
+    struct BaseSaveState
+    {
+        std::string mName; // File name of the base saved game
+        int mCellCount; // Number of cell states in the base saved game
+
+        void load (ESMReader &esm);
+        void save (ESMWriter &esm) const;
+    };
+
+    bool operator== (const BaseSaveState& left, const BaseSaveState& right);
+    bool operator!= (const BaseSaveState& left, const BaseSaveState& right);
+}
+
+#endif
@@ -0,0 +1,283 @@
+#include "compressedsavedgame.hpp"
+
+#include "defs.hpp"
+
+#include <components/misc/compression.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <istream>
+#include <memory>
+#include <ostream>
+#include <stdexcept>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+namespace ESM
+{
+    namespace
+    {
+        constexpr std::uint32_t compressedBlocksRecordName = FourCC<'C', 'M', 'P', 'R'>::value;
+
+        // Misc::compress output starts with the original size followed by lz4 data which is never larger than
+        // LZ4_COMPRESSBOUND.
+        constexpr std::size_t compressedBlockHeaderSize = sizeof(std::size_t);
+        constexpr std::size_t maxCompressedBlockSize = compressedBlockHeaderSize + maxCompressedSavedGameBlockSize
+            + maxCompressedSavedGameBlockSize / 255 + 16;
+
+        struct RecordHeader
+        {
+            std::uint32_t mName;
+            std::uint32_t mSize;
+            std::uint32_t mUnused;
+            std::uint32_t mFlags;
+        };
+
+        static_assert(sizeof(RecordHeader) == 4 * sizeof(std::uint32_t));
+
+        bool readRecordHeader(std::istream& stream, RecordHeader& header)
+        {
+            stream.read(reinterpret_cast<char*>(&header), sizeof(header));
+            return stream.gcount() == static_cast<std::streamsize>(sizeof(header));
+        }
+
+        bool copyRecord(std::istream& source, std::vector<char>& dest)
+        {
+            RecordHeader header;
+            if (!readRecordHeader(source, header))
+                return false;
+            const std::size_t offset = dest.size();
+            dest.resize(offset + sizeof(header) + header.mSize);
+            std::memcpy(dest.data() + offset, &header, sizeof(header));
+            source.read(dest.data() + offset + sizeof(header), header.mSize);
+            return source.gcount() == static_cast<std::streamsize>(header.mSize);
+        }
+
+        /// Reads the uncompressed prefix of the file (TES3 and SAVE records) and then decompresses the following
+        /// blocks on demand. Offsets of already visited blocks are remembered to allow seeking backwards.
+        class CompressedSavedGameBuf final : public std::streambuf
+        {
+        public:
+            CompressedSavedGameBuf(std::unique_ptr<std::istream>&& file, std::vector<char>&& header,
+                    std::uint64_t compressedDataSize)
+                : mFile(std::move(file))
+                , mHeader(std::move(header))
+                , mSize(mHeader.size() + compressedDataSize)
+                , mPosition(0)
+            {
+                mBlocks.push_back(Block {0, 0});
+                mBlocks.push_back(Block {mFile->tellg(), mHeader.size()});
+                setg(mHeader.data(), mHeader.data(), mHeader.data() + mHeader.size());
+            }
+
+        protected:
+            int_type underflow() override
+            {
+                if (gptr() != nullptr && gptr() < egptr())
+                    return traits_type::to_int_type(*gptr());
+                const std::uint64_t position = mPosition + static_cast<std::uint64_t>(egptr() - eback());
+                if (position >= mSize)
+                    return traits_type::eof();
+                load(position);
+                return traits_type::to_int_type(*gptr());
+            }
+
+            pos_type seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which) override
+            {
+                if (!(which & std::ios_base::in))
+                    return pos_type(off_type(-1));
+                switch (dir)
+                {
+                    case std::ios_base::beg:
+                        return seek(off);
+                    case std::ios_base::cur:
+                        return seek(static_cast<off_type>(tell()) + off);
+                    case std::ios_base::end:
+                        return seek(static_cast<off_type>(mSize) + off);
+                    default:
+                        return pos_type(off_type(-1));
+                }
+            }
+
+            pos_type seekpos(pos_type pos, std::ios_base::openmode which) override
+            {
+                return seekoff(off_type(pos), std::ios_base::beg, which);
+            }
+
+        private:
+            struct Block
+            {
+                std::streamoff mFileOffset;
+                std::uint64_t mPosition;
+            };
+
+            std::unique_ptr<std::istream> mFile;
+            std::vector<char> mHeader;
+            std::uint64_t mSize;
+            std::vector<Block> mBlocks;
+            std::vector<std::byte> mCompressed;
+            std::vector<std::byte> mDecompressed;
+            // Position of eback() in the decompressed stream
+            std::uint64_t mPosition;
+
+            std::uint64_t tell() const
+            {
+                return mPosition + static_cast<std::uint64_t>(gptr() - eback());
+            }
+
+            pos_type seek(off_type target)
+            {
+                if (target < 0 || static_cast<std::uint64_t>(target) > mSize)
+                    return pos_type(off_type(-1));
+                const std::uint64_t position = static_cast<std::uint64_t>(target);
+                if (eback() != nullptr && position >= mPosition
+                        && position < mPosition + static_cast<std::uint64_t>(egptr() - eback()))
+                {
+                    setg(eback(), eback() + (position - mPosition), egptr());
+                    return pos_type(target);
+                }
+                // Defer decompression until the data is actually read. This keeps seeking to the end to find the
+                // file size cheap.
+                setg(nullptr, nullptr, nullptr);
+                mPosition = position;
+                return pos_type(target);
+            }
+
+            void load(std::uint64_t position)
+            {
+                auto block = std::upper_bound(mBlocks.begin(), mBlocks.end(), position,
+                    [] (std::uint64_t value, const Block& v) { return value < v.mPosition; });
+                std::size_t index = static_cast<std::size_t>(block - mBlocks.begin()) - 1;
+                while (true)
+                {
+                    const std::uint64_t size = loadBlock(index);
+                    if (position < mBlocks[index].mPosition + size)
+                        break;
+                    ++index;
+                }
+                char* const begin = index == 0 ? mHeader.data() : reinterpret_cast<char*>(mDecompressed.data());
+                const std::size_t size = index == 0 ? mHeader.size() : mDecompressed.size();
+                mPosition = mBlocks[index].mPosition;
+                setg(begin, begin + (position - mPosition), begin + size);
+            }
+
+            std::uint64_t loadBlock(std::size_t index)
+            {
+                if (index == 0)
+                    return mHeader.size();
+
+                const Block block = mBlocks[index];
+                mFile->clear();
+                mFile->seekg(block.mFileOffset);
+                std::uint32_t compressedSize = 0;
+                mFile->read(reinterpret_cast<char*>(&compressedSize), sizeof(compressedSize));
+                if (!mFile->good())
+                    throw std::runtime_error("Unexpected end of compressed saved game data");
+                if (compressedSize <= compressedBlockHeaderSize || compressedSize > maxCompressedBlockSize)
+                    throw std::runtime_error("Invalid compressed block size in saved game: " + std::to_string(compressedSize));
+                mCompressed.resize(compressedSize);
+                mFile->read(reinterpret_cast<char*>(mCompressed.data()), compressedSize);
+                if (!mFile->good())
+                    throw std::runtime_error("Unexpected end of compressed saved game data");
+
+                std::size_t originalSize = 0;
+                std::memcpy(&originalSize, mCompressed.data(), sizeof(originalSize));
+                if (originalSize > maxCompressedSavedGameBlockSize)
+                    throw std::runtime_error("Invalid decompressed block size in saved game: " + std::to_string(originalSize));
+
+                mDecompressed = Misc::decompress(mCompressed);
+                if (mDecompressed.empty())
+                    throw std::runtime_error("Empty block in compressed saved game data");
+
+                if (index + 1 == mBlocks.size())
+                    mBlocks.push_back(Block {
+                        block.mFileOffset + static_cast<std::streamoff>(sizeof(compressedSize) + compressedSize),
+                        block.mPosition + mDecompressed.size()
+                    });
+
+                return mDecompressed.size();
+            }
+        };
+
+        class CompressedSavedGameStream final : public std::istream
+        {
+        public:
+            explicit CompressedSavedGameStream(std::unique_ptr<CompressedSavedGameBuf>&& buf)
+                : std::istream(buf.get())
+                , mBuf(std::move(buf))
+            {
+                // Report decompression errors instead of silently ending the stream
+                exceptions(std::ios_base::badbit);
+            }
+
+        private:
+            std::unique_ptr<CompressedSavedGameBuf> mBuf;
+        };
+    }
+
+    void writeCompressedSavedGame(std::istream& source, std::ostream& dest, std::size_t blockSize)
+    {
+        if (blockSize == 0 || blockSize > maxCompressedSavedGameBlockSize)
+            throw std::invalid_argument("Invalid saved game block size: " + std::to_string(blockSize));
+
+        std::vector<char> header;
+        if (!copyRecord(source, header) || !copyRecord(source, header))
+            throw std::runtime_error("Saved game is missing TES3 or SAVE record");
+        dest.write(header.data(), static_cast<std::streamsize>(header.size()));
+
+        const std::istream::pos_type dataBegin = source.tellg();
+        source.seekg(0, std::ios_base::end);
+        const std::uint64_t dataSize = static_cast<std::uint64_t>(source.tellg() - dataBegin);
+        source.seekg(dataBegin);
+
+        const RecordHeader compressedBlocks {compressedBlocksRecordName, sizeof(dataSize), 0, 0};
+        dest.write(reinterpret_cast<const char*>(&compressedBlocks), sizeof(compressedBlocks));
+        dest.write(reinterpret_cast<const char*>(&dataSize), sizeof(dataSize));
+
+        std::vector<std::byte> block;
+        for (std::uint64_t left = dataSize; left > 0;)
+        {
+            block.resize(static_cast<std::size_t>(std::min<std::uint64_t>(left, blockSize)));
+            source.read(reinterpret_cast<char*>(block.data()), static_cast<std::streamsize>(block.size()));
+            if (source.gcount() != static_cast<std::streamsize>(block.size()))
+                throw std::runtime_error("Failed to read saved game data for compression");
+            left -= block.size();
+            const std::vector<std::byte> compressed = Misc::compress(block);
+            const std::uint32_t compressedSize = static_cast<std::uint32_t>(compressed.size());
+            dest.write(reinterpret_cast<const char*>(&compressedSize), sizeof(compressedSize));
+            dest.write(reinterpret_cast<const char*>(compressed.data()), static_cast<std::streamsize>(compressed.size()));
+        }
+    }
+
+    Files::IStreamPtr openSavedGame(std::unique_ptr<std::istream>&& stream)
+    {
+        std::vector<char> header;
+        RecordHeader compressedBlocks;
+        std::uint64_t dataSize = 0;
+        if (!copyRecord(*stream, header) || !copyRecord(*stream, header) || !readRecordHeader(*stream, compressedBlocks)
+                || compressedBlocks.mName != compressedBlocksRecordName || compressedBlocks.mSize != sizeof(dataSize))
+        {
+            stream->clear();
+            stream->seekg(0, std::ios_base::beg);
+            return Files::IStreamPtr(std::move(stream));
+        }
+
+        stream->read(reinterpret_cast<char*>(&dataSize), sizeof(dataSize));
+        if (!stream->good())
+            throw std::runtime_error("Failed to read compressed saved game header");
+
+        return std::make_shared<CompressedSavedGameStream>(
+            std::make_unique<CompressedSavedGameBuf>(std::move(stream), std::move(header), dataSize));
+    }
+
+    Files::IStreamPtr openSavedGame(const std::string& path)
+    {
+        auto file = std::make_unique<std::ifstream>(path, std::ios_base::binary);
+        if (!file->is_open())
+            throw std::runtime_error("Failed to open saved game: " + path);
+        return openSavedGame(std::move(file));
+    }
+}
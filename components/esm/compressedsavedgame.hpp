@@ -0,0 +1,37 @@
+#ifndef OPENMW_ESM_COMPRESSEDSAVEDGAME_H
+#define OPENMW_ESM_COMPRESSEDSAVEDGAME_H
+
+#include <components/files/constrainedfilestream.hpp>
+
+#include <cstddef>
+#include <iosfwd>
+#include <memory>
+#include <string>
+
+namespace ESM
+{
+    // format 19, saved games only
+    //
+    // Layout of a compressed saved game:
+    //   TES3 record            - uncompressed
+    //   SAVE record            - uncompressed, so the saved games list doesn't have to decompress anything
+    //   CMPR record            - uint64 size of the decompressed data that follows
+    //   blocks until EOF       - uint32 compressed size followed by Misc::compress output
+
+    constexpr std::size_t compressedSavedGameBlockSize = 1024 * 1024;
+
+    // Larger blocks are rejected on reading to not allocate arbitrary amounts of memory for corrupted files.
+    constexpr std::size_t maxCompressedSavedGameBlockSize = 64 * 1024 * 1024;
+
+    /// Copy uncompressed saved game data from \a source into \a dest, compressing every record after the SAVE record.
+    void writeCompressedSavedGame(std::istream& source, std::ostream& dest,
+        std::size_t blockSize = compressedSavedGameBlockSize);
+
+    /// Prepare a saved game for reading. Compressed saved games are decompressed block by block while they are read,
+    /// so the whole file never has to be held in memory. Uncompressed saved games are returned as they are.
+    Files::IStreamPtr openSavedGame(std::unique_ptr<std::istream>&& stream);
+
+    Files::IStreamPtr openSavedGame(const std::string& path);
+}
+
+#endif
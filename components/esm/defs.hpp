@@ -177,6 +177,9 @@ enum RecNameInts
 
     // format 16 - Lua scripts in saved games
     REC_LUAM = FourCC<'L','U','A','M'>::value,  // LuaManager data
+
+    // format 20 - incremental saved games
+    REC_BASE = FourCC<'B','A','S','E'>::value,  // Cell states of unchanged cells are in the base saved game
 };
 
 /// Common subrecords
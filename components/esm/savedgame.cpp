@@ -4,7 +4,7 @@
 #include "esmwriter.hpp"
 
 unsigned int ESM::SavedGame::sRecordId = ESM::REC_SAVE;
-int ESM::SavedGame::sCurrentFormat = 18;
+int ESM::SavedGame::sCurrentFormat = 20;
 
 void ESM::SavedGame::load (ESMReader &esm)
 {
@@ -22,6 +22,8 @@ void ESM::SavedGame::load (ESMReader &esm)
     while (esm.isNextSub ("DEPE"))
         mContentFiles.push_back (esm.getHString());
 
+    mBaseSave = esm.getHNOString("BASE");
+
     esm.getSubNameIs("SCRN");
     esm.getSubHeader();
     mScreenshot.resize(esm.getSubSize());
@@ -47,6 +49,9 @@ void ESM::SavedGame::save (ESMWriter &esm) const
          iter!=mContentFiles.end(); ++iter)
          esm.writeHNString ("DEPE", *iter);
 
+    if (!mBaseSave.empty())
+        esm.writeHNString ("BASE", mBaseSave);
+
     esm.startSubRecord("SCRN");
     esm.write(&mScreenshot[0], mScreenshot.size());
     esm.endRecord("SCRN");
@@ -35,6 +35,10 @@ namespace ESM
         std::string mDescription;
         std::vector<char> mScreenshot; // raw jpg-encoded data
 
+        // File name of the base saved game holding the state of cells that have not changed since it was
+        // written. Empty if this saved game includes the state of all cells.
+        std::string mBaseSave;
+
         void load (ESMReader &esm);
         void save (ESMWriter &esm) const;
     };
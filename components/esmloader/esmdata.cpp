@@ -8,6 +8,7 @@
 #include <components/esm/loaddoor.hpp>
 #include <components/esm/loadgmst.hpp>
 #include <components/esm/loadland.hpp>
+#include <components/esm/loadltex.hpp>
 #include <components/esm/loadstat.hpp>
 #include <components/esm/variant.hpp>
 #include <components/misc/stringops.hpp>
@@ -14,6 +14,7 @@ namespace ESM
     struct Door;
     struct GameSetting;
     struct Land;
+    struct LandTexture;
     struct Static;
     class Variant;
 }
@@ -34,6 +35,7 @@ namespace EsmLoader
         std::vector<ESM::Door> mDoors;
         std::vector<ESM::GameSetting> mGameSettings;
         std::vector<ESM::Land> mLands;
+        std::vector<std::vector<ESM::LandTexture>> mLandTextures; // by content file index, then by texture index
         std::vector<ESM::Static> mStatics;
         std::vector<RefIdWithType> mRefIdTypes;
 
@@ -13,6 +13,7 @@
 #include <components/esm/loaddoor.hpp>
 #include <components/esm/loadgmst.hpp>
 #include <components/esm/loadland.hpp>
+#include <components/esm/loadltex.hpp>
 #include <components/esm/loadstat.hpp>
 #include <components/files/collections.hpp>
 #include <components/files/multidircollection.hpp>
@@ -139,6 +140,29 @@ namespace EsmLoader
             }
         }
 
+        // Land textures are referenced by index within the content file that uses them, so they are kept per file.
+        void loadRecord(ESM::ESMReader& reader, std::vector<std::vector<ESM::LandTexture>>& records)
+        {
+            ESM::LandTexture record;
+            bool deleted = false;
+            record.load(reader, deleted);
+
+            // Replace texture for records with given ID and index from all content files
+            for (std::vector<ESM::LandTexture>& textures : records)
+                if (record.mIndex < static_cast<int>(textures.size())
+                        && Misc::StringUtils::ciEqual(textures[record.mIndex].mId, record.mId))
+                    textures[record.mIndex].mTexture = record.mTexture;
+
+            const std::size_t plugin = static_cast<std::size_t>(reader.getIndex());
+            if (records.size() <= plugin)
+                records.resize(plugin + 1);
+            std::vector<ESM::LandTexture>& textures = records[plugin];
+            if (record.mIndex + 1 > static_cast<int>(textures.size()))
+                textures.resize(record.mIndex + 1);
+            const int index = record.mIndex;
+            textures[index] = std::move(record);
+        }
+
         struct ShallowContent
         {
             Records<ESM::Activator> mActivators;
@@ -147,6 +171,7 @@ namespace EsmLoader
             Records<ESM::Door> mDoors;
             Records<ESM::GameSetting> mGameSettings;
             Records<ESM::Land> mLands;
+            std::vector<std::vector<ESM::LandTexture>> mLandTextures;
             Records<ESM::Static> mStatics;
         };
 
@@ -178,6 +203,10 @@ namespace EsmLoader
                     if (query.mLoadLands)
                         return loadRecord(reader, content.mLands);
                     break;
+                case ESM::REC_LTEX:
+                    if (query.mLoadLandTextures)
+                        return loadRecord(reader, content.mLandTextures);
+                    break;
                 case ESM::REC_STAT:
                     if (query.mLoadStatics)
                         return loadRecord(reader, content.mStatics);
@@ -304,6 +333,8 @@ namespace EsmLoader
             loaded << ' ' << content.mGameSettings.size() << " game settings,";
         if (query.mLoadLands)
             loaded << ' ' << content.mLands.size() << " lands,";
+        if (query.mLoadLandTextures)
+            loaded << ' ' << content.mLandTextures.size() << " land texture lists,";
         if (query.mLoadStatics)
             loaded << ' ' << content.mStatics.size() << " statics,";
 
@@ -323,6 +354,8 @@ namespace EsmLoader
             result.mGameSettings = prepareRecords(content.mGameSettings, GetKey {});
         if (query.mLoadLands)
             result.mLands = prepareRecords(content.mLands, GetKey {});
+        if (query.mLoadLandTextures)
+            result.mLandTextures = std::move(content.mLandTextures);
         if (query.mLoadStatics)
             result.mStatics = prepareRecords(content.mStatics, GetKey {});
 
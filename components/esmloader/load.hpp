@@ -28,6 +28,7 @@ namespace EsmLoader
         bool mLoadDoors = false;
         bool mLoadGameSettings = false;
         bool mLoadLands = false;
+        bool mLoadLandTextures = false;
         bool mLoadStatics = false;
     };
 
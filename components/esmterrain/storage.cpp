@@ -1,5 +1,8 @@
 #include "storage.hpp"
 
+#include <algorithm>
+#include <cmath>
+#include <iterator>
 #include <set>
 
 #include <osg/Image>
@@ -171,6 +174,91 @@ namespace ESMTerrain
         }
     }
 
+    void Storage::fillVertexData(int cellX, int cellY, const LandObject* land, CellVertexData& vertexData, LandCache& cache)
+    {
+        constexpr int landSize = ESM::Land::LAND_SIZE;
+        constexpr int numVerts = ESM::Land::LAND_NUM_VERTS;
+
+        const ESM::Land::LandData *heightData = nullptr;
+        const ESM::Land::LandData *normalData = nullptr;
+        const ESM::Land::LandData *colourData = nullptr;
+        if (land)
+        {
+            heightData = land->getData(ESM::Land::DATA_VHGT);
+            normalData = land->getData(ESM::Land::DATA_VNML);
+            colourData = land->getData(ESM::Land::DATA_VCLR);
+        }
+
+        if (heightData)
+            std::copy(std::begin(heightData->mHeights), std::end(heightData->mHeights), vertexData.mHeights);
+        else
+            std::fill(std::begin(vertexData.mHeights), std::end(vertexData.mHeights), defaultHeight);
+
+        if (normalData)
+        {
+            // Keep the loop free of branches and calls, so it can be vectorized
+            const ESM::Land::VNML* source = normalData->mNormals;
+            for (int i = 0; i < numVerts; ++i)
+            {
+                const float x = source[i * 3];
+                const float y = source[i * 3 + 1];
+                const float z = source[i * 3 + 2];
+                const float length = std::sqrt(x * x + y * y + z * z);
+                const float scale = length > 0.f ? 1.f / length : 0.f;
+                vertexData.mNormals[i] = osg::Vec3f(x * scale, y * scale, z * scale);
+            }
+        }
+        else
+            std::fill(std::begin(vertexData.mNormals), std::end(vertexData.mNormals), osg::Vec3f(0, 0, 1));
+
+        if (colourData)
+        {
+            const unsigned char* source = colourData->mColours;
+            for (int i = 0; i < numVerts; ++i)
+                vertexData.mColours[i] = osg::Vec4ub(source[i * 3], source[i * 3 + 1], source[i * 3 + 2], 255);
+        }
+        else
+            std::fill(std::begin(vertexData.mColours), std::end(vertexData.mColours), osg::Vec4ub(255, 255, 255, 255));
+
+        for (int i = 0; i < landSize; ++i)
+        {
+            // Normals apparently don't connect seamlessly between cells
+            fixNormal(vertexData.mNormals[(landSize - 1) * landSize + i], cellX, cellY, landSize - 1, i, cache);
+            fixNormal(vertexData.mNormals[i * landSize + landSize - 1], cellX, cellY, i, landSize - 1, cache);
+
+            // Unlike normals, colors mostly connect seamlessly between cells, but not always...
+            vertexData.mBorderColours[0][i] = vertexData.mColours[(landSize - 1) * landSize + i];
+            fixColour(vertexData.mBorderColours[0][i], cellX, cellY, landSize - 1, i, cache);
+            vertexData.mBorderColours[1][i] = vertexData.mColours[i * landSize + landSize - 1];
+            fixColour(vertexData.mBorderColours[1][i], cellX, cellY, i, landSize - 1, cache);
+        }
+
+        // some corner normals appear to be complete garbage (z < 0)
+        for (int col : {0, landSize - 1})
+            for (int row : {0, landSize - 1})
+                averageNormal(vertexData.mNormals[col * landSize + row], cellX, cellY, col, row, cache);
+    }
+
+    const CellVertexData& Storage::getVertexData(int cellX, int cellY, const LandObject* land,
+                                                 std::unique_ptr<CellVertexData>& scratch, LandCache& cache)
+    {
+        if (land)
+        {
+            return land->getVertexData([&]
+            {
+                auto vertexData = std::make_unique<CellVertexData>();
+                fillVertexData(cellX, cellY, land, *vertexData, cache);
+                return vertexData;
+            });
+        }
+
+        // Cells without land still take the border normals and colours from their neighbours
+        if (!scratch)
+            scratch = std::make_unique<CellVertexData>();
+        fillVertexData(cellX, cellY, nullptr, *scratch, cache);
+        return *scratch;
+    }
+
     void Storage::fillVertexBuffers (int lodLevel, float size, const osg::Vec2f& center,
                                             osg::ref_ptr<osg::Vec3Array> positions,
                                             osg::ref_ptr<osg::Vec3Array> normals,
@@ -190,13 +278,11 @@ namespace ESMTerrain
         normals->resize(numVerts*numVerts);
         colours->resize(numVerts*numVerts);
 
-        osg::Vec3f normal;
-        osg::Vec4ub color;
-
         float vertY = 0;
         float vertX = 0;
 
         LandCache cache;
+        std::unique_ptr<CellVertexData> scratch;
 
         bool alteration = useAlteration();
 
@@ -207,15 +293,8 @@ namespace ESMTerrain
             for (int cellX = startCellX; cellX < startCellX + std::ceil(size); ++cellX)
             {
                 const LandObject* land = getLand(cellX, cellY, cache);
-                const ESM::Land::LandData *heightData = nullptr;
-                const ESM::Land::LandData *normalData = nullptr;
-                const ESM::Land::LandData *colourData = nullptr;
-                if (land)
-                {
-                    heightData = land->getData(ESM::Land::DATA_VHGT);
-                    normalData = land->getData(ESM::Land::DATA_VNML);
-                    colourData = land->getData(ESM::Land::DATA_VCLR);
-                }
+                const ESM::Land::LandData *heightData = land ? land->getData(ESM::Land::DATA_VHGT) : nullptr;
+                const CellVertexData& vertexData = getVertexData(cellX, cellY, land, scratch, cache);
 
                 int rowStart = 0;
                 int colStart = 0;
@@ -239,7 +318,8 @@ namespace ESMTerrain
                     vertX = vertX_;
                     for (int row=rowStart; row<rowEnd; row += increment)
                     {
-                        int srcArrayIndex = col*ESM::Land::LAND_SIZE*3+row*3;
+                        const int srcIndex = col*ESM::Land::LAND_SIZE + row;
+                        const unsigned int dstIndex = static_cast<unsigned int>(vertX*numVerts + vertY);
 
                         assert(row >= 0 && row < ESM::Land::LAND_SIZE);
                         assert(col >= 0 && col < ESM::Land::LAND_SIZE);
@@ -247,59 +327,28 @@ namespace ESMTerrain
                         assert (vertX < numVerts);
                         assert (vertY < numVerts);
 
-                        float height = defaultHeight;
-                        if (heightData)
-                            height = heightData->mHeights[col*ESM::Land::LAND_SIZE + row];
+                        float height = vertexData.mHeights[srcIndex];
                         if (alteration)
                             height += getAlteredHeight(col, row);
-                        (*positions)[static_cast<unsigned int>(vertX*numVerts + vertY)]
+                        (*positions)[dstIndex]
                             = osg::Vec3f((vertX / float(numVerts - 1) - 0.5f) * size * Constants::CellSizeInUnits,
                                          (vertY / float(numVerts - 1) - 0.5f) * size * Constants::CellSizeInUnits,
                                          height);
 
-                        if (normalData)
-                        {
-                            for (int i=0; i<3; ++i)
-                                normal[i] = normalData->mNormals[srcArrayIndex+i];
-
-                            normal.normalize();
-                        }
-                        else
-                            normal = osg::Vec3f(0,0,1);
-
-                        // Normals apparently don't connect seamlessly between cells
-                        if (col == ESM::Land::LAND_SIZE-1 || row == ESM::Land::LAND_SIZE-1)
-                            fixNormal(normal, cellX, cellY, col, row, cache);
-
-                        // some corner normals appear to be complete garbage (z < 0)
-                        if ((row == 0 || row == ESM::Land::LAND_SIZE-1) && (col == 0 || col == ESM::Land::LAND_SIZE-1))
-                            averageNormal(normal, cellX, cellY, col, row, cache);
-
-                        assert(normal.z() > 0);
-
-                        (*normals)[static_cast<unsigned int>(vertX*numVerts + vertY)] = normal;
+                        assert(vertexData.mNormals[srcIndex].z() > 0);
+                        (*normals)[dstIndex] = vertexData.mNormals[srcIndex];
 
-                        if (colourData)
-                        {
-                            for (int i=0; i<3; ++i)
-                                color[i] = colourData->mColours[srcArrayIndex+i];
-                        }
-                        else
-                        {
-                            color.r() = 255;
-                            color.g() = 255;
-                            color.b() = 255;
-                        }
+                        osg::Vec4ub color = vertexData.mColours[srcIndex];
                         if (alteration)
                             adjustColor(col, row, heightData, color); //Does nothing by default, override in OpenMW-CS
 
                         // Unlike normals, colors mostly connect seamlessly between cells, but not always...
-                        if (col == ESM::Land::LAND_SIZE-1 || row == ESM::Land::LAND_SIZE-1)
-                            fixColour(color, cellX, cellY, col, row, cache);
-
-                        color.a() = 255;
+                        if (col == ESM::Land::LAND_SIZE-1)
+                            color = vertexData.mBorderColours[0][row];
+                        else if (row == ESM::Land::LAND_SIZE-1)
+                            color = vertexData.mBorderColours[1][col];
 
-                        (*colours)[static_cast<unsigned int>(vertX*numVerts + vertY)] = color;
+                        (*colours)[dstIndex] = color;
 
                         ++vertX;
                     }
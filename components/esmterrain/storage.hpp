@@ -2,8 +2,12 @@
 #define COMPONENTS_ESM_TERRAIN_STORAGE_H
 
 #include <cassert>
+#include <memory>
 #include <mutex>
 
+#include <osg/Vec3f>
+#include <osg/Vec4ub>
+
 #include <components/terrain/storage.hpp>
 
 #include <components/esm/loadland.hpp>
@@ -19,6 +23,19 @@ namespace ESMTerrain
 
     class LandCache;
 
+    /// @brief Vertex data of a cell prepared for rendering. Normals are normalized and the normals on the cell borders
+    ///        are taken from the neighbouring cells, so terrain chunks of any size and LOD level only need to pick every
+    ///        n-th vertex. Indexed the same way as ESM::Land::LandData.
+    struct CellVertexData
+    {
+        float mHeights[ESM::Land::LAND_NUM_VERTS];
+        osg::Vec3f mNormals[ESM::Land::LAND_NUM_VERTS];
+        /// Colours of the cell itself, the colours on the borders are replaced by mBorderColours after adjustColor
+        osg::Vec4ub mColours[ESM::Land::LAND_NUM_VERTS];
+        /// Colours of the last column (by row) and of the last row (by column) taken from the neighbouring cells
+        osg::Vec4ub mBorderColours[2][ESM::Land::LAND_SIZE];
+    };
+
     /// @brief Wrapper around Land Data with reference counting. The wrapper needs to be held as long as the data is still in use
     class LandObject : public osg::Object
     {
@@ -38,11 +55,23 @@ namespace ESMTerrain
         }
         inline int getPlugin() const { return mLand->getPlugin(); }
 
+        /// Returns the vertex data of the cell, `create` is called to build it the first time.
+        /// @note Thread safe.
+        template <class Function>
+        const CellVertexData& getVertexData(Function&& create) const
+        {
+            std::call_once(mVertexDataCreated, [&] { mVertexData = create(); });
+            return *mVertexData;
+        }
+
     private:
         const ESM::Land* mLand;
         int mLoadFlags;
 
         ESM::Land::LandData mData;
+
+        mutable std::once_flag mVertexDataCreated;
+        mutable std::unique_ptr<const CellVertexData> mVertexData;
     };
 
     /// @brief Feeds data from ESM terrain records (ESM::Land, ESM::LandTexture)
@@ -120,6 +149,11 @@ namespace ESMTerrain
 
         inline const LandObject* getLand(int cellX, int cellY, LandCache& cache);
 
+        void fillVertexData(int cellX, int cellY, const LandObject* land, CellVertexData& vertexData, LandCache& cache);
+        /// @param scratch Used for cells without land, since there is no LandObject to keep their vertex data.
+        const CellVertexData& getVertexData(int cellX, int cellY, const LandObject* land,
+                                            std::unique_ptr<CellVertexData>& scratch, LandCache& cache);
+
         virtual bool useAlteration() const { return false; }
         virtual void adjustColor(int col, int row, const ESM::Land::LandData *heightData, osg::Vec4ub& color) const;
         virtual float getAlteredHeight(int col, int row) const;
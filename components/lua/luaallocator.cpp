@@ -0,0 +1,171 @@
+#include "luaallocator.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+namespace LuaUtil
+{
+
+    namespace
+    {
+        // Chunks are linked in a list; the link is stored at the beginning of each chunk.
+        constexpr std::size_t chunkHeaderSize = LuaAllocator::sSizeClassStep;
+    }
+
+    LuaAllocator::~LuaAllocator()
+    {
+        while (mLastChunk != nullptr)
+        {
+            void* previous = *static_cast<void**>(mLastChunk);
+            std::free(mLastChunk);
+            mLastChunk = previous;
+        }
+    }
+
+    void* LuaAllocator::allocate(void* ud, void* ptr, std::size_t osize, std::size_t nsize)
+    {
+        return static_cast<LuaAllocator*>(ud)->reallocate(ptr, osize, nsize);
+    }
+
+    void* LuaAllocator::reallocate(void* ptr, std::size_t osize, std::size_t nsize)
+    {
+        // If ptr is null, Lua passes the type of the object that is being allocated instead of the old size.
+        if (ptr == nullptr)
+            osize = 0;
+        BlockHeader* const block = ptr != nullptr ? static_cast<BlockHeader*>(ptr) - 1 : nullptr;
+
+        if (nsize == 0)
+        {
+            if (block != nullptr)
+            {
+                addUsage(block->mScriptId, osize, 0);
+                freeBlock(block, getBlockSize(osize));
+            }
+            return nullptr;
+        }
+
+        const int scriptId = block != nullptr ? block->mScriptId : mActiveScript;
+        if (nsize > osize && isLimitExceeded(scriptId, nsize - osize))
+        {
+            ++mStats.mFailedAllocations;
+            return nullptr;
+        }
+
+        const std::size_t oldBlockSize = getBlockSize(osize);
+        const std::size_t newBlockSize = getBlockSize(nsize);
+        BlockHeader* result = nullptr;
+        if (block != nullptr && isPooled(oldBlockSize) && isPooled(newBlockSize)
+            && getSizeClass(oldBlockSize) == getSizeClass(newBlockSize))
+        {
+            result = block;
+        }
+        else if (block != nullptr && !isPooled(oldBlockSize) && !isPooled(newBlockSize))
+        {
+            result = static_cast<BlockHeader*>(std::realloc(block, newBlockSize));
+            if (result == nullptr)
+                return nullptr;
+            mStats.mLargeUsed = mStats.mLargeUsed + newBlockSize - oldBlockSize;
+        }
+        else
+        {
+            result = allocateBlock(newBlockSize);
+            if (result == nullptr)
+                return nullptr;
+            result->mScriptId = scriptId;
+            result->mPadding = 0;
+            if (block != nullptr)
+            {
+                std::memcpy(result + 1, block + 1, std::min(osize, nsize));
+                freeBlock(block, oldBlockSize);
+            }
+        }
+
+        ++mStats.mAllocations;
+        if (isPooled(newBlockSize))
+            ++mStats.mPoolAllocations;
+        addUsage(scriptId, osize, nsize);
+        return result + 1;
+    }
+
+    void LuaAllocator::setActiveScript(int scriptId)
+    {
+        // Resized here rather than in `reallocate` because Lua doesn't expect exceptions from the allocator.
+        if (scriptId != sNoScript && static_cast<std::size_t>(scriptId) >= mScriptMemoryUsage.size())
+            mScriptMemoryUsage.resize(scriptId + 1, 0);
+        mActiveScript = scriptId;
+    }
+
+    std::size_t LuaAllocator::getScriptMemoryUsage(int scriptId) const
+    {
+        if (scriptId < 0 || static_cast<std::size_t>(scriptId) >= mScriptMemoryUsage.size())
+            return 0;
+        return mScriptMemoryUsage[scriptId];
+    }
+
+    LuaAllocator::BlockHeader* LuaAllocator::allocateBlock(std::size_t blockSize)
+    {
+        if (!isPooled(blockSize))
+        {
+            void* result = std::malloc(blockSize);
+            if (result != nullptr)
+                mStats.mLargeUsed += blockSize;
+            return static_cast<BlockHeader*>(result);
+        }
+
+        const std::size_t sizeClass = getSizeClass(blockSize);
+        const std::size_t classBlockSize = (sizeClass + 1) * sSizeClassStep;
+        Pool& pool = mPools[sizeClass];
+        void* result = pool.mFreeList;
+        if (result != nullptr)
+            pool.mFreeList = *static_cast<void**>(result);
+        else
+        {
+            if (static_cast<std::size_t>(pool.mEnd - pool.mNext) < classBlockSize)
+            {
+                char* const chunk = static_cast<char*>(std::malloc(sChunkSize));
+                if (chunk == nullptr)
+                    return nullptr;
+                *reinterpret_cast<void**>(chunk) = mLastChunk;
+                mLastChunk = chunk;
+                pool.mNext = chunk + chunkHeaderSize;
+                pool.mEnd = chunk + sChunkSize;
+                mStats.mPoolReserved += sChunkSize;
+            }
+            result = pool.mNext;
+            pool.mNext += classBlockSize;
+        }
+        mStats.mPoolUsed += classBlockSize;
+        return static_cast<BlockHeader*>(result);
+    }
+
+    void LuaAllocator::freeBlock(BlockHeader* block, std::size_t blockSize)
+    {
+        if (!isPooled(blockSize))
+        {
+            mStats.mLargeUsed -= blockSize;
+            std::free(block);
+            return;
+        }
+        const std::size_t sizeClass = getSizeClass(blockSize);
+        Pool& pool = mPools[sizeClass];
+        *reinterpret_cast<void**>(block) = pool.mFreeList;
+        pool.mFreeList = block;
+        mStats.mPoolUsed -= (sizeClass + 1) * sSizeClassStep;
+    }
+
+    void LuaAllocator::addUsage(int scriptId, std::size_t oldSize, std::size_t newSize)
+    {
+        mStats.mUsed = mStats.mUsed + newSize - oldSize;
+        if (scriptId != sNoScript)
+            mScriptMemoryUsage[scriptId] = mScriptMemoryUsage[scriptId] + newSize - oldSize;
+    }
+
+    bool LuaAllocator::isLimitExceeded(int scriptId, std::size_t delta) const
+    {
+        if (mScriptMemoryLimit == 0 || scriptId == sNoScript)
+            return false;
+        return mScriptMemoryUsage[scriptId] + delta > mScriptMemoryLimit;
+    }
+
+}
@@ -0,0 +1,122 @@
+#ifndef COMPONENTS_LUA_LUAALLOCATOR_H
+#define COMPONENTS_LUA_LUAALLOCATOR_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace LuaUtil
+{
+
+    // Memory allocator for a Lua state (see lua_Alloc).
+    // Small blocks are taken from free lists of fixed size classes. The pools request memory from the
+    // system in big chunks and keep it until the allocator is destroyed, so the many short-living
+    // tables and strings created by scripts don't fragment the heap and don't cost a malloc/free pair.
+    // Every block is attributed to the script that was active when it was allocated, which makes it
+    // possible to find scripts that use too much memory and to limit memory usage per script.
+    // Not thread safe; the Lua state itself is not thread safe either.
+    class LuaAllocator
+    {
+    public:
+        // Memory that is allocated when no script is active belongs to the engine itself.
+        static constexpr int sNoScript = -1;
+
+        static constexpr std::size_t sSizeClassStep = 16;
+        static constexpr std::size_t sMaxPooledSize = 256;
+        static constexpr std::size_t sChunkSize = 64 * 1024;
+
+        struct Stats
+        {
+            std::size_t mUsed = 0;  // bytes requested by Lua
+            std::size_t mPoolReserved = 0;  // bytes requested by the pools from the system
+            std::size_t mPoolUsed = 0;  // bytes of pool blocks that are currently in use
+            std::size_t mLargeUsed = 0;  // bytes of blocks that are too big for the pools
+            std::size_t mAllocations = 0;  // total number of allocations and reallocations
+            std::size_t mPoolAllocations = 0;  // allocations that were served by the pools
+            std::size_t mFailedAllocations = 0;  // allocations that were blocked by the memory limit
+        };
+
+        LuaAllocator() = default;
+        LuaAllocator(const LuaAllocator&) = delete;
+        LuaAllocator& operator=(const LuaAllocator&) = delete;
+        ~LuaAllocator();
+
+        // Has the signature of lua_Alloc; `ud` should point to a LuaAllocator.
+        static void* allocate(void* ud, void* ptr, std::size_t osize, std::size_t nsize);
+
+        void* reallocate(void* ptr, std::size_t osize, std::size_t nsize);
+
+        int getActiveScript() const { return mActiveScript; }
+        void setActiveScript(int scriptId);
+
+        // 0 means no limit. Allocations of a script that would exceed the limit fail and cause a Lua
+        // "not enough memory" error in this script. Memory of the engine itself is never limited.
+        std::size_t getScriptMemoryLimit() const { return mScriptMemoryLimit; }
+        void setScriptMemoryLimit(std::size_t limit) { mScriptMemoryLimit = limit; }
+
+        // scriptId is an index in LuaUtil::ScriptsConfiguration. If the script runs in several
+        // containers (e.g. as a local script of many objects), the usage of all instances is summed.
+        std::size_t getScriptMemoryUsage(int scriptId) const;
+        std::size_t getScriptsCount() const { return mScriptMemoryUsage.size(); }
+
+        const Stats& getStats() const { return mStats; }
+
+    private:
+        struct BlockHeader
+        {
+            std::int32_t mScriptId;
+            std::uint32_t mPadding;
+        };
+
+        static_assert(sizeof(BlockHeader) == 8);
+
+        static constexpr std::size_t sSizeClasses = sMaxPooledSize / sSizeClassStep;
+
+        struct Pool
+        {
+            void* mFreeList = nullptr;
+            char* mNext = nullptr;  // not yet used part of the last chunk
+            char* mEnd = nullptr;
+        };
+
+        static std::size_t getBlockSize(std::size_t size) { return size + sizeof(BlockHeader); }
+        static bool isPooled(std::size_t blockSize) { return blockSize <= sMaxPooledSize; }
+        static std::size_t getSizeClass(std::size_t blockSize) { return (blockSize - 1) / sSizeClassStep; }
+
+        BlockHeader* allocateBlock(std::size_t blockSize);
+        void freeBlock(BlockHeader* block, std::size_t blockSize);
+        void addUsage(int scriptId, std::size_t oldSize, std::size_t newSize);
+        bool isLimitExceeded(int scriptId, std::size_t delta) const;
+
+        int mActiveScript = sNoScript;
+        std::size_t mScriptMemoryLimit = 0;
+        std::vector<std::size_t> mScriptMemoryUsage;
+        std::array<Pool, sSizeClasses> mPools;
+        void* mLastChunk = nullptr;
+        Stats mStats;
+    };
+
+    // All memory allocated during the lifetime of this object is attributed to the given script.
+    class ActiveScriptScope
+    {
+    public:
+        ActiveScriptScope(LuaAllocator& allocator, int scriptId)
+            : mAllocator(allocator), mPrevious(allocator.getActiveScript())
+        {
+            mAllocator.setActiveScript(scriptId);
+        }
+
+        ActiveScriptScope(const ActiveScriptScope&) = delete;
+        ActiveScriptScope& operator=(const ActiveScriptScope&) = delete;
+
+        ~ActiveScriptScope() { mAllocator.setActiveScript(mPrevious); }
+
+    private:
+        LuaAllocator& mAllocator;
+        const int mPrevious;
+    };
+
+}
+
+#endif // COMPONENTS_LUA_LUAALLOCATOR_H
@@ -0,0 +1,237 @@
+#include "luaprofiler.hpp"
+
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
+#include <sol/sol.hpp>
+
+#include <components/debug/debuglog.hpp>
+
+#include "configuration.hpp"
+
+namespace LuaUtil
+{
+
+    namespace
+    {
+        // Address is used as a key in the Lua registry to find the profiler from the hook.
+        const char registryKey = 0;
+
+        constexpr std::chrono::seconds budgetWarningInterval(10);
+
+        double toMilliseconds(LuaProfiler::Clock::duration duration)
+        {
+            return std::chrono::duration<double, std::milli>(duration).count();
+        }
+
+        double toMicroseconds(LuaProfiler::Clock::duration duration)
+        {
+            return std::chrono::duration<double, std::micro>(duration).count();
+        }
+
+        void writeJsonString(std::ostream& stream, std::string_view value)
+        {
+            stream << '"';
+            for (char c : value)
+            {
+                if (c == '"' || c == '\\')
+                    stream << '\\' << c;
+                else if (static_cast<unsigned char>(c) < 0x20)
+                    stream << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c) << std::dec;
+                else
+                    stream << c;
+            }
+            stream << '"';
+        }
+    }
+
+    LuaProfiler::LuaProfiler(lua_State* lua, const ScriptsConfiguration* conf)
+        : mLua(lua)
+        , mConf(conf)
+    {
+        lua_pushlightuserdata(mLua, const_cast<char*>(&registryKey));
+        lua_pushlightuserdata(mLua, this);
+        lua_rawset(mLua, LUA_REGISTRYINDEX);
+    }
+
+    LuaProfiler::~LuaProfiler()
+    {
+        if (mRunning)
+            lua_sethook(mLua, nullptr, 0, 0);
+    }
+
+    void LuaProfiler::start()
+    {
+        mStats.clear();
+        mFunctionSamples.clear();
+        mUnattributedInstructions = 0;
+        mTrace.clear();
+        mStartTime = Clock::now();
+        mRunning = true;
+        lua_sethook(mLua, &LuaProfiler::hook, LUA_MASKCOUNT, sInstructionsPerSample);
+    }
+
+    void LuaProfiler::stop()
+    {
+        lua_sethook(mLua, nullptr, 0, 0);
+        mRunning = false;
+    }
+
+    void LuaProfiler::hook(lua_State* lua, lua_Debug* ar)
+    {
+        lua_pushlightuserdata(lua, const_cast<char*>(&registryKey));
+        lua_rawget(lua, LUA_REGISTRYINDEX);
+        LuaProfiler* self = static_cast<LuaProfiler*>(lua_touserdata(lua, -1));
+        lua_pop(lua, 1);
+        if (self == nullptr || !self->mRunning)
+            return;
+
+        if (self->mStack.empty())
+            self->mUnattributedInstructions += sInstructionsPerSample;
+        else
+            self->mStack.back().mInstructions += sInstructionsPerSample;
+
+        if (lua_getinfo(lua, "S", ar) == 0)
+            return;
+        std::string function = ar->short_src;
+        function += ':';
+        function += std::to_string(ar->linedefined);
+        ++self->mFunctionSamples[function];
+    }
+
+    bool LuaProfiler::enter(int scriptId, std::string_view handler)
+    {
+        if (!isTiming())
+            return false;
+        const std::string* handlerName = nullptr;
+        if (mRunning)
+        {
+            auto it = mHandlerNames.find(handler);
+            if (it == mHandlerNames.end())
+                it = mHandlerNames.emplace(handler).first;
+            handlerName = &*it;
+        }
+        if (scriptId >= 0 && static_cast<std::size_t>(scriptId) >= mFrameTime.size())
+        {
+            mFrameTime.resize(scriptId + 1, Clock::duration::zero());
+            mLastBudgetWarning.resize(scriptId + 1);
+            mFramesOverBudget.resize(scriptId + 1, 0);
+        }
+        mStack.push_back(Frame {HandlerKey {scriptId, handlerName}, Clock::now()});
+        return true;
+    }
+
+    void LuaProfiler::leave()
+    {
+        const Frame frame = mStack.back();
+        mStack.pop_back();
+        const Clock::duration duration = Clock::now() - frame.mStart;
+        const Clock::duration time = duration - frame.mNested;
+        if (!mStack.empty())
+            mStack.back().mNested += duration;
+        if (frame.mKey.mScriptId >= 0)
+            mFrameTime[frame.mKey.mScriptId] += time;
+        if (!mRunning || frame.mKey.mHandler == nullptr)
+            return;
+
+        Stats& stats = mStats[frame.mKey];
+        stats.mTime += time;
+        stats.mInstructions += frame.mInstructions;
+        ++stats.mCalls;
+        if (mTrace.size() < sMaxTraceEvents)
+            mTrace.push_back(TraceEvent {frame.mKey, frame.mStart, duration, frame.mInstructions});
+    }
+
+    void LuaProfiler::finishFrame()
+    {
+        if (mFrameBudget != Clock::duration::zero())
+            checkFrameBudget();
+        std::fill(mFrameTime.begin(), mFrameTime.end(), Clock::duration::zero());
+    }
+
+    void LuaProfiler::checkFrameBudget()
+    {
+        const Clock::time_point now = Clock::now();
+        for (std::size_t i = 0; i < mFrameTime.size(); ++i)
+        {
+            if (mFrameTime[i] <= mFrameBudget)
+                continue;
+            ++mFramesOverBudget[i];
+            if (now - mLastBudgetWarning[i] < budgetWarningInterval)
+                continue;
+            Log(Debug::Warning) << "Lua script " << getScriptPath(static_cast<int>(i)) << " has exceeded the frame budget of "
+                                << toMilliseconds(mFrameBudget) << " ms in " << mFramesOverBudget[i]
+                                << " frame(s), the last time it took " << toMilliseconds(mFrameTime[i]) << " ms";
+            mLastBudgetWarning[i] = now;
+            mFramesOverBudget[i] = 0;
+        }
+    }
+
+    const std::string& LuaProfiler::getScriptPath(int scriptId) const
+    {
+        static const std::string unknown = "<unknown script>";
+        if (scriptId < 0 || static_cast<std::size_t>(scriptId) >= mConf->size())
+            return unknown;
+        return (*mConf)[scriptId].mScriptPath;
+    }
+
+    std::string LuaProfiler::getReport(std::size_t maxEntries) const
+    {
+        std::vector<std::pair<HandlerKey, Stats>> handlers(mStats.begin(), mStats.end());
+        std::sort(handlers.begin(), handlers.end(),
+                  [] (const auto& l, const auto& r) { return l.second.mTime > r.second.mTime; });
+        Clock::duration total {};
+        std::uint64_t instructions = mUnattributedInstructions;
+        for (const auto& [key, stats] : mStats)
+        {
+            total += stats.mTime;
+            instructions += stats.mInstructions;
+        }
+
+        std::ostringstream out;
+        out << std::fixed << std::setprecision(3);
+        out << "Lua profiler " << (mRunning ? "is running" : "is stopped") << "; "
+            << toMilliseconds(total) << " ms in handlers, " << instructions << " instructions\n";
+        out << "Time (ms) | Calls | Instructions | Handler\n";
+        for (std::size_t i = 0; i < handlers.size() && i < maxEntries; ++i)
+        {
+            const auto& [key, stats] = handlers[i];
+            out << toMilliseconds(stats.mTime) << " | " << stats.mCalls << " | " << stats.mInstructions << " | "
+                << getScriptPath(key.mScriptId) << " " << *key.mHandler << "\n";
+        }
+
+        std::vector<std::pair<std::uint64_t, std::string_view>> functions;
+        functions.reserve(mFunctionSamples.size());
+        for (const auto& [function, samples] : mFunctionSamples)
+            functions.emplace_back(samples, function);
+        std::sort(functions.begin(), functions.end(), std::greater<>());
+        out << "Instructions | Function\n";
+        for (std::size_t i = 0; i < functions.size() && i < maxEntries; ++i)
+            out << functions[i].first * sInstructionsPerSample << " | " << functions[i].second << "\n";
+        return out.str();
+    }
+
+    void LuaProfiler::writeChromeTrace(std::ostream& stream) const
+    {
+        stream << std::fixed << std::setprecision(3) << "{\"traceEvents\":[";
+        bool first = true;
+        for (const TraceEvent& event : mTrace)
+        {
+            if (!first)
+                stream << ",";
+            first = false;
+            const std::string& script = getScriptPath(event.mKey.mScriptId);
+            stream << "\n{\"name\":";
+            writeJsonString(stream, *event.mKey.mHandler);
+            stream << ",\"cat\":";
+            writeJsonString(stream, script);
+            stream << ",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":" << toMicroseconds(event.mStart - mStartTime)
+                   << ",\"dur\":" << toMicroseconds(event.mDuration) << ",\"args\":{\"script\":";
+            writeJsonString(stream, script);
+            stream << ",\"instructions\":" << event.mInstructions << "}}";
+        }
+        stream << "\n],\"displayTimeUnit\":\"ms\"}\n";
+    }
+
+}
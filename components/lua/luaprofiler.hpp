@@ -0,0 +1,144 @@
+#ifndef COMPONENTS_LUA_LUAPROFILER_H
+#define COMPONENTS_LUA_LUAPROFILER_H
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <ostream>
+#include <set>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+struct lua_State;
+struct lua_Debug;
+
+namespace LuaUtil
+{
+    class ScriptsConfiguration;
+
+    // Measures time and the number of executed Lua instructions per script and per handler.
+    // Time is measured by ProfilerScope around every call of a script handler. Instructions are sampled
+    // with a Lua count hook, which also records what Lua function is running at the moment.
+    // While the profiler is running it also collects a trace that can be saved in the Chrome trace
+    // format (can be viewed in chrome://tracing or https://ui.perfetto.dev).
+    // If a frame budget is set, time is measured even if the profiler is not running and a warning is
+    // printed when a script exceeds the budget.
+    class LuaProfiler
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        static constexpr int sInstructionsPerSample = 1000;
+        static constexpr std::size_t sMaxTraceEvents = 1000000;
+
+        struct Stats
+        {
+            Clock::duration mTime {};  // doesn't include time of nested handlers
+            std::uint64_t mInstructions = 0;
+            std::uint64_t mCalls = 0;
+        };
+
+        LuaProfiler(lua_State* lua, const ScriptsConfiguration* conf);
+        LuaProfiler(const LuaProfiler&) = delete;
+        LuaProfiler& operator=(const LuaProfiler&) = delete;
+        ~LuaProfiler();
+
+        bool isRunning() const { return mRunning; }
+
+        // Clears results of the previous run.
+        void start();
+        void stop();
+
+        // 0 means no budget.
+        Clock::duration getFrameBudget() const { return mFrameBudget; }
+        void setFrameBudget(Clock::duration budget) { mFrameBudget = budget; }
+
+        // Should be called once per frame after all scripts are processed.
+        void finishFrame();
+
+        // Results of the current or the last run, sorted by time. `maxEntries` limits each section of the report.
+        std::string getReport(std::size_t maxEntries) const;
+
+        void writeChromeTrace(std::ostream& stream) const;
+
+        // Returns false if nothing is measured at the moment; `leave` should be called only if `enter` returned true.
+        bool enter(int scriptId, std::string_view handler);
+        void leave();
+
+    private:
+        struct HandlerKey
+        {
+            int mScriptId;
+            const std::string* mHandler;
+
+            bool operator<(const HandlerKey& other) const
+            {
+                return std::make_pair(mScriptId, mHandler) < std::make_pair(other.mScriptId, other.mHandler);
+            }
+        };
+
+        struct Frame
+        {
+            HandlerKey mKey;
+            Clock::time_point mStart;
+            Clock::duration mNested {};
+            std::uint64_t mInstructions = 0;
+        };
+
+        struct TraceEvent
+        {
+            HandlerKey mKey;
+            Clock::time_point mStart;
+            Clock::duration mDuration;
+            std::uint64_t mInstructions;
+        };
+
+        static void hook(lua_State* lua, lua_Debug* ar);
+
+        bool isTiming() const { return mRunning || mFrameBudget != Clock::duration::zero(); }
+        const std::string& getScriptPath(int scriptId) const;
+        void checkFrameBudget();
+
+        lua_State* mLua;
+        const ScriptsConfiguration* mConf;
+        bool mRunning = false;
+        Clock::duration mFrameBudget {};
+        Clock::time_point mStartTime;
+        std::vector<Frame> mStack;
+        std::set<std::string, std::less<>> mHandlerNames;
+        std::map<HandlerKey, Stats> mStats;
+        std::map<std::string, std::uint64_t, std::less<>> mFunctionSamples;
+        std::uint64_t mUnattributedInstructions = 0;
+        std::vector<TraceEvent> mTrace;
+        std::vector<Clock::duration> mFrameTime;  // per script
+        std::vector<Clock::time_point> mLastBudgetWarning;  // per script
+        std::vector<std::uint32_t> mFramesOverBudget;  // per script, since the last warning
+    };
+
+    // Profiles a call of a script handler; see LuaProfiler.
+    class ProfilerScope
+    {
+    public:
+        ProfilerScope(LuaProfiler& profiler, int scriptId, std::string_view handler)
+            : mProfiler(profiler), mActive(profiler.enter(scriptId, handler))
+        {}
+
+        ProfilerScope(const ProfilerScope&) = delete;
+        ProfilerScope& operator=(const ProfilerScope&) = delete;
+
+        ~ProfilerScope()
+        {
+            if (mActive)
+                mProfiler.leave();
+        }
+
+    private:
+        LuaProfiler& mProfiler;
+        const bool mActive;
+    };
+
+}
+
+#endif // COMPONENTS_LUA_LUAPROFILER_H
@@ -22,7 +22,35 @@ namespace LuaUtil
         "type", "unpack", "xpcall", "rawequal", "rawget", "rawset", "getmetatable", "setmetatable"};
     static const std::string safePackages[] = {"coroutine", "math", "string", "table"};
 
-    LuaState::LuaState(const VFS::Manager* vfs, const ScriptsConfiguration* conf) : mConf(conf), mVFS(vfs)
+    static bool isCustomAllocatorSupported()
+    {
+        static const bool supported = []
+        {
+            LuaAllocator allocator;
+            lua_State* lua = lua_newstate(&LuaAllocator::allocate, &allocator);
+            if (lua == nullptr)
+                return false;
+            lua_close(lua);
+            return true;
+        }();
+        return supported;
+    }
+
+    static sol::state createState(LuaAllocator& allocator, bool customAllocator)
+    {
+        if (customAllocator)
+            return sol::state(&sol::default_at_panic, &LuaAllocator::allocate, &allocator);
+        Log(Debug::Warning) << "Custom Lua allocators are not supported by " << getLuaVersion()
+                            << ", memory usage of Lua scripts will not be tracked";
+        return sol::state();
+    }
+
+    LuaState::LuaState(const VFS::Manager* vfs, const ScriptsConfiguration* conf)
+        : mMemoryTracked(isCustomAllocatorSupported())
+        , mLua(createState(mAllocator, mMemoryTracked))
+        , mConf(conf)
+        , mVFS(vfs)
+        , mProfiler(mLua.lua_state(), conf)
     {
         mLua.open_libraries(sol::lib::base, sol::lib::coroutine, sol::lib::math,
                             sol::lib::string, sol::lib::table, sol::lib::debug);
@@ -8,6 +8,8 @@
 #include <components/vfs/manager.hpp>
 
 #include "configuration.hpp"
+#include "luaallocator.hpp"
+#include "luaprofiler.hpp"
 
 namespace LuaUtil
 {
@@ -26,6 +28,8 @@ namespace LuaUtil
     //         Lua libraries (only source, no dll's) in the virtual filesystem;
     //   - Make `print` to add the script name to every message and
     //         write to the Log rather than directly to stdout;
+    //   - Track memory usage of every script (see LuaAllocator);
+    //   - Profile scripts (see LuaProfiler).
     class LuaState
     {
     public:
@@ -76,6 +80,15 @@ namespace LuaUtil
 
         const ScriptsConfiguration& getConfiguration() const { return *mConf; }
 
+        // The allocator is used only if the Lua implementation supports custom allocators (LuaJIT on 64-bit
+        // platforms supports it only if built with GC64). Otherwise memory usage is not tracked and not limited.
+        bool isMemoryTracked() const { return mMemoryTracked; }
+        LuaAllocator& getAllocator() { return mAllocator; }
+        const LuaAllocator& getAllocator() const { return mAllocator; }
+
+        LuaProfiler& getProfiler() { return mProfiler; }
+        const LuaProfiler& getProfiler() const { return mProfiler; }
+
     private:
         static sol::protected_function_result throwIfError(sol::protected_function_result&&);
         template <typename... Args>
@@ -83,12 +96,15 @@ namespace LuaUtil
 
         sol::function loadScript(const std::string& path);
 
+        LuaAllocator mAllocator;
+        const bool mMemoryTracked;
         sol::state mLua;
         const ScriptsConfiguration* mConf;
         sol::table mSandboxEnv;
         std::map<std::string, sol::bytecode> mCompiledScripts;
         std::map<std::string, sol::object> mCommonPackages;
         const VFS::Manager* mVFS;
+        LuaProfiler mProfiler;
     };
 
     // Should be used for every call of every Lua function.
@@ -74,6 +74,7 @@ namespace LuaUtil
 
         try
         {
+            HandlerScope scope = handlerScope(scriptId, "start");
             sol::object scriptOutput = mLua.runInNewSandbox(path, mNamePrefix, mAPI, script.mHiddenData);
             if (scriptOutput == sol::nil)
                 return true;
@@ -187,12 +188,20 @@ namespace LuaUtil
         }
         if (prev && script.mOnOverride)
         {
-            try { LuaUtil::call(*script.mOnOverride, *prev->mInterface); }
+            try
+            {
+                HandlerScope scope = handlerScope(scriptId, HANDLER_INTERFACE_OVERRIDE);
+                LuaUtil::call(*script.mOnOverride, *prev->mInterface);
+            }
             catch (std::exception& e) { printError(scriptId, "onInterfaceOverride failed", e); }
         }
         if (next && next->mOnOverride)
         {
-            try { LuaUtil::call(*next->mOnOverride, *script.mInterface); }
+            try
+            {
+                HandlerScope scope = handlerScope(nextId, HANDLER_INTERFACE_OVERRIDE);
+                LuaUtil::call(*next->mOnOverride, *script.mInterface);
+            }
             catch (std::exception& e) { printError(nextId, "onInterfaceOverride failed", e); }
         }
         if (next == nullptr)
@@ -225,7 +234,11 @@ namespace LuaUtil
                 sol::object prevInterface = sol::nil;
                 if (prev)
                     prevInterface = *prev->mInterface;
-                try { LuaUtil::call(*next->mOnOverride, prevInterface); }
+                try
+                {
+                    HandlerScope scope = handlerScope(nextId, HANDLER_INTERFACE_OVERRIDE);
+                    LuaUtil::call(*next->mOnOverride, prevInterface);
+                }
                 catch (std::exception& e) { printError(nextId, "onInterfaceOverride failed", e); }
             }
         }
@@ -255,7 +268,7 @@ namespace LuaUtil
                    list.end());
     }
 
-    void ScriptsContainer::receiveEvent(std::string_view eventName, std::string_view eventData)
+    void ScriptsContainer::receiveEvent(std::string_view eventName, const sol::object& eventData)
     {
         auto it = mEventHandlers.find(eventName);
         if (it == mEventHandlers.end())
@@ -263,22 +276,13 @@ namespace LuaUtil
             Log(Debug::Warning) << mNamePrefix << " has received event '" << eventName << "', but there are no handlers for this event";
             return;
         }
-        sol::object data;
-        try
-        {
-            data = LuaUtil::deserialize(mLua.sol(), eventData, mSerializer);
-        }
-        catch (std::exception& e)
-        {
-            Log(Debug::Error) << mNamePrefix << " can not parse eventData for '" << eventName << "': " << e.what();
-            return;
-        }
         EventHandlerList& list = it->second;
         for (int i = list.size() - 1; i >= 0; --i)
         {
             try
             {
-                sol::object res = LuaUtil::call(list[i].mFn, data);
+                HandlerScope scope = handlerScope(list[i].mScriptId, eventName);
+                sol::object res = LuaUtil::call(list[i].mFn, eventData);
                 if (res != sol::nil && !res.as<bool>())
                     break;  // Skip other handlers if 'false' was returned.
             }
@@ -290,6 +294,21 @@ namespace LuaUtil
         }
     }
 
+    void ScriptsContainer::receiveEvent(std::string_view eventName, std::string_view eventData)
+    {
+        sol::object data;
+        try
+        {
+            data = LuaUtil::deserialize(mLua.sol(), eventData, mSerializer);
+        }
+        catch (std::exception& e)
+        {
+            Log(Debug::Error) << mNamePrefix << " can not parse eventData for '" << eventName << "': " << e.what();
+            return;
+        }
+        receiveEvent(eventName, data);
+    }
+
     void ScriptsContainer::registerEngineHandlers(std::initializer_list<EngineHandlerList*> handlers)
     {
         for (EngineHandlerList* h : handlers)
@@ -300,6 +319,7 @@ namespace LuaUtil
     {
         try
         {
+            HandlerScope scope = handlerScope(scriptId, HANDLER_INIT);
             const std::string& data = mLua.getConfiguration()[scriptId].mInitializationData;
             LuaUtil::call(onInit, deserialize(mLua.sol(), data, mSerializer));
         }
@@ -335,6 +355,7 @@ namespace LuaUtil
             {
                 try
                 {
+                    HandlerScope scope = handlerScope(scriptId, HANDLER_SAVE);
                     sol::object state = LuaUtil::call(*script.mOnSave);
                     savedScript.mData = serialize(state, mSerializer);
                 }
@@ -386,6 +407,7 @@ namespace LuaUtil
             {
                 try
                 {
+                    HandlerScope scope = handlerScope(scriptId, HANDLER_LOAD);
                     sol::object state = deserialize(mLua.sol(), savedScript->mData, mSerializer);
                     sol::object initializationData =
                         deserialize(mLua.sol(), mLua.getConfiguration()[scriptId].mInitializationData, mSerializer);
@@ -495,6 +517,7 @@ namespace LuaUtil
     {
         try
         {
+            HandlerScope scope = handlerScope(t.mScriptId, "timer");
             Script& script = getScript(t.mScriptId);
             if (t.mSerializable)
             {
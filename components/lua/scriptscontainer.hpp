@@ -6,6 +6,7 @@
 #include <string>
 
 #include <components/debug/debuglog.hpp>
+#include <components/debug/frameprofiler.hpp>
 #include <components/esm/luascripts.hpp>
 
 #include "luastate.hpp"
@@ -110,6 +111,9 @@ namespace LuaUtil
         // If several scripts register handlers for `eventName`, they are called in reverse order.
         // If some handler returns `false`, all remaining handlers are ignored. Any other return value
         // (including `nil`) has no effect.
+        void receiveEvent(std::string_view eventName, const sol::object& eventData);
+
+        // Same as above, but deserializes eventData using the serializer of this container first.
         void receiveEvent(std::string_view eventName, std::string_view eventData);
 
         // Serializer defines how to serialize/deserialize userdata. If serializer is not provided,
@@ -146,6 +150,22 @@ namespace LuaUtil
         // because it can not be stored in saves. I.e. loading a saved game will not fully restore the state.
         void setupUnsavableTimer(TimeUnit timeUnit, double time, int scriptId, sol::function callback);
 
+        // Lua memory allocated and time spent while a HandlerScope exists are attributed to the given script and handler.
+        class HandlerScope
+        {
+        public:
+            HandlerScope(LuaState& lua, int scriptId, std::string_view handler)
+                : mActiveScript(lua.getAllocator(), scriptId), mProfile(lua.getProfiler(), scriptId, handler)
+                , mZone(Debug::FrameProfiler::isRunning() ? Debug::FrameProfiler::intern(handler) : nullptr) {}
+
+        private:
+            ActiveScriptScope mActiveScript;
+            ProfilerScope mProfile;
+            Debug::ProfileZone mZone;
+        };
+
+        HandlerScope handlerScope(int scriptId, std::string_view handler) { return HandlerScope(mLua, scriptId, handler); }
+
     protected:
         struct Handler
         {
@@ -168,7 +188,11 @@ namespace LuaUtil
         {
             for (Handler& handler : handlers.mList)
             {
-                try { LuaUtil::call(handler.mFn, args...); }
+                try
+                {
+                    HandlerScope scope = handlerScope(handler.mScriptId, handlers.mName);
+                    LuaUtil::call(handler.mFn, args...);
+                }
                 catch (std::exception& e)
                 {
                     Log(Debug::Error) << mNamePrefix << "[" << scriptPath(handler.mScriptId) << "] "
@@ -253,11 +277,21 @@ namespace LuaUtil
         template <typename... Args>
         void operator()(Args&&... args) const
         {
-            if (mHiddenData[ScriptsContainer::sScriptIdKey] != sol::nil)
-                LuaUtil::call(mFunc, std::forward<Args>(args)...);
-            else
+            sol::object id = mHiddenData[ScriptsContainer::sScriptIdKey];
+            if (id == sol::nil)
+            {
                 Log(Debug::Debug) << "Ignored callback to the removed script "
                                   << mHiddenData.get<std::string>(ScriptsContainer::sScriptDebugNameKey);
+                return;
+            }
+            const ScriptsContainer::ScriptId scriptId = id.as<ScriptsContainer::ScriptId>();
+            if (scriptId.mContainer == nullptr)
+            {
+                LuaUtil::call(mFunc, std::forward<Args>(args)...);
+                return;
+            }
+            ScriptsContainer::HandlerScope scope = scriptId.mContainer->handlerScope(scriptId.mIndex, "callback");
+            LuaUtil::call(mFunc, std::forward<Args>(args)...);
         }
     };
 
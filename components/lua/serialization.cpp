@@ -235,6 +235,39 @@ namespace LuaUtil
         throw std::runtime_error("Unknown type in serialized data: " + std::to_string(type));
     }
 
+    static sol::object copy(lua_State* lua, const sol::object& obj, const UserdataSerializer* customSerializer, int recursionCounter)
+    {
+        if (obj.get_type() == sol::type::lightuserdata)
+            throw std::runtime_error("Light userdata is not allowed to be serialized.");
+        if (obj.is<sol::function>())
+            throw std::runtime_error("Functions are not allowed to be serialized.");
+        else if (obj.is<sol::userdata>())
+        {
+            if (obj.is<osg::Vec2f>() || obj.is<osg::Vec3f>())
+                return obj;  // Vectors are immutable in Lua
+            BinaryData data;
+            serializeUserdata(data, obj, customSerializer);
+            std::string_view binaryData = data;
+            deserializeImpl(lua, binaryData, customSerializer, false);
+            return sol::stack::pop<sol::object>(lua);
+        }
+        else if (obj.is<sol::lua_table>())
+        {
+            if (recursionCounter >= 32)
+                throw std::runtime_error("Can not serialize more than 32 nested tables. Likely the table contains itself.");
+            sol::table table = obj;
+            sol::table res(lua, sol::create);
+            for (auto& [key, value] : table)
+                res.raw_set(copy(lua, key, customSerializer, recursionCounter + 1),
+                            copy(lua, value, customSerializer, recursionCounter + 1));
+            return res;
+        }
+        else if (obj.is<double>() || obj.is<std::string_view>() || obj.is<bool>())
+            return obj;  // Immutable, no need to copy
+        else
+            throw std::runtime_error("Unknown Lua type.");
+    }
+
     BinaryData serialize(const sol::object& obj, const UserdataSerializer* customSerializer)
     {
         if (obj == sol::nil)
@@ -260,4 +293,11 @@ namespace LuaUtil
         return sol::stack::pop<sol::object>(lua);
     }
 
+    sol::object copy(lua_State* lua, const sol::object& obj, const UserdataSerializer* customSerializer)
+    {
+        if (obj == sol::nil)
+            return sol::nil;
+        return copy(lua, obj, customSerializer, 0);
+    }
+
 }
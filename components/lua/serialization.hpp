@@ -30,6 +30,11 @@ namespace LuaUtil
     sol::object deserialize(lua_State* lua, std::string_view binaryData,
                             const UserdataSerializer* customSerializer = nullptr, bool readOnly = false);
 
+    // Same result as `deserialize(lua, serialize(obj, customSerializer), customSerializer)`, but without the intermediate
+    // BinaryData. Tables are copied recursively, immutable values are shared, and custom userdata is recreated by
+    // customSerializer. Throws for values that can not be serialized.
+    sol::object copy(lua_State* lua, const sol::object& obj, const UserdataSerializer* customSerializer = nullptr);
+
 }
 
 #endif // COMPONENTS_LUA_SERIALIZATION_H
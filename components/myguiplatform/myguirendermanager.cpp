@@ -4,6 +4,7 @@
 #include <MyGUI_Timer.h>
 
 #include <osg/Drawable>
+#include <osg/Stats>
 #include <osg/Texture2D>
 #include <osg/TexMat>
 
@@ -83,9 +84,9 @@ public:
             mRenderManager = renderManager;
         }
 
-        void operator()(osg::Node*, osg::NodeVisitor*)
+        void operator()(osg::Node*, osg::NodeVisitor* nv)
         {
-            mRenderManager->collectDrawCalls();
+            mRenderManager->collectDrawCalls(nv->getTraversalNumber());
         }
 
     private:
@@ -111,7 +112,7 @@ public:
         for (std::vector<Batch>::const_iterator it = vec.begin(); it != vec.end(); ++it)
         {
             const Batch& batch = *it;
-            osg::VertexBufferObject *vbo = batch.mVertexBuffer;
+            osg::VertexBufferObject *vbo = mVertexBuffer[mReadFrom];
 
             if (batch.mStateSet)
             {
@@ -143,7 +144,7 @@ public:
                 glTexCoordPointer(2, GL_FLOAT, sizeof(MyGUI::Vertex), (char*)vbo->getArray(0)->getDataPointer() + 16);
             }
 
-            glDrawArrays(GL_TRIANGLES, 0, batch.mVertexCount);
+            glDrawArrays(GL_TRIANGLES, batch.mFirstVertex, batch.mVertexCount);
 
             if (batch.mStateSet)
             {
@@ -189,6 +190,8 @@ public:
         mDummyTexture->setInternalFormat(GL_RGB);
         mDummyTexture->setTextureSize(1,1);
 
+        createVertexBuffers();
+
         // need to flip tex coords since MyGUI uses DirectX convention of top left image origin
         osg::Matrix flipMat;
         flipMat.preMultTranslate(osg::Vec3f(0,1,0));
@@ -203,6 +206,7 @@ public:
         , mReadFrom(0)
         , mDummyTexture(copy.mDummyTexture)
     {
+        createVertexBuffers();
     }
 
     // Defines the necessary information for a draw call
@@ -211,25 +215,53 @@ public:
         // May be empty
         osg::ref_ptr<osg::Texture2D> mTexture;
 
-        osg::ref_ptr<osg::VertexBufferObject> mVertexBuffer;
-        // need to hold on to this too as the mVertexBuffer does not hold a ref to its own array
-        osg::ref_ptr<osg::Array> mArray;
-
         // optional
         osg::ref_ptr<osg::StateSet> mStateSet;
 
+        // Range in the vertex buffer of the frame
+        size_t mFirstVertex;
         size_t mVertexCount;
     };
 
-    void addBatch(const Batch& batch)
+    /// Copies the vertices into the vertex buffer of the frame. Consecutive vertices with the same texture and state
+    /// are drawn by a single draw call.
+    void addVertices(const MyGUI::Vertex* vertices, size_t count, osg::Texture2D* texture, osg::StateSet* stateSet)
     {
-        mBatchVector[mWriteTo].push_back(batch);
+        if (count == 0)
+            return;
+
+        osg::UByteArray& array = *mVertexArray[mWriteTo];
+        const size_t firstVertex = array.size() / sizeof(MyGUI::Vertex);
+        const unsigned char* data = reinterpret_cast<const unsigned char*>(vertices);
+        array.insert(array.end(), data, data + count * sizeof(MyGUI::Vertex));
+
+        std::vector<Batch>& batches = mBatchVector[mWriteTo];
+        if (!batches.empty() && batches.back().mTexture == texture && batches.back().mStateSet == stateSet)
+        {
+            batches.back().mVertexCount += count;
+            return;
+        }
+
+        batches.push_back(Batch {texture, stateSet, firstVertex, count});
     }
 
     void clear()
     {
         mWriteTo = (mWriteTo+1)%sNumBuffers;
         mBatchVector[mWriteTo].clear();
+        mVertexArray[mWriteTo]->clear();
+    }
+
+    // Called after all vertices of the frame are added
+    void finish()
+    {
+        mVertexArray[mWriteTo]->dirty();
+        mVertexBuffer[mWriteTo]->dirty();
+    }
+
+    size_t getDrawCallCount() const
+    {
+        return mBatchVector[mWriteTo].size();
     }
 
     osg::StateSet* getDrawableStateSet()
@@ -240,11 +272,27 @@ public:
     META_Object(osgMyGUI, Drawable)
 
 private:
+    void createVertexBuffers()
+    {
+        for (int i = 0; i < sNumBuffers; ++i)
+        {
+            mVertexArray[i] = new osg::UByteArray;
+            mVertexBuffer[i] = new osg::VertexBufferObject;
+            mVertexBuffer[i]->setDataVariance(osg::Object::DYNAMIC);
+            mVertexBuffer[i]->setUsage(GL_DYNAMIC_DRAW);
+            // NB mVertexBuffer does not own the array
+            mVertexBuffer[i]->setArray(0, mVertexArray[i].get());
+        }
+    }
+
     // 2 would be enough in most cases, use 4 to get stereo working
     static const int sNumBuffers = 4;
 
     // double buffering approach, to avoid the need for synchronization with the draw thread
     std::vector<Batch> mBatchVector[sNumBuffers];
+    // vertices of all batches of the frame
+    osg::ref_ptr<osg::UByteArray> mVertexArray[sNumBuffers];
+    osg::ref_ptr<osg::VertexBufferObject> mVertexBuffer[sNumBuffers];
 
     int mWriteTo;
     mutable int mReadFrom;
@@ -252,27 +300,18 @@ private:
     osg::ref_ptr<osg::Texture2D> mDummyTexture;
 };
 
+// Vertices are copied into the vertex buffer of the frame on render, so the draw thread never reads this buffer.
 class OSGVertexBuffer : public MyGUI::IVertexBuffer
 {
-    osg::ref_ptr<osg::VertexBufferObject> mBuffer[2];
-    osg::ref_ptr<osg::UByteArray> mVertexArray[2];
+    std::vector<MyGUI::Vertex> mVertices;
 
     size_t mNeedVertexCount;
 
-    unsigned int mCurrentBuffer;
-    bool mUsed; // has the mCurrentBuffer been submitted to the rendering thread
-
-    void destroy();
-    osg::UByteArray* create();
-
 public:
     OSGVertexBuffer();
     virtual ~OSGVertexBuffer() {}
 
-    void markUsed();
-
-    osg::Array* getVertexArray();
-    osg::VertexBufferObject* getVertexBuffer();
+    const MyGUI::Vertex* getVertices() const { return mVertices.data(); }
 
     void setVertexCount(size_t count) override;
     size_t getVertexCount() const override;
@@ -284,21 +323,11 @@ public:
 
 OSGVertexBuffer::OSGVertexBuffer()
   : mNeedVertexCount(0)
-  , mCurrentBuffer(0)
-  , mUsed(false)
-{
-}
-
-void OSGVertexBuffer::markUsed()
 {
-    mUsed = true;
 }
 
 void OSGVertexBuffer::setVertexCount(size_t count)
 {
-    if(count == mNeedVertexCount)
-        return;
-
     mNeedVertexCount = count;
 }
 
@@ -309,51 +338,12 @@ size_t OSGVertexBuffer::getVertexCount() const
 
 MyGUI::Vertex *OSGVertexBuffer::lock()
 {
-    if (mUsed)
-    {
-        mCurrentBuffer = (mCurrentBuffer+1)%2;
-        mUsed = false;
-    }
-    osg::UByteArray* array = mVertexArray[mCurrentBuffer];
-    if (!array)
-    {
-        array = create();
-    }
-    else if (array->size() != mNeedVertexCount * sizeof(MyGUI::Vertex))
-    {
-        array->resize(mNeedVertexCount * sizeof(MyGUI::Vertex));
-    }
-
-    return (MyGUI::Vertex*)&(*array)[0];
+    mVertices.resize(mNeedVertexCount);
+    return mVertices.data();
 }
 
 void OSGVertexBuffer::unlock()
 {
-    mVertexArray[mCurrentBuffer]->dirty();
-    mBuffer[mCurrentBuffer]->dirty();
-}
-
-osg::UByteArray* OSGVertexBuffer::create()
-{
-    mVertexArray[mCurrentBuffer] = new osg::UByteArray(mNeedVertexCount*sizeof(MyGUI::Vertex));
-
-    mBuffer[mCurrentBuffer] = new osg::VertexBufferObject;
-    mBuffer[mCurrentBuffer]->setDataVariance(osg::Object::DYNAMIC);
-    mBuffer[mCurrentBuffer]->setUsage(GL_DYNAMIC_DRAW);
-    // NB mBuffer does not own the array
-    mBuffer[mCurrentBuffer]->setArray(0, mVertexArray[mCurrentBuffer].get());
-
-    return mVertexArray[mCurrentBuffer];
-}
-
-osg::Array* OSGVertexBuffer::getVertexArray()
-{
-    return mVertexArray[mCurrentBuffer];
-}
-
-osg::VertexBufferObject* OSGVertexBuffer::getVertexBuffer()
-{
-    return mBuffer[mCurrentBuffer];
 }
 
 // ---------------------------------------------------------------------------
@@ -366,6 +356,7 @@ RenderManager::RenderManager(osgViewer::Viewer *viewer, osg::Group *sceneroot, R
   , mIsInitialise(false)
   , mInvScalingFactor(1.f)
   , mInjectState(nullptr)
+  , mBatchCount(0)
 {
     if (scalingFactor != 0.f)
         mInvScalingFactor = 1.f / scalingFactor;
@@ -449,30 +440,29 @@ void RenderManager::destroyVertexBuffer(MyGUI::IVertexBuffer *buffer)
 void RenderManager::begin()
 {
     mDrawable->clear();
+    mBatchCount = 0;
     // variance will be recomputed based on textures being rendered in this frame
     mDrawable->setDataVariance(osg::Object::STATIC);
 }
 
 void RenderManager::doRender(MyGUI::IVertexBuffer *buffer, MyGUI::ITexture *texture, size_t count)
 {
-    Drawable::Batch batch;
-    batch.mVertexCount = count;
-    batch.mVertexBuffer = static_cast<OSGVertexBuffer*>(buffer)->getVertexBuffer();
-    batch.mArray = static_cast<OSGVertexBuffer*>(buffer)->getVertexArray();
-    static_cast<OSGVertexBuffer*>(buffer)->markUsed();
+    osg::Texture2D* osgTexture = nullptr;
+    osg::StateSet* stateSet = nullptr;
 
     if (OSGTexture* osgtexture = static_cast<OSGTexture*>(texture))
     {
-        batch.mTexture = osgtexture->getTexture();
-        if (batch.mTexture->getDataVariance() == osg::Object::DYNAMIC)
+        osgTexture = osgtexture->getTexture();
+        if (osgTexture->getDataVariance() == osg::Object::DYNAMIC)
             mDrawable->setDataVariance(osg::Object::DYNAMIC); // only for this frame, reset in begin()
         if (!mInjectState && osgtexture->getInjectState())
-            batch.mStateSet = osgtexture->getInjectState();
+            stateSet = osgtexture->getInjectState();
     }
     if (mInjectState)
-        batch.mStateSet = mInjectState;
+        stateSet = mInjectState;
 
-    mDrawable->addBatch(batch);
+    mDrawable->addVertices(static_cast<OSGVertexBuffer*>(buffer)->getVertices(), count, osgTexture, stateSet);
+    ++mBatchCount;
 }
 
 void RenderManager::setInjectState(osg::StateSet* stateSet)
@@ -482,6 +472,7 @@ void RenderManager::setInjectState(osg::StateSet* stateSet)
 
 void RenderManager::end()
 {
+    mDrawable->finish();
 }
 
 void RenderManager::update()
@@ -496,13 +487,20 @@ void RenderManager::update()
     last_time = now_time;
 }
 
-void RenderManager::collectDrawCalls()
+void RenderManager::collectDrawCalls(unsigned int frameNumber)
 {
     begin();
     onRenderToTarget(this, mUpdate);
     end();
 
     mUpdate = false;
+
+    osg::Stats* stats = mViewer->getViewerStats();
+    if (stats->collectStats("resource"))
+    {
+        stats->setAttribute(frameNumber, "GUI Batches", mBatchCount);
+        stats->setAttribute(frameNumber, "GUI DrawCalls", mDrawable->getDrawCallCount());
+    }
 }
 
 void RenderManager::setViewSize(int width, int height)
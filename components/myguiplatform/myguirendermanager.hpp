@@ -56,6 +56,9 @@ class RenderManager : public MyGUI::RenderManager, public MyGUI::IRenderTarget
 
     osg::StateSet* mInjectState;
 
+    // Number of doRender calls in the last frame
+    std::size_t mBatchCount;
+
     void destroyAllResources();
 
 public:
@@ -120,7 +123,7 @@ public:
 
 /*internal:*/
 
-    void collectDrawCalls();
+    void collectDrawCalls(unsigned int frameNumber);
 };
 
 }
@@ -327,6 +327,7 @@ namespace Resource
         , mMaxAnisotropy(1)
         , mUnRefImageDataAfterApply(false)
         , mParticleSystemMask(~0u)
+        , mWorkQueue(nullptr)
     {
     }
 
@@ -340,11 +341,12 @@ namespace Resource
         return mForceShaders;
     }
 
-    void SceneManager::recreateShaders(osg::ref_ptr<osg::Node> node, const std::string& shaderPrefix, bool forceShadersForNode, const osg::Program* programTemplate)
+    void SceneManager::recreateShaders(osg::ref_ptr<osg::Node> node, const std::string& shaderPrefix, bool forceShadersForNode, const osg::Program* programTemplate, bool instancing)
     {
         osg::ref_ptr<Shader::ShaderVisitor> shaderVisitor(createShaderVisitor(shaderPrefix));
         shaderVisitor->setAllowedToModifyStateSets(false);
         shaderVisitor->setProgramTemplate(programTemplate);
+        shaderVisitor->setInstancing(instancing);
         if (forceShadersForNode)
             shaderVisitor->setForceShaders(true);
         node->accept(*shaderVisitor);
@@ -569,23 +571,24 @@ namespace Resource
             if (name.empty())
                 return false;
 
-            static std::vector<std::string> reservedNames;
-            if (reservedNames.empty())
+            // Scenes are optimized by several threads at once.
+            static const std::vector<std::string> reservedNames = []
             {
                 const char* reserved[] = {"Head", "Neck", "Chest", "Groin", "Right Hand", "Left Hand", "Right Wrist", "Left Wrist", "Shield Bone", "Right Forearm", "Left Forearm", "Right Upper Arm",
                                           "Left Upper Arm", "Right Foot", "Left Foot", "Right Ankle", "Left Ankle", "Right Knee", "Left Knee", "Right Upper Leg", "Left Upper Leg", "Right Clavicle",
                                           "Left Clavicle", "Weapon Bone", "Tail", "Bip01", "Root Bone", "BoneOffset", "AttachLight", "Arrow", "Camera", "Collision", "Right_Wrist", "Left_Wrist",
                                           "Shield_Bone", "Right_Forearm", "Left_Forearm", "Right_Upper_Arm", "Left_Clavicle", "Weapon_Bone", "Root_Bone"};
 
-                reservedNames = std::vector<std::string>(reserved, reserved + sizeof(reserved)/sizeof(reserved[0]));
+                std::vector<std::string> result(reserved, reserved + sizeof(reserved)/sizeof(reserved[0]));
 
                 for (unsigned int i=0; i<sizeof(reserved)/sizeof(reserved[0]); ++i)
-                    reservedNames.push_back(std::string("Tri ") + reserved[i]);
+                    result.push_back(std::string("Tri ") + reserved[i]);
 
-                std::sort(reservedNames.begin(), reservedNames.end(), Misc::StringUtils::ciLess);
-            }
+                std::sort(result.begin(), result.end(), Misc::StringUtils::ciLess);
+                return result;
+            }();
 
-            std::vector<std::string>::iterator it = Misc::partialBinarySearch(reservedNames.begin(), reservedNames.end(), name);
+            std::vector<std::string>::const_iterator it = Misc::partialBinarySearch(reservedNames.begin(), reservedNames.end(), name);
             return it != reservedNames.end();
         }
 
@@ -711,6 +714,7 @@ namespace Resource
             {
                 SceneUtil::Optimizer optimizer;
                 optimizer.setSharedStateManager(mSharedStateManager, &mSharedStateMutex);
+                optimizer.setWorkQueue(mWorkQueue);
                 optimizer.setIsOperationPermissibleForObjectCallback(new CanOptimizeCallback);
 
                 static const unsigned int options = getOptimizationOptions()|SceneUtil::Optimizer::SHARE_DUPLICATE_STATE;
@@ -865,6 +869,11 @@ namespace Resource
         mUnRefImageDataAfterApply = unref;
     }
 
+    void SceneManager::setWorkQueue(SceneUtil::WorkQueue* workQueue)
+    {
+        mWorkQueue = workQueue;
+    }
+
     void SceneManager::updateCache(double referenceTime)
     {
         ResourceManager::updateCache(referenceTime);
@@ -915,6 +924,8 @@ namespace Resource
         }
 
         stats->setAttribute(frameNumber, "Node", mCache->getCacheSize());
+
+        SceneUtil::Optimizer::reportStats(frameNumber, stats);
     }
 
     Shader::ShaderVisitor *SceneManager::createShaderVisitor(const std::string& shaderPrefix)
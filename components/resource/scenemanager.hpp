@@ -38,6 +38,11 @@ namespace Shader
     class ShaderVisitor;
 }
 
+namespace SceneUtil
+{
+    class WorkQueue;
+}
+
 namespace Resource
 {
     class TemplateRef : public osg::Object
@@ -77,7 +82,8 @@ namespace Resource
         Shader::ShaderManager& getShaderManager();
 
         /// Re-create shaders for this node, need to call this if alpha testing, texture stages or vertex color mode have changed.
-        void recreateShaders(osg::ref_ptr<osg::Node> node, const std::string& shaderPrefix = "objects", bool forceShadersForNode = false, const osg::Program* programTemplate = nullptr);
+        /// @param instancing The node is drawn with per-instance transforms in vertex attributes (see ObjectPaging).
+        void recreateShaders(osg::ref_ptr<osg::Node> node, const std::string& shaderPrefix = "objects", bool forceShadersForNode = false, const osg::Program* programTemplate = nullptr, bool instancing = false);
 
         /// Applying shaders to a node may replace some fixed-function state.
         /// This restores it.
@@ -188,6 +194,11 @@ namespace Resource
         /// otherwise should be disabled to reduce memory usage.
         void setUnRefImageDataAfterApply(bool unref);
 
+        /// Use the work queue to optimize loaded scenes in parallel. The work queue must outlive the SceneManager or be reset.
+        void setWorkQueue(SceneUtil::WorkQueue* workQueue);
+
+        SceneUtil::WorkQueue* getWorkQueue() const { return mWorkQueue; }
+
         /// @see ResourceManager::updateCache
         void updateCache(double referenceTime) override;
 
@@ -229,6 +240,8 @@ namespace Resource
 
         unsigned int mParticleSystemMask;
 
+        SceneUtil::WorkQueue* mWorkQueue;
+
         SceneManager(const SceneManager&);
         void operator = (const SceneManager&);
     };
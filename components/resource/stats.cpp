@@ -384,10 +384,22 @@ void StatsHandler::setUpScene(osgViewer::ViewerBase *viewer)
             "",
             "Groundcover Chunk",
             "Object Chunk",
+            "Object Chunk BuildTime",
+            "Object Chunk Instances",
+            "Object Chunk SavedMemory",
             "Terrain Chunk",
             "Terrain Texture",
             "Land",
             "Composite",
+            "Chunk Prefetch HitRate",
+            "Terrain Preload Positions",
+            "Terrain Preload Cancelled",
+            "",
+            "Optimizer Flatten",
+            "Optimizer ShareState",
+            "Optimizer RemoveNodes",
+            "Optimizer Merge",
+            "Optimizer VertexOrder",
             "",
             "NavMesh Jobs",
             "NavMesh Waiting",
@@ -399,6 +411,8 @@ void StatsHandler::setUpScene(osgViewer::ViewerBase *viewer)
             "NavMesh UsedTiles",
             "NavMesh CachedTiles",
             "NavMesh CacheHitRate",
+            "NavMesh PathCacheSize",
+            "NavMesh PathCacheHitRate",
             "",
             "Mechanics Actors",
             "Mechanics Objects",
@@ -407,6 +421,15 @@ void StatsHandler::setUpScene(osgViewer::ViewerBase *viewer)
             "Physics Objects",
             "Physics Projectiles",
             "Physics HeightFields",
+            "",
+            "Lua UsedMemory",
+            "Lua PoolMemory",
+            "Lua PoolUsage",
+            "Lua PoolAllocRate",
+            "Lua FailedAllocs",
+            "",
+            "GUI Batches",
+            "GUI DrawCalls",
         });
 
         static const auto longest = std::max_element(statNames.begin(), statNames.end(),
@@ -29,6 +29,7 @@
 #include <osg/Timer>
 #include <osg/io_utils>
 #include <osg/Depth>
+#include <osg/Stats>
 
 #include <osgDB/SharedStateManager>
 
@@ -38,17 +39,74 @@
 
 #include <typeinfo>
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
 #include <numeric>
 
 #include <iterator>
 
+#include <components/debug/frameprofiler.hpp>
 #include <components/sceneutil/depth.hpp>
+#include <components/sceneutil/workqueue.hpp>
 
 using namespace osgUtil;
 
 namespace SceneUtil
 {
 
+namespace
+{
+    enum Pass
+    {
+        Pass_FlattenStaticTransforms,
+        Pass_ShareDuplicateState,
+        Pass_RemoveRedundantNodes,
+        Pass_MergeGeometry,
+        Pass_VertexOrder,
+        Pass_Count
+    };
+
+    const std::array<const char*, Pass_Count> passNames {
+        "Optimizer Flatten",
+        "Optimizer ShareState",
+        "Optimizer RemoveNodes",
+        "Optimizer Merge",
+        "Optimizer VertexOrder",
+    };
+
+    // Time in microseconds spent in each pass by all optimizers since the stats were last reported.
+    std::array<std::atomic<std::uint64_t>, Pass_Count> passTimes {};
+
+    class PassTimer
+    {
+    public:
+        explicit PassTimer(Pass pass)
+            : mPass(pass)
+            , mZone(passNames[pass])
+            , mStart(std::chrono::steady_clock::now())
+        {}
+
+        ~PassTimer()
+        {
+            const auto duration = std::chrono::steady_clock::now() - mStart;
+            passTimes[mPass] += std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+        }
+
+    private:
+        const Pass mPass;
+        const Debug::ProfileZone mZone;
+        const std::chrono::steady_clock::time_point mStart;
+    };
+}
+
+void Optimizer::reportStats(unsigned int frameNumber, osg::Stats* stats)
+{
+    for (std::size_t i = 0; i < Pass_Count; ++i)
+        stats->setAttribute(frameNumber, passNames[i], passTimes[i].exchange(0, std::memory_order_relaxed) / 1000.0);
+}
+
 void Optimizer::reset()
 {
 }
@@ -68,6 +126,7 @@ void Optimizer::optimize(osg::Node* node, unsigned int options)
     if (options & FLATTEN_STATIC_TRANSFORMS)
     {
         OSG_INFO<<"Optimizer::optimize() doing FLATTEN_STATIC_TRANSFORMS"<<std::endl;
+        PassTimer timer(Pass_FlattenStaticTransforms);
 
         int i=0;
         bool result = false;
@@ -88,6 +147,7 @@ void Optimizer::optimize(osg::Node* node, unsigned int options)
 
     if (options & SHARE_DUPLICATE_STATE && _sharedStateManager)
     {
+        PassTimer timer(Pass_ShareDuplicateState);
         if (_sharedStateMutex) _sharedStateMutex->lock();
         _sharedStateManager->share(node);
         if (_sharedStateMutex) _sharedStateMutex->unlock();
@@ -96,6 +156,7 @@ void Optimizer::optimize(osg::Node* node, unsigned int options)
     if (options & REMOVE_REDUNDANT_NODES)
     {
         OSG_INFO<<"Optimizer::optimize() doing REMOVE_REDUNDANT_NODES"<<std::endl;
+        PassTimer timer(Pass_RemoveRedundantNodes);
 
         RemoveEmptyNodesVisitor renv(this);
         node->accept(renv);
@@ -112,6 +173,7 @@ void Optimizer::optimize(osg::Node* node, unsigned int options)
     if (options & MERGE_GEOMETRY)
     {
         OSG_INFO<<"Optimizer::optimize() doing MERGE_GEOMETRY"<<std::endl;
+        PassTimer timer(Pass_MergeGeometry);
 
         osg::Timer_t startTick = osg::Timer::instance()->tick();
 
@@ -119,6 +181,7 @@ void Optimizer::optimize(osg::Node* node, unsigned int options)
         mgv.setTargetMaximumNumberOfVertices(1000000);
         mgv.setMergeAlphaBlending(_mergeAlphaBlending);
         mgv.setViewPoint(_viewPoint);
+        mgv.setWorkQueue(_workQueue);
         node->accept(mgv);
 
         osg::Timer_t endTick = osg::Timer::instance()->tick();
@@ -129,6 +192,7 @@ void Optimizer::optimize(osg::Node* node, unsigned int options)
     if (options & VERTEX_POSTTRANSFORM)
     {
         OSG_INFO<<"Optimizer::optimize() doing VERTEX_POSTTRANSFORM"<<std::endl;
+        PassTimer timer(Pass_VertexOrder);
         VertexCacheVisitor vcv;
         node->accept(vcv);
         vcv.optimizeVertices();
@@ -137,6 +201,7 @@ void Optimizer::optimize(osg::Node* node, unsigned int options)
     if (options & VERTEX_PRETRANSFORM)
     {
         OSG_INFO<<"Optimizer::optimize() doing VERTEX_PRETRANSFORM"<<std::endl;
+        PassTimer timer(Pass_VertexOrder);
         VertexAccessOrderVisitor vaov;
         node->accept(vaov);
         vaov.optimizeOrder();
@@ -1169,6 +1234,15 @@ void Optimizer::MergeGeometryVisitor::checkAlphaBlendingActive()
     _alphaBlendingActive = renderingHint == osg::StateSet::TRANSPARENT_BIN;
 }
 
+void Optimizer::MergeGeometryVisitor::inheritState(const MergeGeometryVisitor& parent)
+{
+    _targetMaximumNumberOfVertices = parent._targetMaximumNumberOfVertices;
+    _mergeAlphaBlending = parent._mergeAlphaBlending;
+    _viewPoint = parent._viewPoint;
+    _stateSetStack = parent._stateSetStack;
+    checkAlphaBlendingActive();
+}
+
 void Optimizer::MergeGeometryVisitor::apply(osg::Group &group)
 {
     bool pushed = pushStateSet(group.getStateSet());
@@ -1176,12 +1250,119 @@ void Optimizer::MergeGeometryVisitor::apply(osg::Group &group)
     if (!_alphaBlendingActive || _mergeAlphaBlending)
         mergeGroup(group);
 
-    traverse(group);
+    if (_workQueue)
+        traverseInParallel(group);
+    else
+        traverse(group);
 
     if (pushed)
         popStateSet();
 }
 
+namespace
+{
+    // Subgraphs with fewer drawables are not worth a work item.
+    const unsigned int minDrawablesToMergeInParallel = 32;
+
+    class CountDrawablesVisitor : public osg::NodeVisitor
+    {
+    public:
+        CountDrawablesVisitor() : osg::NodeVisitor(osg::NodeVisitor::TRAVERSE_ALL_CHILDREN) {}
+
+        void apply(osg::Node& node) override
+        {
+            // A node with several parents may be reached from another subgraph on another thread.
+            if (node.getNumParents() > 1)
+                _shared = true;
+            if (node.asDrawable())
+                ++_numDrawables;
+            traverse(node);
+        }
+
+        bool _shared = false;
+        unsigned int _numDrawables = 0;
+    };
+
+    class MergeGeometryWorkItem : public WorkItem
+    {
+    public:
+        MergeGeometryWorkItem(Optimizer* optimizer, const Optimizer::MergeGeometryVisitor& parent, osg::Node* node)
+            : _visitor(optimizer)
+            , _node(node)
+        {
+            _visitor.inheritState(parent);
+        }
+
+        const char* getProfileName() const override { return "MergeGeometryWorkItem"; }
+
+        void doWork() override { run(); }
+
+        /// Returns false if another thread has already taken the item.
+        bool run()
+        {
+            if (_taken.exchange(true))
+                return false;
+            _node->accept(_visitor);
+            return true;
+        }
+
+    private:
+        std::atomic_bool _taken {false};
+        Optimizer::MergeGeometryVisitor _visitor;
+        osg::ref_ptr<osg::Node> _node;
+    };
+}
+
+void Optimizer::MergeGeometryVisitor::traverseInParallel(osg::Group& group)
+{
+    // Only the children of the top level group are merged in parallel, the rest of the graph is traversed as usual.
+    WorkQueue* const workQueue = _workQueue;
+    _workQueue = nullptr;
+
+    std::vector<unsigned int> numDrawables(group.getNumChildren());
+    unsigned int numLargeChildren = 0;
+    for (unsigned int i = 0; i < group.getNumChildren(); ++i)
+    {
+        CountDrawablesVisitor countDrawables;
+        group.getChild(i)->accept(countDrawables);
+        if (countDrawables._shared)
+        {
+            traverse(group);
+            return;
+        }
+        numDrawables[i] = countDrawables._numDrawables;
+        if (numDrawables[i] >= minDrawablesToMergeInParallel)
+            ++numLargeChildren;
+    }
+
+    if (numLargeChildren < 2)
+    {
+        traverse(group);
+        return;
+    }
+
+    std::vector<osg::ref_ptr<MergeGeometryWorkItem>> items;
+    for (unsigned int i = 0; i < group.getNumChildren(); ++i)
+    {
+        if (numDrawables[i] < minDrawablesToMergeInParallel)
+            continue;
+        items.emplace_back(new MergeGeometryWorkItem(_optimizer, *this, group.getChild(i)));
+        workQueue->addWorkItem(items.back());
+    }
+
+    for (unsigned int i = 0; i < group.getNumChildren(); ++i)
+        if (numDrawables[i] < minDrawablesToMergeInParallel)
+            group.getChild(i)->accept(*this);
+
+    // Take part in the work instead of only waiting for it, the work queue may be busy or this may be one of its threads.
+    std::vector<MergeGeometryWorkItem*> takenByOthers;
+    for (const auto& item : items)
+        if (!item->run())
+            takenByOthers.push_back(item.get());
+    for (MergeGeometryWorkItem* item : takenByOthers)
+        item->waitTillDone();
+}
+
 osg::PrimitiveSet* clonePrimitive(osg::PrimitiveSet* ps, osg::ElementBufferObject*& ebo, const osg::Geometry* geom)
 {
     if (ps->referenceCount() <= 1)
@@ -1206,6 +1387,50 @@ bool containsSharedPrimitives(const osg::Geometry* geom)
     return false;
 }
 
+unsigned int getNumElements(const osg::Array* array)
+{
+    return array ? array->getNumElements() : 0;
+}
+
+// Reserve the arrays of lhs for the vertices of all the geometries merged into it at once instead of growing them on every merge.
+void reserveMergedArrays(osg::Geometry& lhs, const std::vector<osg::ref_ptr<osg::Geometry>>& geometries)
+{
+    osg::VertexBufferObject* vbo = nullptr;
+    const auto reserve = [&] (osg::Array* array, auto&& getArray) -> osg::Array*
+    {
+        unsigned int total = 0;
+        for (const osg::ref_ptr<osg::Geometry>& geometry : geometries)
+            total += getNumElements(getArray(*geometry));
+        if (total <= array->getNumElements())
+            return array;
+        if (array->referenceCount() > 1)
+            array = cloneArray(array, vbo, &lhs);
+        array->reserveArray(total);
+        return array;
+    };
+    const auto isMerged = [] (const osg::Array* array)
+    {
+        return array && array->getBinding() != osg::Array::BIND_OVERALL;
+    };
+
+    if (lhs.getVertexArray())
+        lhs.setVertexArray(reserve(lhs.getVertexArray(), [] (const osg::Geometry& g) { return g.getVertexArray(); }));
+    if (isMerged(lhs.getNormalArray()))
+        lhs.setNormalArray(reserve(lhs.getNormalArray(), [] (const osg::Geometry& g) { return g.getNormalArray(); }));
+    if (isMerged(lhs.getColorArray()))
+        lhs.setColorArray(reserve(lhs.getColorArray(), [] (const osg::Geometry& g) { return g.getColorArray(); }));
+    if (isMerged(lhs.getSecondaryColorArray()))
+        lhs.setSecondaryColorArray(reserve(lhs.getSecondaryColorArray(), [] (const osg::Geometry& g) { return g.getSecondaryColorArray(); }));
+    if (isMerged(lhs.getFogCoordArray()))
+        lhs.setFogCoordArray(reserve(lhs.getFogCoordArray(), [] (const osg::Geometry& g) { return g.getFogCoordArray(); }));
+    for (unsigned int unit = 0; unit < lhs.getNumTexCoordArrays(); ++unit)
+        if (lhs.getTexCoordArray(unit))
+            lhs.setTexCoordArray(unit, reserve(lhs.getTexCoordArray(unit), [&] (const osg::Geometry& g) { return g.getTexCoordArray(unit); }));
+    for (unsigned int unit = 0; unit < lhs.getNumVertexAttribArrays(); ++unit)
+        if (lhs.getVertexAttribArray(unit))
+            lhs.setVertexAttribArray(unit, reserve(lhs.getVertexAttribArray(unit), [&] (const osg::Geometry& g) { return g.getVertexAttribArray(unit); }));
+}
+
 bool Optimizer::MergeGeometryVisitor::mergeGroup(osg::Group& group)
 {
     if (!isOperationPermissibleForObject(&group)) return false;
@@ -1372,6 +1597,8 @@ bool Optimizer::MergeGeometryVisitor::mergeGroup(osg::Group& group)
                     DuplicateList::iterator ditr = duplicateList.begin();
                     osg::ref_ptr<osg::Geometry> lhs = *ditr++;
                     group.addChild(lhs.get());
+                    if (ditr != duplicateList.end())
+                        reserveMergedArrays(*lhs, duplicateList);
                     for(;
                         ditr != duplicateList.end();
                         ++ditr)
@@ -27,6 +27,11 @@
 #include <set>
 #include <mutex>
 
+namespace osg
+{
+    class Stats;
+}
+
 namespace osgDB
 {
     class SharedStateManager;
@@ -37,6 +42,7 @@ namespace SceneUtil {
 
 // forward declare
 class Optimizer;
+class WorkQueue;
 
 /** Helper base class for implementing Optimizer techniques.*/
 class BaseOptimizerVisitor : public osg::NodeVisitor
@@ -71,7 +77,7 @@ class Optimizer
 
     public:
 
-        Optimizer() : _mergeAlphaBlending(false), _sharedStateManager(nullptr), _sharedStateMutex(nullptr) {}
+        Optimizer() : _mergeAlphaBlending(false), _sharedStateManager(nullptr), _sharedStateMutex(nullptr), _workQueue(nullptr) {}
         virtual ~Optimizer() {}
 
         enum OptimizationOptions
@@ -129,6 +135,13 @@ class Optimizer
 
         void setSharedStateManager(osgDB::SharedStateManager* sharedStateManager, std::mutex* sharedStateMutex) { _sharedStateMutex = sharedStateMutex; _sharedStateManager = sharedStateManager; }
 
+        /** Merge geometry of the top level subgraphs that don't share nodes on the work queue. The calling thread takes part
+          * in the work, so the optimizer can be used from a work queue thread as well.*/
+        void setWorkQueue(WorkQueue* workQueue) { _workQueue = workQueue; }
+
+        /** Report the time all optimizers have spent in every optimization pass since the previous call, meant to be called once per frame.*/
+        static void reportStats(unsigned int frameNumber, osg::Stats* stats);
+
         /** Reset internal data to initial state - the getPermissibleOptionsMap is cleared.*/
         void reset();
 
@@ -269,6 +282,8 @@ class Optimizer
         osgDB::SharedStateManager* _sharedStateManager;
         mutable std::mutex* _sharedStateMutex;
 
+        WorkQueue* _workQueue;
+
     public:
 
         /** Flatten Static Transform nodes by applying their transform to the
@@ -394,7 +409,16 @@ class Optimizer
                 /// default to traversing all children.
                 MergeGeometryVisitor(Optimizer* optimizer=0) :
                     BaseOptimizerVisitor(optimizer, MERGE_GEOMETRY),
-                    _targetMaximumNumberOfVertices(10000), _alphaBlendingActive(false), _mergeAlphaBlending(false) {}
+                    _targetMaximumNumberOfVertices(10000), _alphaBlendingActive(false), _mergeAlphaBlending(false), _workQueue(nullptr) {}
+
+                /// Children of the first visited group are merged in parallel on the work queue if they don't share nodes.
+                void setWorkQueue(WorkQueue* workQueue)
+                {
+                    _workQueue = workQueue;
+                }
+
+                /// Copy the settings and the state of the traversal, used to continue it for a subgraph on another thread.
+                void inheritState(const MergeGeometryVisitor& parent);
 
                 void setMergeAlphaBlending(bool merge)
                 {
@@ -424,6 +448,8 @@ class Optimizer
 
                 bool mergeGroup(osg::Group& group);
 
+                void traverseInParallel(osg::Group& group);
+
                 static bool mergeGeometry(osg::Geometry& lhs,osg::Geometry& rhs);
 
                 static bool mergePrimitive(osg::DrawArrays& lhs,osg::DrawArrays& rhs);
@@ -439,6 +465,7 @@ class Optimizer
                 bool _alphaBlendingActive;
                 bool _mergeAlphaBlending;
                 osg::Vec3f _viewPoint;
+                WorkQueue* _workQueue;
         };
 
 };
@@ -31,6 +31,8 @@ namespace
                 assert(mImpl != nullptr);
             }
 
+            const char* getProfileName() const override { return "ScreenCaptureWorkItem"; }
+
             void doWork() override
             {
                 if (mAborted)
@@ -99,6 +99,10 @@ StateGraph* ShadowsBin::cullStateGraph(StateGraph* sg, StateGraph* root, std::un
             accumulateState(state.mAlphaFunc, static_cast<osg::AlphaFunc*>(rap.first.get()), state.mAlphaFuncOverride, rap.second);
         }
 
+        // Instanced geometry needs its per-instance state
+        if (ss->getUniformList().count("useInstancing"))
+            state.mImportantState = true;
+
         if (!cullFaceOverridden)
         {
             // osg::FrontFace specifies triangle winding, not front-face culling. We can't safely reparent anything under it unless GL_CULL_FACE is off or we flip face culling.
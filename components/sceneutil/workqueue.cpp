@@ -1,6 +1,7 @@
 #include "workqueue.hpp"
 
 #include <components/debug/debuglog.hpp>
+#include <components/debug/frameprofiler.hpp>
 
 #include <numeric>
 
@@ -19,6 +20,15 @@ void WorkItem::waitTillDone()
     }
 }
 
+bool WorkItem::waitTillDone(std::chrono::steady_clock::duration timeout)
+{
+    if (mDone)
+        return true;
+
+    std::unique_lock<std::mutex> lock(mMutex);
+    return mCondition.wait_for(lock, timeout, [&] { return mDone.load(); });
+}
+
 void WorkItem::signalDone()
 {
     {
@@ -125,13 +135,17 @@ WorkThread::~WorkThread()
 
 void WorkThread::run()
 {
+    Debug::FrameProfiler::setThreadName("WorkQueue");
     while (true)
     {
         osg::ref_ptr<WorkItem> item = mWorkQueue->removeWorkItem();
         if (!item)
             return;
         mActive = true;
-        item->doWork();
+        {
+            const Debug::ProfileZone zone(item->getProfileName());
+            item->doWork();
+        }
         item->signalDone();
         mActive = false;
     }
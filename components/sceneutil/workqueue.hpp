@@ -5,6 +5,7 @@
 #include <osg/ref_ptr>
 
 #include <atomic>
+#include <chrono>
 #include <queue>
 #include <thread>
 #include <mutex>
@@ -19,11 +20,17 @@ namespace SceneUtil
         /// Override in a derived WorkItem to perform actual work.
         virtual void doWork() {}
 
+        /// Name of the zone that shows the work in the frame profiler trace. Must be a string literal.
+        virtual const char* getProfileName() const { return "WorkItem"; }
+
         bool isDone() const;
 
         /// Wait until the work is completed. Usually called from the main thread.
         void waitTillDone();
 
+        /// Wait until the work is completed or the timeout expires. Returns true if the work is completed.
+        bool waitTillDone(std::chrono::steady_clock::duration timeout);
+
         /// Internal use by the WorkQueue.
         void signalDone();
 
@@ -21,6 +21,11 @@ namespace Shader
 
         ShaderManager();
 
+        /// Location of the first of the three vertex attributes holding the per-instance transform of instanced objects.
+        /// Some drivers alias generic attributes 8 to 15 with texture coordinates 0 to 7, so the attributes overlap with
+        /// texture units 4 to 6, which Morrowind meshes don't use, and not with the attributes used by groundcover.
+        static constexpr unsigned int sInstanceTransformAttribLocation = 12;
+
         void setShaderPath(const std::string& path);
 
         typedef std::map<std::string, std::string> DefineMap;
@@ -114,6 +114,7 @@ namespace Shader
         , mAutoUseSpecularMaps(false)
         , mApplyLightingToEnvMaps(false)
         , mConvertAlphaTestToAlphaToCoverage(false)
+        , mInstancing(false)
         , mShaderManager(shaderManager)
         , mImageManager(imageManager)
         , mDefaultShaderPrefix(defaultShaderPrefix)
@@ -577,6 +578,7 @@ namespace Shader
         }
 
         defineMap["softParticles"] = softParticles ? "1" : "0";
+        defineMap["instancing"] = mInstancing ? "1" : "0";
 
         std::string shaderPrefix;
         if (!node.getUserValue("shaderPrefix", shaderPrefix))
@@ -793,6 +795,11 @@ namespace Shader
         mConvertAlphaTestToAlphaToCoverage = convert;
     }
 
+    void ShaderVisitor::setInstancing(bool instancing)
+    {
+        mInstancing = instancing;
+    }
+
     void ShaderVisitor::setOpaqueDepthTex(osg::ref_ptr<osg::Texture2D> texture)
     {
         mOpaqueDepthTex = texture;
@@ -46,6 +46,10 @@ namespace Shader
 
         void setConvertAlphaTestToAlphaToCoverage(bool convert);
 
+        /// Geometries in the graph are drawn with instancing; per-instance transforms are passed in the vertex attributes
+        /// starting at ShaderManager::sInstanceTransformAttribLocation.
+        void setInstancing(bool instancing);
+
         void setOpaqueDepthTex(osg::ref_ptr<osg::Texture2D> texture);
 
         void apply(osg::Node& node) override;
@@ -73,6 +77,8 @@ namespace Shader
 
         bool mConvertAlphaTestToAlphaToCoverage;
 
+        bool mInstancing;
+
         ShaderManager& mShaderManager;
         Resource::ImageManager& mImageManager;
 
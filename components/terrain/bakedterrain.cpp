@@ -0,0 +1,323 @@
+#include "bakedterrain.hpp"
+
+#include <osgDB/Registry>
+
+#include <components/debug/debuglog.hpp>
+#include <components/files/memorystream.hpp>
+#include <components/misc/stringops.hpp>
+
+#include <boost/filesystem/operations.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+#include <type_traits>
+
+namespace Terrain
+{
+    namespace
+    {
+        constexpr char magic[8] = {'O', 'M', 'W', 'T', 'B', 'A', 'K', 'E'};
+
+        // Height, normal with 8 bits per component and colour
+        constexpr std::size_t vertexSize = sizeof(float) + 3 + 4;
+
+        template <class T>
+        void writeValue(std::string& out, const T& value)
+        {
+            static_assert(std::is_trivially_copyable_v<T>);
+            out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+        }
+
+        template <class T>
+        bool readValue(std::istream& stream, T& value)
+        {
+            static_assert(std::is_trivially_copyable_v<T>);
+            return static_cast<bool>(stream.read(reinterpret_cast<char*>(&value), sizeof(T)));
+        }
+
+        template <class T>
+        T readValue(const char*& data)
+        {
+            T value;
+            std::memcpy(&value, data, sizeof(T));
+            data += sizeof(T);
+            return value;
+        }
+
+        std::int8_t packNormal(float value)
+        {
+            return static_cast<std::int8_t>(std::lround(std::clamp(value, -1.f, 1.f) * 127.f));
+        }
+
+        osgDB::ReaderWriter* getPngReaderWriter()
+        {
+            osgDB::ReaderWriter* readerWriter = osgDB::Registry::instance()->getReaderWriterForExtension("png");
+            if (!readerWriter)
+                Log(Debug::Error) << "Error: Unable to process baked terrain composite maps, can't find a png ReaderWriter";
+            return readerWriter;
+        }
+    }
+
+    std::string BakedTerrain::makeContentKey(const std::vector<boost::filesystem::path>& contentFiles)
+    {
+        std::ostringstream key;
+        for (const boost::filesystem::path& path : contentFiles)
+        {
+            key << Misc::StringUtils::lowerCase(path.filename().string()) << ':';
+            boost::system::error_code ec;
+            const auto size = boost::filesystem::file_size(path, ec);
+            key << (ec ? 0 : size) << ':';
+            const auto time = boost::filesystem::last_write_time(path, ec);
+            key << (ec ? 0 : time) << ';';
+        }
+        return key.str();
+    }
+
+    std::unique_ptr<BakedTerrain> BakedTerrain::load(const boost::filesystem::path& path, const std::string& contentKey)
+    {
+        std::unique_ptr<BakedTerrain> result(new BakedTerrain);
+        result->mFile.open(path.string(), std::ios::binary);
+        if (!result->mFile.is_open())
+        {
+            Log(Debug::Info) << "Baked terrain " << path << " is not found";
+            return nullptr;
+        }
+
+        std::ifstream& file = result->mFile;
+        char fileMagic[sizeof(magic)];
+        std::uint32_t version = 0;
+        if (!file.read(fileMagic, sizeof(fileMagic)) || std::memcmp(fileMagic, magic, sizeof(magic)) != 0
+                || !readValue(file, version) || version != sVersion)
+        {
+            Log(Debug::Warning) << "Baked terrain " << path << " has unsupported format, bake it again with the terrainbaketool";
+            return nullptr;
+        }
+
+        std::uint32_t keySize = 0;
+        if (!readValue(file, result->mCellWorldSize) || !readValue(file, result->mCompositeMapSize) || !readValue(file, keySize))
+        {
+            Log(Debug::Warning) << "Baked terrain " << path << " is corrupted";
+            return nullptr;
+        }
+        std::string key(keySize, '\0');
+        if (!file.read(key.data(), keySize) || key != contentKey)
+        {
+            Log(Debug::Warning) << "Baked terrain " << path << " is made for other content files, bake it again with the terrainbaketool";
+            return nullptr;
+        }
+
+        std::uint64_t indexOffset = 0;
+        std::uint32_t verticesCount = 0;
+        std::uint32_t compositeMapsCount = 0;
+        bool valid = file.seekg(-static_cast<std::streamoff>(sizeof(indexOffset)), std::ios::end)
+            && readValue(file, indexOffset)
+            && file.seekg(static_cast<std::streamoff>(indexOffset))
+            && readValue(file, verticesCount);
+        for (std::uint32_t i = 0; valid && i < verticesCount; ++i)
+        {
+            float size;
+            osg::Vec2f center;
+            std::uint32_t lod;
+            Blob blob;
+            valid = readValue(file, size) && readValue(file, center) && readValue(file, lod)
+                && readValue(file, blob.mOffset) && readValue(file, blob.mSize);
+            result->mVertices.emplace(VerticesKey(size, center, lod), blob);
+        }
+        valid = valid && readValue(file, compositeMapsCount);
+        for (std::uint32_t i = 0; valid && i < compositeMapsCount; ++i)
+        {
+            float size;
+            osg::Vec2f center;
+            Blob blob;
+            valid = readValue(file, size) && readValue(file, center)
+                && readValue(file, blob.mOffset) && readValue(file, blob.mSize);
+            result->mCompositeMaps.emplace(CompositeMapKey(size, center), blob);
+        }
+
+        if (!valid)
+        {
+            Log(Debug::Warning) << "Baked terrain " << path << " is corrupted";
+            return nullptr;
+        }
+
+        Log(Debug::Info) << "Loaded baked terrain " << path << " with " << result->mVertices.size()
+                         << " chunk vertex buffers and " << result->mCompositeMaps.size() << " composite maps";
+
+        return result;
+    }
+
+    bool BakedTerrain::read(const Blob& blob, std::vector<char>& data) const
+    {
+        data.resize(blob.mSize);
+        std::lock_guard<std::mutex> lock(mMutex);
+        mFile.clear();
+        return mFile.seekg(static_cast<std::streamoff>(blob.mOffset))
+            && mFile.read(data.data(), static_cast<std::streamsize>(blob.mSize));
+    }
+
+    bool BakedTerrain::getVertices(float size, const osg::Vec2f& center, unsigned int lod, osg::Vec3Array& positions,
+                                   osg::Vec3Array& normals, osg::Vec4ubArray& colours) const
+    {
+        const auto it = mVertices.find(VerticesKey(size, center, lod));
+        if (it == mVertices.end())
+            return false;
+
+        std::vector<char> data;
+        if (!read(it->second, data) || data.size() < sizeof(std::uint32_t))
+            return false;
+
+        const char* ptr = data.data();
+        const std::size_t numVerts = readValue<std::uint32_t>(ptr);
+        if (numVerts < 2 || data.size() != sizeof(std::uint32_t) + numVerts * numVerts * vertexSize)
+            return false;
+
+        positions.resize(numVerts * numVerts);
+        normals.resize(numVerts * numVerts);
+        colours.resize(numVerts * numVerts);
+
+        // Vertices are stored in the same order as Storage::fillVertexBuffers puts them.
+        std::size_t index = 0;
+        for (std::size_t vertX = 0; vertX < numVerts; ++vertX)
+        {
+            for (std::size_t vertY = 0; vertY < numVerts; ++vertY)
+            {
+                const auto height = readValue<float>(ptr);
+                positions[index] = osg::Vec3f((vertX / float(numVerts - 1) - 0.5f) * size * mCellWorldSize,
+                                              (vertY / float(numVerts - 1) - 0.5f) * size * mCellWorldSize,
+                                              height);
+
+                osg::Vec3f normal;
+                for (int i = 0; i < 3; ++i)
+                    normal[i] = readValue<std::int8_t>(ptr) / 127.f;
+                normal.normalize();
+                normals[index] = normal;
+
+                for (int i = 0; i < 4; ++i)
+                    colours[index][i] = readValue<std::uint8_t>(ptr);
+
+                ++index;
+            }
+        }
+
+        return true;
+    }
+
+    osg::ref_ptr<osg::Image> BakedTerrain::getCompositeMap(float size, const osg::Vec2f& center) const
+    {
+        const auto it = mCompositeMaps.find(CompositeMapKey(size, center));
+        if (it == mCompositeMaps.end())
+            return nullptr;
+
+        osgDB::ReaderWriter* readerWriter = getPngReaderWriter();
+        if (!readerWriter)
+            return nullptr;
+
+        std::vector<char> data;
+        if (!read(it->second, data))
+            return nullptr;
+
+        Files::IMemStream stream(data.data(), data.size());
+        osgDB::ReaderWriter::ReadResult result = readerWriter->readImage(stream);
+        if (!result.success())
+        {
+            Log(Debug::Error) << "Error: Failed to read baked composite map: " << result.message() << " code " << result.status();
+            return nullptr;
+        }
+
+        return result.getImage();
+    }
+
+    BakedTerrainWriter::BakedTerrainWriter(const boost::filesystem::path& path, const std::string& contentKey,
+                                           float cellWorldSize, unsigned int compositeMapSize)
+        : mFile(path.string(), std::ios::binary | std::ios::trunc)
+    {
+        if (!mFile.is_open())
+            throw std::runtime_error("Failed to open " + path.string() + " for writing");
+
+        std::string header(magic, sizeof(magic));
+        writeValue(header, BakedTerrain::sVersion);
+        writeValue(header, cellWorldSize);
+        writeValue(header, static_cast<std::uint32_t>(compositeMapSize));
+        writeValue(header, static_cast<std::uint32_t>(contentKey.size()));
+        header += contentKey;
+        write(header);
+    }
+
+    void BakedTerrainWriter::addVertices(float size, const osg::Vec2f& center, unsigned int lod,
+                                         const osg::Vec3Array& positions, const osg::Vec3Array& normals,
+                                         const osg::Vec4ubArray& colours)
+    {
+        const auto numVerts = static_cast<std::uint32_t>(std::lround(std::sqrt(positions.size())));
+        if (static_cast<std::size_t>(numVerts) * numVerts != positions.size() || normals.size() != positions.size() || colours.size() != positions.size())
+            throw std::runtime_error("Invalid terrain chunk vertex data");
+
+        std::string data;
+        data.reserve(sizeof(numVerts) + positions.size() * vertexSize);
+        writeValue(data, numVerts);
+        for (std::size_t i = 0; i < positions.size(); ++i)
+        {
+            writeValue(data, positions[i].z());
+            for (int j = 0; j < 3; ++j)
+                writeValue(data, packNormal(normals[i][j]));
+            for (int j = 0; j < 4; ++j)
+                writeValue(data, colours[i][j]);
+        }
+
+        mVertices[BakedTerrain::VerticesKey(size, center, lod)] = write(data);
+    }
+
+    void BakedTerrainWriter::addCompositeMap(float size, const osg::Vec2f& center, const osg::Image& image)
+    {
+        osgDB::ReaderWriter* readerWriter = getPngReaderWriter();
+        if (!readerWriter)
+            throw std::runtime_error("Unable to write composite map, can't find a png ReaderWriter");
+
+        std::ostringstream stream;
+        osgDB::ReaderWriter::WriteResult result = readerWriter->writeImage(image, stream);
+        if (!result.success())
+            throw std::runtime_error("Unable to write composite map: " + result.message());
+
+        mCompositeMaps[BakedTerrain::CompositeMapKey(size, center)] = write(stream.str());
+    }
+
+    void BakedTerrainWriter::finish()
+    {
+        const auto indexOffset = static_cast<std::uint64_t>(mFile.tellp());
+
+        std::string index;
+        writeValue(index, static_cast<std::uint32_t>(mVertices.size()));
+        for (const auto& [key, blob] : mVertices)
+        {
+            writeValue(index, std::get<0>(key));
+            writeValue(index, std::get<1>(key));
+            writeValue(index, static_cast<std::uint32_t>(std::get<2>(key)));
+            writeValue(index, blob.mOffset);
+            writeValue(index, blob.mSize);
+        }
+        writeValue(index, static_cast<std::uint32_t>(mCompositeMaps.size()));
+        for (const auto& [key, blob] : mCompositeMaps)
+        {
+            writeValue(index, std::get<0>(key));
+            writeValue(index, std::get<1>(key));
+            writeValue(index, blob.mOffset);
+            writeValue(index, blob.mSize);
+        }
+        writeValue(index, indexOffset);
+        write(index);
+
+        mFile.close();
+        if (mFile.fail())
+            throw std::runtime_error("Failed to write baked terrain");
+    }
+
+    BakedTerrain::Blob BakedTerrainWriter::write(const std::string& data)
+    {
+        const BakedTerrain::Blob blob {static_cast<std::uint64_t>(mFile.tellp()), data.size()};
+        if (!mFile.write(data.data(), static_cast<std::streamsize>(data.size())))
+            throw std::runtime_error("Failed to write baked terrain");
+        return blob;
+    }
+}
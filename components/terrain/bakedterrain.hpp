@@ -0,0 +1,100 @@
+#ifndef OPENMW_COMPONENTS_TERRAIN_BAKEDTERRAIN_H
+#define OPENMW_COMPONENTS_TERRAIN_BAKEDTERRAIN_H
+
+#include <osg/Array>
+#include <osg/Image>
+#include <osg/ref_ptr>
+#include <osg/Vec2f>
+
+#include <boost/filesystem/path.hpp>
+
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace Terrain
+{
+    /// @brief Terrain chunk vertex buffers and composite maps generated ahead of time by the terrainbaketool.
+    /// The data is read from the file on demand, so a baked terrain can be queried from any thread.
+    /// Chunks are identified the same way as by the ChunkManager: by size, center and vertex LOD.
+    class BakedTerrain
+    {
+    public:
+        static constexpr std::uint32_t sVersion = 1;
+
+        /// Identifies the content a terrain is baked for. Includes names, sizes and modification times of the
+        /// content files, so changing any of them invalidates the baked data.
+        static std::string makeContentKey(const std::vector<boost::filesystem::path>& contentFiles);
+
+        /// Returns nullptr if the file doesn't exist or if it is baked for other content or with another version
+        /// of the format.
+        static std::unique_ptr<BakedTerrain> load(const boost::filesystem::path& path, const std::string& contentKey);
+
+        unsigned int getCompositeMapSize() const { return mCompositeMapSize; }
+
+        std::size_t getVerticesCount() const { return mVertices.size(); }
+        std::size_t getCompositeMapsCount() const { return mCompositeMaps.size(); }
+
+        /// Fills the arrays the same way as Terrain::Storage::fillVertexBuffers does. Returns false if the chunk
+        /// is not baked.
+        bool getVertices(float size, const osg::Vec2f& center, unsigned int lod, osg::Vec3Array& positions,
+                         osg::Vec3Array& normals, osg::Vec4ubArray& colours) const;
+
+        /// Returns nullptr if the chunk doesn't have a baked composite map.
+        osg::ref_ptr<osg::Image> getCompositeMap(float size, const osg::Vec2f& center) const;
+
+    private:
+        using VerticesKey = std::tuple<float, osg::Vec2f, unsigned int>;
+        using CompositeMapKey = std::tuple<float, osg::Vec2f>;
+
+        struct Blob
+        {
+            std::uint64_t mOffset;
+            std::uint64_t mSize;
+        };
+
+        BakedTerrain() = default;
+
+        bool read(const Blob& blob, std::vector<char>& data) const;
+
+        float mCellWorldSize = 0;
+        unsigned int mCompositeMapSize = 0;
+        std::map<VerticesKey, Blob> mVertices;
+        std::map<CompositeMapKey, Blob> mCompositeMaps;
+        mutable std::mutex mMutex;
+        mutable std::ifstream mFile;
+
+        friend class BakedTerrainWriter;
+    };
+
+    /// @brief Writes a file that can be loaded by BakedTerrain. Throws std::runtime_error on failure.
+    class BakedTerrainWriter
+    {
+    public:
+        BakedTerrainWriter(const boost::filesystem::path& path, const std::string& contentKey, float cellWorldSize,
+                           unsigned int compositeMapSize);
+
+        void addVertices(float size, const osg::Vec2f& center, unsigned int lod, const osg::Vec3Array& positions,
+                         const osg::Vec3Array& normals, const osg::Vec4ubArray& colours);
+
+        /// The image must have GL_RGB format with GL_UNSIGNED_BYTE data.
+        void addCompositeMap(float size, const osg::Vec2f& center, const osg::Image& image);
+
+        /// Writes the index, the file can't be loaded until this is called.
+        void finish();
+
+    private:
+        BakedTerrain::Blob write(const std::string& data);
+
+        std::ofstream mFile;
+        std::map<BakedTerrain::VerticesKey, BakedTerrain::Blob> mVertices;
+        std::map<BakedTerrain::CompositeMapKey, BakedTerrain::Blob> mCompositeMaps;
+    };
+}
+
+#endif
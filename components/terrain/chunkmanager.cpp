@@ -12,6 +12,7 @@
 
 #include <components/sceneutil/lightmanager.hpp>
 
+#include "bakedterrain.hpp"
 #include "terraindrawable.hpp"
 #include "material.hpp"
 #include "storage.hpp"
@@ -57,6 +58,7 @@ osg::ref_ptr<osg::Node> ChunkManager::getChunk(float size, const osg::Vec2f& cen
     lod = static_cast<unsigned char>(lodFlags >> (4*4));
     ChunkId id = std::make_tuple(center, lod, lodFlags);
     osg::ref_ptr<osg::Object> obj = mCache->getRefFromObjectCache(id);
+    countRequest(compile, obj != nullptr);
     if (obj)
         return static_cast<osg::Node*>(obj.get());
     else
@@ -103,6 +105,16 @@ osg::ref_ptr<osg::Texture2D> ChunkManager::createCompositeMapRTT()
     return texture;
 }
 
+osg::ref_ptr<CompositeMap> ChunkManager::createCompositeMap(float chunkSize, const osg::Vec2f& chunkCenter)
+{
+    osg::ref_ptr<CompositeMap> compositeMap = new CompositeMap;
+    compositeMap->mTexture = createCompositeMapRTT();
+
+    createCompositeMapGeometry(chunkSize, chunkCenter, osg::Vec4f(0,0,1,1), *compositeMap);
+
+    return compositeMap;
+}
+
 void ChunkManager::createCompositeMapGeometry(float chunkSize, const osg::Vec2f& chunkCenter, const osg::Vec4f& texCoords, CompositeMap& compositeMap)
 {
     if (chunkSize > mMaxCompGeometrySize)
@@ -194,7 +206,8 @@ osg::ref_ptr<osg::Node> ChunkManager::createChunk(float chunkSize, const osg::Ve
         osg::ref_ptr<osg::Vec4ubArray> colors (new osg::Vec4ubArray);
         colors->setNormalize(true);
 
-        mStorage->fillVertexBuffers(lod, chunkSize, chunkCenter, positions, normals, colors);
+        if (!mBakedTerrain || !mBakedTerrain->getVertices(chunkSize, chunkCenter, lod, *positions, *normals, *colors))
+            mStorage->fillVertexBuffers(lod, chunkSize, chunkCenter, positions, normals, colors);
 
         osg::ref_ptr<osg::VertexBufferObject> vbo (new osg::VertexBufferObject);
         positions->setVertexBufferObject(vbo);
@@ -254,18 +267,31 @@ osg::ref_ptr<osg::Node> ChunkManager::createChunk(float chunkSize, const osg::Ve
     {
         if (useCompositeMap)
         {
-            osg::ref_ptr<CompositeMap> compositeMap = new CompositeMap;
-            compositeMap->mTexture = createCompositeMapRTT();
+            osg::ref_ptr<osg::Image> bakedImage;
+            if (mBakedTerrain && mBakedTerrain->getCompositeMapSize() == mCompositeMapSize)
+                bakedImage = mBakedTerrain->getCompositeMap(chunkSize, chunkCenter);
 
-            createCompositeMapGeometry(chunkSize, chunkCenter, osg::Vec4f(0,0,1,1), *compositeMap);
+            osg::ref_ptr<osg::Texture2D> texture;
+            if (bakedImage)
+            {
+                texture = createCompositeMapRTT();
+                texture->setImage(bakedImage);
+                texture->setUnRefImageDataAfterApply(true);
+            }
+            else
+            {
+                osg::ref_ptr<CompositeMap> compositeMap = createCompositeMap(chunkSize, chunkCenter);
 
-            mCompositeMapRenderer->addCompositeMap(compositeMap.get(), false);
+                mCompositeMapRenderer->addCompositeMap(compositeMap.get(), false);
 
-            geometry->setCompositeMap(compositeMap);
-            geometry->setCompositeMapRenderer(mCompositeMapRenderer);
+                geometry->setCompositeMap(compositeMap);
+                geometry->setCompositeMapRenderer(mCompositeMapRenderer);
+
+                texture = compositeMap->mTexture;
+            }
 
             TextureLayer layer;
-            layer.mDiffuseMap = compositeMap->mTexture;
+            layer.mDiffuseMap = texture;
             layer.mParallax = false;
             layer.mSpecular = false;
             geometry->setPasses(::Terrain::createPasses(mSceneManager->getForceShaders() || !mSceneManager->getClampLighting(), &mSceneManager->getShaderManager(), std::vector<TextureLayer>(1, layer), std::vector<osg::ref_ptr<osg::Texture2D> >(), 1.f, 1.f));
@@ -1,6 +1,7 @@
 #ifndef OPENMW_COMPONENTS_TERRAIN_CHUNKMANAGER_H
 #define OPENMW_COMPONENTS_TERRAIN_CHUNKMANAGER_H
 
+#include <memory>
 #include <tuple>
 
 #include <components/resource/resourcemanager.hpp>
@@ -22,6 +23,7 @@ namespace Resource
 namespace Terrain
 {
 
+    class BakedTerrain;
     class TextureManager;
     class CompositeMapRenderer;
     class Storage;
@@ -42,6 +44,12 @@ namespace Terrain
         void setCompositeMapLevel(float level) { mCompositeMapLevel = level; }
         void setMaxCompositeGeometrySize(float maxCompGeometrySize) { mMaxCompGeometrySize = maxCompGeometrySize; }
 
+        /// Use vertex buffers and composite maps from the baked terrain when it has them, generate the rest.
+        void setBakedTerrain(std::shared_ptr<const BakedTerrain> bakedTerrain) { mBakedTerrain = std::move(bakedTerrain); }
+
+        /// Create the geometry to render the composite map of a chunk, it is rendered by CompositeMapRenderer.
+        osg::ref_ptr<CompositeMap> createCompositeMap(float chunkSize, const osg::Vec2f& chunkCenter);
+
         void setNodeMask(unsigned int mask) { mNodeMask = mask; }
         unsigned int getNodeMask() override { return mNodeMask; }
 
@@ -64,6 +72,7 @@ namespace Terrain
         Resource::SceneManager* mSceneManager;
         TextureManager* mTextureManager;
         CompositeMapRenderer* mCompositeMapRenderer;
+        std::shared_ptr<const BakedTerrain> mBakedTerrain;
         BufferCache mBufferCache;
 
         osg::ref_ptr<osg::StateSet> mMultiPassRoot;
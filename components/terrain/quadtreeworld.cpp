@@ -127,6 +127,8 @@ private:
     QuadTreeWorld* mWorld;
 };
 
+constexpr float minNodeSize = 1/8.f;
+
 class QuadTreeBuilder
 {
 public:
@@ -278,7 +280,7 @@ QuadTreeWorld::QuadTreeWorld(osg::Group *parent, osg::Group *compileRoot, Resour
     , mLodFactor(lodFactor)
     , mVertexLodMod(vertexLodMod)
     , mViewDistance(std::numeric_limits<float>::max())
-    , mMinSize(1/8.f)
+    , mMinSize(minNodeSize)
     , mDebugTerrainChunks(debugChunks)
 {
     mChunkManager->setCompositeMapSize(compMapResolution);
@@ -351,6 +353,24 @@ unsigned int getLodFlags(QuadTreeNode* node, unsigned int ourVertexLod, int vert
     return lodFlags;
 }
 
+void forEachChunk(QuadTreeNode* node, int vertexLodMod,
+                  const std::function<void(float size, const osg::Vec2f& center, unsigned int vertexLod)>& function)
+{
+    if (!node->hasValidBounds())
+        return;
+    function(node->getSize(), node->getCenter(), getVertexLod(node, vertexLodMod));
+    for (unsigned int i=0; i<node->getNumChildren(); ++i)
+        forEachChunk(node->getChild(i), vertexLodMod, function);
+}
+
+void QuadTreeWorld::forEachChunk(Storage* storage, int vertexLodMod,
+                                 const std::function<void(float size, const osg::Vec2f& center, unsigned int vertexLod)>& function)
+{
+    QuadTreeBuilder builder(storage, minNodeSize);
+    builder.build();
+    ::Terrain::forEachChunk(builder.getRootNode(), vertexLodMod, function);
+}
+
 void QuadTreeWorld::loadRenderingNode(ViewDataEntry& entry, ViewData* vd, float cellWorldSize, const osg::Vec4i &gridbounds, bool compile)
 {
     if (!vd->hasChanged() && entry.mRenderingNode)
@@ -554,6 +574,17 @@ void QuadTreeWorld::reportStats(unsigned int frameNumber, osg::Stats *stats)
 {
     if (mCompositeMapRenderer)
         stats->setAttribute(frameNumber, "Composite", mCompositeMapRenderer->getCompileSetSize());
+
+    unsigned int cached = 0;
+    unsigned int missed = 0;
+    for (ChunkManager* chunkManager : mChunkManagers)
+    {
+        const auto [chunkCached, chunkMissed] = chunkManager->takeRequestCounts();
+        cached += chunkCached;
+        missed += chunkMissed;
+    }
+    if (cached + missed > 0)
+        stats->setAttribute(frameNumber, "Chunk Prefetch HitRate", static_cast<double>(cached) / static_cast<double>(cached + missed) * 100.0);
 }
 
 void QuadTreeWorld::loadCell(int x, int y)
@@ -4,8 +4,11 @@
 #include "world.hpp"
 #include "terraingrid.hpp"
 
+#include <atomic>
+#include <functional>
 #include <mutex>
 #include <memory>
+#include <utility>
 
 namespace osg
 {
@@ -47,6 +50,11 @@ namespace Terrain
 
         void reportStats(unsigned int frameNumber, osg::Stats* stats) override;
 
+        /// Calls `function(size, center, vertexLod)` for every node of the quad tree built for the storage, i.e. for every
+        /// chunk the terrain can be rendered with. vertexLod is the LOD the ChunkManager creates the chunk vertices with.
+        static void forEachChunk(Storage* storage, int vertexLodMod,
+                                 const std::function<void(float size, const osg::Vec2f& center, unsigned int vertexLod)>& function);
+
         class ChunkManager
         {
         public:
@@ -60,9 +68,32 @@ namespace Terrain
             // Automatically set by addChunkManager based on getViewDistance()
             unsigned int getMaxLodLevel() const { return mMaxLodLevel; }
             void setMaxLodLevel(unsigned int level) { mMaxLodLevel = level; }
+
+            /// Returns the number of chunks requested for rendering that were found in the cache and that had to be
+            /// created, since the last call.
+            std::pair<unsigned int, unsigned int> takeRequestCounts()
+            {
+                return { mCachedRequests.exchange(0), mMissedRequests.exchange(0) };
+            }
+
+        protected:
+            /// Should be called by getChunk, so we know how many chunks were preloaded in time.
+            void countRequest(bool compile, bool cached)
+            {
+                // Preloading requests chunks with compile enabled
+                if (compile)
+                    return;
+                if (cached)
+                    ++mCachedRequests;
+                else
+                    ++mMissedRequests;
+            }
+
         private:
             float mViewDistance = 0.f;
             unsigned int mMaxLodLevel = ~0u;
+            std::atomic<unsigned int> mCachedRequests {0};
+            std::atomic<unsigned int> mMissedRequests {0};
         };
         void addChunkManager(ChunkManager*);
 
@@ -118,6 +118,12 @@ void World::setTargetFrameRate(float rate)
     mCompositeMapRenderer->setTargetFrameRate(rate);
 }
 
+void World::setBakedTerrain(std::shared_ptr<const BakedTerrain> bakedTerrain)
+{
+    if (mChunkManager)
+        mChunkManager->setBakedTerrain(std::move(bakedTerrain));
+}
+
 float World::getHeightAt(const osg::Vec3f &worldPos)
 {
     return mStorage->getHeightAt(worldPos);
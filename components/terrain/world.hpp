@@ -37,6 +37,7 @@ namespace Terrain
 {
     class Storage;
 
+    class BakedTerrain;
     class TextureManager;
     class ChunkManager;
     class CompositeMapRenderer;
@@ -113,6 +114,10 @@ namespace Terrain
         /// See CompositeMapRenderer::setTargetFrameRate
         void setTargetFrameRate(float rate);
 
+        /// See ChunkManager::setBakedTerrain
+        /// @note Should be called before any chunk is created.
+        void setBakedTerrain(std::shared_ptr<const BakedTerrain> bakedTerrain);
+
         /// Apply the scene manager's texture filtering settings to all cached textures.
         /// @note Thread safe.
         void updateTextureFiltering();
@@ -10,6 +10,13 @@
 
 uniform mat4 projectionMatrix;
 
+#if @instancing
+// Columns of the per-instance transform, relative to the coordinate system of the geometry
+attribute vec4 aInstanceTransform0;
+attribute vec4 aInstanceTransform1;
+attribute vec4 aInstanceTransform2;
+#endif
+
 #if @diffuseMap
 varying vec2 diffuseMapUV;
 #endif
@@ -68,16 +75,25 @@ varying vec3 passNormal;
 
 void main(void)
 {
-    gl_Position = projectionMatrix * (gl_ModelViewMatrix * gl_Vertex);
+#if @instancing
+    vec4 vertex = vec4(dot(aInstanceTransform0, gl_Vertex), dot(aInstanceTransform1, gl_Vertex), dot(aInstanceTransform2, gl_Vertex), 1.0);
+    mat3 instanceRotation = mat3(aInstanceTransform0.xyz, aInstanceTransform1.xyz, aInstanceTransform2.xyz);
+    vec3 normal = gl_Normal * instanceRotation;
+#else
+    vec4 vertex = gl_Vertex;
+    vec3 normal = gl_Normal;
+#endif
 
-    vec4 viewPos = (gl_ModelViewMatrix * gl_Vertex);
+    gl_Position = projectionMatrix * (gl_ModelViewMatrix * vertex);
+
+    vec4 viewPos = (gl_ModelViewMatrix * vertex);
 
     gl_ClipVertex = viewPos;
     euclideanDepth = length(viewPos.xyz);
     linearDepth = getLinearDepth(gl_Position.z, viewPos.z);
 
 #if (@envMap || !PER_PIXEL_LIGHTING || @shadows_enabled)
-    vec3 viewNormal = normalize((gl_NormalMatrix * gl_Normal).xyz);
+    vec3 viewNormal = normalize((gl_NormalMatrix * normal).xyz);
 #endif
 
 #if @envMap
@@ -109,8 +125,12 @@ void main(void)
 
 #if @normalMap
     normalMapUV = (gl_TextureMatrix[@normalMapUV] * gl_MultiTexCoord@normalMapUV).xy;
+#if @instancing
+    passTangent = vec4(gl_MultiTexCoord7.xyz * instanceRotation, gl_MultiTexCoord7.w);
+#else
     passTangent = gl_MultiTexCoord7.xyzw;
 #endif
+#endif
 
 #if @bumpMap
     bumpMapUV = (gl_TextureMatrix[@bumpMapUV] * gl_MultiTexCoord@bumpMapUV).xy;
@@ -122,7 +142,7 @@ void main(void)
 
     passColor = gl_Color;
     passViewPos = viewPos.xyz;
-    passNormal = gl_Normal.xyz;
+    passNormal = normal;
 
 #if !PER_PIXEL_LIGHTING
     vec3 diffuseLight, ambientLight;
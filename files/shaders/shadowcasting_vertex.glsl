@@ -8,11 +8,21 @@ uniform int colorMode;
 uniform bool useDiffuseMapForShadowAlpha = true;
 uniform bool alphaTestShadows = true;
 
+// Per-instance transform of instanced objects, see objects_vertex.glsl
+uniform bool useInstancing = false;
+attribute vec4 aInstanceTransform0;
+attribute vec4 aInstanceTransform1;
+attribute vec4 aInstanceTransform2;
+
 void main(void)
 {
-    gl_Position = gl_ModelViewProjectionMatrix * gl_Vertex;
+    vec4 vertex = gl_Vertex;
+    if (useInstancing)
+        vertex = vec4(dot(aInstanceTransform0, gl_Vertex), dot(aInstanceTransform1, gl_Vertex), dot(aInstanceTransform2, gl_Vertex), 1.0);
+
+    gl_Position = gl_ModelViewProjectionMatrix * vertex;
 
-    vec4 viewPos = (gl_ModelViewMatrix * gl_Vertex);
+    vec4 viewPos = (gl_ModelViewMatrix * vertex);
     gl_ClipVertex = viewPos;
 
     if (useDiffuseMapForShadowAlpha)